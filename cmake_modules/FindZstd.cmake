@@ -0,0 +1,43 @@
+# - Find Zstd (zstd.h, libzstd.a or libzstd.so)
+# This module defines
+#  ZSTD_INCLUDE_DIR, directory containing headers
+#  ZSTD_STATIC_LIB, path to libzstd's static library
+#  ZSTD_SHARED_LIB, path to libzstd's shared library, used when there is no static library
+#  ZSTD_FOUND, whether zstd has been found
+
+#
+# The following only applies to changes made to this file as part of YugaByte development.
+#
+# Portions Copyright (c) YugaByte, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+# in compliance with the License.  You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under the License
+# is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+# or implied.  See the License for the specific language governing permissions and limitations
+# under the License.
+#
+# Prefer zstd from thirdparty, and fall back to the system one, since zstd is not present in all
+# thirdparty builds. find_path and find_library do not search again once the variable is set.
+find_path(ZSTD_INCLUDE_DIR zstd.h
+  NO_CMAKE_SYSTEM_PATH
+  NO_SYSTEM_ENVIRONMENT_PATH)
+find_path(ZSTD_INCLUDE_DIR zstd.h)
+find_library(ZSTD_STATIC_LIB libzstd.a
+  NO_CMAKE_SYSTEM_PATH
+  NO_SYSTEM_ENVIRONMENT_PATH)
+find_library(ZSTD_STATIC_LIB libzstd.a)
+if(ZSTD_STATIC_LIB)
+  set(ZSTD_LIB ${ZSTD_STATIC_LIB})
+else()
+  # Some distributions only ship the shared library.
+  find_library(ZSTD_SHARED_LIB zstd)
+  set(ZSTD_LIB ${ZSTD_SHARED_LIB})
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD REQUIRED_VARS
+  ZSTD_LIB ZSTD_INCLUDE_DIR)
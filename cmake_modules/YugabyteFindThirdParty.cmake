@@ -153,6 +153,21 @@ find_package(Lz4 REQUIRED)
 include_directories(SYSTEM ${LZ4_INCLUDE_DIR})
 ADD_THIRDPARTY_LIB(lz4 STATIC_LIB "${LZ4_STATIC_LIB}")
 
+## Zstd
+# Zstd is optional, since it is not present in all third-party builds. Without it ZSTD compression
+# of SST blocks and RPC streams is reported as not supported.
+find_package(Zstd)
+if(ZSTD_FOUND)
+  include_directories(SYSTEM ${ZSTD_INCLUDE_DIR})
+  ADD_THIRDPARTY_LIB(zstd
+    STATIC_LIB "${ZSTD_STATIC_LIB}"
+    SHARED_LIB "${ZSTD_SHARED_LIB}")
+  ADD_CXX_FLAGS("-DZSTD")
+  set(ZSTD_LIBS zstd)
+else()
+  set(ZSTD_LIBS "")
+endif()
+
 ## ZLib
 find_package(Zlib REQUIRED)
 include_directories(SYSTEM ${ZLIB_INCLUDE_DIR})
@@ -2497,6 +2497,60 @@ TEST_F(ClientTest, BadMasterAddress) {
   messenger->Shutdown();
 }
 
+// Microbenchmark of tablet lookups resolved from the MetaCache, these lookups should scale with
+// the number of threads since they don't take any locks.
+TEST_F(ClientTest, CachedLookupScaling) {
+  const auto kLookupTimeout = 10s;
+  const auto kTestTime = AllowSlowTests() ? 5s : 1s;
+  const auto kNumKeys = 1024;
+
+  std::vector<PartitionKey> partition_keys;
+  for (int i = 0; i != kNumKeys; ++i) {
+    const auto hash_code = RandomUniformInt<uint16_t>(0, PartitionSchema::kMaxPartitionKey);
+    partition_keys.push_back(PartitionSchema::EncodeMultiColumnHashValue(hash_code));
+    // Fill the cache.
+    ASSERT_RESULT(client_->LookupTabletByKeyFuture(
+        client_table_.table(), partition_keys.back(),
+        CoarseMonoClock::now() + kLookupTimeout).get());
+  }
+
+  const size_t max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  for (size_t num_threads = 1;; num_threads = std::min(num_threads * 2, max_threads)) {
+    std::atomic<bool> stop_requested{false};
+    std::atomic<size_t> num_lookups{0};
+    std::atomic<size_t> num_failures{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i != num_threads; ++i) {
+      threads.emplace_back([&, i] {
+        size_t lookups = 0;
+        for (size_t idx = i; !stop_requested.load(std::memory_order_acquire); ++idx) {
+          client_->LookupTabletByKey(
+              client_table_.table(), partition_keys[idx % partition_keys.size()],
+              CoarseMonoClock::now() + kLookupTimeout,
+              [&num_failures](const Result<internal::RemoteTabletPtr>& tablet) {
+                if (!tablet.ok()) {
+                  num_failures.fetch_add(1, std::memory_order_relaxed);
+                }
+              });
+          ++lookups;
+        }
+        num_lookups.fetch_add(lookups, std::memory_order_acq_rel);
+      });
+    }
+    std::this_thread::sleep_for(kTestTime);
+    stop_requested.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(num_failures.load(), 0U);
+    LOG(INFO) << "Threads: " << num_threads << ", lookups per second: "
+              << num_lookups.load() * 1s / kTestTime;
+    if (num_threads == max_threads) {
+      break;
+    }
+  }
+}
+
 TEST_F(ClientTest, RefreshPartitions) {
   const auto kLookupTimeout = 10s;
   const auto kNumLookupThreads = 2;
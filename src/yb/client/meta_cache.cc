@@ -357,18 +357,17 @@ void RemoteTablet::Refresh(
   } else {
     ++lookups_without_new_replicas_;
   }
-  stale_ = false;
+  UpdateLeaderUnlocked();
+  stale_.store(false, std::memory_order_release);
   refresh_time_.store(MonoTime::Now(), std::memory_order_release);
 }
 
 void RemoteTablet::MarkStale() {
-  std::lock_guard<rw_spinlock> lock(mutex_);
-  stale_ = true;
+  stale_.store(true, std::memory_order_release);
 }
 
 bool RemoteTablet::stale() const {
-  SharedLock<rw_spinlock> lock(mutex_);
-  return stale_;
+  return stale_.load(std::memory_order_acquire);
 }
 
 void RemoteTablet::MarkAsSplit() {
@@ -389,6 +388,7 @@ bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& statu
   for (RemoteReplica& rep : replicas_) {
     if (rep.ts == ts) {
       rep.MarkFailed();
+      UpdateLeaderUnlocked();
       return true;
     }
   }
@@ -439,13 +439,19 @@ void RemoteTablet::SetAliveReplicas(int alive_live_replicas, int alive_read_repl
 }
 
 RemoteTabletServer* RemoteTablet::LeaderTServer() const {
-  SharedLock<rw_spinlock> lock(mutex_);
+  return leader_.load(std::memory_order_acquire);
+}
+
+void RemoteTablet::UpdateLeaderUnlocked() {
+  DCHECK(mutex_.is_locked());
+  RemoteTabletServer* leader = nullptr;
   for (const RemoteReplica& replica : replicas_) {
     if (!replica.Failed() && replica.role == PeerRole::LEADER) {
-      return replica.ts;
+      leader = replica.ts;
+      break;
     }
   }
-  return nullptr;
+  leader_.store(leader, std::memory_order_release);
 }
 
 bool RemoteTablet::HasLeader() const {
@@ -552,6 +558,7 @@ void RemoteTablet::GetRemoteTabletServers(
         update.replica->ClearFailed();
       }
     }
+    UpdateLeaderUnlocked();
   }
 }
 
@@ -566,6 +573,7 @@ bool RemoteTablet::MarkTServerAsLeader(const RemoteTabletServer* server) {
       replica.role = PeerRole::FOLLOWER;
     }
   }
+  UpdateLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   VLOG_IF_WITH_PREFIX(3, !found) << "Specified server not found: " << server->ToString()
                                  << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -581,6 +589,7 @@ void RemoteTablet::MarkTServerAsFollower(const RemoteTabletServer* server) {
       found = true;
     }
   }
+  UpdateLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   DCHECK(found) << "Tablet " << tablet_id_ << ": Specified server not found: "
                 << server->ToString() << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -921,9 +930,20 @@ Status MetaCache::ProcessTabletLocations(
   RETURN_NOT_OK(CheckTabletLocations(locations));
 
   std::vector<std::pair<LookupCallback, LookupCallbackVisitor>> to_notify;
+  // Partition maps are published after mutex_ is released.
+  std::vector<std::pair<TableId, TablePartitionMapPtr>> partition_maps;
+  auto publish_partition_maps = ScopeExit([this, &partition_maps] {
+    PublishPartitionMaps(&partition_maps);
+  });
   {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
     ProcessedTablesMap processed_tables;
+    // Tables with updated tablets_by_partition, their partition maps are prepared on exit.
+    std::unordered_set<TableId> updated_tables;
+    auto prepare_partition_maps = ScopeExit(
+        [this, &updated_tables, &partition_maps]() NO_THREAD_SAFETY_ANALYSIS {
+      PreparePartitionMapsUnlocked(updated_tables, &partition_maps);
+    });
 
     for (const TabletLocationsPB& loc : locations) {
       const std::string& tablet_id = loc.tablet_id();
@@ -991,6 +1011,7 @@ Status MetaCache::ProcessTabletLocations(
             // This only can happen for those LookupTabletById requests that don't specify table,
             // because they don't care about partitions changing.
             tablets_by_key = &table_data.tablets_by_partition;
+            updated_tables.insert(table_id);
           }
         }
 
@@ -1068,6 +1089,8 @@ Status MetaCache::ProcessTabletLocations(
     }
   }
 
+  // Publish before notifying callbacks, so their subsequent lookups could use the fast path.
+  PublishPartitionMaps(&partition_maps);
   for (const auto& callback_and_param : to_notify) {
     boost::apply_visitor(callback_and_param.second, callback_and_param.first);
   }
@@ -1128,6 +1151,7 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
       "table: $0, table.partition_list.version: $1", table_id, table_partition_list->version);
 
   std::vector<LookupCallback> to_notify;
+  std::vector<std::pair<TableId, TablePartitionMapPtr>> partition_maps;
 
   auto invalidate_needed = [this, &table_id, &table_partition_list](const auto& it) {
     const auto table_data_partition_list_version = it->second.partition_list->version;
@@ -1185,7 +1209,9 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
     // Only update partitions here after invalidating TableData cache to avoid inconsistencies.
     // See https://github.com/yugabyte/yugabyte-db/issues/6890.
     table_data.partition_list = table_partition_list;
+    PreparePartitionMapsUnlocked({table_id}, &partition_maps);
   }
+  PublishPartitionMaps(&partition_maps);
   for (const auto& callback : to_notify) {
     const auto s = STATUS_EC_FORMAT(
         TryAgain, ClientError(ClientErrorCode::kMetaCacheInvalidated),
@@ -1756,18 +1782,13 @@ void MetaCache::LookupByIdFailed(
   }
 }
 
-RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
-    const TableId& table_id, const VersionedPartitionStartKey& versioned_partition_start_key) {
-  auto it = tables_.find(table_id);
-  if (PREDICT_FALSE(it == tables_.end())) {
-    // No cache available for this table.
-    return nullptr;
-  }
-
-  const auto& table_data = it->second;
+namespace {
 
+RemoteTabletPtr LookupTabletInPartitionMap(
+    const TablePartitionMap& partition_map,
+    const VersionedPartitionStartKey& versioned_partition_start_key) {
   if (PREDICT_FALSE(
-          table_data.partition_list->version !=
+          partition_map.partition_list_version !=
           versioned_partition_start_key.partition_list_version)) {
     // TableData::partition_list version in cache does not match partition_list_version used to
     // calculate partition_key_start, can't use cache.
@@ -1776,11 +1797,8 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
 
   const auto& partition_start_key = *versioned_partition_start_key.key;
 
-  DCHECK_EQ(
-      partition_start_key,
-      *client::FindPartitionStart(table_data.partition_list, partition_start_key));
-  auto tablet_it = table_data.tablets_by_partition.find(partition_start_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
+  auto tablet_it = partition_map.tablets_by_partition.find(partition_start_key);
+  if (PREDICT_FALSE(tablet_it == partition_map.tablets_by_partition.end())) {
     // No tablets with a start partition key lower than 'partition_key'.
     return nullptr;
   }
@@ -1801,6 +1819,46 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
   return nullptr;
 }
 
+} // namespace
+
+RemoteTabletPtr MetaCache::LookupTabletByKeyFastPath(
+    const TableId& table_id, const VersionedPartitionStartKey& versioned_partition_start_key) {
+  return partition_maps_.Read(
+      table_id,
+      [&versioned_partition_start_key](const TablePartitionMap* partition_map) -> RemoteTabletPtr {
+    if (!partition_map) {
+      // No cache available for this table.
+      return nullptr;
+    }
+    return LookupTabletInPartitionMap(*partition_map, versioned_partition_start_key);
+  });
+}
+
+void MetaCache::PreparePartitionMapsUnlocked(
+    const std::unordered_set<TableId>& table_ids,
+    std::vector<std::pair<TableId, TablePartitionMapPtr>>* partition_maps) {
+  for (const auto& table_id : table_ids) {
+    auto it = tables_.find(table_id);
+    if (it == tables_.end()) {
+      continue;
+    }
+    auto& table_data = it->second;
+    partition_maps->emplace_back(table_id, std::make_unique<TablePartitionMap>(TablePartitionMap {
+      .partition_list_version = table_data.partition_list->version,
+      .tablets_by_partition = table_data.tablets_by_partition,
+      .change_number = ++table_data.partition_map_change_number,
+    }));
+  }
+}
+
+void MetaCache::PublishPartitionMaps(
+    std::vector<std::pair<TableId, TablePartitionMapPtr>>* partition_maps) {
+  for (auto& p : *partition_maps) {
+    partition_maps_.Publish(p.first, std::move(p.second));
+  }
+  partition_maps->clear();
+}
+
 boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnlocked(
     const std::shared_ptr<const YBTable>& table) {
   auto tablets = std::vector<RemoteTabletPtr>();
@@ -1823,11 +1881,10 @@ boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnl
   return tablets;
 }
 
-// We disable thread safety analysis in this function due to manual conditional locking.
-RemoteTabletPtr MetaCache::FastLookupTabletByKeyUnlocked(
+RemoteTabletPtr MetaCache::FastLookupTabletByKey(
     const TableId& table_id, const VersionedPartitionStartKey& partition_start) {
   // Fast path: lookup in the cache.
-  auto result = LookupTabletByKeyFastPathUnlocked(table_id, partition_start);
+  auto result = LookupTabletByKeyFastPath(table_id, partition_start);
   if (result && result->HasLeader()) {
     VLOG_WITH_PREFIX(5) << "Fast lookup: found tablet " << result->tablet_id();
     return result;
@@ -1864,7 +1921,7 @@ bool MetaCache::DoLookupTabletByKey(
   int64_t request_no;
   {
     Lock lock(mutex_);
-    tablet = FastLookupTabletByKeyUnlocked(table->id(), {partition_start, partitions->version});
+    tablet = FastLookupTabletByKey(table->id(), {partition_start, partitions->version});
     if (tablet) {
       return true;
     }
@@ -2009,6 +2066,13 @@ void MetaCache::LookupTabletByKey(const std::shared_ptr<YBTable>& table,
                     << ", partition_key: " << Slice(partition_key).ToDebugHexString()
                     << ", partition_start: " << Slice(*partition_start).ToDebugHexString();
 
+  // Most lookups are resolved from the cache, that does not require mutex_.
+  auto tablet = FastLookupTabletByKey(table->id(), {partition_start, table_partition_list->version});
+  if (tablet) {
+    callback(tablet);
+    return;
+  }
+
   PartitionGroupStartKeyPtr partition_group_start;
   if (DoLookupTabletByKey<SharedLock<std::shared_timed_mutex>>(
           table, table_partition_list, partition_start, deadline, &callback,
@@ -2195,6 +2259,55 @@ TableData::TableData(const VersionedTablePartitionListPtr& partition_list_)
   DCHECK_ONLY_NOTNULL(partition_list);
 }
 
+TablePartitionMaps::TablePartitionMaps() : slots_(new Slots()) {
+}
+
+TablePartitionMaps::~TablePartitionMaps() {
+  delete slots_.load(std::memory_order_acquire);
+}
+
+TablePartitionMaps::Slot::~Slot() {
+  delete map.load(std::memory_order_acquire);
+}
+
+void TablePartitionMaps::Publish(const TableId& table_id, TablePartitionMapPtr map) {
+  // Retired values are destroyed after the lock is released and the grace period is over.
+  std::vector<TablePartitionMapPtr> retired_maps;
+  std::vector<std::unique_ptr<const Slots>> retired_slots;
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto* slots = slots_.load(std::memory_order_acquire);
+  std::shared_ptr<Slot> slot;
+  auto it = slots->find(table_id);
+  if (it != slots->end()) {
+    slot = it->second;
+  } else {
+    auto new_slots = std::make_unique<Slots>(*slots);
+    slot = std::make_shared<Slot>();
+    new_slots->emplace(table_id, slot);
+    slots_.store(new_slots.release(), std::memory_order_release);
+    retired_slots_.emplace_back(slots);
+  }
+
+  const auto* old_map = slot->map.load(std::memory_order_acquire);
+  if (old_map && old_map->change_number >= map->change_number) {
+    // Snapshot of a later change was published concurrently.
+    return;
+  }
+  slot->map.store(map.release(), std::memory_order_release);
+  if (old_map) {
+    retired_maps_.emplace_back(old_map);
+  }
+
+  constexpr size_t kMaxRetiredValues = 16;
+  if (retired_maps_.size() + retired_slots_.size() < kMaxRetiredValues) {
+    return;
+  }
+  retired_maps.swap(retired_maps_);
+  retired_slots.swap(retired_slots_);
+  lock.unlock();
+  urcu_.Synchronize();
+}
+
 std::string VersionedPartitionStartKey::ToString() const {
   return YB_STRUCT_TO_STRING(key, partition_list_version);
 }
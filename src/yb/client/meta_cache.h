@@ -33,11 +33,14 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <atomic>
 #include <shared_mutex>
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/variant.hpp>
@@ -65,11 +68,13 @@
 #include "yb/tserver/tserver_fwd.h"
 
 #include "yb/util/capabilities.h"
+#include "yb/util/concurrent_value.h"
 #include "yb/util/format.h"
 #include "yb/util/locks.h"
 #include "yb/util/lockfree.h"
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/semaphore.h"
 #include "yb/util/status_fwd.h"
 #include "yb/util/memory/arena.h"
@@ -344,6 +349,9 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Same as ReplicasAsString(), except that the caller must hold mutex_.
   std::string ReplicasAsStringUnlocked() const;
 
+  // Updates leader_ after a change of replicas_, the caller must hold mutex_ exclusively.
+  void UpdateLeaderUnlocked();
+
   const std::string tablet_id_;
   const std::string log_prefix_;
   const Partition partition_;
@@ -353,7 +361,10 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
 
   // All non-const members are protected by 'mutex_'.
   mutable rw_spinlock mutex_;
-  bool stale_;
+  // Read without mutex_ by the MetaCache lookup fast path.
+  std::atomic<bool> stale_;
+  // Non-failed leader replica server, maintained from replicas_ to be read without mutex_.
+  std::atomic<RemoteTabletServer*> leader_{nullptr};
   bool is_split_ = false;
   std::vector<RemoteReplica> replicas_;
   PartitionListVersion last_known_partition_list_version_ = 0;
@@ -445,6 +456,9 @@ struct TableData {
   std::vector<RemoteTabletPtr> all_tablets;
   LookupDataGroup full_table_lookups;
   bool stale = false;
+  // Incremented on each change of partition_list or tablets_by_partition, that is published to
+  // MetaCache::partition_maps_.
+  uint64_t partition_map_change_number = 0;
   // To resolve partition_key to tablet_id MetaCache uses client::FindPartitionStart with
   // TableData::partition_list and then translates partition_start to tablet_id based on
   // TableData::tablets_by_partition.
@@ -461,6 +475,63 @@ struct TableData {
   // miss the key, because it doesn't exist in 1st post-split tablet.
 };
 
+// Immutable snapshot of TableData::partition_list version and TableData::tablets_by_partition.
+// Snapshots are made by MetaCache on each change of TableData under its lock, published after the
+// lock is released, and are used to resolve partition keys to tablets without taking any locks.
+struct TablePartitionMap {
+  PartitionListVersion partition_list_version;
+  std::map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+  // TableData::partition_map_change_number the snapshot was made at.
+  uint64_t change_number;
+};
+
+using TablePartitionMapPtr = std::unique_ptr<const TablePartitionMap>;
+
+// Partition maps of tables, that could be read without locks.
+//
+// Each table has its own slot, so publishing a map of a table replaces only this map. The table to
+// slot mapping is copied only when a new table is added. Replaced values are reclaimed in batches
+// after a URCU grace period, so a publisher does not wait for readers on each change.
+class TablePartitionMaps {
+ public:
+  TablePartitionMaps();
+  ~TablePartitionMaps();
+
+  TablePartitionMaps(const TablePartitionMaps&) = delete;
+  void operator=(const TablePartitionMaps&) = delete;
+
+  // Invokes f with the partition map of the specified table, or nullptr if there is no map for
+  // this table. The map should not be accessed after f returns.
+  template <class F>
+  auto Read(const TableId& table_id, const F& f) {
+    urcu_.AccessLock();
+    auto se = ScopeExit([this] { urcu_.AccessUnlock(); });
+    const auto* slots = slots_.load(std::memory_order_acquire);
+    auto it = slots->find(table_id);
+    return f(it != slots->end() ? it->second->map.load(std::memory_order_acquire) : nullptr);
+  }
+
+  // Publishes the partition map of the table, unless a map with a later change number was already
+  // published for it.
+  void Publish(const TableId& table_id, TablePartitionMapPtr map);
+
+ private:
+  struct Slot {
+    ~Slot();
+
+    std::atomic<const TablePartitionMap*> map{nullptr};
+  };
+
+  using Slots = std::unordered_map<TableId, std::shared_ptr<Slot>>;
+
+  std::atomic<const Slots*> slots_;
+  internal::URCU urcu_;
+
+  std::mutex mutex_;
+  std::vector<TablePartitionMapPtr> retired_maps_ GUARDED_BY(mutex_);
+  std::vector<std::unique_ptr<const Slots>> retired_slots_ GUARDED_BY(mutex_);
+};
+
 class LookupCallbackVisitor : public boost::static_visitor<> {
  public:
   explicit LookupCallbackVisitor(const LookupCallbackParam& param) : param_(param) {
@@ -569,10 +640,19 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
 
   // Lookup the given tablet by partition_start_key, only consulting local information.
-  // Returns true and sets *remote_tablet if successful.
-  RemoteTabletPtr LookupTabletByKeyFastPathUnlocked(
-      const TableId& table_id,
-      const VersionedPartitionStartKey& partition_key) REQUIRES_SHARED(mutex_);
+  // Does not require mutex_, uses the published partition maps.
+  RemoteTabletPtr LookupTabletByKeyFastPath(
+      const TableId& table_id, const VersionedPartitionStartKey& partition_key);
+
+  // Makes snapshots of partition maps of the specified tables, should be called after changing
+  // their partition list or tablets_by_partition. Snapshots are published with
+  // PublishPartitionMaps after releasing mutex_.
+  void PreparePartitionMapsUnlocked(
+      const std::unordered_set<TableId>& table_ids,
+      std::vector<std::pair<TableId, TablePartitionMapPtr>>* partition_maps) REQUIRES(mutex_);
+
+  void PublishPartitionMaps(std::vector<std::pair<TableId, TablePartitionMapPtr>>* partition_maps)
+      EXCLUDES(mutex_);
 
   RemoteTabletPtr LookupTabletByIdFastPathUnlocked(const TabletId& tablet_id)
       REQUIRES_SHARED(mutex_);
@@ -614,9 +694,8 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       LookupDataGroup* lookup_data_group,
       CallbackNotifier* notifier) REQUIRES(mutex_);
 
-  RemoteTabletPtr FastLookupTabletByKeyUnlocked(
-      const TableId& table_id,
-      const VersionedPartitionStartKey& partition_start) REQUIRES_SHARED(mutex_);
+  RemoteTabletPtr FastLookupTabletByKey(
+      const TableId& table_id, const VersionedPartitionStartKey& partition_start);
 
   // Lookup from cache the set of tablets corresponding to a tiven table.
   // Returns empty vector if the cache is invalid or a tablet is stale,
@@ -677,6 +756,9 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  // Snapshots of tables_ partition maps, read without mutex_.
+  TablePartitionMaps partition_maps_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<TabletId, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
@@ -52,6 +52,7 @@ class QLExprExecutor;
 typedef std::shared_ptr<QLExprExecutor> QLExprExecutorPtr;
 
 class QLTableRow;
+class QLTableRowBatch;
 class QLType;
 class QLValue;
 
@@ -18,9 +18,14 @@
 #include <rapidjson/prettywriter.h>
 
 #include "yb/common/jsonb.h"
+#include "yb/common/ql_protocol.pb.h"
+#include "yb/common/ql_value.h"
 
 #include "yb/gutil/dynamic_annotations.h"
+#include "yb/gutil/stringprintf.h"
 
+#include "yb/util/format.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/tostring.h"
@@ -158,5 +163,79 @@ TEST(JsonbTest, TestArrays) {
   VerifyArray(document);
 }
 
+namespace {
+
+void AddJsonOperation(JsonOperatorPB json_operator, const std::string& key,
+                      QLJsonColumnOperationsPB* json_ops) {
+  auto* op = json_ops->add_json_operations();
+  op->set_json_operator(json_operator);
+  op->mutable_operand()->mutable_value()->set_string_value(key);
+}
+
+std::string ObjectKey(int index) {
+  return StringPrintf("key_%04d", index);
+}
+
+} // namespace
+
+// Applies operators to a document of several hundred KBs. Logs the time of applying them and the
+// time of looking up the same path in the decoded document.
+TEST(JsonbTest, TestApplyOperatorsOnLargeDocument) {
+  constexpr int kNumKeys = 1000;
+  constexpr int kNumIterations = 1000;
+  const std::string kPayload(200, 'x');
+
+  std::string json = "{";
+  for (int i = 0; i != kNumKeys; ++i) {
+    if (i) {
+      json += ", ";
+    }
+    json += Format(R"#("$0" : { "a" : $1, "b" : "value_$1", "payload" : "$2" })#",
+                   ObjectKey(i), i, kPayload);
+  }
+  json += "}";
+  Jsonb jsonb;
+  ASSERT_OK(jsonb.FromString(json));
+  LOG(INFO) << "Serialized jsonb size: " << jsonb.SerializedJsonb().size();
+
+  QLJsonColumnOperationsPB text_ops;
+  AddJsonOperation(JsonOperatorPB::JSON_OBJECT, ObjectKey(kNumKeys / 3), &text_ops);
+  AddJsonOperation(JsonOperatorPB::JSON_TEXT, "b", &text_ops);
+  QLValue result;
+  ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), text_ops, &result));
+  ASSERT_EQ(Format("value_$0", kNumKeys / 3), result.string_value());
+
+  QLJsonColumnOperationsPB object_ops;
+  AddJsonOperation(JsonOperatorPB::JSON_OBJECT, ObjectKey(kNumKeys - 1), &object_ops);
+  ASSERT_OK(jsonb.ApplyJsonbOperators(object_ops, &result));
+  std::string object_json;
+  ASSERT_OK(Jsonb(result.jsonb_value()).ToJsonString(&object_json));
+  rapidjson::Document object;
+  object.Parse(object_json.c_str());
+  ASSERT_EQ(kNumKeys - 1, object["a"].GetInt());
+
+  QLJsonColumnOperationsPB missing_ops;
+  AddJsonOperation(JsonOperatorPB::JSON_OBJECT, ObjectKey(kNumKeys), &missing_ops);
+  AddJsonOperation(JsonOperatorPB::JSON_TEXT, "b", &missing_ops);
+  ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), missing_ops, &result));
+  ASSERT_TRUE(result.IsNull());
+
+  auto start = MonoTime::Now();
+  for (int i = 0; i != kNumIterations; ++i) {
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), text_ops, &result));
+  }
+  auto in_place_time = MonoTime::Now() - start;
+
+  start = MonoTime::Now();
+  for (int i = 0; i != kNumIterations; ++i) {
+    rapidjson::Document document;
+    ASSERT_OK(jsonb.ToRapidJson(&document));
+    result.set_string_value(document[ObjectKey(kNumKeys / 3).c_str()]["b"].GetString());
+  }
+  auto decode_time = MonoTime::Now() - start;
+
+  LOG(INFO) << "In place: " << in_place_time << ", with decode: " << decode_time;
+}
+
 }  // namespace common
 }  // namespace yb
@@ -710,7 +710,7 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
                                    ComputeDataOffset(num_kv_pairs, kJBObject), num_kv_pairs,
                                    result, element_metadata));
       return Status::OK();
-    } else if (mid_key.ToBuffer() > search_key) {
+    } else if (mid_key.compare(search_key_slice) > 0) {
       high = mid - 1;
     } else {
       low = mid + 1;
@@ -720,10 +720,15 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
 }
 
 Status Jsonb::ApplyJsonbOperators(const QLJsonColumnOperationsPB& json_ops, QLValue* result) const {
+  return ApplyJsonbOperators(serialized_jsonb_, json_ops, result);
+}
+
+Status Jsonb::ApplyJsonbOperators(const Slice& jsonb, const QLJsonColumnOperationsPB& json_ops,
+                                  QLValue* result) {
   const int num_ops = json_ops.json_operations().size();
 
   Slice jsonop_result;
-  Slice operand(serialized_jsonb_);
+  Slice operand(jsonb);
   JEntry element_metadata;
   for (int i = 0; i < num_ops; i++) {
     const QLJsonOperationPB &op = json_ops.json_operations().Get(i);
@@ -89,6 +89,13 @@ class Jsonb {
   CHECKED_STATUS ApplyJsonbOperators(const QLJsonColumnOperationsPB& json_ops,
                                      QLValue* result) const;
 
+  // Applies the json operators to the serialized jsonb in place. Object keys are looked up with a
+  // binary search over the sorted keys and array elements are accessed by their offsets, so the
+  // document is neither decoded nor copied, only the final result is materialized.
+  static CHECKED_STATUS ApplyJsonbOperators(const Slice& jsonb,
+                                            const QLJsonColumnOperationsPB& json_ops,
+                                            QLValue* result);
+
   const std::string& SerializedJsonb() const;
 
   // Use with extreme care since this destroys the internal state of the object. The only purpose
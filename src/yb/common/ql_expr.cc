@@ -50,9 +50,9 @@ CHECKED_STATUS QLExprExecutor::EvalExpr(const QLExpressionPB& ql_expr,
       if (temp.IsNull()) {
         result_writer.SetNull();
       } else {
-        common::Jsonb jsonb;
-        temp.MoveToJsonb(&jsonb);
-        RETURN_NOT_OK(jsonb.ApplyJsonbOperators(json_ops, &result_writer.NewValue()));
+        // Evaluate the operators directly on the column value, instead of copying the document.
+        RETURN_NOT_OK(common::Jsonb::ApplyJsonbOperators(
+            temp.Value().jsonb_value(), json_ops, &result_writer.NewValue()));
       }
       break;
     }
@@ -874,15 +874,6 @@ std::string QLTableRow::ToString(const Schema& schema) const {
   return ret;
 }
 
-void QLExprResult::MoveToJsonb(common::Jsonb* out) {
-  if (existing_value_) {
-    out->Assign(existing_value_->jsonb_value());
-    existing_value_ = nullptr;
-  } else {
-    out->Assign(std::move(*value_.mutable_value()->mutable_jsonb_value()));
-  }
-}
-
 const QLValuePB& QLExprResult::Value() const {
   if (existing_value_) {
     return *existing_value_;
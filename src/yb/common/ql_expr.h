@@ -54,8 +54,6 @@ class QLExprResult {
  public:
   const QLValuePB& Value() const;
 
-  void MoveToJsonb(common::Jsonb* out);
-
   void MoveTo(QLValuePB* out);
 
   QLValue& ForceNewValue();
@@ -206,6 +204,45 @@ class QLTableRow {
   size_t num_assigned_ = 0;
 };
 
+// Fixed capacity block of rows used by batched index lookups.
+// Rows are cleared but never destroyed when the batch is reset, so column storage allocated for
+// one batch is reused by the next one.
+class QLTableRowBatch {
+ public:
+  explicit QLTableRowBatch(size_t capacity) : rows_(capacity) {}
+
+  size_t capacity() const { return rows_.size(); }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == rows_.size(); }
+
+  const QLTableRow& row(size_t index) const {
+    DCHECK_LT(index, size_);
+    return rows_[index];
+  }
+
+  QLTableRow& row(size_t index) {
+    DCHECK_LT(index, size_);
+    return rows_[index];
+  }
+
+  // Returns cleared row at the end of the batch. Batch should not be full.
+  QLTableRow& AddRow() {
+    DCHECK_LT(size_, rows_.size());
+    auto& result = rows_[size_++];
+    result.Clear();
+    return result;
+  }
+
+  void Reset() {
+    size_ = 0;
+  }
+
+ private:
+  std::vector<QLTableRow> rows_;
+  size_t size_ = 0;
+};
+
 class QLExprExecutor {
  public:
   // Public types.
@@ -43,6 +43,13 @@ class TransactionStatusManagerMock : public TransactionStatusManager {
     return boost::none;
   }
 
+  boost::optional<CommitMetadata> CachedCommitData(const TransactionId& id) override {
+    return boost::none;
+  }
+
+  void CacheCommitData(const TransactionId& id, const CommitMetadata& data) override {
+  }
+
   void RequestStatusAt(const StatusRequest& request) override;
 
   void Commit(const TransactionId& txn_id, HybridTime commit_time) {
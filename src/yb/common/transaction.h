@@ -136,6 +136,15 @@ class TransactionStatusManager {
   // transaction. Otherwise, returns boost::none.
   virtual boost::optional<CommitMetadata> LocalCommitData(const TransactionId& id) = 0;
 
+  // Returns commit data of the transaction with known terminal status from the tablet wide cache,
+  // shared by all reads of this tablet. commit_ht is HybridTime::kMin for aborted transactions.
+  // Returns boost::none if the transaction is not cached.
+  virtual boost::optional<CommitMetadata> CachedCommitData(const TransactionId& id) = 0;
+
+  // Records commit data of the transaction with known terminal status, see CachedCommitData.
+  // Ignored if the transaction is not known to this tablet anymore.
+  virtual void CacheCommitData(const TransactionId& id, const CommitMetadata& data) = 0;
+
   // Fetches status of specified transaction at specified time from transaction coordinator.
   // Callback would be invoked in any case.
   // There are the following potential cases:
@@ -853,6 +853,43 @@ TEST_F(LogTest, TestWriteManyBatches) {
   }
 }
 
+// Reading a segment in chunks should return the same entries as reading it at once.
+TEST_F(LogTest, TestReadEntriesInChunks) {
+  constexpr size_t kNumBatches = 50;
+  BuildLog();
+  AppendReplicateBatchToLog(kNumBatches);
+  ASSERT_OK(log_->Close());
+
+  std::unique_ptr<LogReader> reader;
+  ASSERT_OK(LogReader::Open(
+      fs_manager_->env(), /* index= */ nullptr, "Log reader: ", tablet_wal_path_,
+      /* table_metric_entity= */ nullptr, /* tablet_metric_entity= */ nullptr, &reader));
+  SegmentSequence segments;
+  ASSERT_OK(reader->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(1U, segments.size());
+
+  auto all_entries = segments[0]->ReadEntries();
+  ASSERT_OK(all_entries.status);
+  ASSERT_EQ(kNumBatches, all_entries.entries.size());
+
+  ReadableLogSegment::ReadEntriesState state;
+  std::vector<yb::OpId> op_ids;
+  size_t num_chunks = 0;
+  while (!state.finished) {
+    // Budget of a single byte makes every chunk contain exactly one batch.
+    auto chunk = segments[0]->ReadEntries(&state, std::numeric_limits<int64_t>::max(), 1);
+    ASSERT_OK(chunk.status);
+    ASSERT_EQ(1U, chunk.entries.size());
+    op_ids.push_back(yb::OpId::FromPB(chunk.entries[0]->replicate().id()));
+    ++num_chunks;
+  }
+  ASSERT_EQ(kNumBatches, num_chunks);
+  ASSERT_EQ(all_entries.end_offset, state.offset);
+  for (size_t i = 0; i != op_ids.size(); ++i) {
+    ASSERT_EQ(yb::OpId::FromPB(all_entries.entries[i]->replicate().id()), op_ids[i]);
+  }
+}
+
 // This tests that querying LogReader works.
 // This sets up a reader with some segments to query which amount to the
 // following:
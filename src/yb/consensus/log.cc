@@ -954,7 +954,13 @@ Status Log::Sync() {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
-        RETURN_NOT_OK(active_segment_->Sync());
+        if (durable_wal_write_) {
+          RETURN_NOT_OK(active_segment_->Sync());
+        } else {
+          // Callbacks do not wait for periodic syncs, so the appender does not have to wait for
+          // them either. Result of the previous periodic sync is returned here.
+          RETURN_NOT_OK(active_segment_->SyncAsync());
+        }
       }
     }
   }
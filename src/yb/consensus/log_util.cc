@@ -471,40 +471,50 @@ Status ReadableLogSegment::ParseFooterMagicAndFooterLength(const Slice &data,
 }
 
 ReadEntriesResult ReadableLogSegment::ReadEntries(int64_t max_entries_to_read) {
+  ReadEntriesState state;
+  return ReadEntries(&state, max_entries_to_read, std::numeric_limits<size_t>::max());
+}
+
+ReadEntriesResult ReadableLogSegment::ReadEntries(
+    ReadEntriesState* state, int64_t max_entries_to_read, size_t max_bytes_to_read) {
   TRACE_EVENT1("log", "ReadableLogSegment::ReadEntries",
                "path", path_);
 
   ReadEntriesResult result;
 
-  std::vector<int64_t> recent_offsets(4, -1);
-  int64_t batches_read = 0;
-
-  int64_t offset = first_entry_offset();
-  int64_t readable_to_offset = readable_to_offset_.Load();
-  VLOG(1) << "Reading segment entries from "
-          << path_ << ": offset=" << offset << " file_size="
-          << file_size() << " readable_to_offset=" << readable_to_offset;
-  faststring tmp_buf;
-
-  // If we have a footer we only read up to it. If we don't we likely crashed
-  // and always read to the end.
-  int64_t read_up_to = (footer_.IsInitialized() && !footer_was_rebuilt_) ?
-      file_size() - footer_.ByteSize() - kLogSegmentFooterMagicAndFooterLength :
-      readable_to_offset;
-
+  if (state->offset < 0) {
+    state->offset = first_entry_offset();
+    int64_t readable_to_offset = readable_to_offset_.Load();
+    VLOG(1) << "Reading segment entries from "
+            << path_ << ": offset=" << state->offset << " file_size="
+            << file_size() << " readable_to_offset=" << readable_to_offset;
+
+    // If we have a footer we only read up to it. If we don't we likely crashed
+    // and always read to the end.
+    state->read_up_to = (footer_.IsInitialized() && !footer_was_rebuilt_) ?
+        file_size() - footer_.ByteSize() - kLogSegmentFooterMagicAndFooterLength :
+        readable_to_offset;
+  }
+
+  // Reset below when reading stops because of max_bytes_to_read.
+  state->finished = true;
+  int64_t& offset = state->offset;
+  const int64_t read_up_to = state->read_up_to;
+  auto& recent_offsets = state->recent_offsets;
+  auto& num_entries_read = state->num_entries_read;
+  const int64_t start_offset = offset;
   result.end_offset = offset;
 
-  int64_t num_entries_read = 0;
   while (offset < read_up_to) {
     const int64_t this_batch_offset = offset;
-    recent_offsets[batches_read++ % recent_offsets.size()] = offset;
+    recent_offsets[state->batches_read++ % recent_offsets.size()] = offset;
 
     LogEntryBatchPB current_batch;
 
     // Read and validate the entry header first.
     Status s;
     if (offset + implicit_cast<ssize_t>(kEntryHeaderSize) < read_up_to) {
-      s = ReadEntryHeaderAndBatch(&offset, &tmp_buf, &current_batch);
+      s = ReadEntryHeaderAndBatch(&offset, &state->tmp_buf, &current_batch);
     } else {
       s = STATUS(Corruption, Substitute("Truncated log entry at offset $0", offset));
     }
@@ -517,7 +527,7 @@ ReadEntriesResult ReadableLogSegment::ReadEntries(int64_t max_entries_to_read) {
       }
 
       result.status = MakeCorruptionStatus(
-          batches_read, this_batch_offset, &recent_offsets, result.entries, s);
+          state->batches_read, this_batch_offset, &recent_offsets, result.entries, s);
 
       // If we have a valid footer in the segment, then the segment was correctly
       // closed, and we shouldn't see any corruption anywhere (including the last
@@ -583,6 +593,11 @@ ReadEntriesResult ReadableLogSegment::ReadEntries(int64_t max_entries_to_read) {
       result.status = Status::OK();
       return result;
     }
+    if (static_cast<size_t>(offset - start_offset) >= max_bytes_to_read && offset < read_up_to) {
+      state->finished = false;
+      result.status = Status::OK();
+      return result;
+    }
   }
 
   if (footer_.IsInitialized() && footer_.num_entries() != num_entries_read) {
@@ -896,6 +911,10 @@ Status WritableLogSegment::Sync() {
   return writable_file_->Sync();
 }
 
+Status WritableLogSegment::SyncAsync() {
+  return writable_file_->SyncAsync();
+}
+
 // Creates a LogEntryBatchPB from pre-allocated ReplicateMsgs managed using shared pointers. The
 // caller has to ensure these messages are not deleted twice, both by LogEntryBatchPB and by
 // the shared pointers.
@@ -52,6 +52,7 @@
 #include "yb/util/atomic.h"
 #include "yb/util/compare_util.h"
 #include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/restart_safe_clock.h"
@@ -203,6 +204,29 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   // Will stop after reading max_entries_to_read entries.
   ReadEntriesResult ReadEntries(int64_t max_entries_to_read = std::numeric_limits<int64_t>::max());
 
+  // State of reading entries of the segment chunk by chunk, see ReadEntries below.
+  struct ReadEntriesState {
+    // Offset of the next batch to read, -1 if reading has not started yet.
+    int64_t offset = -1;
+    int64_t read_up_to = 0;
+    size_t batches_read = 0;
+    int64_t num_entries_read = 0;
+    std::vector<int64_t> recent_offsets = std::vector<int64_t>(4, -1);
+    faststring tmp_buf;
+    // Set when there is nothing more to read, because the end of the segment is reached, max
+    // entries were read or reading failed.
+    bool finished = false;
+  };
+
+  // Continues reading entries of the segment from the position saved in the state, so a segment
+  // could be processed without materializing all its entries at once.
+  // Stops after the batch that makes the total size of batches read by this call reach
+  // max_bytes_to_read, or when the number of entries read since the beginning of the segment
+  // reaches max_entries_to_read. Result has the same meaning as for ReadEntries above, for the
+  // entries read by this call.
+  ReadEntriesResult ReadEntries(
+      ReadEntriesState* state, int64_t max_entries_to_read, size_t max_bytes_to_read);
+
   // Reads the metadata of the first entry in the segment
   Result<FirstEntryMetadata> ReadFirstEntryMetadata();
 
@@ -402,6 +426,9 @@ class WritableLogSegment {
   // Makes sure the I/O buffers in the underlying writable file are flushed.
   CHECKED_STATUS Sync();
 
+  // Starts syncing the underlying writable file, see WritableFile::SyncAsync.
+  CHECKED_STATUS SyncAsync();
+
   // Returns true if the segment header has already been written to disk.
   bool IsHeaderWritten() const {
     return is_header_written_;
@@ -58,6 +58,12 @@ CHECKED_STATUS DocExprExecutor::EvalColumnRef(ColumnIdRep col_id,
 
   // Read key of the given row.
   if (col_id == static_cast<int>(PgSystemAttrNum::kYBTupleId)) {
+    // Batched index lookups store the tuple id in the row, since the iterator has moved past it.
+    const auto* tuple_id = table_row->GetColumn(col_id);
+    if (tuple_id) {
+      result_writer.SetExisting(tuple_id);
+      return Status::OK();
+    }
     return GetTupleId(&result_writer.NewValue());
   }
 
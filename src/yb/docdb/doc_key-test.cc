@@ -13,18 +13,26 @@
 
 #include "yb/docdb/doc_key.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table.h"
+#include "yb/rocksdb/table/block.h"
+#include "yb/rocksdb/table/block_builder.h"
+#include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/util/coding.h"
 
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/decimal.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/string_trim.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
 
 using std::unique_ptr;
 using strings::Substitute;
@@ -731,5 +739,213 @@ TEST_F(DocKeyTest, TestEnumerateIntents) {
   }
 }
 
+TEST_F(DocKeyTest, WholeDocKeyHashIndexKeyExtractor) {
+  const auto extractor = DocKeyHashIndexKeyExtractor();
+  ASSERT_STRNE(extractor->Name(), rocksdb::WholeUserKeyHashIndexKeyExtractor().Name());
+
+  for (const auto& sub_doc_key : GetVariedSubDocKeys()) {
+    SCOPED_TRACE(sub_doc_key.ToString());
+    const auto encoded_doc_key = sub_doc_key.doc_key().Encode();
+    // Hash index key is the whole DocKey, regardless of subkeys and hybrid time.
+    ASSERT_EQ(extractor->Extract(sub_doc_key.Encode().AsSlice()), encoded_doc_key.AsSlice());
+    ASSERT_EQ(extractor->Extract(encoded_doc_key.AsSlice()), encoded_doc_key.AsSlice());
+    // Keys that are not DocKeys could not be indexed.
+    ASSERT_TRUE(extractor->Extract(encoded_doc_key.AsSlice().Prefix(encoded_doc_key.size() - 1))
+                    .empty());
+  }
+}
+
+namespace {
+
+constexpr rocksdb::SequenceNumber kBlockSeqNo = 100;
+
+DocKey BlockTestDocKey(int doc) {
+  return DocKey({ PrimitiveValue::Int32(doc) });
+}
+
+// Returns sorted user keys of documents in [0, num_docs) range, only even documents are present.
+// Each document has num_columns columns, each column has num_versions versions.
+std::vector<std::string> GenerateDocDbUserKeys(int num_docs, int num_columns, int num_versions) {
+  std::vector<std::string> result;
+  for (int doc = 0; doc < num_docs; doc += 2) {
+    for (int column = 0; column != num_columns; ++column) {
+      for (int version = 1; version <= num_versions; ++version) {
+        result.push_back(SubDocKey(
+            BlockTestDocKey(doc), HybridTime::FromMicros(1000 * version),
+            { PrimitiveValue(ColumnId(column)) }).Encode().ToStringBuffer());
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::unique_ptr<rocksdb::Block> BuildDocDbBlock(
+    const std::vector<std::string>& user_keys, int restart_interval,
+    rocksdb::KeyValueEncodingFormat key_value_encoding_format,
+    const rocksdb::DataBlockHashIndexKeyExtractor* extractor) {
+  rocksdb::BlockBuilder builder(
+      restart_interval, key_value_encoding_format, /* use_delta_encoding = */ true, extractor);
+  for (const auto& user_key : user_keys) {
+    builder.Add(rocksdb::InternalKey(user_key, kBlockSeqNo, rocksdb::kTypeValue).Encode(),
+                user_key);
+  }
+  // Builder owns the data, so copy it to the block.
+  const auto data = builder.Finish();
+  std::unique_ptr<char[]> buffer(new char[data.size()]);
+  memcpy(buffer.get(), data.data(), data.size());
+  return std::make_unique<rocksdb::Block>(rocksdb::BlockContents(
+      std::move(buffer), data.size(), /* cachable= */ false, rocksdb::kNoCompression,
+      /* mem_tracker= */ nullptr));
+}
+
+bool HasDataBlockHashIndex(const rocksdb::Block& block) {
+  return rocksdb::DecodeFixed32(block.data() + block.size() - sizeof(uint32_t)) &
+         rocksdb::kDataBlockHashIndexFlag;
+}
+
+// Returns seek targets for all columns of documents in [-1, num_docs] range, including missing
+// documents and columns.
+std::vector<std::string> GenerateDocDbSeekTargets(int num_docs, int num_columns) {
+  std::vector<std::string> result;
+  for (int doc = -1; doc <= num_docs; ++doc) {
+    result.push_back(rocksdb::InternalKey(
+        BlockTestDocKey(doc).Encode().AsSlice(), rocksdb::kMaxSequenceNumber,
+        rocksdb::kValueTypeForSeek).Encode().ToString());
+    for (int column = 0; column <= num_columns; ++column) {
+      const auto user_key = SubDocKey(
+          BlockTestDocKey(doc), PrimitiveValue(ColumnId(column))).EncodeWithoutHt();
+      result.push_back(rocksdb::InternalKey(
+          user_key.AsSlice(), rocksdb::kMaxSequenceNumber,
+          rocksdb::kValueTypeForSeek).Encode().ToString());
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+// Documents span several restart intervals, seek using data block hash index by DocKey should
+// return the same entries as binary search.
+TEST_F(DocKeyTest, DataBlockHashIndexSeek) {
+  constexpr int kNumDocs = 64;
+  constexpr int kNumColumns = 8;
+
+  const rocksdb::InternalKeyComparator comparator(rocksdb::BytewiseComparator());
+  const auto targets = GenerateDocDbSeekTargets(kNumDocs, kNumColumns);
+  const auto extractor = DocKeyHashIndexKeyExtractor();
+
+  for (int num_versions : {2, 8}) {
+    const auto user_keys = GenerateDocDbUserKeys(kNumDocs, kNumColumns, num_versions);
+    for (auto key_value_encoding_format : rocksdb::kKeyValueEncodingFormatList) {
+      for (int restart_interval : {1, 4, 16}) {
+        SCOPED_TRACE(Format("Versions: $0, format: $1, restart interval: $2",
+                            num_versions, key_value_encoding_format, restart_interval));
+        auto plain_block = BuildDocDbBlock(
+            user_keys, restart_interval, key_value_encoding_format, nullptr);
+        auto hash_block = BuildDocDbBlock(
+            user_keys, restart_interval, key_value_encoding_format, extractor.get());
+        ASSERT_EQ(HasDataBlockHashIndex(*hash_block),
+                  hash_block->NumRestarts() <= rocksdb::kDataBlockHashIndexMaxRestart + 1U);
+
+        std::unique_ptr<rocksdb::InternalIterator> plain_iter(
+            plain_block->NewIterator(&comparator, key_value_encoding_format));
+        std::unique_ptr<rocksdb::InternalIterator> hash_iter(hash_block->NewIterator(
+            &comparator, key_value_encoding_format, /* iter = */ nullptr,
+            /* total_order_seek = */ true, extractor.get()));
+        for (const auto& target : targets) {
+          plain_iter->Seek(target);
+          hash_iter->Seek(target);
+          ASSERT_OK(hash_iter->status());
+          ASSERT_EQ(plain_iter->Valid(), hash_iter->Valid()) << Slice(target).ToDebugHexString();
+          if (plain_iter->Valid()) {
+            ASSERT_EQ(plain_iter->key(), hash_iter->key()) << Slice(target).ToDebugHexString();
+            ASSERT_EQ(plain_iter->value(), hash_iter->value());
+          }
+        }
+      }
+    }
+  }
+}
+
+namespace {
+
+// Compares seek within data block using data block hash index by DocKey and using binary search.
+void BenchmarkDataBlockHashIndexSeek(int num_columns, int num_versions) {
+  // Fills block with max number of restart intervals allowed with data block hash index.
+  constexpr int kRestartInterval = 16;
+  const int num_docs = std::max(
+      2 * (rocksdb::kDataBlockHashIndexMaxRestart + 1) * kRestartInterval /
+          (num_columns * num_versions),
+      2);
+  const int kNumIterations = RegularBuildVsSanitizers(100, 5);
+
+  const rocksdb::InternalKeyComparator comparator(rocksdb::BytewiseComparator());
+  const auto user_keys = GenerateDocDbUserKeys(num_docs, num_columns, num_versions);
+  auto targets = GenerateDocDbSeekTargets(num_docs, num_columns);
+  std::shuffle(targets.begin(), targets.end(), ThreadLocalRandom());
+  const auto extractor = DocKeyHashIndexKeyExtractor();
+  const auto format = rocksdb::KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
+
+  auto plain_block = BuildDocDbBlock(user_keys, kRestartInterval, format, nullptr);
+  auto hash_block = BuildDocDbBlock(user_keys, kRestartInterval, format, extractor.get());
+  ASSERT_TRUE(HasDataBlockHashIndex(*hash_block));
+
+  auto measure = [&targets, kNumIterations](rocksdb::InternalIterator* iter) {
+    size_t found = 0;
+    const auto start = MonoTime::Now();
+    for (int i = 0; i != kNumIterations; ++i) {
+      for (const auto& target : targets) {
+        iter->Seek(target);
+        found += iter->Valid();
+      }
+    }
+    const auto time = MonoTime::Now() - start;
+    LOG(INFO) << "Found: " << found;
+    return time;
+  };
+
+  std::unique_ptr<rocksdb::InternalIterator> plain_iter(
+      plain_block->NewIterator(&comparator, format));
+  std::unique_ptr<rocksdb::InternalIterator> hash_iter(hash_block->NewIterator(
+      &comparator, format, /* iter = */ nullptr, /* total_order_seek = */ true, extractor.get()));
+  // Keep the best of several runs to reduce noise.
+  MonoDelta plain_time;
+  MonoDelta hash_time;
+  for (int run = 0; run != 3; ++run) {
+    auto time = measure(plain_iter.get());
+    if (!plain_time || time < plain_time) {
+      plain_time = time;
+    }
+    time = measure(hash_iter.get());
+    if (!hash_time || time < hash_time) {
+      hash_time = time;
+    }
+  }
+
+  const auto num_seeks = targets.size() * kNumIterations;
+  LOG(INFO) << "Columns: " << num_columns << ", versions: " << num_versions
+            << ", block size: " << hash_block->size() << ", restarts: "
+            << hash_block->NumRestarts() << ", seeks: " << num_seeks;
+  LOG(INFO) << "Binary search per seek: " << plain_time.ToNanoseconds() * 1.0 / num_seeks << "ns";
+  LOG(INFO) << "Hash index per seek:    " << hash_time.ToNanoseconds() * 1.0 / num_seeks << "ns";
+#if !defined(THREAD_SANITIZER) && !defined(ADDRESS_SANITIZER)
+  // Allow some noise, both paths are expected to be close for wide rows.
+  ASSERT_LE(hash_time.ToNanoseconds(), plain_time.ToNanoseconds() * 1.1);
+#endif
+}
+
+} // namespace
+
+TEST_F(DocKeyTest, BenchmarkDataBlockHashIndexSeek) {
+  BenchmarkDataBlockHashIndexSeek(/* num_columns= */ 4, /* num_versions= */ 1);
+}
+
+// Each document spans many restart intervals, so most targets are located after the restart
+// interval the document is indexed by.
+TEST_F(DocKeyTest, BenchmarkDataBlockHashIndexSeekWideRows) {
+  BenchmarkDataBlockHashIndexSeek(/* num_columns= */ 32, /* num_versions= */ 8);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -25,6 +25,8 @@
 
 #include "yb/gutil/strings/substitute.h"
 
+#include "yb/rocksdb/table.h"
+
 #include "yb/util/compare_util.h"
 #include "yb/util/enums.h"
 #include "yb/util/result.h"
@@ -1149,8 +1151,25 @@ class HashedDocKeyUpToHashComponentsExtractor : public rocksdb::FilterPolicy::Ke
   HashedDocKeyUpToHashComponentsExtractor() = default;
 };
 
+class WholeDocKeyHashIndexKeyExtractor : public rocksdb::DataBlockHashIndexKeyExtractor {
+ public:
+  const char* Name() const override { return "DocKeyWholeDocKey"; }
+
+  // Non-DocKey keys could not be used with data block hash index, so blocks containing them are
+  // written without it.
+  Slice Extract(Slice user_key) const override {
+    auto size_result = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+    return size_result.ok() ? Slice(user_key.data(), *size_result) : Slice();
+  }
+};
+
 } // namespace
 
+std::shared_ptr<const rocksdb::DataBlockHashIndexKeyExtractor> DocKeyHashIndexKeyExtractor() {
+  static const auto instance = std::make_shared<const WholeDocKeyHashIndexKeyExtractor>();
+  return instance;
+}
+
 void DocDbAwareFilterPolicyBase::CreateFilter(
     const rocksdb::Slice* keys, int n, std::string* dst) const {
   CHECK_GT(n, 0);
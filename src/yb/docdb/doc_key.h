@@ -26,6 +26,7 @@
 
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/filter_policy.h"
+#include "yb/rocksdb/rocksdb_fwd.h"
 
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/slice.h"
@@ -869,6 +870,10 @@ class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
   const KeyTransformer* GetKeyTransformer() const override;
 };
 
+// Returns data block hash index key extractor that uses the whole encoded DocKey as hash index key,
+// so point lookups of all subkeys of the same document are served by the same restart interval.
+std::shared_ptr<const rocksdb::DataBlockHashIndexKeyExtractor> DocKeyHashIndexKeyExtractor();
+
 }  // namespace docdb
 }  // namespace yb
 
@@ -27,6 +27,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
+#include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/redis_operation.h"
 
@@ -41,10 +42,13 @@
 #include "yb/util/size_literals.h"
 #include "yb/util/tostring.h"
 
+#include "yb/yql/pggate/util/pg_wire.h"
+
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
+DECLARE_int32(ysql_index_lookup_batch_size);
 
 using namespace std::literals; // NOLINT
 
@@ -334,6 +338,30 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ <max> w: 2 }]) -> 4
     return row_block;
   }
 
+  // Executes the PGSQL read request and returns its rows in the PG wire format, skipping the row
+  // count that precedes them.
+  Result<std::string> ReadPgsql(const PgsqlReadRequestPB& request, const Schema& schema,
+                                const HybridTime& read_time, size_t* num_rows) {
+    return ReadPgsql(request, schema, nullptr /* index_schema */, read_time, num_rows);
+  }
+
+  Result<std::string> ReadPgsql(const PgsqlReadRequestPB& request, const Schema& schema,
+                                const Schema* index_schema, const HybridTime& read_time,
+                                size_t* num_rows) {
+    PgsqlReadOperation read_op(request, kNonTransactionalOperationContext);
+    QLRocksDBStorage ql_storage(doc_db());
+    faststring result_buffer;
+    HybridTime read_restart_ht;
+    *num_rows = VERIFY_RESULT(read_op.Execute(
+        ql_storage, CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(read_time),
+        false /* is_explicit_request_read_time */, schema, index_schema,
+        &result_buffer, &read_restart_ht));
+    SCHECK(!read_restart_ht.is_valid(), IllegalState, "Unexpected read restart");
+    SCHECK_GE(result_buffer.size(), sizeof(int64_t), Corruption, "Row count is missing");
+    return std::string(result_buffer.c_str() + sizeof(int64_t),
+                       result_buffer.size() - sizeof(int64_t));
+  }
+
   void SetMaxFileSizeForCompaction(const uint64_t max_size) {
     ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_max_file_size_for_compaction) = max_size;
     // Make a function that will always use rocksdb_max_file_size_for_compaction.
@@ -1283,5 +1311,85 @@ TEST_F(DocOperationTest, EarlyFilesFilteredBeforeBigFile) {
   ASSERT_EQ(kNumFilesToExpire, stats->getTickerCount(rocksdb::COMPACTION_FILES_FILTERED));
 }
 
+namespace {
+
+// Reads a value of the PG wire format row, returns boost::none for null.
+template <class T>
+boost::optional<T> ReadPgWireColumn(Slice* cursor) {
+  uint8_t header;
+  cursor->remove_prefix(pggate::PgWire::ReadNumber(cursor, &header));
+  if (pggate::PgWireDataHeader(header).is_null()) {
+    return boost::none;
+  }
+  T value;
+  cursor->remove_prefix(pggate::PgWire::ReadNumber(cursor, &value));
+  return value;
+}
+
+} // namespace
+
+// Base table rows are looked up in the key order, but should be returned in the index order.
+TEST_F(DocOperationTest, PgsqlIndexLookupBatch) {
+  constexpr int32_t kNumRows = 20;
+  // Index rows in [kNumRows, kNumRows + kNumDuplicates) refer the same base rows as the first ones.
+  constexpr int32_t kNumDuplicates = 5;
+  constexpr PgTableOid kIndexTableOid = 16384;
+  const ColumnId kIndexKeyColumnId(10);
+  const ColumnId kIndexBaseCtidColumnId(11);
+
+  Schema schema = CreateSchema();
+  for (int32_t k = 0; k != kNumRows; ++k) {
+    WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema,
+               vector<int32_t>({k, k, k * 2, k * 3}),
+               HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0));
+  }
+
+  // Index on a range column, whose order differs from the base table order.
+  const vector<ColumnSchema> index_columns({
+      ColumnSchema("v", INT32, false, false), ColumnSchema("ybidxbasectid", BINARY, false, false)});
+  Schema index_schema(index_columns, {kIndexKeyColumnId, kIndexBaseCtidColumnId}, 1);
+  index_schema.set_pgtable_id(kIndexTableOid);
+  auto base_key = [](int32_t v) {
+    return v < kNumRows ? v * 3 % kNumRows : v - kNumRows;
+  };
+  for (int32_t v = 0; v != kNumRows + kNumDuplicates; ++v) {
+    const DocKey index_key(index_schema, PrimitiveValues(PrimitiveValue::Int32(v)));
+    const DocKey ybctid(
+        kFixedHashCode, PrimitiveValues(PrimitiveValue::Int32(base_key(v))), PrimitiveValues());
+    ASSERT_OK(SetPrimitive(
+        DocPath(index_key.Encode(), PrimitiveValue(kIndexBaseCtidColumnId)),
+        Value(PrimitiveValue(ybctid.Encode().ToStringBuffer())), HybridTime(1000)));
+  }
+
+  // SELECT k, c2 ... using the index.
+  PgsqlReadRequestPB request;
+  for (int32_t column_id : {0, 2}) {
+    request.add_col_refs()->set_column_id(column_id);
+    request.add_targets()->set_column_id(column_id);
+  }
+  auto* index_request = request.mutable_index_request();
+  index_request->mutable_column_refs()->add_ids(kIndexKeyColumnId.rep());
+  index_request->mutable_column_refs()->add_ids(kIndexBaseCtidColumnId.rep());
+
+  const auto read_time = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0);
+  for (int32_t batch_size : {1, 3, kNumRows, 1024}) {
+    SCOPED_TRACE(Format("Batch size: $0", batch_size));
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_index_lookup_batch_size) = batch_size;
+    size_t num_rows = 0;
+    const auto rows = ASSERT_RESULT(ReadPgsql(
+        request, schema, &index_schema, read_time, &num_rows));
+    ASSERT_EQ(num_rows, static_cast<size_t>(kNumRows + kNumDuplicates));
+    Slice cursor(rows);
+    for (int32_t v = 0; v != kNumRows + kNumDuplicates; ++v) {
+      const auto key = ReadPgWireColumn<int32_t>(&cursor);
+      const auto value = ReadPgWireColumn<int32_t>(&cursor);
+      ASSERT_TRUE(key && value);
+      ASSERT_EQ(*key, base_key(v)) << "Index key: " << v;
+      ASSERT_EQ(*value, *key * 2);
+    }
+    ASSERT_TRUE(cursor.empty());
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -1439,35 +1439,57 @@ Result<Slice> DocRowwiseIterator::GetTupleId() const {
   return tuple_id;
 }
 
-Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
+Slice DocRowwiseIterator::PrepareTupleKey(const Slice& tuple_id) {
   // If cotable id / pgtable id is present in the table schema, then
   // we need to prepend it in the tuple key to seek.
-  if (schema_.has_cotable_id() || schema_.has_pgtable_id()) {
-    uint32_t size = schema_.has_pgtable_id() ? sizeof(PgTableOid) : kUuidSize;
-    if (!tuple_key_) {
-      tuple_key_.emplace();
-      tuple_key_->Reserve(1 + size + tuple_id.size());
-
-      if (schema_.has_cotable_id()) {
-        std::string bytes;
-        schema_.cotable_id().EncodeToComparable(&bytes);
-        tuple_key_->AppendValueType(ValueType::kTableId);
-        tuple_key_->AppendRawBytes(bytes);
-      } else {
-        tuple_key_->AppendValueType(ValueType::kPgTableOid);
-        tuple_key_->AppendUInt32(schema_.pgtable_id());
-      }
+  if (!schema_.has_cotable_id() && !schema_.has_pgtable_id()) {
+    return tuple_id;
+  }
+  uint32_t size = schema_.has_pgtable_id() ? sizeof(PgTableOid) : kUuidSize;
+  if (!tuple_key_) {
+    tuple_key_.emplace();
+    tuple_key_->Reserve(1 + size + tuple_id.size());
+
+    if (schema_.has_cotable_id()) {
+      std::string bytes;
+      schema_.cotable_id().EncodeToComparable(&bytes);
+      tuple_key_->AppendValueType(ValueType::kTableId);
+      tuple_key_->AppendRawBytes(bytes);
     } else {
-      tuple_key_->Truncate(1 + size);
+      tuple_key_->AppendValueType(ValueType::kPgTableOid);
+      tuple_key_->AppendUInt32(schema_.pgtable_id());
     }
-    tuple_key_->AppendRawBytes(tuple_id);
-    db_iter_->Seek(*tuple_key_);
   } else {
-    db_iter_->Seek(tuple_id);
+    tuple_key_->Truncate(1 + size);
+  }
+  tuple_key_->AppendRawBytes(tuple_id);
+  return tuple_key_->AsSlice();
+}
+
+Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
+  db_iter_->Seek(PrepareTupleKey(tuple_id));
+
+  iter_key_.Clear();
+  row_ready_ = false;
+
+  return VERIFY_RESULT(HasNext()) && VERIFY_RESULT(GetTupleId()) == tuple_id;
+}
+
+Result<bool> DocRowwiseIterator::SeekTupleForward(const Slice& tuple_id) {
+  const auto tuple_key = PrepareTupleKey(tuple_id);
+  bool need_seek = true;
+  if (is_forward_scan_ && !scan_choices_ && db_iter_->valid()) {
+    // Keep current position if the iterator already points to the requested row.
+    const auto key_data = VERIFY_RESULT(db_iter_->FetchKey());
+    need_seek = !key_data.key.starts_with(tuple_key);
+  }
+  if (need_seek) {
+    db_iter_->Seek(tuple_key);
   }
 
   iter_key_.Clear();
   row_ready_ = false;
+  done_ = false;
 
   return VERIFY_RESULT(HasNext()) && VERIFY_RESULT(GetTupleId()) == tuple_id;
 }
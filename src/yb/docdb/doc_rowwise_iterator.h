@@ -109,6 +109,12 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // the cotable id.
   Result<bool> SeekTuple(const Slice& tuple_id) override;
 
+  // Seeks to the given tuple, which is not less than the one sought by the previous SeekTuple or
+  // SeekTupleForward call. After a tuple is read, the underlying iterator is positioned at the
+  // beginning of the following row, so when tuples are sought in key order and are adjacent in the
+  // table, no seek is performed at all.
+  Result<bool> SeekTupleForward(const Slice& tuple_id) override;
+
   // Retrieves the next key to read after the iterator finishes for the given page.
   CHECKED_STATUS GetNextReadSubDocKey(SubDocKey* sub_doc_key) const override;
 
@@ -160,6 +166,10 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // ensures that the iterator will be positioned on the first kv-pair of the next row.
   CHECKED_STATUS AdvanceIteratorToNextDesiredRow() const;
 
+  // Fills tuple_key_ with the key of the given tuple prefixed with cotable id / pgtable id if the
+  // table has one, returns the key to seek.
+  Slice PrepareTupleKey(const Slice& tuple_id);
+
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
@@ -3958,5 +3958,30 @@ TEST_P(DocDBTestWrapper, DISABLED_KeyBuffer) {
   TestKeyBytes<ByteBuffer<64>>("ByteBuffer<64>");
 }
 
+// Subcompaction boundaries are aligned to document keys, so all entries of a document are processed
+// by the same compaction filter.
+TEST_F(DocDBTest, AdjustSubcompactionBoundary) {
+  DocDBCompactionFilterFactory factory(/* retention_policy= */ nullptr, /* key_bounds= */ nullptr);
+  for (const auto& doc_key : {DocKey(PrimitiveValues("k", 1)),
+                              DocKey(0x1234, PrimitiveValues("h"), PrimitiveValues("r", 2))}) {
+    SCOPED_TRACE(doc_key.ToString());
+    const auto encoded_doc_key = doc_key.Encode();
+    for (const auto& key : {
+        SubDocKey(doc_key, HybridTime::FromMicros(1000)).Encode(),
+        SubDocKey(doc_key, PrimitiveValue("c"), HybridTime::FromMicros(1000)).Encode(),
+        SubDocKey(doc_key, PrimitiveValue("c"), PrimitiveValue(5)).Encode()}) {
+      Slice boundary = key.AsSlice();
+      ASSERT_TRUE(factory.AdjustSubcompactionBoundary(&boundary));
+      ASSERT_EQ(encoded_doc_key.AsSlice(), boundary);
+    }
+  }
+
+  // A truncated document key could not be used as a boundary.
+  const auto encoded_doc_key = DocKey(PrimitiveValues("k", 1)).Encode();
+  Slice boundary = encoded_doc_key.AsSlice();
+  boundary.remove_suffix(1);
+  ASSERT_FALSE(factory.AdjustSubcompactionBoundary(&boundary));
+}
+
 }  // namespace docdb
 }  // namespace yb
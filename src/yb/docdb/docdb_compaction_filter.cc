@@ -371,6 +371,17 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
       key_bounds_);
 }
 
+bool DocDBCompactionFilterFactory::AdjustSubcompactionBoundary(Slice* user_key) const {
+  // DocDBCompactionFilter tracks overwrites and deletions within a document, so the whole document
+  // should be processed by the same subcompaction.
+  auto doc_key_size = DocKey::EncodedSize(*user_key, DocKeyPart::kWholeDocKey);
+  if (!doc_key_size.ok()) {
+    return false;
+  }
+  *user_key = Slice(user_key->data(), *doc_key_size);
+  return true;
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
@@ -178,6 +178,7 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  bool AdjustSubcompactionBoundary(Slice* user_key) const override;
   const char* Name() const override;
 
  private:
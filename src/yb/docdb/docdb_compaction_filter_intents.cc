@@ -235,6 +235,12 @@ std::unique_ptr<CompactionFilter> DocDBIntentsCompactionFilterFactory::CreateCom
   return std::make_unique<DocDBIntentsCompactionFilter>(tablet_, key_bounds_);
 }
 
+bool DocDBIntentsCompactionFilterFactory::AdjustSubcompactionBoundary(Slice* user_key) const {
+  // DocDBIntentsCompactionFilter decides on each key separately, and transactions to cleanup are
+  // collected and cleaned up by each filter, so any key could be a boundary.
+  return true;
+}
+
 const char* DocDBIntentsCompactionFilterFactory::Name() const {
   return "DocDBIntentsCompactionFilterFactory";
 }
@@ -38,6 +38,8 @@ class DocDBIntentsCompactionFilterFactory : public rocksdb::CompactionFilterFact
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
 
+  bool AdjustSubcompactionBoundary(Slice* user_key) const override;
+
   const char* Name() const override;
 
  private:
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <algorithm>
 #include <memory>
 #include <thread>
 
@@ -58,6 +59,8 @@ using namespace std::literals;
 static constexpr int32_t kMinBlockStartInterval = 1;
 static constexpr int32_t kDefaultBlockStartInterval = 16;
 static constexpr int32_t kMaxBlockStartInterval = 256;
+// Number of io_uring read chunks compaction inputs are read ahead with by default.
+static constexpr uint64_t kCompactionReadaheadIoUringChunks = 16;
 
 DEFINE_int32(rocksdb_max_background_flushes, -1, "Number threads to do background flushes.");
 DEFINE_bool(rocksdb_disable_compactions, false, "Disable rocksdb compactions.");
@@ -92,6 +95,12 @@ DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximum number of key range parts, processed in parallel, a large compaction could "
+             "be split into. 1 - do not split compactions.");
+DEFINE_int64(rocksdb_compaction_readahead_size_bytes, -1,
+             "Size of reads compaction input files are read with. -1 - multiple io_uring read "
+             "chunks when use_io_uring_reads is set and no readahead otherwise, 0 - no readahead.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
 
@@ -121,6 +130,15 @@ DEFINE_int32(max_nexts_to_avoid_seek, 2,
 
 DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.");
 
+DEFINE_bool(use_data_block_hash_index, false,
+            "Whether to add hash index by DocKey to data blocks of new SST files, so point lookups "
+            "could avoid binary search inside the data block. Files written with this option "
+            "could not be read by versions that do not support data block hash index.");
+
+DEFINE_double(data_block_hash_table_util_ratio, 0.75,
+              "Ratio of the number of distinct DocKeys to the number of buckets in data block hash "
+              "index. Used when use_data_block_hash_index is true.");
+
 DEFINE_string(
     regular_tablets_data_block_key_value_encoding, "shared_prefix",
     "Key-value encoding to use for regular data blocks in RocksDB. Possible options: "
@@ -143,9 +161,19 @@ DEFINE_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
               "By default, Snappy is used if supported.");
 
+DEFINE_int32(zstd_compression_level, -1,
+             "Compression level used with ZSTD on-disk compression. -1 means zstd default.");
+
+DEFINE_int32(zstd_max_dict_bytes, 0,
+             "Maximum size of the zstd dictionary trained for each SST file when ZSTD on-disk "
+             "compression is used. 0 disables dictionary compression.");
+
 DEFINE_int32(block_restart_interval, kDefaultBlockStartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
 
+DECLARE_bool(use_io_uring_reads);
+DECLARE_uint64(io_uring_read_chunk_bytes);
+
 namespace yb {
 
 namespace {
@@ -158,7 +186,8 @@ Result<rocksdb::CompressionType> GetConfiguredCompressionType(const std::string&
     rocksdb::kNoCompression,
     rocksdb::kSnappyCompression,
     rocksdb::kZlibCompression,
-    rocksdb::kLZ4Compression
+    rocksdb::kLZ4Compression,
+    rocksdb::kZSTDNotFinalCompression
   };
   for (const auto& compression_type : kValidRocksDBCompressionTypes) {
     if (flag_value == rocksdb::CompressionTypeToString(compression_type)) {
@@ -598,6 +627,10 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  if (options->compression == rocksdb::kZSTDNotFinalCompression) {
+    options->compression_opts.level = FLAGS_zstd_compression_level;
+    options->compression_opts.max_dict_bytes = std::max(FLAGS_zstd_max_dict_bytes, 0);
+  }
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -634,6 +667,14 @@ void InitRocksDBOptions(
     table_options.index_type = rocksdb::IndexType::kBinarySearch;
   }
 
+  // Extractor is always specified, so files written with data block hash index would use it even
+  // after use_data_block_hash_index is turned off.
+  table_options.data_block_hash_index_key_extractor = DocKeyHashIndexKeyExtractor();
+  if (FLAGS_use_data_block_hash_index) {
+    table_options.data_block_index_type = rocksdb::DataBlockIndexType::kBinarySearchAndHash;
+    table_options.data_block_hash_table_util_ratio = FLAGS_data_block_hash_table_util_ratio;
+  }
+
   options->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
 
   // Compaction related options.
@@ -663,6 +704,14 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = std::max(FLAGS_rocksdb_max_subcompactions, 1);
+    if (FLAGS_rocksdb_compaction_readahead_size_bytes >= 0) {
+      options->compaction_readahead_size = FLAGS_rocksdb_compaction_readahead_size_bytes;
+    } else if (FLAGS_use_io_uring_reads) {
+      // Readahead buffer is filled with a single read, that is split into parallel io_uring reads.
+      options->compaction_readahead_size =
+          kCompactionReadaheadIoUringChunks * FLAGS_io_uring_read_chunk_bytes;
+    }
     options->rate_limiter = tablet_options.rate_limiter ? tablet_options.rate_limiter
                                                         : CreateRocksDBRateLimiter();
   } else {
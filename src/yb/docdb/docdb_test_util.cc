@@ -74,6 +74,15 @@ class NonTransactionalStatusProvider: public TransactionStatusManager {
     return boost::none;
   }
 
+  boost::optional<CommitMetadata> CachedCommitData(const TransactionId& id) override {
+    Fail();
+    return boost::none;
+  }
+
+  void CacheCommitData(const TransactionId& id, const CommitMetadata& data) override {
+    Fail();
+  }
+
   void RequestStatusAt(const StatusRequest& request) override {
     Fail();
   }
@@ -553,6 +553,44 @@ SubDocKey(DocKey([], ["row1", 11111]), [ColumnId(50); HT{ physical: 2800 }]) ->
   }
 }
 
+TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorSeekTupleForward) {
+  constexpr int kNumRows = 6;
+  std::vector<KeyBytes> keys;
+  for (int i = 0; i != kNumRows; ++i) {
+    keys.push_back(DocKey(PrimitiveValues(Format("row$0", i), i)).Encode());
+    if (i == 3) {
+      // Leave a gap to check lookup of the missing row.
+      continue;
+    }
+    ASSERT_OK(SetPrimitive(
+        DocPath(keys.back(), PrimitiveValue(40_ColId)),
+        PrimitiveValue(i * 10), HybridTime::FromMicros(1000)));
+  }
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.Init(YQL_TABLE_TYPE));
+
+  QLTableRow row;
+  QLValue value;
+  for (int i : {0, 1, 2, 3, 5}) {
+    auto found = ASSERT_RESULT(iter.SeekTupleForward(keys[i].AsSlice()));
+    if (i == 3) {
+      ASSERT_FALSE(found);
+      continue;
+    }
+    ASSERT_TRUE(found);
+    row.Clear();
+    ASSERT_OK(iter.NextRow(&row));
+    ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+    ASSERT_EQ(i * 10, value.int64_value());
+  }
+}
+
 TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorIncompleteProjection) {
   auto dwb = MakeDocWriteBatch();
 
@@ -13,13 +13,17 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
 #include <boost/optional/optional_io.hpp>
 
+#include "yb/bfpg/bfdecl.h"
+
 #include "yb/common/partition.h"
 #include "yb/common/pg_system_attr.h"
 #include "yb/common/ql_value.h"
@@ -37,6 +41,8 @@
 #include "yb/docdb/primitive_value_util.h"
 #include "yb/docdb/ql_storage_interface.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
@@ -69,6 +75,12 @@ DEFINE_bool(pgsql_consistent_transactional_paging, true,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_int32(ysql_index_lookup_batch_size, 1024,
+             "Number of index rows collected before their base table rows are looked up, when "
+             "serving a YSQL index scan. Lookups of the batch are performed in the base table key "
+             "order. Value of 1 or less looks up base table rows one by one in the index order.");
+TAG_FLAG(ysql_index_lookup_batch_size, advanced);
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -167,6 +179,35 @@ Result<DocKey> FetchDocKey(const Schema& schema, const PgsqlWriteRequestPB& requ
       });
 }
 
+// Whether expression reads ybctid of the row.
+bool ReferencesTupleId(const PgsqlExpressionPB& expr) {
+  const google::protobuf::RepeatedPtrField<PgsqlExpressionPB>* operands;
+  switch (expr.expr_case()) {
+    case PgsqlExpressionPB::ExprCase::kColumnId:
+      return expr.column_id() == static_cast<int>(PgSystemAttrNum::kYBTupleId);
+    case PgsqlExpressionPB::ExprCase::kBfcall:
+      operands = &expr.bfcall().operands();
+      break;
+    case PgsqlExpressionPB::ExprCase::kTscall:
+      operands = &expr.tscall().operands();
+      break;
+    case PgsqlExpressionPB::ExprCase::kBocall:
+      operands = &expr.bocall().operands();
+      break;
+    case PgsqlExpressionPB::ExprCase::kCondition:
+      operands = &expr.condition().operands();
+      break;
+    default:
+      return false;
+  }
+  for (const auto& operand : *operands) {
+    if (ReferencesTupleId(operand)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Result<YQLRowwiseIteratorIf::UniPtr> CreateIterator(
     const YQLStorageIf& ql_storage,
     const PgsqlReadRequestPB& request,
@@ -995,9 +1036,20 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   bool scan_time_exceeded = false;
   CoarseTimePoint stop_scan = deadline - FLAGS_ysql_scan_deadline_margin_ms * 1ms;
 
+  // Rows of plain scans are collected column by column when the columnar format is requested,
+  // other result sets are small and always returned in the row format.
+  if (request_.columnar_result() && !request_.is_aggregate() && !request_.targets().empty()) {
+    columnar_writer_.emplace(request_.targets().size());
+  }
+
   // Fetching data.
   int match_count = 0;
   QLTableRow row;
+  if (request_.has_index_request() && FLAGS_ysql_index_lookup_batch_size > 1) {
+    match_count = VERIFY_RESULT(ExecuteIndexLookupBatch(
+        projection, ybbasectid_id, stop_scan, row_count_limit, result_buffer, &fetched_rows,
+        &scan_time_exceeded));
+  }
   while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
          !scan_time_exceeded) {
     row.Clear();
@@ -1050,12 +1102,114 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
     SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_slowdown_pgsql_aggregate_read_ms));
   }
 
+  if (columnar_writer_) {
+    DCHECK_EQ(columnar_writer_->num_rows(), fetched_rows);
+    columnar_writer_->Flush(result_buffer);
+    response_.set_columnar_result(true);
+  }
+
   RETURN_NOT_OK(SetPagingStateIfNecessary(
       iter, fetched_rows, row_count_limit, scan_time_exceeded, scan_schema,
       read_time, has_paging_state));
   return fetched_rows;
 }
 
+Result<int> PgsqlReadOperation::ExecuteIndexLookupBatch(const Schema& projection,
+                                                        ColumnId ybbasectid_id,
+                                                        CoarseTimePoint stop_scan,
+                                                        size_t row_count_limit,
+                                                        faststring* result_buffer,
+                                                        size_t* fetched_rows,
+                                                        bool* scan_time_exceeded) {
+  bool add_tuple_id = false;
+  for (const PgsqlExpressionPB& expr : request_.targets()) {
+    if (ReferencesTupleId(expr)) {
+      add_tuple_id = true;
+      break;
+    }
+  }
+
+  QLTableRowBatch batch(FLAGS_ysql_index_lookup_batch_size);
+  std::vector<std::string> tuple_ids(batch.capacity());
+  std::vector<size_t> lookup_order;
+  lookup_order.reserve(batch.capacity());
+  QLTableRow index_row;
+  int match_count = 0;
+  while (*fetched_rows < row_count_limit && !*scan_time_exceeded) {
+    // Never read more index rows than could be returned, so paging state is not affected.
+    const size_t max_rows = std::min(batch.capacity(), row_count_limit - *fetched_rows);
+    size_t num_rows = 0;
+    while (num_rows < max_rows && VERIFY_RESULT(index_iter_->HasNext())) {
+      index_row.Clear();
+      RETURN_NOT_OK(index_iter_->NextRow(&index_row));
+      const auto& tuple_id = index_row.GetValue(ybbasectid_id);
+      SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
+      tuple_ids[num_rows++] = tuple_id->binary_value();
+    }
+    if (num_rows == 0) {
+      break;
+    }
+
+    // Look up base table rows in key order, so the table iterator moves forward only and
+    // rows that are adjacent in the table are read without extra seeks.
+    lookup_order.resize(num_rows);
+    std::iota(lookup_order.begin(), lookup_order.end(), 0);
+    std::sort(lookup_order.begin(), lookup_order.end(), [&tuple_ids](size_t lhs, size_t rhs) {
+      return tuple_ids[lhs] < tuple_ids[rhs];
+    });
+    batch.Reset();
+    for (size_t i = 0; i != num_rows; ++i) {
+      batch.AddRow();
+    }
+    const std::string* prev_tuple_id = nullptr;
+    size_t prev_index = 0;
+    for (auto index : lookup_order) {
+      const auto& tuple_id = tuple_ids[index];
+      auto& row = batch.row(index);
+      if (prev_tuple_id && *prev_tuple_id == tuple_id) {
+        // Several index rows could refer the same base table row.
+        row = batch.row(prev_index);
+        continue;
+      }
+      // Tuple ids ascend only within a batch, so the first lookup of a batch repositions the
+      // iterator.
+      auto found = prev_tuple_id ? table_iter_->SeekTupleForward(tuple_id)
+                                 : table_iter_->SeekTuple(tuple_id);
+      if (!VERIFY_RESULT(std::move(found))) {
+        DocKey doc_key;
+        RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id));
+        return STATUS_FORMAT(Corruption, "ybctid $0 not found in indexed table", doc_key);
+      }
+      if (add_tuple_id) {
+        row.AllocColumn(static_cast<ColumnIdRep>(PgSystemAttrNum::kYBTupleId))
+            .value.set_binary_value(tuple_id);
+      }
+      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+      prev_tuple_id = &tuple_id;
+      prev_index = index;
+    }
+
+    // Produce results in the index order.
+    match_count += num_rows;
+    for (size_t i = 0; i != num_rows; ++i) {
+      if (request_.is_aggregate()) {
+        RETURN_NOT_OK(EvalAggregate(batch.row(i)));
+      } else {
+        RETURN_NOT_OK(PopulateResultSet(batch.row(i), result_buffer));
+        ++*fetched_rows;
+      }
+    }
+
+    if (num_rows < max_rows) {
+      break;
+    }
+
+    // Check if we are running out of time
+    *scan_time_exceeded = CoarseMonoClock::now() >= stop_scan;
+  }
+  return match_count;
+}
+
 Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_storage,
                                                       CoarseTimePoint deadline,
                                                       const ReadHybridTime& read_time,
@@ -1142,13 +1296,22 @@ Status PgsqlReadOperation::SetPagingStateIfNecessary(const YQLRowwiseIteratorIf*
 Status PgsqlReadOperation::PopulateResultSet(const QLTableRow& table_row,
                                              faststring *result_buffer) {
   QLExprResult result;
+  size_t index = 0;
   for (const PgsqlExpressionPB& expr : request_.targets()) {
     RETURN_NOT_OK(EvalExpr(expr, table_row, result.Writer()));
-    RETURN_NOT_OK(pggate::WriteColumn(result.Value(), result_buffer));
+    RETURN_NOT_OK(WriteTargetValue(index++, result.Value(), result_buffer));
   }
   return Status::OK();
 }
 
+Status PgsqlReadOperation::WriteTargetValue(size_t index, const QLValuePB& value,
+                                            faststring *result_buffer) {
+  if (columnar_writer_) {
+    return columnar_writer_->AppendValue(index, value);
+  }
+  return pggate::WriteColumn(value, result_buffer);
+}
+
 Status PgsqlReadOperation::GetTupleId(QLValue *result) const {
   // Get row key and save to QLValue.
   // TODO(neil) Check if we need to append a table_id and other info to TupleID. For example, we
@@ -14,6 +14,12 @@
 #ifndef YB_DOCDB_PGSQL_OPERATION_H
 #define YB_DOCDB_PGSQL_OPERATION_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
+
 #include "yb/common/pgsql_protocol.pb.h"
 
 #include "yb/docdb/doc_expr.h"
@@ -22,6 +28,10 @@
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/ql_rowwise_iterator_interface.h"
 
+#include "yb/util/mem_tracker.h"
+
+#include "yb/yql/pggate/util/pg_columnar_data.h"
+
 namespace yb {
 
 class IndexInfo;
@@ -169,6 +179,17 @@ class PgsqlReadOperation : public DocExprExecutor {
                                HybridTime *restart_read_ht,
                                bool *has_paging_state);
 
+  // Scan the index collecting batches of ysql_index_lookup_batch_size base table tuple ids, then
+  // look the base table rows up in key order and return them in the index order.
+  // Updates fetched_rows and scan_time_exceeded, returns number of rows found.
+  Result<int> ExecuteIndexLookupBatch(const Schema& projection,
+                                      ColumnId ybbasectid_id,
+                                      CoarseTimePoint stop_scan,
+                                      size_t row_count_limit,
+                                      faststring* result_buffer,
+                                      size_t* fetched_rows,
+                                      bool* scan_time_exceeded);
+
   // Execute a READ operator for a given batch of ybctids.
   Result<size_t> ExecuteBatchYbctid(const YQLStorageIf& ql_storage,
                                     CoarseTimePoint deadline,
@@ -189,6 +210,9 @@ class PgsqlReadOperation : public DocExprExecutor {
   CHECKED_STATUS PopulateResultSet(const QLTableRow& table_row,
                                    faststring *result_buffer);
 
+  // Write value of the target to the result set, in the columnar format if it was requested.
+  CHECKED_STATUS WriteTargetValue(size_t index, const QLValuePB& value, faststring *result_buffer);
+
   CHECKED_STATUS EvalAggregate(const QLTableRow& table_row);
 
   CHECKED_STATUS PopulateAggregate(const QLTableRow& table_row,
@@ -210,6 +234,9 @@ class PgsqlReadOperation : public DocExprExecutor {
   PgsqlResponsePB response_;
   YQLRowwiseIteratorIf::UniPtr table_iter_;
   YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // Accumulates rows of the result set when it is returned in the columnar format.
+  boost::optional<pggate::PgColumnarWriter> columnar_writer_;
 };
 
 }  // namespace docdb
@@ -208,7 +208,7 @@ Status QLRocksDBStorage::GetIterator(const PgsqlReadRequestPB& request,
             upper_doc_key.AddRangeComponent(
                 PrimitiveValue(docdb::ValueType::kHighest));
         }
-        LOG(INFO) << "WE HAVE AN UPPER BOUND";
+        VLOG(4) << "Upper bound: " << upper_doc_key.ToString();
     }
 
 
@@ -30,6 +30,10 @@ Result<bool> YQLRowwiseIteratorIf::SeekTuple(const Slice& tuple_id) {
   return STATUS(NotSupported, "This iterator cannot seek by tuple id");
 }
 
+Result<bool> YQLRowwiseIteratorIf::SeekTupleForward(const Slice& tuple_id) {
+  return SeekTuple(tuple_id);
+}
+
 Status YQLRowwiseIteratorIf::NextRow(const Schema& projection, QLTableRow* table_row) {
   return DoNextRow(projection, table_row);
 }
@@ -70,6 +70,11 @@ class YQLRowwiseIteratorIf {
   // Seeks to the given tuple by its id. See DocRowwiseIterator for details.
   virtual Result<bool> SeekTuple(const Slice& tuple_id);
 
+  // Same as SeekTuple, but the caller guarantees that tuple ids passed to consecutive calls since
+  // the last SeekTuple call are in ascending order, so the iterator could avoid repositioning when
+  // it is already there.
+  virtual Result<bool> SeekTupleForward(const Slice& tuple_id);
+
   //------------------------------------------------------------------------------------------------
   // Common API methods.
   //------------------------------------------------------------------------------------------------
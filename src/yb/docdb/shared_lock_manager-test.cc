@@ -16,11 +16,14 @@
 #include <stack>
 #include <thread>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include "yb/docdb/lock_batch.h"
 #include "yb/docdb/shared_lock_manager.h"
 
 #include "yb/rpc/thread_pool.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/result.h"
 #include "yb/util/test_macros.h"
@@ -35,6 +38,10 @@ using std::thread;
 
 DECLARE_bool(dump_lock_keys);
 
+METRIC_DECLARE_entity(tablet);
+
+METRIC_DECLARE_histogram(lock_manager_wait_time);
+
 namespace yb {
 namespace docdb {
 
@@ -199,5 +206,49 @@ TEST_F(SharedLockManagerTest, DumpKeys) {
       "{ key: 626172 intent_types: [kStrongRead, kStrongWrite] }]");
 }
 
+TEST_F(SharedLockManagerTest, WaitMetrics) {
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_tablet.Instantiate(&registry, "lock-manager-test");
+  lm_.SetMetricEntity(entity);
+  auto wait_time = METRIC_lock_manager_wait_time.Instantiate(entity);
+  // Sum of the per partition waiters gauges.
+  auto waiters = [&entity] {
+    int64_t result = 0;
+    size_t num_partitions = 0;
+    for (const auto& p : entity->UnsafeMetricsMapForTests()) {
+      const std::string name = p.first->name();
+      if (boost::starts_with(name, "lock_manager_partition_") &&
+          boost::ends_with(name, "_waiters")) {
+        result += down_cast<AtomicGauge<int64_t>*>(p.second.get())->value();
+        ++num_partitions;
+      }
+    }
+    EXPECT_GT(num_partitions, 1U);
+    return result;
+  };
+
+  auto lb1 = TestLockBatch();
+  ASSERT_OK(lb1.status());
+  ASSERT_EQ(0U, wait_time->TotalCount());
+
+  std::atomic<bool> locked(false);
+  Status waiter_status;
+  thread waiter([this, &locked, &waiter_status] {
+    auto lb2 = TestLockBatch();
+    waiter_status = lb2.status();
+    locked = true;
+  });
+
+  ASSERT_OK(WaitFor([&waiters] { return waiters() == 1; }, 10s, "Waiter registered"));
+  ASSERT_FALSE(locked.load());
+  lb1.Reset();
+  waiter.join();
+
+  ASSERT_OK(waiter_status);
+  ASSERT_TRUE(locked.load());
+  ASSERT_EQ(0, waiters());
+  ASSERT_GE(wait_time->TotalCount(), 1U);
+}
+
 } // namespace docdb
 } // namespace yb
@@ -25,12 +25,21 @@
 #include "yb/docdb/lock_batch.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/metrics.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
 
 using std::string;
 
+METRIC_DEFINE_coarse_histogram(
+    tablet, lock_manager_wait_time, "Key lock wait time", yb::MetricUnit::kMicroseconds,
+    "Time spent waiting for conflicting key locks");
+
+METRIC_DEFINE_counter(tablet, lock_manager_partition_contentions,
+                      "Lock manager partition contentions", yb::MetricUnit::kRequests,
+                      "Number of times a lock table partition mutex was held by another thread");
+
 namespace yb {
 namespace docdb {
 
@@ -92,6 +101,10 @@ std::array<LockState, kIntentTypeSetMapSize> GenerateByMask(LockState single_int
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetAdd = GenerateByMask(1);
 
+// Lock table is split into partitions by key hash, each partition has its own mutex, so threads
+// locking unrelated keys don't contend on the same mutex.
+constexpr size_t kNumLockPartitions = 16;
+
 } // namespace
 
 bool IntentTypeSetsConflict(IntentTypeSet lhs, IntentTypeSet rhs) {
@@ -105,14 +118,20 @@ bool IntentTypeSetsConflict(IntentTypeSet lhs, IntentTypeSet rhs) {
   return false;
 }
 
+struct LockManagerMetrics {
+  scoped_refptr<Histogram> wait_time;
+  scoped_refptr<Counter> partition_contentions;
+};
+
 struct LockedBatchEntry {
   // Taken only for short duration, with no blocking wait.
   mutable std::mutex mutex;
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the partition mutex is locked.
+  // Partition mutex resides in lock manager and is the same for all LockBatchEntries of the
+  // partition.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -120,7 +139,11 @@ struct LockedBatchEntry {
 
   std::atomic<size_t> num_waiters{0};
 
-  MUST_USE_RESULT bool Lock(IntentTypeSet lock, CoarseTimePoint deadline);
+  // Waiters gauge of the partition this entry belongs to, null when metrics are not exported.
+  AtomicGauge<int64_t>* partition_waiters = nullptr;
+
+  MUST_USE_RESULT bool Lock(
+      IntentTypeSet lock, CoarseTimePoint deadline, const LockManagerMetrics& metrics);
 
   void Unlock(IntentTypeSet lock);
 
@@ -137,29 +160,62 @@ class SharedLockManager::Impl {
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+    metrics_.wait_time = METRIC_lock_manager_wait_time.Instantiate(metric_entity);
+    metrics_.partition_contentions =
+        METRIC_lock_manager_partition_contentions.Instantiate(metric_entity);
+    for (size_t i = 0; i != kNumLockPartitions; ++i) {
+      auto description = Format("Number of lock requests waiting in lock table partition $0", i);
+      partitions_[i].waiters = metric_entity->FindOrCreateGauge(
+          std::unique_ptr<GaugePrototype<int64_t>>(new OwningGaugePrototype<int64_t>(
+              metric_entity->prototype().name(), Format("lock_manager_partition_$0_waiters", i),
+              description, MetricUnit::kRequests, description, MetricLevel::kInfo)),
+          static_cast<int64_t>(0) /* initial_value */);
+    }
+  }
+
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& partition : partitions_) {
+      std::lock_guard<std::mutex> lock(partition.mutex);
+      LOG_IF(DFATAL, !partition.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(partition.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  struct Partition {
+    // The partition mutex should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks;
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries;
+    std::vector<LockedBatchEntry*> free_lock_entries;
+
+    scoped_refptr<AtomicGauge<int64_t>> waiters;
+  };
+
+  // Make sure the entries exist in the locks map of their partitions and return pointers so we
+  // can access them without holding the partition lock. Returns a vector with pointers in the
+  // same order as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  Partition& PartitionForKey(const RefCntPrefix& key) {
+    return partitions_[RefCntPrefixHash()(key) % kNumLockPartitions];
+  }
+
+  // Locks the partition mutex unless it is already held, i.e. it is the same partition as the
+  // one used for the previous key of the batch.
+  void SwitchPartition(Partition* partition, std::unique_lock<std::mutex>* lock);
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<Partition, kNumLockPartitions> partitions_;
+
+  LockManagerMetrics metrics_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -184,11 +240,24 @@ std::string SharedLockManager::ToString(const LockState& state) {
   return result;
 }
 
-bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
+bool LockedBatchEntry::Lock(
+    IntentTypeSet lock_type, CoarseTimePoint deadline, const LockManagerMetrics& metrics) {
   size_t type_idx = lock_type.ToUIntPtr();
   auto& num_holding = this->num_holding;
   auto old_value = num_holding.load(std::memory_order_acquire);
   auto add = kIntentTypeSetAdd[type_idx];
+  CoarseTimePoint wait_start;
+  auto wait_se = ScopeExit([this, &metrics, &wait_start] {
+    if (wait_start != CoarseTimePoint()) {
+      if (partition_waiters) {
+        partition_waiters->Decrement();
+      }
+      if (metrics.wait_time) {
+        metrics.wait_time->Increment(
+            MonoDelta(CoarseMonoClock::Now() - wait_start).ToMicroseconds());
+      }
+    }
+  });
   for (;;) {
     if ((old_value & kIntentTypeSetConflicts[type_idx]) == 0) {
       auto new_value = old_value + add;
@@ -197,6 +266,12 @@ bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
       }
       continue;
     }
+    if (wait_start == CoarseTimePoint()) {
+      wait_start = CoarseMonoClock::Now();
+      if (partition_waiters) {
+        partition_waiters->Increment();
+      }
+    }
     num_waiters.fetch_add(1, std::memory_order_release);
     auto se = ScopeExit([this] {
       num_waiters.fetch_sub(1, std::memory_order_release);
@@ -263,7 +338,7 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
     const auto intent_types = key_and_intent_type.intent_types;
     VLOG(4) << "Locking " << yb::ToString(intent_types) << ": "
             << key_and_intent_type.key.as_slice().ToDebugHexString();
-    if (!key_and_intent_type.locked->Lock(intent_types, deadline)) {
+    if (!key_and_intent_type.locked->Lock(intent_types, deadline, metrics_)) {
       while (it != key_to_intent_type->begin()) {
         --it;
         it->locked->Unlock(it->intent_types);
@@ -277,18 +352,38 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
   return true;
 }
 
+void SharedLockManager::Impl::SwitchPartition(
+    Partition* partition, std::unique_lock<std::mutex>* lock) {
+  if (lock->mutex() == &partition->mutex) {
+    return;
+  }
+  if (lock->owns_lock()) {
+    lock->unlock();
+  }
+  *lock = std::unique_lock<std::mutex>(partition->mutex, std::try_to_lock);
+  if (!lock->owns_lock()) {
+    if (metrics_.partition_contentions) {
+      metrics_.partition_contentions->Increment();
+    }
+    lock->lock();
+  }
+}
+
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  std::unique_lock<std::mutex> lock;
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& partition = PartitionForKey(key_and_intent_type.key);
+    SwitchPartition(&partition, &lock);
+    auto& value = partition.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!partition.free_lock_entries.empty()) {
+        value = partition.free_lock_entries.back();
+        partition.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        partition.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = partition.lock_entries.back().get();
       }
+      value->partition_waiters = partition.waiters.get();
     }
     value->ref_count++;
     key_and_intent_type.locked = value;
@@ -306,11 +401,13 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  std::unique_lock<std::mutex> lock;
   for (const auto& item : key_to_intent_type) {
+    auto& partition = PartitionForKey(item.key);
+    SwitchPartition(&partition, &lock);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      partition.locks.erase(item.key);
+      partition.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -328,5 +425,9 @@ void SharedLockManager::Unlock(const LockBatchEntries& key_to_intent_type) {
   impl_->Unlock(key_to_intent_type);
 }
 
+void SharedLockManager::SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+  impl_->SetMetricEntity(metric_entity);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -21,6 +21,9 @@
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/intent.h"
 
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/monotime.h"
 
 namespace yb {
@@ -47,6 +50,10 @@ class SharedLockManager {
   // Release the batch of locks. Requires that the locks are held.
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  // Export lock manager metrics to the given entity. Should be called before the lock manager is
+  // used.
+  void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity);
+
   // Whether or not the state is possible
   static std::string ToString(const LockState& state);
 
@@ -0,0 +1,96 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <vector>
+
+#include "yb/docdb/transaction_status_cache.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+// Cache metrics are tablet level metrics, and docdb tests are not linked with tablet.
+METRIC_DEFINE_entity(tablet);
+
+METRIC_DECLARE_counter(transaction_status_cache_hits);
+METRIC_DECLARE_counter(transaction_status_cache_misses);
+
+namespace yb {
+namespace docdb {
+
+class TerminalTransactionStatusCacheTest : public YBTest {
+};
+
+TEST_F(TerminalTransactionStatusCacheTest, Simple) {
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_tablet.Instantiate(&registry, "transaction-status-cache-test");
+  TerminalTransactionStatusCache cache(100, entity);
+  auto hits = METRIC_transaction_status_cache_hits.Instantiate(entity);
+  auto misses = METRIC_transaction_status_cache_misses.Instantiate(entity);
+
+  auto committed = TransactionId::GenerateRandom();
+  auto aborted = TransactionId::GenerateRandom();
+  const HybridTime kCommitTime(1000);
+
+  ASSERT_FALSE(cache.Get(committed));
+  cache.Insert(committed, CommitMetadata {kCommitTime});
+  cache.Insert(aborted, CommitMetadata {HybridTime::kMin});
+
+  auto commit_data = cache.Get(committed);
+  ASSERT_TRUE(commit_data);
+  ASSERT_EQ(kCommitTime, commit_data->commit_ht);
+  commit_data = cache.Get(aborted);
+  ASSERT_TRUE(commit_data);
+  ASSERT_EQ(HybridTime::kMin, commit_data->commit_ht);
+
+  cache.Erase(committed);
+  ASSERT_FALSE(cache.Get(committed));
+
+  ASSERT_EQ(2, hits->value());
+  ASSERT_EQ(2, misses->value());
+}
+
+TEST_F(TerminalTransactionStatusCacheTest, Eviction) {
+  constexpr size_t kCapacity = 64;
+  TerminalTransactionStatusCache cache(kCapacity, nullptr);
+
+  std::vector<TransactionId> ids;
+  for (size_t i = 0; i != kCapacity * 10; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    cache.Insert(ids.back(), CommitMetadata {HybridTime(i + 1)});
+  }
+
+  size_t cached = 0;
+  for (size_t i = 0; i != ids.size(); ++i) {
+    auto commit_data = cache.Get(ids[i]);
+    if (commit_data) {
+      ASSERT_EQ(HybridTime(i + 1), commit_data->commit_ht);
+      ++cached;
+    }
+  }
+  ASSERT_GT(cached, 0);
+  // Capacity is split between shards, so it is rounded up to the number of shards.
+  ASSERT_LE(cached, kCapacity + 16);
+  // The most recently inserted transaction should not be evicted.
+  ASSERT_TRUE(cache.Get(ids.back()));
+}
+
+TEST_F(TerminalTransactionStatusCacheTest, Disabled) {
+  TerminalTransactionStatusCache cache(0, nullptr);
+  auto id = TransactionId::GenerateRandom();
+  cache.Insert(id, CommitMetadata {HybridTime(1)});
+  ASSERT_FALSE(cache.Get(id));
+}
+
+} // namespace docdb
+} // namespace yb
@@ -19,7 +19,9 @@
 #include "yb/common/hybrid_time.h"
 #include "yb/docdb/transaction_dump.h"
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/metrics.h"
 #include "yb/util/result.h"
+#include "yb/util/shared_lock.h"
 #include "yb/util/status_format.h"
 #include "yb/util/tsan_util.h"
 
@@ -28,6 +30,15 @@ using namespace std::literals;
 DEFINE_bool(TEST_transaction_allow_rerequest_status, true,
             "Allow rerequest transaction status when TryAgain is received.");
 
+METRIC_DEFINE_simple_counter(
+    tablet, transaction_status_cache_hits,
+    "Number of transaction status lookups served by the tablet transaction status cache",
+    yb::MetricUnit::kRequests);
+METRIC_DEFINE_simple_counter(
+    tablet, transaction_status_cache_misses,
+    "Number of transaction status lookups missed in the tablet transaction status cache",
+    yb::MetricUnit::kRequests);
+
 namespace yb {
 namespace docdb {
 
@@ -77,11 +88,31 @@ Result<CommitMetadata> TransactionStatusCache::GetCommitData(const TransactionId
     return it->second;
   }
 
+  auto cached_commit_data = txn_context_opt_.txn_status_manager->CachedCommitData(transaction_id);
+  if (cached_commit_data) {
+    // Commit time of the transaction is fixed, so it is enough to check whether it is visible at
+    // our read time.
+    if (cached_commit_data->commit_ht > read_time_.global_limit) {
+      cached_commit_data->commit_ht = HybridTime::kMin;
+    }
+    cache_.emplace(transaction_id, *cached_commit_data);
+    return *cached_commit_data;
+  }
+
   auto result = VERIFY_RESULT(DoGetCommitData(transaction_id));
   YB_TRANSACTION_DUMP(
       Status, txn_context_opt_ ? txn_context_opt_.transaction_id : TransactionId::Nil(),
       read_time_, transaction_id, result.commit_data.commit_ht, static_cast<uint8_t>(result.source),
       result.status_time, result.safe_time, result.commit_data.aborted_subtxn_set.ToString());
+  // Only statuses received from the coordinator are shared, locally committed transactions are
+  // already known to the participant.
+  // Coordinator also responds with ABORTED for transactions it does not know anymore, so such
+  // response is shared only when we waited for safe time at its status time and the transaction was
+  // still not committed locally.
+  if (result.source == CommitTimeSource::kRemoteCommitted ||
+      (result.source == CommitTimeSource::kRemoteAborted && result.safe_time.is_valid())) {
+    txn_context_opt_.txn_status_manager->CacheCommitData(transaction_id, result.commit_data);
+  }
   cache_.emplace(transaction_id, result.commit_data);
   return result.commit_data;
 }
@@ -200,5 +231,57 @@ Result<TransactionStatusCache::GetCommitDataResult> TransactionStatusCache::DoGe
   };
 }
 
+TerminalTransactionStatusCache::TerminalTransactionStatusCache(
+    size_t capacity, const scoped_refptr<MetricEntity>& entity)
+    : shard_capacity_((capacity + kNumShards - 1) / kNumShards) {
+  if (entity) {
+    hits_ = METRIC_transaction_status_cache_hits.Instantiate(entity);
+    misses_ = METRIC_transaction_status_cache_misses.Instantiate(entity);
+  }
+}
+
+TerminalTransactionStatusCache::Shard& TerminalTransactionStatusCache::ShardFor(
+    const TransactionId& transaction_id) {
+  return shards_[TransactionIdHash()(transaction_id) % kNumShards];
+}
+
+boost::optional<CommitMetadata> TerminalTransactionStatusCache::Get(
+    const TransactionId& transaction_id) {
+  auto& shard = ShardFor(transaction_id);
+  {
+    SharedLock<rw_spinlock> lock(shard.mutex);
+    auto& index = shard.entries.get<TransactionIdTag>();
+    auto it = index.find(transaction_id);
+    if (it != index.end()) {
+      IncrementCounter(hits_);
+      return it->commit_data;
+    }
+  }
+  IncrementCounter(misses_);
+  return boost::none;
+}
+
+void TerminalTransactionStatusCache::Insert(
+    const TransactionId& transaction_id, const CommitMetadata& commit_data) {
+  if (shard_capacity_ == 0) {
+    return;
+  }
+  auto& shard = ShardFor(transaction_id);
+  std::lock_guard<rw_spinlock> lock(shard.mutex);
+  auto p = shard.entries.push_back(Entry {
+    .transaction_id = transaction_id,
+    .commit_data = commit_data,
+  });
+  if (p.second && shard.entries.size() > shard_capacity_) {
+    shard.entries.pop_front();
+  }
+}
+
+void TerminalTransactionStatusCache::Erase(const TransactionId& transaction_id) {
+  auto& shard = ShardFor(transaction_id);
+  std::lock_guard<rw_spinlock> lock(shard.mutex);
+  shard.entries.get<TransactionIdTag>().erase(transaction_id);
+}
+
 } // namespace docdb
 } // namespace yb
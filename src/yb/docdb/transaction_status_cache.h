@@ -14,9 +14,21 @@
 #ifndef YB_DOCDB_TRANSACTION_STATUS_CACHE_H
 #define YB_DOCDB_TRANSACTION_STATUS_CACHE_H
 
+#include <array>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
 #include "yb/common/read_hybrid_time.h"
 #include "yb/common/transaction.h"
 
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/metrics_fwd.h"
+
 namespace yb {
 namespace docdb {
 
@@ -45,6 +57,57 @@ class TransactionStatusCache {
   std::unordered_map<TransactionId, CommitMetadata, TransactionIdHash> cache_;
 };
 
+// Bounded cache of commit data of transactions with terminal status, i.e. committed or aborted,
+// shared by all reads of a tablet. Without it every read that encounters provisional records of
+// the same transaction, that was committed but not yet applied at this tablet, would resolve its
+// status at the transaction coordinator.
+// Entries are evicted in insertion order and are invalidated when the transaction is removed from
+// the participant.
+class TerminalTransactionStatusCache {
+ public:
+  TerminalTransactionStatusCache(size_t capacity, const scoped_refptr<MetricEntity>& entity);
+
+  // Returns cached commit data. commit_ht is HybridTime::kMin for aborted transactions.
+  boost::optional<CommitMetadata> Get(const TransactionId& transaction_id);
+
+  void Insert(const TransactionId& transaction_id, const CommitMetadata& commit_data);
+
+  void Erase(const TransactionId& transaction_id);
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct Entry {
+    TransactionId transaction_id;
+    CommitMetadata commit_data;
+  };
+
+  class TransactionIdTag;
+
+  typedef boost::multi_index_container<
+      Entry,
+      boost::multi_index::indexed_by<
+          boost::multi_index::sequenced<>,
+          boost::multi_index::hashed_unique<
+              boost::multi_index::tag<TransactionIdTag>,
+              boost::multi_index::member<Entry, TransactionId, &Entry::transaction_id>,
+              TransactionIdHash>
+      >
+  > Entries;
+
+  struct Shard {
+    rw_spinlock mutex;
+    Entries entries;
+  };
+
+  Shard& ShardFor(const TransactionId& transaction_id);
+
+  const size_t shard_capacity_;
+  std::array<Shard, kNumShards> shards_;
+  scoped_refptr<Counter> hits_;
+  scoped_refptr<Counter> misses_;
+};
+
 } // namespace docdb
 } // namespace yb
 
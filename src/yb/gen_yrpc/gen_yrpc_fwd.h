@@ -23,6 +23,7 @@ class FieldDescriptor;
 class FileDescriptor;
 class Descriptor;
 class MethodDescriptor;
+class OneofDescriptor;
 class ServiceDescriptor;
 
 namespace io {
@@ -148,19 +148,24 @@ class Message {
             "}\n\n"
         );
         if (StoredAsSlice(field)) {
+          printer("void dup_$field_name$($field_stored_type$ value) {\n");
+          OneofSwitch(printer, field);
           printer(
-              "void dup_$field_name$($field_stored_type$ value) {\n"
               "  has_fields_.Set($message_name$Fields::k$field_camelcase_name$);\n"
               "  $field_name$_ = arena_.DupSlice(value);\n"
               "}\n\n"
               "void ref_$field_name$($field_stored_type$ value) {\n"
+          );
+          OneofSwitch(printer, field);
+          printer(
               "  has_fields_.Set($message_name$Fields::k$field_camelcase_name$);\n"
               "  $field_name$_ = value;\n"
               "}\n\n"
           );
         } else {
+          printer("void set_$field_name$($field_stored_type$ value) {\n");
+          OneofSwitch(printer, field);
           printer(
-              "void set_$field_name$($field_stored_type$ value) {\n"
               "  has_fields_.Set($message_name$Fields::k$field_camelcase_name$);\n"
               "  $field_name$_ = value;\n"
               "}\n\n"
@@ -173,6 +178,9 @@ class Message {
                 ": ::yb::rpc::empty_message<$field_stored_type$>();\n"
             "}\n\n"
             "$field_stored_type$& ref_$field_name$($field_stored_type$* value) {\n"
+        );
+        OneofSwitch(printer, field);
+        printer(
             "  $field_name$_ = value;\n"
             "  return *$field_name$_;\n"
             "}\n\n"
@@ -192,14 +200,16 @@ class Message {
       ScopedIndent mutable_ident(printer);
 
       if (StoreAsPointer(field)) {
+        printer("if (!$field_name$_) {\n");
+        OneofSwitch(printer, field);
         printer(
-          "if (!$field_name$_) {\n"
           "  $field_name$_ = arena_.NewObject<$field_stored_type$>(&arena_);\n"
           "}\n"
           "return $field_name$_;\n"
         );
       } else {
         if (!field->is_repeated()) {
+          OneofSwitch(printer, field, "");
           printer(
               "has_fields_.Set($message_name$Fields::k$field_camelcase_name$);\n"
           );
@@ -227,7 +237,7 @@ class Message {
           if (IsMessage(field)) {
             printer("  $field_name$_.Clear();\n");
           } else {
-            printer("  $field_name$_ = $field_stored_type$();\n");
+            printer("  $field_name$_ = $field_default_value$;\n");
           }
           printer("  has_fields_.Reset($message_name$Fields::k$field_camelcase_name$);\n");
         }
@@ -241,6 +251,10 @@ class Message {
       }
     }
 
+    for (int i = 0; i != message_->oneof_decl_count(); ++i) {
+      OneofAccessors(printer, message_->oneof_decl(i));
+    }
+
     if (NeedArena(message_)) {
       printer(
           "::yb::Arena& arena() const {\n"
@@ -285,7 +299,7 @@ class Message {
         );
       } else if (IsSimple(field)) {
         printer(
-            "$field_stored_type$ $field_name$_ = $field_stored_type$();\n"
+            "$field_stored_type$ $field_name$_ = $field_default_value$;\n"
         );
       } else {
         printer(
@@ -838,6 +852,57 @@ class Message {
     method_indent.Reset("}\n\n");
   }
 
+  // Oneof members are mutually exclusive, so other members of the oneof are cleared when a member
+  // that is not set yet gets a value. Nothing is printed for fields that are not in a oneof.
+  void OneofSwitch(
+      YBPrinter printer, const google::protobuf::FieldDescriptor* field,
+      const std::string& indent = "  ") const {
+    if (!field->containing_oneof()) {
+      return;
+    }
+    if (StoreAsPointer(field)) {
+      // Pointer fields call it only when the field is not set or is replaced anyway.
+      printer(indent + "clear_$field_oneof_name$();\n");
+    } else {
+      printer(
+          indent + "if (!has_$field_name$()) {\n" +
+          indent + "  clear_$field_oneof_name$();\n" +
+          indent + "}\n"
+      );
+    }
+  }
+
+  // Generates the case and clear accessors of the oneof, named the same way as in protobuf
+  // generated classes. The case is detected from the members that are set, since only one of them
+  // could be set at a time.
+  void OneofAccessors(YBPrinter printer, const google::protobuf::OneofDescriptor* oneof) const {
+    ScopedSubstituter oneof_substituter(printer, oneof);
+    printer(
+        "using $oneof_case_type$ = $message_pb_name$::$oneof_case_type$;\n"
+        "\n"
+        "$oneof_case_type$ $oneof_name$_case() const {\n"
+    );
+    for (int j = 0; j != oneof->field_count(); ++j) {
+      ScopedSubstituter field_substituter(printer, oneof->field(j));
+      printer(
+          "  if (has_$field_name$()) {\n"
+          "    return $message_pb_name$::$field_oneof_case$;\n"
+          "  }\n"
+      );
+    }
+    printer(
+        "  return $message_pb_name$::$oneof_not_set$;\n"
+        "}\n"
+        "\n"
+        "void clear_$oneof_name$() {\n"
+    );
+    for (int j = 0; j != oneof->field_count(); ++j) {
+      ScopedSubstituter field_substituter(printer, oneof->field(j));
+      printer("  clear_$field_name$();\n");
+    }
+    printer("}\n\n");
+  }
+
   bool StoreAsPointer(const google::protobuf::FieldDescriptor* field) const {
     return cycle_dependencies_.count(field) || IsPointerField(field);
   }
@@ -859,6 +924,8 @@ class MessagesGenerator::Impl {
         "#ifndef $upper_case$_MESSAGES_H\n"
         "#define $upper_case$_MESSAGES_H\n"
         "\n"
+        "#include <limits>\n"
+        "\n"
     );
 
     bool generating_any = false;
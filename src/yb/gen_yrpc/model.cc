@@ -13,13 +13,18 @@
 
 #include "yb/gen_yrpc/model.h"
 
+#include <cmath>
+#include <limits>
+
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/descriptor.pb.h>
 
 #include "yb/gutil/macros.h"
+#include "yb/gutil/strings/escaping.h"
 #include "yb/gutil/strings/join.h"
+#include "yb/gutil/strings/numbers.h"
 #include "yb/gutil/strings/split.h"
 
 #include "yb/rpc/service.pb.h"
@@ -33,6 +38,25 @@ namespace {
 
 const std::string kProtoExtension = ".proto";
 
+template <class T>
+std::string IntegerLiteral(T value, const std::string& type, const char* suffix) {
+  if (value == std::numeric_limits<T>::min() && value != 0) {
+    return "std::numeric_limits<" + type + ">::min()";
+  }
+  return std::to_string(value) + suffix;
+}
+
+template <class T>
+std::string FloatingPointLiteral(T value, const std::string& type, const std::string& str) {
+  if (std::isnan(value)) {
+    return "std::numeric_limits<" + type + ">::quiet_NaN()";
+  }
+  if (std::isinf(value)) {
+    return std::string(value < 0 ? "-" : "") + "std::numeric_limits<" + type + ">::infinity()";
+  }
+  return "static_cast<" + type + ">(" + str + ")";
+}
+
 }
 
 WireFormatLite::FieldType FieldType(const google::protobuf::FieldDescriptor* field) {
@@ -190,6 +214,45 @@ std::string MapFieldType(const google::protobuf::FieldDescriptor* field, Lightwe
   return "UNSUPPORTED TYPE";
 }
 
+std::string DefaultValue(const google::protobuf::FieldDescriptor* field) {
+  auto type = MapFieldType(field, Lightweight::kTrue);
+  // Enums default to their first value, that is not necessarily zero.
+  if (!field->has_default_value() &&
+      (field->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_ENUM ||
+       field->default_value_enum()->number() == 0)) {
+    return type + "()";
+  }
+  switch (field->cpp_type()) {
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+      return IntegerLiteral(field->default_value_int32(), type, "");
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+      return IntegerLiteral(field->default_value_int64(), type, "LL");
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+      return IntegerLiteral(field->default_value_uint32(), type, "U");
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+      return IntegerLiteral(field->default_value_uint64(), type, "ULL");
+    case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+      return FloatingPointLiteral(
+          field->default_value_double(), type, SimpleDtoa(field->default_value_double()));
+    case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+      return FloatingPointLiteral(
+          field->default_value_float(), type, SimpleFtoa(field->default_value_float()));
+    case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+      return field->default_value_bool() ? "true" : "false";
+    case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+      return "static_cast<" + type + ">(" +
+             std::to_string(field->default_value_enum()->number()) + ")";
+    case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
+      const auto& value = field->default_value_string();
+      // Points to a string literal, so it does not have to be copied to the arena.
+      return type + "(\"" + CEscape(value) + "\", " + std::to_string(value.size()) + ")";
+    }
+    default:
+      break;
+  }
+  return type + "()";
+}
+
 bool IsMessage(const google::protobuf::FieldDescriptor* field) {
   return field->type() == google::protobuf::FieldDescriptor::TYPE_MESSAGE;
 }
@@ -42,6 +42,8 @@ std::string RelativeClassPath(const std::string& clazz, const std::string& servi
 std::string UnnestedName(
     const google::protobuf::Descriptor* message, Lightweight lightweight, bool full_path);
 std::string MapFieldType(const google::protobuf::FieldDescriptor* field, Lightweight lightweight);
+// Returns C++ expression for the default value of the non repeated, non message field.
+std::string DefaultValue(const google::protobuf::FieldDescriptor* field);
 bool IsMessage(const google::protobuf::FieldDescriptor* field);
 bool IsSimple(const google::protobuf::FieldDescriptor* field);
 bool NeedArena(const google::protobuf::Descriptor* message);
@@ -56,6 +56,26 @@ std::string GenerateCloseNamespace(const string &str) {
   return out;
 }
 
+// Converts name to camel case the same way protobuf does for oneof case names.
+std::string UnderscoresToCamelCase(const std::string& input, bool cap_next_letter) {
+  std::string result;
+  for (char c : input) {
+    if ('a' <= c && c <= 'z') {
+      result += cap_next_letter ? static_cast<char>(c - 'a' + 'A') : c;
+      cap_next_letter = false;
+    } else if ('A' <= c && c <= 'Z') {
+      result += c;
+      cap_next_letter = false;
+    } else if ('0' <= c && c <= '9') {
+      result += c;
+      cap_next_letter = true;
+    } else {
+      cap_next_letter = true;
+    }
+  }
+  return result;
+}
+
 } // namespace
 
 FileSubstitutions::FileSubstitutions(const google::protobuf::FileDescriptor* file)
@@ -160,6 +180,9 @@ Substitutions CreateSubstitutions(const google::protobuf::FieldDescriptor* field
           : field_type);
   result.emplace_back("field_type", field_type);
   result.emplace_back("nonlw_field_type", MapFieldType(field, Lightweight::kFalse));
+  if (IsSimple(field)) {
+    result.emplace_back("field_default_value", DefaultValue(field));
+  }
   auto field_type_name = "TYPE_" + boost::to_upper_copy(std::string(field->type_name()));
   result.emplace_back("field_type_name", field_type_name);
   result.emplace_back("field_number", std::to_string(field->number()));
@@ -170,6 +193,19 @@ Substitutions CreateSubstitutions(const google::protobuf::FieldDescriptor* field
   result.emplace_back(
       "field_serialization_prefix",
       field->is_packed() ? "Packed" : field->is_repeated() ? "Repeated" : "Single");
+  const auto* oneof = field->containing_oneof();
+  if (oneof) {
+    result.emplace_back("field_oneof_name", boost::to_lower_copy(oneof->name()));
+    result.emplace_back("field_oneof_case", "k" + UnderscoresToCamelCase(field->name(), true));
+  }
+  return result;
+}
+
+Substitutions CreateSubstitutions(const google::protobuf::OneofDescriptor* oneof) {
+  Substitutions result;
+  result.emplace_back("oneof_name", boost::to_lower_copy(oneof->name()));
+  result.emplace_back("oneof_case_type", UnderscoresToCamelCase(oneof->name(), true) + "Case");
+  result.emplace_back("oneof_not_set", boost::to_upper_copy(oneof->name()) + "_NOT_SET");
   return result;
 }
 
@@ -56,6 +56,7 @@ Substitutions CreateSubstitutions(const google::protobuf::Descriptor* message);
 Substitutions CreateSubstitutions(
     const google::protobuf::MethodDescriptor* method, rpc::RpcSides side);
 Substitutions CreateSubstitutions(const google::protobuf::FieldDescriptor* field);
+Substitutions CreateSubstitutions(const google::protobuf::OneofDescriptor* oneof);
 Substitutions CreateSubstitutions(const google::protobuf::ServiceDescriptor* service);
 
 } // namespace gen_yrpc
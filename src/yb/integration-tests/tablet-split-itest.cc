@@ -119,6 +119,8 @@ DECLARE_bool(TEST_pause_tserver_get_split_key);
 DECLARE_bool(TEST_reject_delete_not_serving_tablet_rpc);
 DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int64(db_block_cache_size_bytes);
+DECLARE_uint64(tablet_key_access_sample_size);
+DECLARE_uint64(tablet_split_min_key_access_samples);
 
 
 namespace yb {
@@ -1482,6 +1484,44 @@ TEST_F(TabletSplitSingleServerITest, TabletServerGetSplitKey) {
   auto decoded_partition_key_hash = PartitionSchema::DecodeMultiColumnHashValue(
       resp.split_partition_key());
   CHECK_EQ(decoded_partition_key_hash, expected_middle_key_hash);
+
+  // Access distribution is not sampled by default, so the middle key is used instead.
+  ASSERT_NOK(tablet_peer->shared_tablet()->GetEncodedAccessSplitKey());
+  resp = ASSERT_RESULT(GetSplitKey(source_tablet_id, /* by_access_distribution = */ true));
+  ASSERT_FALSE(resp.has_error()) << resp.error().DebugString();
+  decoded_split_key_hash = ASSERT_RESULT(docdb::DocKey::DecodeHash(resp.split_encoded_key()));
+  ASSERT_EQ(decoded_split_key_hash, expected_middle_key_hash);
+}
+
+TEST_F(TabletSplitSingleServerITest, TabletServerGetAccessSplitKey) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_key_access_sample_size) = 256;
+  CreateSingleTablet();
+  ASSERT_OK(WriteRowsAndGetMiddleHashCode(kDefaultNumRows));
+  const auto source_tablet_id =
+      ASSERT_RESULT(GetSingleTestTabletInfo(ASSERT_RESULT(catalog_manager())))->id();
+  auto tablet_peer = ASSERT_RESULT(GetSingleTabletLeaderPeer());
+  auto tablet = tablet_peer->shared_tablet();
+  ASSERT_OK(tablet->Flush(tablet::FlushMode::kSync));
+
+  // Written keys are sampled, so the access split key is available.
+  const auto access_key = ASSERT_RESULT(tablet->GetEncodedAccessSplitKey());
+  const auto access_key_hash = ASSERT_RESULT(docdb::DocKey::DecodeHash(access_key));
+  auto resp = ASSERT_RESULT(GetSplitKey(source_tablet_id, /* by_access_distribution = */ true));
+  ASSERT_FALSE(resp.has_error()) << resp.error().DebugString();
+  auto split_key_hash = ASSERT_RESULT(docdb::DocKey::DecodeHash(resp.split_encoded_key()));
+  ASSERT_EQ(split_key_hash, access_key_hash);
+  ASSERT_EQ(PartitionSchema::DecodeMultiColumnHashValue(resp.split_partition_key()),
+            access_key_hash);
+
+  // GetSplitKey falls back to the middle key when there are not enough samples.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_min_key_access_samples) = 1000000;
+  ASSERT_NOK(tablet->GetEncodedAccessSplitKey());
+  const auto middle_key = ASSERT_RESULT(tablet->GetEncodedMiddleSplitKey());
+  const auto middle_key_hash = ASSERT_RESULT(docdb::DocKey::DecodeHash(middle_key));
+  resp = ASSERT_RESULT(GetSplitKey(source_tablet_id, /* by_access_distribution = */ true));
+  ASSERT_FALSE(resp.has_error()) << resp.error().DebugString();
+  split_key_hash = ASSERT_RESULT(docdb::DocKey::DecodeHash(resp.split_encoded_key()));
+  ASSERT_EQ(split_key_hash, middle_key_hash);
 }
 
 TEST_F(TabletSplitSingleServerITest, TabletServerOrphanedPostSplitData) {
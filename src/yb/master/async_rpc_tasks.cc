@@ -1336,9 +1336,12 @@ bool IsDefinitelyPermanentError(const Status& s) {
 // ============================================================================
 AsyncGetTabletSplitKey::AsyncGetTabletSplitKey(
     Master* master, ThreadPool* callback_pool, const scoped_refptr<TabletInfo>& tablet,
-    DataCallbackType result_cb)
+    bool by_access_distribution, DataCallbackType result_cb)
     : AsyncTabletLeaderTask(master, callback_pool, tablet), result_cb_(result_cb) {
   req_.set_tablet_id(tablet_id());
+  if (by_access_distribution) {
+    req_.set_by_access_distribution(true);
+  }
 }
 
 void AsyncGetTabletSplitKey::HandleResponse(int attempt) {
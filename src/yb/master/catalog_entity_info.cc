@@ -87,6 +87,14 @@ void TabletReplica::UpdateDriveInfo(const TabletReplicaDriveInfo& info) {
   drive_info = info;
 }
 
+void TabletReplica::UpdateLoadInfo(const TabletReplicaLoadInfo& info) {
+  auto split_load_exceeded_since = load_info.split_load_exceeded_since;
+  load_info = info;
+  if (split_load_exceeded_since && info.split_load_exceeded_since) {
+    load_info.split_load_exceeded_since = split_load_exceeded_since;
+  }
+}
+
 bool TabletReplica::IsStale() const {
   MonoTime now(MonoTime::Now());
   if (now.GetDeltaSince(time_updated).ToMilliseconds() >=
@@ -180,6 +188,17 @@ Result<TabletReplicaDriveInfo> TabletInfo::GetLeaderReplicaDriveInfo() const {
   return GetLeaderNotFoundStatus();
 }
 
+Result<TabletReplicaLoadInfo> TabletInfo::GetLeaderReplicaLoadInfo() const {
+  std::lock_guard<simple_spinlock> l(lock_);
+
+  for (const auto& pair : *replica_locations_) {
+    if (pair.second.role == PeerRole::LEADER) {
+      return pair.second.load_info;
+    }
+  }
+  return GetLeaderNotFoundStatus();
+}
+
 TSDescriptor* TabletInfo::GetLeaderUnlocked() const {
   for (const auto& pair : *replica_locations_) {
     if (pair.second.role == PeerRole::LEADER) {
@@ -222,6 +241,19 @@ void TabletInfo::UpdateReplicaDriveInfo(const std::string& ts_uuid,
   it->second.UpdateDriveInfo(drive_info);
 }
 
+void TabletInfo::UpdateReplicaLoadInfo(const std::string& ts_uuid,
+                                       const TabletReplicaLoadInfo& load_info) {
+  std::lock_guard<simple_spinlock> l(lock_);
+  // Make a new shared_ptr, copying the data, to ensure we don't race against access to data from
+  // clients that already have the old shared_ptr.
+  replica_locations_ = std::make_shared<TabletReplicaMap>(*replica_locations_);
+  auto it = replica_locations_->find(ts_uuid);
+  if (it == replica_locations_->end()) {
+    return;
+  }
+  it->second.UpdateLoadInfo(load_info);
+}
+
 void TabletInfo::set_last_update_time(const MonoTime& ts) {
   std::lock_guard<simple_spinlock> l(lock_);
   last_update_time_ = ts;
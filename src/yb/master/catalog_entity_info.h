@@ -68,6 +68,25 @@ struct TabletReplicaDriveInfo {
   bool may_have_orphaned_post_split_data = true;
 };
 
+// Load of a current replica of a tablet, as reported by its tablet server.
+struct TabletReplicaLoadInfo {
+  double read_ops_per_sec = 0;
+  double write_ops_per_sec = 0;
+  double read_bytes_per_sec = 0;
+  double write_bytes_per_sec = 0;
+  double cpu_time_us_per_sec = 0;
+
+  // Time since the replica continuously reports load above the load based split thresholds,
+  // uninitialized if the last reported load is below them.
+  MonoTime split_load_exceeded_since;
+
+  // Load of the replica used for balancing. CPU time spent on the requests is used, since it
+  // accounts for the cost of each operation, unlike the number of operations.
+  double Load() const {
+    return cpu_time_us_per_sec;
+  }
+};
+
 // Information on a current replica of a tablet.
 // This is copyable so that no locking is needed.
 struct TabletReplica {
@@ -86,12 +105,18 @@ struct TabletReplica {
 
   TabletReplicaDriveInfo drive_info;
 
+  TabletReplicaLoadInfo load_info;
+
   TabletReplica() : time_updated(MonoTime::Now()) {}
 
   void UpdateFrom(const TabletReplica& source);
 
   void UpdateDriveInfo(const TabletReplicaDriveInfo& info);
 
+  // Updates load info, split_load_exceeded_since of the info is used only when the replica did not
+  // exceed the split load thresholds before, so it tracks when the high load started.
+  void UpdateLoadInfo(const TabletReplicaLoadInfo& info);
+
   bool IsStale() const;
 
   bool IsStarting() const;
@@ -232,6 +257,7 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   std::shared_ptr<const TabletReplicaMap> GetReplicaLocations() const;
   Result<TSDescriptor*> GetLeader() const;
   Result<TabletReplicaDriveInfo> GetLeaderReplicaDriveInfo() const;
+  Result<TabletReplicaLoadInfo> GetLeaderReplicaLoadInfo() const;
 
   // Replaces a replica in replica_locations_ map if it exists. Otherwise, it adds it to the map.
   void UpdateReplicaLocations(const TabletReplica& replica);
@@ -240,6 +266,10 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   void UpdateReplicaDriveInfo(const std::string& ts_uuid,
                               const TabletReplicaDriveInfo& drive_info);
 
+  // Updates load of a replica in replica_locations_ map if it exists.
+  void UpdateReplicaLoadInfo(const std::string& ts_uuid,
+                             const TabletReplicaLoadInfo& load_info);
+
   // Accessors for the last time the replica locations were updated.
   void set_last_update_time(const MonoTime& ts);
   MonoTime last_update_time() const;
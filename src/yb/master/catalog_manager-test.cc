@@ -33,6 +33,16 @@
 #include "yb/master/catalog_manager-test_base.h"
 #include "yb/master/master_client.pb.h"
 
+#include "yb/util/size_literals.h"
+
+DECLARE_int64(tablet_split_load_threshold_cpu_time_us_per_sec);
+DECLARE_int64(tablet_split_load_threshold_ops_per_sec);
+DECLARE_int32(tablet_split_load_sustain_secs);
+DECLARE_int64(tablet_split_load_min_size_bytes);
+
+using namespace std::literals;
+using namespace yb::size_literals;
+
 namespace yb {
 namespace master {
 
@@ -386,5 +396,69 @@ TEST(TestCatalogManager, CheckIfCanDeleteSingleTablet) {
   }
 }
 
+TEST(TestCatalogManager, ShouldSplitByLoad) {
+  google::FlagSaver flag_saver;
+  FLAGS_tablet_split_load_sustain_secs = 60;
+  FLAGS_tablet_split_load_min_size_bytes = 1_MB;
+
+  const auto now = MonoTime::Now();
+  TabletReplicaLoadInfo load_info;
+  load_info.read_ops_per_sec = 600;
+  load_info.write_ops_per_sec = 500;
+  load_info.cpu_time_us_per_sec = 200000;
+  load_info.split_load_exceeded_since = now - 61s;
+  TabletReplicaDriveInfo drive_info;
+  drive_info.sst_files_size = 2_MB;
+
+  // Load based splitting is disabled by default.
+  ASSERT_FALSE(CatalogManagerUtil::ExceedsSplitLoadThreshold(load_info));
+  ASSERT_FALSE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+
+  FLAGS_tablet_split_load_threshold_ops_per_sec = 1000;
+  ASSERT_TRUE(CatalogManagerUtil::ExceedsSplitLoadThreshold(load_info));
+  ASSERT_TRUE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+
+  FLAGS_tablet_split_load_threshold_ops_per_sec = 2000;
+  ASSERT_FALSE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+  FLAGS_tablet_split_load_threshold_cpu_time_us_per_sec = 100000;
+  ASSERT_TRUE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+
+  // The load should be sustained.
+  ASSERT_FALSE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now - 2s));
+  load_info.split_load_exceeded_since = MonoTime();
+  ASSERT_FALSE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+  load_info.split_load_exceeded_since = now - 61s;
+
+  // Too small and empty tablets are not split by load.
+  drive_info.sst_files_size = 512_KB;
+  ASSERT_FALSE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+  FLAGS_tablet_split_load_min_size_bytes = 0;
+  ASSERT_TRUE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+  drive_info.sst_files_size = 0;
+  ASSERT_FALSE(CatalogManagerUtil::ShouldSplitByLoad(load_info, drive_info, now));
+}
+
+TEST(TestCatalogManager, SplitLoadExceededSince) {
+  TabletReplica replica;
+  TabletReplicaLoadInfo load_info;
+  const auto start = MonoTime::Now();
+  load_info.split_load_exceeded_since = start;
+  replica.UpdateLoadInfo(load_info);
+  ASSERT_EQ(start, replica.load_info.split_load_exceeded_since);
+
+  // Time when the load started to exceed the thresholds is kept while the load stays high.
+  load_info.split_load_exceeded_since = start + 10s;
+  replica.UpdateLoadInfo(load_info);
+  ASSERT_EQ(start, replica.load_info.split_load_exceeded_since);
+
+  // And is reset when the load drops.
+  load_info.split_load_exceeded_since = MonoTime();
+  replica.UpdateLoadInfo(load_info);
+  ASSERT_FALSE(replica.load_info.split_load_exceeded_since);
+  load_info.split_load_exceeded_since = start + 20s;
+  replica.UpdateLoadInfo(load_info);
+  ASSERT_EQ(start + 20s, replica.load_info.split_load_exceeded_since);
+}
+
 } // namespace master
 } // namespace yb
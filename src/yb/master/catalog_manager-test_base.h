@@ -240,6 +240,11 @@ class TestLoadBalancerBase {
     gflags::SetCommandLineOption("leader_balance_threshold", "0");
     PrepareTestState(ts_descs_multi_az);
     TestLeaderBlacklist();
+
+    gflags::SetCommandLineOption("load_balancer_load_aware", "true");
+    PrepareTestState(ts_descs_multi_az);
+    TestLoadAwareLeaderBalancing();
+    gflags::SetCommandLineOption("load_balancer_load_aware", "false");
   }
 
  protected:
@@ -316,6 +321,50 @@ class TestLoadBalancerBase {
     LOG(INFO) << "Leader distribution: 2 1 1 -OR- 1 2 1";
   }
 
+  void TestLoadAwareLeaderBalancing() {
+    LOG(INFO) << "Testing moving leaders based on the reported load";
+    // Leader distribution: 2 1 1, leaders of tablets 0 and 3 are on ts0.
+    SetLeaderLoad(tablets_[0].get(), 120000);
+    SetLeaderLoad(tablets_[1].get(), 10000);
+    SetLeaderLoad(tablets_[2].get(), 20000);
+    SetLeaderLoad(tablets_[3].get(), 80000);
+    LOG(INFO) << "Reported load: 200000 10000 20000";
+
+    ASSERT_OK(AnalyzeTablets());
+
+    // Moving the leader of tablet 3 to ts1 results in the lowest max load of the two tablet
+    // servers: 120000 on ts0.
+    string placeholder, tablet_id;
+    TestMoveLeader(
+        &tablet_id, ts_descs_[0]->permanent_uuid(), ts_descs_[1]->permanent_uuid());
+    ASSERT_EQ(tablets_[3]->id(), tablet_id);
+    LOG(INFO) << "Reported load: 120000 90000 20000";
+
+    // Moving the leader of tablet 0 would just move the hotspot to another tablet server.
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    // Nothing is moved when the load is low, even if it is not balanced.
+    for (const auto& tablet : tablets_) {
+      SetLeaderLoad(tablet.get(), 0);
+    }
+    SetLeaderLoad(tablets_[0].get(), 1000);
+    LOG(INFO) << "Reported load: 1000 0 0";
+
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    // When the load is too low for load-aware balancing, leaders are balanced by their count.
+    for (const auto& tablet : tablets_) {
+      MoveTabletLeader(tablet.get(), ts_descs_[0]);
+    }
+    LOG(INFO) << "Leader distribution: 4 0 0";
+
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+    TestMoveLeader(&placeholder, ts_descs_[0]->permanent_uuid(), "");
+  }
+
   void TestWithBlacklist() {
     LOG(INFO) << "Testing with tablet servers with blacklist";
     // Setup cluster config.
@@ -1077,6 +1126,17 @@ class TestLoadBalancerBase {
     tablet->SetReplicaLocations(replicas);
   }
 
+  void SetLeaderLoad(TabletInfo* tablet, double cpu_time_us_per_sec) {
+    std::shared_ptr<TabletReplicaMap> replicas =
+      std::const_pointer_cast<TabletReplicaMap>(tablet->GetReplicaLocations());
+    for (auto& replica : *replicas) {
+      if (replica.second.role == PeerRole::LEADER) {
+        replica.second.load_info.cpu_time_us_per_sec = cpu_time_us_per_sec;
+      }
+    }
+    tablet->SetReplicaLocations(replicas);
+  }
+
   // Clear the tablets_added_ field from the state, used for testing.
   void ClearTabletsAddedForTest() {
     cb_->state_->tablets_added_.clear();
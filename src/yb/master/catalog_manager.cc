@@ -2525,11 +2525,23 @@ Result<ReplicationInfoPB> CatalogManager::GetTableReplicationInfo(
   return cluster_config_->LockForRead()->pb.replication_info();
 }
 
+bool CatalogManager::ShouldSplitByLoad(
+    const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const {
+  auto load_info = tablet_info.GetLeaderReplicaLoadInfo();
+  return load_info.ok() &&
+         CatalogManagerUtil::ShouldSplitByLoad(*load_info, drive_info, MonoTime::Now());
+}
+
 bool CatalogManager::ShouldSplitValidCandidate(
     const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const {
   if (drive_info.may_have_orphaned_post_split_data) {
     return false;
   }
+  // Tablets that receive most of the traffic are split even below the size thresholds, so the
+  // traffic could be spread across nodes.
+  if (ShouldSplitByLoad(tablet_info, drive_info)) {
+    return true;
+  }
   ssize_t size = drive_info.sst_files_size;
   DCHECK(size >= 0) << "Detected overflow in casting sst_files_size to signed int.";
   if (size < FLAGS_tablet_split_low_phase_size_threshold_bytes) {
@@ -2688,8 +2700,15 @@ Status CatalogManager::SplitTablet(const TabletId& tablet_id, bool select_all_ta
 
   VLOG(2) << "Scheduling GetSplitKey request to leader tserver for source tablet ID: "
           << tablet->tablet_id();
+  // Split key of a tablet split because of its load is chosen by the distribution of accessed keys,
+  // so the load is divided between the child tablets.
+  bool by_access_distribution = false;
+  if (!select_all_tablets_for_split) {
+    auto drive_info = tablet->GetLeaderReplicaDriveInfo();
+    by_access_distribution = drive_info.ok() && ShouldSplitByLoad(*tablet, *drive_info);
+  }
   auto call = std::make_shared<AsyncGetTabletSplitKey>(
-      master_, AsyncTaskPool(), tablet,
+      master_, AsyncTaskPool(), tablet, by_access_distribution,
       [this, tablet, select_all_tablets_for_split]
           (const Result<AsyncGetTabletSplitKey::Data>& result) {
         if (result.ok()) {
@@ -8386,6 +8405,7 @@ void CatalogManager::ReconcileTabletReplicasInLocalMemoryWithReport(
       LOG_IF(FATAL, !result.second) << "duplicate uuid: " << replica.ts_desc->permanent_uuid();
       if (existing_replica) {
         result.first->second.UpdateDriveInfo(existing_replica->drive_info);
+        result.first->second.UpdateLoadInfo(existing_replica->load_info);
       }
     }
   }
@@ -10673,6 +10693,31 @@ void CatalogManager::ProcessTabletStorageMetadata(
   tablet->UpdateReplicaDriveInfo(ts_uuid, drive_info);
 }
 
+void CatalogManager::ProcessTabletLoadMetrics(
+    const std::string& ts_uuid,
+    const TabletLoadMetricsPB& load_metrics) {
+  const string& tablet_id = load_metrics.tablet_id();
+  scoped_refptr<TabletInfo> tablet;
+  {
+    SharedLock lock(mutex_);
+    tablet = FindPtrOrNull(*tablet_map_, tablet_id);
+  }
+  if (!tablet) {
+    VLOG(1) << Format("Tablet $0 not found on ts $1", tablet_id, ts_uuid);
+    return;
+  }
+  TabletReplicaLoadInfo load_info{
+        load_metrics.read_ops_per_sec(),
+        load_metrics.write_ops_per_sec(),
+        load_metrics.read_bytes_per_sec(),
+        load_metrics.write_bytes_per_sec(),
+        load_metrics.cpu_time_us_per_sec()};
+  if (CatalogManagerUtil::ExceedsSplitLoadThreshold(load_info)) {
+    load_info.split_load_exceeded_since = MonoTime::Now();
+  }
+  tablet->UpdateReplicaLoadInfo(ts_uuid, load_info);
+}
+
 void CatalogManager::CheckTableDeleted(const TableInfoPtr& table) {
   if (!FLAGS_master_drop_table_after_task_response) {
     return;
@@ -879,11 +879,20 @@ class CatalogManager :
       const std::string& ts_uuid,
       const TabletDriveStorageMetadataPB& storage_metadata);
 
+  void ProcessTabletLoadMetrics(
+      const std::string& ts_uuid,
+      const TabletLoadMetricsPB& load_metrics);
+
   void CheckTableDeleted(const TableInfoPtr& table) override;
 
   bool ShouldSplitValidCandidate(
       const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const override;
 
+  // Returns true if the tablet leader load exceeds the load based split thresholds for long enough,
+  // see CatalogManagerUtil::ShouldSplitByLoad.
+  bool ShouldSplitByLoad(
+      const TabletInfo& tablet_info, const TabletReplicaDriveInfo& drive_info) const;
+
   BlacklistSet BlacklistSetFromPB() const override;
 
   std::vector<std::string> GetMasterAddresses();
@@ -15,15 +15,42 @@
 
 #include "yb/master/catalog_entity_info.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/math_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/string_util.h"
 
+using namespace std::literals;
+using namespace yb::size_literals;
+
 DEFINE_double(balancer_load_max_standard_deviation, 2.0,
               "The standard deviation among the tserver load, above which that distribution "
               "is considered not balanced.");
 TAG_FLAG(balancer_load_max_standard_deviation, advanced);
 
+DEFINE_int64(tablet_split_load_threshold_cpu_time_us_per_sec, 0,
+             "The CPU time per second spent by the tablet leader on requests, after which the "
+             "tablet is split if the load is sustained for tablet_split_load_sustain_secs. "
+             "0 disables CPU based splitting.");
+TAG_FLAG(tablet_split_load_threshold_cpu_time_us_per_sec, runtime);
+
+DEFINE_int64(tablet_split_load_threshold_ops_per_sec, 0,
+             "The number of read and write operations per second handled by the tablet leader, "
+             "after which the tablet is split if the load is sustained for "
+             "tablet_split_load_sustain_secs. 0 disables request rate based splitting.");
+TAG_FLAG(tablet_split_load_threshold_ops_per_sec, runtime);
+
+DEFINE_int32(tablet_split_load_sustain_secs, 300,
+             "For how long the tablet leader load should stay above the load based split "
+             "thresholds before the tablet is split.");
+TAG_FLAG(tablet_split_load_sustain_secs, runtime);
+
+DEFINE_int64(tablet_split_load_min_size_bytes, 64_MB,
+             "Minimal size of SST files of a tablet split because of its load. Smaller tablets are "
+             "not split by load, since a few hot keys could not be spread by the split anyway.");
+TAG_FLAG(tablet_split_load_min_size_bytes, runtime);
+
 namespace yb {
 namespace master {
 
@@ -237,6 +264,31 @@ Result<std::string> CatalogManagerUtil::GetPlacementUuidFromRaftPeer(
   }
 }
 
+bool CatalogManagerUtil::ExceedsSplitLoadThreshold(const TabletReplicaLoadInfo& load_info) {
+  const auto cpu_threshold = GetAtomicFlag(&FLAGS_tablet_split_load_threshold_cpu_time_us_per_sec);
+  const auto ops_threshold = GetAtomicFlag(&FLAGS_tablet_split_load_threshold_ops_per_sec);
+  return (cpu_threshold > 0 && load_info.cpu_time_us_per_sec >= cpu_threshold) ||
+         (ops_threshold > 0 &&
+          load_info.read_ops_per_sec + load_info.write_ops_per_sec >= ops_threshold);
+}
+
+bool CatalogManagerUtil::ShouldSplitByLoad(
+    const TabletReplicaLoadInfo& leader_load_info,
+    const TabletReplicaDriveInfo& leader_drive_info,
+    MonoTime now) {
+  if (!leader_load_info.split_load_exceeded_since ||
+      !ExceedsSplitLoadThreshold(leader_load_info)) {
+    return false;
+  }
+  const auto min_size =
+      std::max<int64_t>(GetAtomicFlag(&FLAGS_tablet_split_load_min_size_bytes), 1);
+  if (leader_drive_info.sst_files_size < static_cast<uint64_t>(min_size)) {
+    return false;
+  }
+  const auto sustained_for = now - leader_load_info.split_load_exceeded_since;
+  return sustained_for >= GetAtomicFlag(&FLAGS_tablet_split_load_sustain_secs) * 1s;
+}
+
 CHECKED_STATUS CatalogManagerUtil::CheckIfCanDeleteSingleTablet(
     const scoped_refptr<TabletInfo>& tablet) {
   static const auto stringify_partition_key = [](const Slice& key) {
@@ -75,6 +75,17 @@ class CatalogManagerUtil {
   // Returns error if tablet partition is not covered by running inner tablets partitions.
   static CHECKED_STATUS CheckIfCanDeleteSingleTablet(const scoped_refptr<TabletInfo>& tablet);
 
+  // Returns true if the reported load of a tablet replica is above the load based split thresholds.
+  static bool ExceedsSplitLoadThreshold(const TabletReplicaLoadInfo& load_info);
+
+  // Returns true if the tablet leader load has exceeded the load based split thresholds for
+  // tablet_split_load_sustain_secs by now, and the tablet is at least
+  // tablet_split_load_min_size_bytes large.
+  static bool ShouldSplitByLoad(
+      const TabletReplicaLoadInfo& leader_load_info,
+      const TabletReplicaDriveInfo& leader_drive_info,
+      MonoTime now);
+
   enum CloudInfoSimilarity {
     NO_MATCH = 0,
     CLOUD_MATCH = 1,
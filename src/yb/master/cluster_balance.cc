@@ -135,6 +135,34 @@ DEFINE_bool(load_balancer_ignore_cloud_info_similarity, false,
             "If true, ignore the similarity between cloud infos when deciding which tablet "
             "to move.");
 
+DEFINE_bool(load_balancer_load_aware, false,
+            "Balance tablet leaders by the load reported by tablet servers, i.e. CPU time spent "
+            "serving requests to each tablet, instead of by the number of leaders. Replica moves "
+            "still balance the number of tablets, but prefer moving loaded tablets off loaded "
+            "tablet servers.");
+TAG_FLAG(load_balancer_load_aware, runtime);
+TAG_FLAG(load_balancer_load_aware, advanced);
+
+DEFINE_double(load_balancer_load_aware_threshold, 0.2,
+              "Load-aware balancing moves leaders off a tablet server only when its reported load "
+              "exceeds the average load of tablet servers by this fraction, and only if the move "
+              "decreases the max load of the source and target tablet servers by this fraction "
+              "of the average load.");
+TAG_FLAG(load_balancer_load_aware_threshold, runtime);
+TAG_FLAG(load_balancer_load_aware_threshold, advanced);
+
+DEFINE_double(load_balancer_load_aware_min_load, 10000,
+              "Load-aware balancing is not done while the average load of tablet servers, in "
+              "microseconds of CPU time per second, is below this value.");
+TAG_FLAG(load_balancer_load_aware_min_load, runtime);
+TAG_FLAG(load_balancer_load_aware_min_load, advanced);
+
+DEFINE_int32(load_balancer_load_aware_move_interval_ms, 60 * 1000,
+             "Minimal interval between load-aware moves of the leader of the same tablet. Gives "
+             "tablet servers time to report the load after the move.");
+TAG_FLAG(load_balancer_load_aware_move_interval_ms, runtime);
+TAG_FLAG(load_balancer_load_aware_move_interval_ms, advanced);
+
 // TODO(tsplit): make false by default or even remove flag after
 // https://github.com/yugabyte/yugabyte-db/issues/10301 is fixed.
 DEFINE_test_flag(
@@ -645,6 +673,18 @@ void ClusterLoadBalancer::ResetGlobalState(bool initialize_ts_descs) {
     GetAllDescriptors(&global_state_->ts_descs_);
   }
   skipped_tables_per_run_.clear();
+
+  // Forget load-aware leader moves that no longer limit the moves of their tablets.
+  const auto now = MonoTime::Now();
+  const auto move_interval = MonoDelta::FromMilliseconds(
+      GetAtomicFlag(&FLAGS_load_balancer_load_aware_move_interval_ms));
+  for (auto it = load_aware_leader_moves_.begin(); it != load_aware_leader_moves_.end();) {
+    if (now - it->second >= move_interval) {
+      it = load_aware_leader_moves_.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 void ClusterLoadBalancer::ResetTableStatePtr(const TableId& table_id, Options* options) {
@@ -974,10 +1014,16 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
   // Below, we choose a tablet to move. We first filter out any tablets which cannot be moved
   // because of placement limitations. Then, we prioritize moving a tablet whose leader is in the
   // same zone/region it is moving to (for faster remote bootstrapping).
+  // In load-aware mode, among such tablets we prefer the most loaded one when moving to a less
+  // loaded tablet server, and the least loaded one otherwise.
+  const bool load_aware = GetAtomicFlag(&FLAGS_load_balancer_load_aware);
+  const bool prefer_loaded_tablet = load_aware &&
+      global_state_->GetReportedLoad(from_ts) > global_state_->GetReportedLoad(to_ts);
   for (const set<TabletId>& drive_tablets : all_filtered_tablets_by_drive) {
     bool found_tablet_to_move = false;
     CatalogManagerUtil::CloudInfoSimilarity chosen_tablet_ci_similarity =
         CatalogManagerUtil::NO_MATCH;
+    double chosen_tablet_load = 0;
     for (const TabletId& tablet_id : drive_tablets) {
       const auto& placement_info = GetPlacementByTablet(tablet_id);
       // TODO(bogdan): this should be augmented as well to allow dropping by one replica, if still
@@ -1013,13 +1059,22 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
         ci_similarity = CatalogManagerUtil::ComputeCloudInfoSimilarity(leader_ci, to_ts_ci);
       }
 
-      if (found_tablet_to_move && ci_similarity <= chosen_tablet_ci_similarity) {
-        continue;
+      const auto tablet_load = load_aware ? global_state_->GetTabletLoad(tablet_id) : 0;
+      if (found_tablet_to_move) {
+        if (ci_similarity < chosen_tablet_ci_similarity) {
+          continue;
+        }
+        if (ci_similarity == chosen_tablet_ci_similarity &&
+            (!load_aware || tablet_load == chosen_tablet_load ||
+             (tablet_load > chosen_tablet_load) != prefer_loaded_tablet)) {
+          continue;
+        }
       }
       // This is the best tablet to move, so far.
       found_tablet_to_move = true;
       *moving_tablet_id = tablet_id;
       chosen_tablet_ci_similarity = ci_similarity;
+      chosen_tablet_load = tablet_load;
     }
 
     // If there is any tablet we can move from this drive, choose it and return.
@@ -1039,6 +1094,12 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(TabletId* moving_tablet_id,
     return false;
   }
 
+  // When leaders are balanced by GetLoadAwareLeaderToMove, here they are only moved off leader
+  // blacklisted tablet servers.
+  std::vector<TabletServerId> load_aware_ts_uuids;
+  double average_load = 0;
+  const bool load_aware = LoadAwareLeaderBalancingActive(&load_aware_ts_uuids, &average_load);
+
   // Find out if there are leaders to be moved.
   for (auto right = state_->sorted_leader_load_.size(); right > 0;) {
     --right;
@@ -1055,6 +1116,9 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(TabletId* moving_tablet_id,
         continue;
       }
     } else {
+      if (load_aware) {
+        return false;
+      }
       if (state_->IsLeaderLoadBelowThreshold(state_->sorted_leader_load_[right])) {
         // Non-leader blacklisted tserver with not too many leader replicas.
         // TODO(Sanket): Even though per table load is below the configured threshold,
@@ -1104,6 +1168,10 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(TabletId* moving_tablet_id,
       const TabletServerId& high_load_uuid = state_->sorted_leader_load_[right];
       auto high_leader_blacklisted = (state_->leader_blacklisted_servers_.find(high_load_uuid) !=
           state_->leader_blacklisted_servers_.end());
+      if (load_aware && !high_leader_blacklisted) {
+        // Leader blacklisted tablet servers are sorted last, so there are no more of them.
+        break;
+      }
       ssize_t load_variance =
           state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
 
@@ -1186,6 +1254,115 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(TabletId* moving_tablet_id,
   FATAL_ERROR("Load balancing algorithm reached invalid state!");
 }
 
+bool ClusterLoadBalancer::LoadAwareLeaderBalancingActive(std::vector<TabletServerId>* ts_uuids,
+                                                         double* average_load) {
+  if (!GetAtomicFlag(&FLAGS_load_balancer_load_aware)) {
+    return false;
+  }
+  double total_load = 0;
+  for (const auto& ts_uuid : state_->sorted_leader_load_) {
+    if (state_->leader_blacklisted_servers_.count(ts_uuid)) {
+      continue;
+    }
+    ts_uuids->push_back(ts_uuid);
+    total_load += global_state_->GetReportedLoad(ts_uuid);
+  }
+  if (ts_uuids->size() < 2) {
+    return false;
+  }
+  *average_load = total_load / ts_uuids->size();
+  return *average_load >= GetAtomicFlag(&FLAGS_load_balancer_load_aware_min_load);
+}
+
+Result<bool> ClusterLoadBalancer::GetLoadAwareLeaderToMove(TabletId* moving_tablet_id,
+                                                           TabletServerId* from_ts,
+                                                           TabletServerId* to_ts,
+                                                           std::string* to_ts_path) {
+  // Tablet servers that could get leaders of this table.
+  vector<TabletServerId> ts_uuids;
+  double average_load = 0;
+  if (!LoadAwareLeaderBalancingActive(&ts_uuids, &average_load)) {
+    return false;
+  }
+  // Hysteresis: only tablet servers with load above max_load are balanced, and a leader is moved
+  // only if the move decreases the max load of the two tablet servers by at least min_gain.
+  // So small fluctuations of the load do not cause moves back and forth.
+  const auto threshold = GetAtomicFlag(&FLAGS_load_balancer_load_aware_threshold);
+  const auto max_load = average_load * (1 + threshold);
+  const auto min_gain = average_load * threshold;
+
+  std::sort(ts_uuids.begin(), ts_uuids.end(),
+            [this](const TabletServerId& lhs, const TabletServerId& rhs) {
+    return global_state_->GetReportedLoad(lhs) > global_state_->GetReportedLoad(rhs);
+  });
+
+  const auto current_time = MonoTime::Now();
+  const auto move_interval = MonoDelta::FromMilliseconds(
+      GetAtomicFlag(&FLAGS_load_balancer_load_aware_move_interval_ms));
+  const auto& pending_stepdowns = state_->pending_stepdown_leader_tasks_[state_->table_id_];
+  for (const auto& high_load_uuid : ts_uuids) {
+    const auto high_load = global_state_->GetReportedLoad(high_load_uuid);
+    if (high_load <= max_load) {
+      // Tablet servers are sorted by load, so the rest of them are not overloaded as well.
+      return false;
+    }
+
+    // Pick the move that minimizes the max load of the two tablet servers after the move.
+    auto best_load = high_load - min_gain;
+    bool found_leader_to_move = false;
+    for (const auto& tablet_id : state_->per_ts_meta_[high_load_uuid].leaders) {
+      const auto tablet_load = global_state_->GetTabletLeaderLoad(tablet_id);
+      if (tablet_load <= 0 || pending_stepdowns.count(tablet_id)) {
+        continue;
+      }
+      auto last_move_it = load_aware_leader_moves_.find(tablet_id);
+      if (last_move_it != load_aware_leader_moves_.end() &&
+          current_time - last_move_it->second < move_interval) {
+        continue;
+      }
+      const auto& tablet_meta = state_->per_tablet_meta_[tablet_id];
+      for (const auto& low_load_uuid : ts_uuids) {
+        const auto low_load = global_state_->GetReportedLoad(low_load_uuid);
+        const auto load_after_move = std::max(high_load - tablet_load, low_load + tablet_load);
+        if (low_load_uuid == high_load_uuid ||
+            (found_leader_to_move ? load_after_move >= best_load : load_after_move > best_load) ||
+            !state_->per_ts_meta_[low_load_uuid].running_tablets.count(tablet_id)) {
+          continue;
+        }
+        const auto& stepdown_failures = tablet_meta.leader_stepdown_failures;
+        const auto stepdown_failure_iter = stepdown_failures.find(low_load_uuid);
+        if (stepdown_failure_iter != stepdown_failures.end() &&
+            (current_time - stepdown_failure_iter->second).ToMilliseconds() <
+                FLAGS_min_leader_stepdown_retry_interval_ms) {
+          continue;
+        }
+        found_leader_to_move = true;
+        best_load = load_after_move;
+        *moving_tablet_id = tablet_id;
+        *to_ts = low_load_uuid;
+      }
+    }
+
+    if (found_leader_to_move) {
+      *from_ts = high_load_uuid;
+      to_ts_path->clear();
+      for (const auto& path_and_tablets : state_->per_ts_meta_[*to_ts].path_to_tablets) {
+        if (path_and_tablets.second.count(*moving_tablet_id)) {
+          *to_ts_path = path_and_tablets.first;
+          break;
+        }
+      }
+      LOG(INFO) << Format(
+          "Load-aware move of tablet $0 leader with load $1 from TS $2 with load $3 to TS $4 "
+          "with load $5, average load: $6",
+          *moving_tablet_id, global_state_->GetTabletLeaderLoad(*moving_tablet_id), *from_ts,
+          high_load, *to_ts, global_state_->GetReportedLoad(*to_ts), average_load);
+      return true;
+    }
+  }
+  return false;
+}
+
 Result<bool> ClusterLoadBalancer::HandleRemoveReplicas(
     TabletId* out_tablet_id, TabletServerId* out_from_ts) {
   // Give high priority to removing tablets that are not respecting the placement policy.
@@ -1318,6 +1495,15 @@ Result<bool> ClusterLoadBalancer::HandleLeaderMoves(
     RETURN_NOT_OK(MoveLeader(*out_tablet_id, *out_from_ts, *out_to_ts, out_ts_ts_path));
     return true;
   }
+
+  if (GetAtomicFlag(&FLAGS_load_balancer_load_aware) &&
+      VERIFY_RESULT(GetLoadAwareLeaderToMove(
+          out_tablet_id, out_from_ts, out_to_ts, &out_ts_ts_path))) {
+    RETURN_NOT_OK(MoveLeader(*out_tablet_id, *out_from_ts, *out_to_ts, out_ts_ts_path));
+    global_state_->MoveTabletLeaderLoad(*out_tablet_id, *out_from_ts, *out_to_ts);
+    load_aware_leader_moves_[*out_tablet_id] = MonoTime::Now();
+    return true;
+  }
   return false;
 }
 
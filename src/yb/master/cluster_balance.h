@@ -285,6 +285,24 @@ class ClusterLoadBalancer {
                                TabletServerId* to_ts,
                                std::string* to_ts_path);
 
+  // Load-aware counterpart of GetLeaderToMove: if the load reported by some tablet server is too
+  // high compared to the average load of tablet servers, picks a leader of the current table on
+  // it, that could be moved to a less loaded tablet server to even out the load.
+  //
+  // Returns true if we could find a leader to move and sets the output parameters.
+  // Returns false otherwise.
+  Result<bool> GetLoadAwareLeaderToMove(TabletId* moving_tablet_id,
+                                        TabletServerId* from_ts,
+                                        TabletServerId* to_ts,
+                                        std::string* to_ts_path);
+
+  // Returns true if leaders of the current table are balanced by GetLoadAwareLeaderToMove, i.e.
+  // load-aware balancing is enabled and the average load reported by the tablet servers that could
+  // get leaders is at least load_balancer_load_aware_min_load. Fills ts_uuids with those tablet
+  // servers and average_load with their average load.
+  bool LoadAwareLeaderBalancingActive(std::vector<TabletServerId>* ts_uuids,
+                                      double* average_load);
+
   // Issue the change config and modify the in-memory state for moving a replica from one tablet
   // server to another.
   CHECKED_STATUS MoveReplica(
@@ -401,6 +419,10 @@ class ClusterLoadBalancer {
   // once we perform a non-global move.
   bool can_perform_global_operations_ = false;
 
+  // Time of the last load-aware move of the leader of a tablet. Used to limit how often the
+  // leader of the same tablet could be moved.
+  std::unordered_map<TabletId, MonoTime> load_aware_leader_moves_;
+
   // Record load balancer activity for tables and tservers.
   void RecordActivity(uint32_t master_errors) REQUIRES_SHARED(catalog_manager_->mutex_);
 
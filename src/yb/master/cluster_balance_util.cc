@@ -62,6 +62,28 @@ int GlobalLoadState::GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const {
   return ts_meta.leaders_count;
 }
 
+double GlobalLoadState::GetReportedLoad(const TabletServerId& ts_uuid) const {
+  auto it = per_ts_global_meta_.find(ts_uuid);
+  return it != per_ts_global_meta_.end() ? it->second.reported_load : 0;
+}
+
+double GlobalLoadState::GetTabletLeaderLoad(const TabletId& tablet_id) const {
+  auto it = per_tablet_leader_load_.find(tablet_id);
+  return it != per_tablet_leader_load_.end() ? it->second : 0;
+}
+
+double GlobalLoadState::GetTabletLoad(const TabletId& tablet_id) const {
+  auto it = per_tablet_load_.find(tablet_id);
+  return it != per_tablet_load_.end() ? it->second : 0;
+}
+
+void GlobalLoadState::MoveTabletLeaderLoad(
+    const TabletId& tablet_id, const TabletServerId& from_ts, const TabletServerId& to_ts) {
+  const auto load = GetTabletLeaderLoad(tablet_id);
+  per_ts_global_meta_[from_ts].reported_load -= load;
+  per_ts_global_meta_[to_ts].reported_load += load;
+}
+
 PerTableLoadState::PerTableLoadState(GlobalLoadState* global_state)
     : leader_balance_threshold_(FLAGS_leader_balance_threshold),
       current_time_(MonoTime::Now()),
@@ -127,6 +149,8 @@ Status PerTableLoadState::UpdateTablet(TabletInfo *tablet) {
 
   // Get replicas for this tablet.
   auto replica_map = GetReplicaLocations(tablet);
+  // The reported load of the tablet is accounted only once per run.
+  const bool account_load = global_state_->per_tablet_load_.emplace(tablet_id, 0).second;
   // Set state information for both the tablet and the tablet server replicas.
   for (const auto& replica_it : *replica_map) {
     const auto& ts_uuid = replica_it.first;
@@ -172,6 +196,15 @@ Status PerTableLoadState::UpdateTablet(TabletInfo *tablet) {
     if (replica.role == PeerRole::LEADER) {
       tablet_meta.leader_uuid = ts_uuid;
       RETURN_NOT_OK(AddLeaderTablet(tablet_id, ts_uuid, replica.fs_data_dir));
+      if (account_load) {
+        global_state_->per_tablet_leader_load_[tablet_id] = replica.load_info.Load();
+      }
+    }
+
+    // Fill the load reported by the replica.
+    if (account_load) {
+      global_state_->per_ts_global_meta_[ts_uuid].reported_load += replica.load_info.Load();
+      global_state_->per_tablet_load_[tablet_id] += replica.load_info.Load();
     }
 
     const tablet::RaftGroupStatePB& tablet_state = replica.state;
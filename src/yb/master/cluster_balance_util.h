@@ -169,6 +169,8 @@ struct CBTabletServerLoadCounts {
   int running_tablets_count = 0;
   int starting_tablets_count = 0;
   int leaders_count = 0;
+  // Sum of loads reported by the tablet replicas on this tablet server.
+  double reported_load = 0;
 };
 
 struct Options {
@@ -238,6 +240,20 @@ class GlobalLoadState {
   // Get global leader load for a certain TS.
   int GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const;
 
+  // Get the load reported by the tablet replicas of a certain TS.
+  double GetReportedLoad(const TabletServerId& ts_uuid) const;
+
+  // Get the load reported by the leader of a certain tablet.
+  double GetTabletLeaderLoad(const TabletId& tablet_id) const;
+
+  // Get the load reported by all replicas of a certain tablet.
+  double GetTabletLoad(const TabletId& tablet_id) const;
+
+  // Accounts the move of the tablet leader load between tablet servers, so the following
+  // load-aware moves of this run take it into account.
+  void MoveTabletLeaderLoad(
+      const TabletId& tablet_id, const TabletServerId& from_ts, const TabletServerId& to_ts);
+
   // Used to determine how many tablets are being remote bootstrapped across the cluster.
   int total_starting_tablets_ = 0;
 
@@ -249,6 +265,10 @@ class GlobalLoadState {
   // Map from tablet server ids to the global metadata we store for each.
   std::unordered_map<TabletServerId, CBTabletServerLoadCounts> per_ts_global_meta_;
 
+  // Map from tablet ids to the load reported by the tablet leader and by all tablet replicas.
+  std::unordered_map<TabletId, double> per_tablet_leader_load_;
+  std::unordered_map<TabletId, double> per_tablet_load_;
+
   friend class PerTableLoadState;
 };
 
@@ -90,6 +90,7 @@ struct SplitTabletIds;
 struct TableDescription;
 struct TabletReplica;
 struct TabletReplicaDriveInfo;
+struct TabletReplicaLoadInfo;
 
 class AsyncTabletSnapshotOp;
 using AsyncTabletSnapshotOpPtr = std::shared_ptr<AsyncTabletSnapshotOp>;
@@ -155,6 +155,10 @@ class MasterHeartbeatServiceImpl : public MasterServiceBase, public MasterHeartb
           server_->catalog_manager_impl()->ProcessTabletStorageMetadata(
                 ts_desc.get()->permanent_uuid(), storage_metadata);
         }
+        for (const auto& load_metrics : req->tablet_load_metrics()) {
+          server_->catalog_manager_impl()->ProcessTabletLoadMetrics(
+                ts_desc.get()->permanent_uuid(), load_metrics);
+        }
       }
 
       // Only set once. It may take multiple heartbeats to receive a full tablet report.
@@ -68,6 +68,13 @@ extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache with CLOCK (second chance) eviction policy and the same sharding and
+// single-touch/multi-touch sub cache semantics as LRU cache. Cache hits don't take exclusive
+// locks and don't modify shared state besides the entry itself, so it scales better than LRU
+// cache when many threads hit the same shard.
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                       bool strict_capacity_limit);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
@@ -164,6 +164,16 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Subcompactions split the key range of a compaction into parts, that are processed in
+  // parallel, each by its own compaction filter. A filter that keeps state between subsequent
+  // keys requires keys related to each other to be processed by the same filter.
+  // Adjusts the candidate subcompaction boundary, so such keys are not split by it. The adjusted
+  // key should be a prefix of the candidate key. Returns false if the candidate could not be used
+  // as a subcompaction boundary.
+  virtual bool AdjustSubcompactionBoundary(Slice* user_key) const {
+    return true;
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
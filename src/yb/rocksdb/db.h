@@ -914,6 +914,12 @@ class DB {
   // Returns approximate middle key (see Version::GetMiddleKey).
   virtual yb::Result<std::string> GetMiddleKey() = 0;
 
+  // Returns up to num_parts - 1 user keys that split SST data within [lower, upper) into parts of
+  // approximately the same size, but not smaller than min_part_size bytes
+  // (see Version::GetApproximateSplitKeys). Empty upper means no upper limit.
+  virtual yb::Result<std::vector<std::string>> GetApproximateSplitKeys(
+      const Slice& lower, const Slice& upper, size_t num_parts, uint64_t min_part_size) = 0;
+
   // Used in testing to make the old memtable immutable and start writing to a new one.
   virtual void TEST_SwitchMemtable() {}
 
@@ -591,7 +591,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // Single level universal compaction writes all its outputs to level 0, but since they are
+    // produced by the same compaction, they have non overlapping key ranges.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
@@ -299,6 +299,10 @@ class Compaction {
   yb::PriorityThreadPoolSuspender* suspender() { return suspender_; }
   void SetSuspender(yb::PriorityThreadPoolSuspender* value) { suspender_ = value; }
 
+  // Priority of the thread pool task running this compaction, used for its subcompactions.
+  int priority() const { return priority_; }
+  void SetPriority(int value) { priority_ = value; }
+
  private:
   Compaction(VersionStorageInfo* input_version,
              const MutableCFOptions& mutable_cf_options,
@@ -388,6 +392,7 @@ class Compaction {
   CompactionReason compaction_reason_;
 
   yb::PriorityThreadPoolSuspender* suspender_ = nullptr;
+  int priority_ = 0;
 };
 
 // Utility function
@@ -32,9 +32,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
@@ -72,12 +74,32 @@
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/result.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
+using namespace yb::size_literals;
+
+DEFINE_uint64(rocksdb_universal_subcompaction_min_size_bytes, 1_GB,
+              "Approximate minimal amount of data processed by a single subcompaction of a single "
+              "level universal compaction. Smaller compactions are not split into subcompactions.");
+TAG_FLAG(rocksdb_universal_subcompaction_min_size_bytes, advanced);
+TAG_FLAG(rocksdb_universal_subcompaction_min_size_bytes, runtime);
+
 namespace rocksdb {
 
+namespace {
+
+// Number of keys sampled from index of each input file per subcompaction, when looking for
+// boundaries of single level universal compaction subcompactions.
+constexpr size_t kSampleKeysPerSubcompaction = 8;
+
+} // namespace
+
 // Maintains state for each sub-compaction
 struct CompactionJob::SubcompactionState {
   Compaction* compaction;
@@ -91,6 +113,13 @@ struct CompactionJob::SubcompactionState {
   // The return status of this subcompaction
   Status status;
 
+  // Suspender of the thread pool task executing this subcompaction, nullptr if it is not executed
+  // by the thread pool.
+  yb::PriorityThreadPoolSuspender* suspender = nullptr;
+
+  // Frontier provided by the compaction filter of this subcompaction.
+  UserFrontierPtr largest_user_frontier;
+
   // Files produced by this subcompaction
   struct Output {
     FileMetaData meta;
@@ -145,6 +174,8 @@ struct CompactionJob::SubcompactionState {
     start = std::move(o.start);
     end = std::move(o.end);
     status = std::move(o.status);
+    suspender = o.suspender;
+    largest_user_frontier = std::move(o.largest_user_frontier);
     outputs = std::move(o.outputs);
     base_outfile = std::move(o.base_outfile);
     data_outfile = std::move(o.data_outfile);
@@ -354,6 +385,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
           bounds.emplace_back(flevel->files[i].smallest.key);
           bounds.emplace_back(flevel->files[i].largest.key);
         }
+        if (out_lvl == 0) {
+          // Files of single level universal compaction usually cover almost the same key range,
+          // so also add keys sampled from their index blocks.
+          SampleSubcompactionBoundaries(*flevel);
+        }
       } else {
         // For all other levels add the smallest/largest key in the level to
         // encompass the range covered by that level
@@ -371,6 +407,9 @@ void CompactionJob::GenSubcompactionBoundaries() {
       }
     }
   }
+  for (const auto& key : sampled_keys_) {
+    bounds.emplace_back(key);
+  }
 
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
@@ -403,9 +442,12 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
+  uint64_t max_output_file_size = out_lvl == 0
+      // Output file size of single level universal compaction is not limited.
+      ? std::max<uint64_t>(FLAGS_rocksdb_universal_subcompaction_min_size_bytes, 1)
+      : cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl);
   uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+      sum / min_file_fill_percent / max_output_file_size));
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -437,6 +479,58 @@ void CompactionJob::GenSubcompactionBoundaries() {
     // Only one range so its size is the total sum of sizes computed above
     sizes_.emplace_back(sum);
   }
+
+  if (cfd->ioptions()->compaction_filter == nullptr &&
+      cfd->ioptions()->compaction_filter_factory != nullptr) {
+    AdjustSubcompactionBoundaries(*cfd->ioptions()->compaction_filter_factory);
+  }
+}
+
+void CompactionJob::SampleSubcompactionBoundaries(const LevelFilesBrief& files) {
+  auto* cfd = compact_->compaction->column_family_data();
+  const size_t max_keys = kSampleKeysPerSubcompaction * db_options_.max_subcompactions;
+  for (size_t i = 0; i != files.num_files; ++i) {
+    auto trwh = cfd->table_cache()->GetTableReader(
+        env_options_, cfd->internal_comparator(), files.files[i].fd, kDefaultQueryId,
+        /* no_io =*/ false, /* file_read_hist =*/ nullptr, /* skip_filters =*/ true);
+    if (!trwh.ok()) {
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+          "[%s] [JOB %d] Failed to open file %" PRIu64 " to sample subcompaction boundaries: %s",
+          cfd->GetName().c_str(), job_id_, files.files[i].fd.GetNumber(),
+          trwh.status().ToString().c_str());
+      continue;
+    }
+    auto keys = trwh->table_reader->GetSampleKeys(max_keys);
+    if (!keys.ok()) {
+      continue;
+    }
+    for (const auto& key : *keys) {
+      sampled_keys_.push_back(InternalKey::MaxPossibleForUserKey(key).Encode().ToBuffer());
+    }
+  }
+}
+
+void CompactionJob::AdjustSubcompactionBoundaries(const CompactionFilterFactory& factory) {
+  // Boundaries are moved back to the keys accepted by the factory. Boundaries that could not be
+  // adjusted, or became equal to the previous one, are removed, merging their subcompactions.
+  const Comparator* cfd_comparator = compact_->compaction->column_family_data()->user_comparator();
+  std::vector<Slice> boundaries;
+  std::vector<uint64_t> sizes;
+  uint64_t size = 0;
+  for (size_t i = 0; i != boundaries_.size(); ++i) {
+    size += sizes_[i];
+    Slice boundary = boundaries_[i];
+    if (!factory.AdjustSubcompactionBoundary(&boundary) ||
+        (!boundaries.empty() && cfd_comparator->Compare(boundary, boundaries.back()) <= 0)) {
+      continue;
+    }
+    boundaries.push_back(boundary);
+    sizes.push_back(size);
+    size = 0;
+  }
+  sizes.push_back(size + sizes_.back());
+  boundaries_ = std::move(boundaries);
+  sizes_ = std::move(sizes);
 }
 
 Result<FileNumbersHolder> CompactionJob::Run() {
@@ -448,23 +542,16 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(num_threads - 1);
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
-  }
-
-  // Always schedule the first subcompaction (whether or not there are also
-  // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
+  RunSubcompactions(&file_numbers_holder);
 
-  // Wait for all other threads (if there are any) to finish execution
-  for (auto& thread : thread_pool) {
-    thread.join();
+  for (auto& state : compact_->sub_compact_states) {
+    if (state.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier_, std::move(state.largest_user_frontier),
+          UpdateUserValueType::kLargest);
+    }
   }
 
   if (output_directory_ && !db_options_.disableDataSync) {
@@ -576,6 +663,132 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
   return status;
 }
 
+// State of subcompactions executed by the thread pool. It is shared with the thread pool tasks,
+// because they could outlive the compaction job.
+struct CompactionJob::SubcompactionsExecution {
+  std::mutex mutex;
+  std::condition_variable cond;
+  // Whether the subcompaction was started by a thread pool task or by the compaction thread.
+  std::vector<bool> started;
+  // Number of subcompactions that are being executed by thread pool tasks.
+  size_t running = 0;
+};
+
+class CompactionJob::SubcompactionTask : public yb::PriorityThreadPoolTask {
+ public:
+  SubcompactionTask(
+      CompactionJob* job, FileNumbersHolder* holder,
+      std::shared_ptr<SubcompactionsExecution> execution, size_t index)
+      : job_(job), job_id_(job->job_id_), holder_(holder), execution_(std::move(execution)),
+        index_(index) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    {
+      std::lock_guard<std::mutex> lock(execution_->mutex);
+      // Subcompaction of the aborted task is executed by the compaction thread.
+      if (!status.ok() || execution_->started[index_]) {
+        return;
+      }
+      execution_->started[index_] = true;
+      ++execution_->running;
+    }
+    auto* sub_compact = &job_->compact_->sub_compact_states[index_];
+    sub_compact->suspender = suspender;
+    job_->ProcessKeyValueCompaction(holder_, sub_compact);
+    {
+      std::lock_guard<std::mutex> lock(execution_->mutex);
+      --execution_->running;
+    }
+    execution_->cond.notify_all();
+  }
+
+  bool ShouldRemoveWithKey(void* key) override {
+    return key == execution_.get();
+  }
+
+  std::string ToString() const override {
+    return yb::Format("{ subcompaction job_id: $0 index: $1 }", job_id_, index_);
+  }
+
+ private:
+  CompactionJob* const job_;
+  const int job_id_;
+  FileNumbersHolder* const holder_;
+  const std::shared_ptr<SubcompactionsExecution> execution_;
+  const size_t index_;
+};
+
+void CompactionJob::RunSubcompactions(FileNumbersHolder* holder) {
+  auto& sub_compact_states = compact_->sub_compact_states;
+  // Subcompactions of a compaction executed by the thread pool are executed by the same pool,
+  // otherwise they get their own threads.
+  if (sub_compact_states.size() > 1 &&
+      db_options_.priority_thread_pool_for_compactions_and_flushes &&
+      compact_->compaction->suspender()) {
+    RunSubcompactionsInThreadPool(holder);
+    return;
+  }
+
+  // Launch a thread for each of subcompactions 1...num_threads-1
+  std::vector<std::thread> thread_pool;
+  thread_pool.reserve(sub_compact_states.size() - 1);
+  for (size_t i = 1; i < sub_compact_states.size(); i++) {
+    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, holder,
+                             &sub_compact_states[i]);
+  }
+
+  // Always schedule the first subcompaction (whether or not there are also
+  // others) in the current thread to be efficient with resources
+  sub_compact_states[0].suspender = compact_->compaction->suspender();
+  ProcessKeyValueCompaction(holder, &sub_compact_states[0]);
+
+  // Wait for all other threads (if there are any) to finish execution
+  for (auto& thread : thread_pool) {
+    thread.join();
+  }
+}
+
+void CompactionJob::RunSubcompactionsInThreadPool(FileNumbersHolder* holder) {
+  auto& sub_compact_states = compact_->sub_compact_states;
+  auto* compaction = compact_->compaction;
+  auto* thread_pool = db_options_.priority_thread_pool_for_compactions_and_flushes;
+  auto execution = std::make_shared<SubcompactionsExecution>();
+  execution->started.resize(sub_compact_states.size());
+  for (size_t i = 1; i < sub_compact_states.size(); i++) {
+    auto task = std::make_unique<SubcompactionTask>(this, holder, execution, i);
+    auto status = thread_pool->Submit(compaction->priority(), &task);
+    if (!status.ok()) {
+      // This subcompaction is executed by the current thread.
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+          "[JOB %d] Failed to submit subcompaction %" ROCKSDB_PRIszt ": %s",
+          job_id_, i, status.ToString().c_str());
+    }
+  }
+
+  sub_compact_states[0].suspender = compaction->suspender();
+  ProcessKeyValueCompaction(holder, &sub_compact_states[0]);
+
+  // Thread pool tasks are executed only when the pool has free workers, so subcompactions, that
+  // were not started yet, are executed by the current thread.
+  for (size_t i = 1; i < sub_compact_states.size(); i++) {
+    {
+      std::lock_guard<std::mutex> lock(execution->mutex);
+      if (execution->started[i]) {
+        continue;
+      }
+      execution->started[i] = true;
+    }
+    sub_compact_states[i].suspender = compaction->suspender();
+    ProcessKeyValueCompaction(holder, &sub_compact_states[i]);
+  }
+
+  // All subcompactions are started, so the tasks remaining in the pool have nothing to do.
+  thread_pool->Remove(execution.get());
+
+  std::unique_lock<std::mutex> lock(execution->mutex);
+  execution->cond.wait(lock, [&execution] { return execution->running == 0; });
+}
+
 void CompactionJob::ProcessKeyValueCompaction(
     FileNumbersHolder* holder, SubcompactionState* sub_compact) {
   assert(sub_compact != nullptr);
@@ -610,7 +823,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = compaction_filter->GetLargestUserFrontier();
   }
 
   MergeHelper merge(
@@ -996,7 +1209,7 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), env_options_, sub_compact->suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -68,6 +68,7 @@ class VersionSet;
 class Arena;
 class FileNumbersProvider;
 class FileNumbersHolder;
+struct LevelFilesBrief;
 
 class CompactionJob {
  public:
@@ -102,9 +103,20 @@ class CompactionJob {
 
  private:
   struct SubcompactionState;
+  class SubcompactionTask;
+  struct SubcompactionsExecution;
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Adds keys sampled from the index blocks of the files as potential subcompaction boundaries.
+  void SampleSubcompactionBoundaries(const LevelFilesBrief& files);
+  // Adjusts subcompaction boundaries, so they are accepted by the compaction filter factory.
+  void AdjustSubcompactionBoundaries(const CompactionFilterFactory& factory);
+
+  // Executes subcompactions 1...n-1 in parallel with the first one, that is executed in the
+  // current thread.
+  void RunSubcompactions(FileNumbersHolder* holder);
+  void RunSubcompactionsInThreadPool(FileNumbersHolder* holder);
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -180,6 +192,8 @@ class CompactionJob {
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
+  // Internal keys sampled from input files, that are used as potential subcompaction boundaries.
+  std::vector<std::string> sampled_keys_;
 
   UserFrontierPtr largest_user_frontier_;
 };
@@ -1194,6 +1194,9 @@ struct UniversalCompactionPicker::SortedRun {
     assert(compensated_file_size > 0);
     // Allowed either one of level and file.
     assert((level != 0) != (file != nullptr));
+    if (file) {
+      files.push_back(file);
+    }
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1210,13 +1213,26 @@ struct UniversalCompactionPicker::SortedRun {
   }
 
   bool delete_after_compaction() const {
-    return file ? file->delete_after_compaction : false;
+    for (auto* f : files) {
+      if (!f->delete_after_compaction) {
+        return false;
+      }
+    }
+    return file != nullptr;
+  }
+
+  // Appends files of level 0 sorted run to the compaction inputs.
+  void AppendFiles(std::vector<FileMetaData*>* inputs) const {
+    inputs->insert(inputs->end(), files.begin(), files.end());
   }
 
   int level;
   // `file` Will be null for level > 0. For level = 0, the sorted run is
   // for this file.
   FileMetaData* file;
+  // For level = 0, all files of the sorted run, starting with `file`. There are several of them
+  // when the sorted run was produced by a compaction split into subcompactions.
+  std::vector<FileMetaData*> files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
@@ -1269,17 +1285,36 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
   std::vector<std::vector<SortedRun>> ret(1);
   MarkL0FilesForDeletion(&vstorage, &ioptions);
 
-  for (FileMetaData* f : vstorage.LevelFiles(0)) {
+  const auto& level0_files = vstorage.LevelFiles(0);
+  for (size_t i = 0; i != level0_files.size();) {
+    FileMetaData* f = level0_files[i];
+    uint64_t size = f->fd.GetTotalFileSize();
+    uint64_t compensated_file_size = f->compensated_file_size;
+    bool being_compacted = f->being_compacted;
+    bool delete_after_compaction = f->delete_after_compaction;
+    size_t end = i + 1;
+    if (vstorage.num_levels() == 1) {
+      end = Level0SortedRunEnd(ioptions.comparator, level0_files, i);
+      for (size_t j = i + 1; j != end; ++j) {
+        size += level0_files[j]->fd.GetTotalFileSize();
+        compensated_file_size += level0_files[j]->compensated_file_size;
+        being_compacted = being_compacted || level0_files[j]->being_compacted;
+        delete_after_compaction =
+            delete_after_compaction && level0_files[j]->delete_after_compaction;
+      }
+    }
     // Any files that can be directly removed during compaction can be included, even if they
     // exceed the "max file size for compaction."
-    if (f->fd.GetTotalFileSize() <= max_file_size || f->delete_after_compaction) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
-          f->being_compacted);
+    if (size <= max_file_size || delete_after_compaction) {
+      ret.back().emplace_back(0, f, size, compensated_file_size, being_compacted);
+      auto& files = ret.back().back().files;
+      files.insert(files.end(), level0_files.begin() + i + 1, level0_files.begin() + end);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
       ret.emplace_back();
     }
+    i = end;
   }
 
   for (int level = 1; level < vstorage.num_levels(); level++) {
@@ -1522,14 +1557,20 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
 
   size_t level_index = 0U;
   if (c->start_level() == 0) {
+    const FileMetaData* prev_file = nullptr;
     for (auto f : *c->inputs(0)) {
       DCHECK_LE(f->smallest.seqno, f->largest.seqno);
-      if (is_first) {
-        is_first = false;
+      is_first = false;
+      if (prev_file && InSameLevel0SortedRun(ioptions_.comparator, *prev_file, *f)) {
+        // Files of the same sorted run have overlapping sequence number ranges.
+        prev_smallest_seqno = std::min(prev_smallest_seqno, f->smallest.seqno);
       } else {
-        DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
+        if (prev_file) {
+          DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
+        }
+        prev_smallest_seqno = f->smallest.seqno;
       }
-      prev_smallest_seqno = f->smallest.seqno;
+      prev_file = f;
     }
     level_index = 1U;
   }
@@ -1759,8 +1800,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      picking_sr.AppendFiles(&inputs[0].files);
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1812,8 +1852,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalDe
     const auto sr = &sorted_runs[loop];
 
     if (!sr->being_compacted && sr->delete_after_compaction()) {
-      FileMetaData* f = sr->file;
-      input_files.files.push_back(f);
+      sr->AppendFiles(&input_files.files);
 
       char file_num_buf[kFormatFileSizeInfoBufSize];
       sr->DumpSizeInfo(file_num_buf, sizeof(file_num_buf), loop);
@@ -1950,8 +1989,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      picking_sr.AppendFiles(&inputs[0].files);
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
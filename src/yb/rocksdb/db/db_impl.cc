@@ -258,6 +258,10 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
 
   void DoRun(yb::PriorityThreadPoolSuspender* suspender) override {
     compaction_->SetSuspender(suspender);
+    {
+      InstrumentedMutexLock lock(&db_impl_->mutex_);
+      compaction_->SetPriority(priority_);
+    }
     db_impl_->BackgroundCallCompaction(manual_compaction_, std::move(compaction_holder_), this);
   }
 
@@ -5737,6 +5741,16 @@ Result<std::string> DBImpl::GetMiddleKey() {
   return default_cf_handle_->cfd()->current()->GetMiddleKey();
 }
 
+Result<std::vector<std::string>> DBImpl::GetApproximateSplitKeys(
+    const Slice& lower, const Slice& upper, size_t num_parts, uint64_t min_part_size) {
+  // Table readers could perform IO, so don't hold the DB mutex while sampling keys.
+  auto cfd = default_cf_handle_->cfd();
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  auto result = sv->current->GetApproximateSplitKeys(lower, upper, num_parts, min_part_size);
+  ReturnAndCleanupSuperVersion(cfd, sv);
+  return result;
+}
+
 void DBImpl::TEST_SwitchMemtable() {
   std::lock_guard<InstrumentedMutex> lock(mutex_);
   WriteContext context;
@@ -483,6 +483,9 @@ class DBImpl : public DB {
 
   Result<std::string> GetMiddleKey() override;
 
+  Result<std::vector<std::string>> GetApproximateSplitKeys(
+      const Slice& lower, const Slice& upper, size_t num_parts, uint64_t min_part_size) override;
+
   // Used in testing to make the old memtable immutable and start writing to a new one.
   void TEST_SwitchMemtable() override;
 
@@ -2606,6 +2606,147 @@ TEST_F(DBTest, ApproximateSizes_MixOfSmallAndLarge) {
 }
 #endif  // ROCKSDB_LITE
 
+TEST_F(DBTest, GetApproximateSplitKeys) {
+  constexpr int kNumKeys = 1000;
+  constexpr int kNumFiles = 4;
+  constexpr int kValueSize = 1000;
+  // Split keys are sampled, so they are only expected to be close to the exact ones.
+  constexpr int kMaxKeyDeviation = kNumKeys / 10;
+
+  BlockBasedTableOptions table_options;
+  table_options.block_size = kValueSize;
+  Options options = CurrentOptions();
+  options.compression = kNoCompression;
+  options.disable_auto_compactions = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // Nothing to split without SST files.
+  ASSERT_TRUE(ASSERT_RESULT(db_->GetApproximateSplitKeys("", "", 4, 0)).empty());
+
+  // Keys of all files are interleaved, so each file covers the whole key range.
+  Random rnd(301);
+  for (int file = 0; file != kNumFiles; ++file) {
+    for (int i = file; i < kNumKeys; i += kNumFiles) {
+      ASSERT_OK(Put(Key(i), RandomString(&rnd, kValueSize)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(kNumFiles, NumTableFilesAtLevel(0));
+
+  auto check_split_keys = [](const std::vector<std::string>& keys, int begin, int end) {
+    const auto num_parts = static_cast<int>(keys.size()) + 1;
+    for (size_t i = 0; i != keys.size(); ++i) {
+      LOG(INFO) << "Split key " << i << ": " << keys[i];
+      if (i > 0) {
+        ASSERT_LT(keys[i - 1], keys[i]);
+      }
+      const auto expected = begin + (end - begin) * static_cast<int>(i + 1) / num_parts;
+      ASSERT_GE(keys[i], Key(std::max<int>(begin, expected - kMaxKeyDeviation)));
+      ASSERT_LE(keys[i], Key(std::min<int>(end, expected + kMaxKeyDeviation)));
+    }
+  };
+
+  auto keys = ASSERT_RESULT(db_->GetApproximateSplitKeys("", "", 4, 0));
+  ASSERT_EQ(keys.size(), 3U);
+  ASSERT_NO_FATALS(check_split_keys(keys, 0, kNumKeys));
+
+  // Only keys within the requested range are returned.
+  const auto lower = Key(kNumKeys / 2);
+  const auto upper = Key(kNumKeys * 3 / 4);
+  keys = ASSERT_RESULT(db_->GetApproximateSplitKeys(lower, upper, 2, 0));
+  ASSERT_EQ(keys.size(), 1U);
+  ASSERT_NO_FATALS(check_split_keys(keys, kNumKeys / 2, kNumKeys * 3 / 4));
+  keys = ASSERT_RESULT(db_->GetApproximateSplitKeys(lower, "", 4, 0));
+  ASSERT_EQ(keys.size(), 3U);
+  ASSERT_NO_FATALS(check_split_keys(keys, kNumKeys / 2, kNumKeys));
+
+  // Single part does not need split keys.
+  ASSERT_TRUE(ASSERT_RESULT(db_->GetApproximateSplitKeys("", "", 1, 0)).empty());
+
+  // Number of parts is limited by the minimal part size.
+  const uint64_t data_size = kNumKeys * kValueSize;
+  keys = ASSERT_RESULT(db_->GetApproximateSplitKeys("", "", 8, data_size / 3));
+  ASSERT_GE(keys.size(), 1U);
+  ASSERT_LE(keys.size(), 2U);
+  ASSERT_TRUE(ASSERT_RESULT(db_->GetApproximateSplitKeys("", "", 8, data_size)).empty());
+  ASSERT_TRUE(ASSERT_RESULT(db_->GetApproximateSplitKeys(lower, upper, 8, data_size / 3)).empty());
+}
+
+namespace {
+
+class CountingHashIndexKeyExtractor : public DataBlockHashIndexKeyExtractor {
+ public:
+  explicit CountingHashIndexKeyExtractor(std::string name) : name_(std::move(name)) {}
+
+  const char* Name() const override { return name_.c_str(); }
+
+  Slice Extract(Slice user_key) const override {
+    ++num_extracts_;
+    return user_key;
+  }
+
+  size_t num_extracts() const { return num_extracts_.load(); }
+
+ private:
+  const std::string name_;
+  mutable std::atomic<size_t> num_extracts_{0};
+};
+
+} // namespace
+
+TEST_F(DBTest, DataBlockHashIndexKeyExtractor) {
+  constexpr int kNumKeys = 1000;
+
+  auto extractor = std::make_shared<CountingHashIndexKeyExtractor>("test.Extractor");
+  BlockBasedTableOptions table_options;
+  table_options.data_block_index_type = DataBlockIndexType::kBinarySearchAndHash;
+  table_options.data_block_hash_index_key_extractor = extractor;
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), Key(i)));
+  }
+  ASSERT_OK(Flush());
+
+  // Extractor name is stored in table properties.
+  TablePropertiesCollection props;
+  ASSERT_OK(db_->GetPropertiesOfAllTables(&props));
+  ASSERT_EQ(props.size(), 1U);
+  for (const auto& file_and_props : props) {
+    const auto& user_props = file_and_props.second->user_collected_properties;
+    auto it = user_props.find(BlockBasedTablePropertyNames::kDataBlockHashIndexKeyExtractor);
+    ASSERT_NE(it, user_props.end());
+    ASSERT_EQ(it->second, extractor->Name());
+  }
+
+  auto check_keys = [this] {
+    for (int i = 0; i != kNumKeys; ++i) {
+      ASSERT_EQ(Get(Key(i)), Key(i));
+    }
+    ASSERT_EQ(Get(Key(kNumKeys)), "NOT_FOUND");
+  };
+
+  // Extractor with the same name is used to read the file.
+  table_options.data_block_hash_index_key_extractor = extractor =
+      std::make_shared<CountingHashIndexKeyExtractor>("test.Extractor");
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_NO_FATALS(check_keys());
+  ASSERT_GT(extractor->num_extracts(), 0U);
+
+  // File written with different extractor is read using binary search only.
+  table_options.data_block_hash_index_key_extractor = extractor =
+      std::make_shared<CountingHashIndexKeyExtractor>("test.OtherExtractor");
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_NO_FATALS(check_keys());
+  ASSERT_EQ(extractor->num_extracts(), 0U);
+}
+
 TEST_F(DBTest, IteratorPinsRef) {
   do {
     CreateAndReopenWithCF({"pikachu"}, CurrentOptions());
@@ -4781,6 +4922,11 @@ class ModelDB: public DB {
     return NotSupported();
   }
 
+  Result<std::vector<std::string>> GetApproximateSplitKeys(
+      const Slice& lower, const Slice& upper, size_t num_parts, uint64_t min_part_size) override {
+    return NotSupported();
+  }
+
  private:
   CHECKED_STATUS NotSupported() const {
     return STATUS(NotSupported, "Not supported in Model DB");
@@ -28,6 +28,10 @@
 #include "yb/rocksdb/util/file_util.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/priority_thread_pool.h"
+
+DECLARE_uint64(rocksdb_universal_subcompaction_min_size_bytes);
+
 namespace rocksdb {
 
 static std::string CompressibleString(Random* rnd, int len) {
@@ -1464,6 +1468,81 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactions) {
+  constexpr int kNumFiles = 4;
+  constexpr int kNumKeys = 2000;
+  constexpr int kValueSize = 1_KB;
+  constexpr int kMaxSubcompactions = 4;
+
+  FLAGS_rocksdb_universal_subcompaction_min_size_bytes = 256_KB;
+
+  for (const auto use_thread_pool : {false, true}) {
+    LOG(INFO) << "use_thread_pool: " << use_thread_pool;
+
+    yb::PriorityThreadPool thread_pool(kMaxSubcompactions);
+    Options options;
+    options.compaction_style = kCompactionStyleUniversal;
+    options.num_levels = 1;
+    options.write_buffer_size = 128_MB;
+    options.level0_file_num_compaction_trigger = 2;
+    options.max_subcompactions = kMaxSubcompactions;
+    options.max_background_compactions = kMaxSubcompactions;
+    if (use_thread_pool) {
+      options.priority_thread_pool_for_compactions_and_flushes = &thread_pool;
+    }
+    options = CurrentOptions(options);
+    DestroyAndReopen(options);
+    ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "true"}}));
+
+    // Each file covers the whole key range, so only sampled keys could split the compaction.
+    Random rnd(301);
+    std::vector<std::string> values(kNumKeys);
+    for (int file = 0; file != kNumFiles; ++file) {
+      for (int i = 0; i != kNumKeys; ++i) {
+        values[i] = RandomString(&rnd, kValueSize);
+        ASSERT_OK(Put(Key(i), values[i]));
+      }
+      ASSERT_OK(Flush());
+    }
+    ASSERT_EQ(kNumFiles, NumTableFilesAtLevel(0));
+
+    ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+    // Subcompaction outputs do not overlap and form a single sorted run.
+    ColumnFamilyMetaData cf_meta;
+    db_->GetColumnFamilyMetaData(&cf_meta);
+    auto files = cf_meta.levels[0].files;
+    ASSERT_GT(files.size(), 1U);
+    ASSERT_LE(files.size(), static_cast<size_t>(kMaxSubcompactions));
+    std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.smallest.key < rhs.smallest.key;
+    });
+    for (size_t i = 1; i < files.size(); ++i) {
+      ASSERT_LT(files[i - 1].largest.key, files[i].smallest.key);
+      ASSERT_EQ(files[0].largest.seqno, files[i].largest.seqno);
+    }
+
+    // Middle key is taken from the whole sorted run, not from one of its files.
+    const auto middle_key = ASSERT_RESULT(db_->GetMiddleKey());
+    const auto middle_user_key = ExtractUserKey(middle_key).ToBuffer();
+    LOG(INFO) << "Middle key: " << middle_user_key;
+    ASSERT_GE(middle_user_key, Key(kNumKeys * 3 / 8));
+    ASSERT_LE(middle_user_key, Key(kNumKeys * 5 / 8));
+
+    // The sorted run should not be picked for compaction again.
+    const auto num_files = static_cast<int>(files.size());
+    ASSERT_OK(dbfull()->EnableAutoCompaction({dbfull()->DefaultColumnFamily()}));
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+    ASSERT_EQ(num_files, NumTableFilesAtLevel(0));
+
+    for (int i = 0; i != kNumKeys; ++i) {
+      ASSERT_EQ(values[i], Get(Key(i)));
+    }
+    Close();
+  }
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
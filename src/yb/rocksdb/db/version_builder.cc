@@ -151,7 +151,10 @@ class VersionBuilder::Rep {
           assert(f1->largest.seqno > f2->largest.seqno ||
                  // We can have multiple files with seqno = 0 as a result of
                  // using DB::AddFile()
-                 (f1->largest.seqno == 0 && f2->largest.seqno == 0));
+                 (f1->largest.seqno == 0 && f2->largest.seqno == 0) ||
+                 // or multiple files of the same sorted run as a result of subcompactions.
+                 InSameLevel0SortedRun(
+                     vstorage->InternalComparator()->user_comparator(), *f1, *f2));
         } else {
           assert(level_nonzero_cmp_(f1, f2));
 
@@ -122,6 +122,27 @@ std::string FileMetaData::ToString() const {
                     being_compacted, smallest, largest);
 }
 
+bool InSameLevel0SortedRun(
+    const Comparator* user_comparator, const FileMetaData& lhs, const FileMetaData& rhs) {
+  return lhs.largest.seqno == rhs.largest.seqno &&
+         (user_comparator->Compare(lhs.largest.key.user_key(), rhs.smallest.key.user_key()) < 0 ||
+          user_comparator->Compare(rhs.largest.key.user_key(), lhs.smallest.key.user_key()) < 0);
+}
+
+size_t Level0SortedRunEnd(
+    const Comparator* user_comparator, const std::vector<FileMetaData*>& files, size_t start) {
+  size_t end = start + 1;
+  for (; end != files.size(); ++end) {
+    // Key range of the file should not overlap with any file of the sorted run.
+    for (size_t i = start; i != end; ++i) {
+      if (!InSameLevel0SortedRun(user_comparator, *files[i], *files[end])) {
+        return end;
+      }
+    }
+  }
+  return end;
+}
+
 void VersionEdit::Clear() {
   comparator_.reset();
   max_level_ = 0;
@@ -153,6 +153,18 @@ struct FileMetaData {
   std::string ToString() const;
 };
 
+// Outputs of a single level universal compaction, that was split into subcompactions, are stored
+// as several level 0 files with non overlapping key ranges. Such files have the same largest
+// sequence number and form a single sorted run.
+bool InSameLevel0SortedRun(
+    const Comparator* user_comparator, const FileMetaData& lhs, const FileMetaData& rhs);
+
+// Returns the index of the first file after the level 0 sorted run, that starts at files[start].
+// Files of the sorted run are adjacent, because level 0 files are ordered by largest sequence
+// number.
+size_t Level0SortedRunEnd(
+    const Comparator* user_comparator, const std::vector<FileMetaData*>& files, size_t start);
+
 class VersionEdit {
  public:
   VersionEdit() { Clear(); }
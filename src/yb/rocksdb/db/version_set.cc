@@ -34,6 +34,7 @@
 #include <map>
 #include <set>
 #include <climits>
+#include <cmath>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -1246,10 +1247,18 @@ void VersionStorageInfo::ComputeCompactionScore(
       // overwrites/deletions).
       int num_sorted_runs = 0;
       uint64_t total_size = 0;
-      for (auto* f : files_[level]) {
-        if (!f->being_compacted) {
-          total_size += f->compensated_file_size;
-          num_sorted_runs++;
+      for (size_t i = 0; i != files_[level].size();) {
+        const auto end = Level0SortedRunEnd(i);
+        bool counted = false;
+        for (; i != end; ++i) {
+          const auto* f = files_[level][i];
+          if (!f->being_compacted) {
+            total_size += f->compensated_file_size;
+            if (!counted) {
+              num_sorted_runs++;
+              counted = true;
+            }
+          }
         }
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
@@ -1883,13 +1892,14 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
   int num_l0_count = 0;
-  if (options.MaxFileSizeForCompaction() == std::numeric_limits<uint64_t>::max()) {
-    num_l0_count = static_cast<int>(files_[0].size());
-  } else {
-    for (const auto& file : files_[0]) {
-      if (file->fd.GetTotalFileSize() <= options.MaxFileSizeForCompaction()) {
-        ++num_l0_count;
-      }
+  for (size_t i = 0; i != files_[0].size();) {
+    const auto end = Level0SortedRunEnd(i);
+    uint64_t run_size = 0;
+    for (; i != end; ++i) {
+      run_size += files_[0][i]->fd.GetTotalFileSize();
+    }
+    if (run_size <= options.MaxFileSizeForCompaction()) {
+      ++num_l0_count;
     }
   }
   if (compaction_style_ == kCompactionStyleUniversal) {
@@ -2067,24 +2077,161 @@ std::string Version::DebugString(bool hex) const {
 }
 
 Result<std::string> Version::GetMiddleKey() {
-  // Largest files are at lowest level.
+  // Number of keys sampled from the file, that contains the middle of a sorted run of several
+  // files.
+  constexpr size_t kMiddleKeySamples = 64;
+
+  // Largest files are at lowest level. Outputs of a compaction that was split into subcompactions
+  // form a single level 0 sorted run of several files, so the middle key is taken from the
+  // largest sorted run, weighted by file size.
   const auto level = storage_info_.num_levels_ - 1;
-  const FileMetaData* largest_sst_meta = nullptr;
-  for (const auto* file : storage_info_.files_[level]) {
-    if (!largest_sst_meta ||
-        file->fd.GetTotalFileSize() > largest_sst_meta->fd.GetTotalFileSize()) {
-      largest_sst_meta = file;
-    }
-  }
-  if (!largest_sst_meta) {
+  const auto& files = storage_info_.files_[level];
+  size_t run_start = 0;
+  size_t run_end = 0;
+  uint64_t run_size = 0;
+  for (size_t i = 0; i != files.size();) {
+    const auto end = level == 0 ? storage_info_.Level0SortedRunEnd(i) : i + 1;
+    uint64_t size = 0;
+    for (auto j = i; j != end; ++j) {
+      size += files[j]->fd.GetTotalFileSize();
+    }
+    if (run_end == 0 || size > run_size) {
+      run_start = i;
+      run_end = end;
+      run_size = size;
+    }
+    i = end;
+  }
+  if (run_end == 0) {
     return STATUS(Incomplete, "No SST files.");
   }
 
+  std::vector<size_t> run;
+  for (auto i = run_start; i != run_end; ++i) {
+    run.push_back(i);
+  }
+  const auto* user_comparator = cfd_->user_comparator();
+  std::sort(run.begin(), run.end(), [&files, user_comparator](size_t lhs, size_t rhs) {
+    return user_comparator->Compare(
+        files[lhs]->smallest.key.user_key(), files[rhs]->smallest.key.user_key()) < 0;
+  });
+
+  // Find the file that contains the middle of the sorted run.
+  const double middle = run_size / 2.0;
+  uint64_t size_before = 0;
+  auto it = run.begin();
+  for (; it + 1 != run.end(); ++it) {
+    const auto file_size = files[*it]->fd.GetTotalFileSize();
+    if (size_before + file_size > middle) {
+      break;
+    }
+    size_before += file_size;
+  }
+  const auto* file = files[*it];
+
   const auto trwh = VERIFY_RESULT(table_cache_->GetTableReader(
-      vset_->env_options_, cfd_->internal_comparator(), largest_sst_meta->fd, kDefaultQueryId,
+      vset_->env_options_, cfd_->internal_comparator(), file->fd, kDefaultQueryId,
       /* no_io =*/ false, cfd_->internal_stats()->GetFileReadHist(level),
-      IsFilterSkipped(level, /* is_file_last_in_level =*/ true)));
-  return trwh.table_reader->GetMiddleKey();
+      IsFilterSkipped(level, /* is_file_last_in_level =*/ *it + 1 == files.size())));
+  if (run.size() == 1) {
+    return trwh.table_reader->GetMiddleKey();
+  }
+
+  auto keys = trwh.table_reader->GetSampleKeys(kMiddleKeySamples);
+  if (!keys.ok() && !keys.status().IsNotSupported()) {
+    return keys.status();
+  }
+  if (!keys.ok() || keys->empty()) {
+    return trwh.table_reader->GetMiddleKey();
+  }
+  // Each sampled key represents file data between it and the previous sampled key, so use the
+  // first sampled key, that is not before the middle of the sorted run.
+  const double fraction =
+      (middle - size_before) / std::max<uint64_t>(file->fd.GetTotalFileSize(), 1);
+  const auto index = std::min<size_t>(
+      std::max<double>(std::ceil(fraction * (keys->size() + 1)), 1) - 1, keys->size() - 1);
+  return InternalKey::MaxPossibleForUserKey((*keys)[index]).Encode().ToBuffer();
+}
+
+Result<std::vector<std::string>> Version::GetApproximateSplitKeys(
+    const Slice& lower, const Slice& upper, size_t num_parts, uint64_t min_part_size) {
+  // Number of keys sampled from each SST file per requested part.
+  constexpr size_t kSampleKeysPerPart = 8;
+
+  std::vector<std::string> result;
+  if (num_parts < 2) {
+    return result;
+  }
+
+  const auto* user_comparator = cfd_->user_comparator();
+  struct WeightedKey {
+    std::string key;
+    double weight;
+  };
+  std::vector<WeightedKey> samples;
+  double total_weight = 0;
+  for (int level = 0; level < storage_info_.num_levels_; ++level) {
+    const auto& files = storage_info_.files_[level];
+    for (size_t i = 0; i != files.size(); ++i) {
+      const auto* file = files[i];
+      if ((!upper.empty() &&
+           user_comparator->Compare(file->smallest.key.user_key(), upper) >= 0) ||
+          user_comparator->Compare(file->largest.key.user_key(), lower) < 0) {
+        continue;
+      }
+      const auto trwh = VERIFY_RESULT(table_cache_->GetTableReader(
+          vset_->env_options_, cfd_->internal_comparator(), file->fd, kDefaultQueryId,
+          /* no_io =*/ false, cfd_->internal_stats()->GetFileReadHist(level),
+          IsFilterSkipped(level, /* is_file_last_in_level =*/ i + 1 == files.size())));
+      auto keys = trwh.table_reader->GetSampleKeys(kSampleKeysPerPart * num_parts);
+      if (!keys.ok()) {
+        if (keys.status().IsNotSupported()) {
+          continue;
+        }
+        return keys.status();
+      }
+      // Each sampled key represents file data between it and the previous sampled key.
+      const double weight =
+          static_cast<double>(file->fd.GetTotalFileSize()) / (keys->size() + 1);
+      for (auto& key : *keys) {
+        if (user_comparator->Compare(key, lower) < 0 ||
+            (!upper.empty() && user_comparator->Compare(key, upper) >= 0)) {
+          continue;
+        }
+        samples.push_back(WeightedKey{std::move(key), weight});
+        total_weight += weight;
+      }
+    }
+  }
+
+  if (min_part_size > 0) {
+    num_parts = std::min(num_parts, static_cast<size_t>(total_weight / min_part_size));
+    if (num_parts < 2) {
+      return result;
+    }
+  }
+
+  std::sort(samples.begin(), samples.end(), [user_comparator](const auto& lhs, const auto& rhs) {
+    return user_comparator->Compare(lhs.key, rhs.key) < 0;
+  });
+
+  const double part_weight = total_weight / num_parts;
+  double accumulated_weight = 0;
+  double next_split_weight = part_weight;
+  for (auto& sample : samples) {
+    accumulated_weight += sample.weight;
+    if (accumulated_weight < next_split_weight) {
+      continue;
+    }
+    if (result.empty() || user_comparator->Compare(sample.key, result.back()) != 0) {
+      result.push_back(std::move(sample.key));
+      if (result.size() + 1 == num_parts) {
+        break;
+      }
+    }
+    next_split_weight += part_weight;
+  }
+  return result;
 }
 
 // this is used to batch writes to the manifest file
@@ -2854,6 +3001,17 @@ Status VersionSet::Recover(
   return s;
 }
 
+namespace {
+
+void AddSeqNoSegment(
+    SequenceNumber smallest, SequenceNumber largest,
+    std::map<SequenceNumber, SequenceNumber>* segments) {
+  auto it = segments->emplace(largest, smallest).first;
+  it->second = std::min(it->second, smallest);
+}
+
+} // namespace
+
 Status VersionSet::Import(const std::string& source_dir,
                           SequenceNumber seqno,
                           VersionEdit* edit) {
@@ -2864,7 +3022,9 @@ Status VersionSet::Import(const std::string& source_dir,
     return status;
   }
   std::vector<FileMetaData> files;
-  std::vector<std::pair<SequenceNumber, SequenceNumber>> segments;
+  // Maps largest sequence number of the sorted run to its smallest sequence number. Level 0 sorted
+  // run could consist of several files with overlapping sequence number ranges.
+  std::map<SequenceNumber, SequenceNumber> imported_segments;
   for (;;) {
     status = manifest_reader.Next();
     if (!status.ok()) {
@@ -2886,7 +3046,7 @@ Status VersionSet::Import(const std::string& source_dir,
                              seqno);
       }
       files.push_back(filemeta);
-      segments.emplace_back(filemeta.smallest.seqno, filemeta.largest.seqno);
+      AddSeqNoSegment(filemeta.smallest.seqno, filemeta.largest.seqno, &imported_segments);
     }
   }
   if (!status.IsEndOfFile()) {
@@ -2899,8 +3059,16 @@ Status VersionSet::Import(const std::string& source_dir,
 
   std::vector<LiveFileMetaData> live_files;
   GetLiveFilesMetaData(&live_files);
+  std::map<SequenceNumber, SequenceNumber> live_segments;
   for (const auto& file : live_files) {
-    segments.emplace_back(file.smallest.seqno, file.largest.seqno);
+    AddSeqNoSegment(file.smallest.seqno, file.largest.seqno, &live_segments);
+  }
+
+  std::vector<std::pair<SequenceNumber, SequenceNumber>> segments;
+  for (const auto* source : {&imported_segments, &live_segments}) {
+    for (const auto& segment : *source) {
+      segments.emplace_back(segment.second, segment.first);
+    }
   }
 
   std::sort(segments.begin(), segments.end(), [](const auto& lhs, const auto& rhs) {
@@ -349,6 +349,16 @@ class VersionStorageInfo {
   }
 
  private:
+  // Returns the index of the first level 0 file after the sorted run, that starts at the file with
+  // the specified index. Only single level universal compaction could have sorted runs that
+  // consist of several files.
+  size_t Level0SortedRunEnd(size_t start) const {
+    if (compaction_style_ != kCompactionStyleUniversal || num_levels_ != 1) {
+      return start + 1;
+    }
+    return rocksdb::Level0SortedRunEnd(user_comparator_, files_[0], start);
+  }
+
   InternalKeyComparatorPtr internal_comparator_;
   const Comparator* user_comparator_;
   int num_levels_;            // Number of levels
@@ -521,6 +531,14 @@ class Version {
   // Returns Status(Incomplete) if there are no SST files for this version.
   Result<std::string> GetMiddleKey();
 
+  // Returns up to num_parts - 1 user keys that split data of this version within [lower, upper)
+  // into parts of approximately the same size. Keys are sampled from indexes of SST files, each
+  // key is weighted by the amount of file data it represents. Memtables are not taken into account.
+  // The number of parts is reduced so that each part holds at least min_part_size bytes, no keys
+  // are returned if the range holds less than 2 * min_part_size bytes.
+  Result<std::vector<std::string>> GetApproximateSplitKeys(
+      const Slice& lower, const Slice& upper, size_t num_parts, uint64_t min_part_size);
+
   ColumnFamilyData* cfd() const { return cfd_; }
 
   // Return the next Version in the linked list. Used for debug only
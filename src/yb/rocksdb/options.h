@@ -168,9 +168,15 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of the zstd dictionary trained for each SST file. The dictionary is trained from
+  // the first data blocks of the file (about 100 times max_dict_bytes of raw data), stored in
+  // the file's meta block and used to compress the rest of its data blocks.
+  // Only used with kZSTDNotFinalCompression, 0 disables dictionary compression.
+  // Default: 0.
+  uint32_t max_dict_bytes;
+  CompressionOptions() : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -18,6 +18,7 @@
 
 namespace rocksdb {
 
+class DataBlockHashIndexKeyExtractor;
 class DB;
 class Env;
 class MemTable;
@@ -77,6 +77,35 @@ YB_DEFINE_ENUM(IndexType,
   (kMultiLevelBinarySearch)
 );
 
+YB_DEFINE_ENUM(DataBlockIndexType,
+  // Restart interval for the key is found using binary search over restart points.
+  (kBinarySearch)
+
+  // Data block also contains hash index, that maps hash index keys to restart intervals,
+  // see DataBlockHashIndexKeyExtractor. It is used for exact-match seeks, falling back to binary
+  // search when the key is not found in hash index.
+  // Files written with hash index could not be read by versions that do not support it.
+  (kBinarySearchAndHash)
+);
+
+// Extracts part of the user key that is used as a key of the data block hash index.
+// Requires: extracted part is a prefix of the user key and for user keys a and b with different
+// extracted parts, a and b are ordered the same way as their extracted parts. So the first key that
+// is not less than the seek target, whose extracted part is present in the block, is either a key
+// with the same extracted part or the key that follows them.
+class DataBlockHashIndexKeyExtractor {
+ public:
+  virtual ~DataBlockHashIndexKeyExtractor() = default;
+
+  // Name is stored in table properties, the hash index is used only when the file was written
+  // with the extractor of the same name.
+  virtual const char* Name() const = 0;
+
+  // Returns empty slice when the key could not be used with hash index. The block that contains
+  // such a key is written without hash index.
+  virtual Slice Extract(Slice user_key) const = 0;
+};
+
 // For advanced user only
 struct BlockBasedTableOptions {
   // @flush_block_policy_factory creates the instances of flush block policy.
@@ -165,6 +194,17 @@ struct BlockBasedTableOptions {
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
 
+  // Specifies how the restart interval of the key is searched in data blocks. Hash index is built
+  // only when the user comparator is BytewiseComparator.
+  DataBlockIndexType data_block_index_type = DataBlockIndexType::kBinarySearch;
+
+  // Ratio of the number of distinct hash index keys to the number of hash index buckets in a data
+  // block. Used only for kBinarySearchAndHash.
+  double data_block_hash_table_util_ratio = 0.75;
+
+  // Extracts data block hash index key from the user key. Whole user key is used if not set.
+  std::shared_ptr<const DataBlockHashIndexKeyExtractor> data_block_hash_index_key_extractor;
+
   // If non-nullptr, use the specified filter policy for new SST files to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
@@ -225,6 +265,9 @@ struct BlockBasedTablePropertyNames {
   static const char kPrefixFiltering[];
   // value is a uint8_t.
   static const char kDataBlockKeyValueEncodingFormat[];
+  // name of the data block hash index key extractor, present only when data blocks could have
+  // hash index.
+  static const char kDataBlockHashIndexKeyExtractor[];
 };
 
 // Create default block based table factory.
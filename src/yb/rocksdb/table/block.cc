@@ -37,6 +37,7 @@
 #include "yb/rocksdb/table/block_internal.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
 #include "yb/rocksdb/table/format.h"
+#include "yb/rocksdb/table.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 
@@ -154,7 +155,9 @@ void BlockIter::Prev() {
 void BlockIter::Initialize(
     const Comparator* comparator, const char* data,
     const KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts,
-    uint32_t num_restarts, BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index) {
+    uint32_t num_restarts, BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index,
+    const DataBlockHashIndex* data_block_hash_index,
+    const DataBlockHashIndexKeyExtractor* data_block_hash_index_key_extractor) {
   DCHECK(data_ == nullptr); // Ensure it is called only once
   DCHECK_GT(num_restarts, 0); // Ensure the param is valid
 
@@ -167,6 +170,8 @@ void BlockIter::Initialize(
   restart_index_ = num_restarts_;
   hash_index_ = hash_index;
   prefix_index_ = prefix_index;
+  data_block_hash_index_ = data_block_hash_index_key_extractor ? data_block_hash_index : nullptr;
+  data_block_hash_index_key_extractor_ = data_block_hash_index_key_extractor;
 }
 
 
@@ -175,6 +180,9 @@ void BlockIter::Seek(const Slice& target) {
   if (data_ == nullptr) {  // Not init yet
     return;
   }
+  if (data_block_hash_index_ && DataBlockHashSeek(target)) {
+    return;
+  }
   uint32_t index = 0;
   bool ok = false;
   if (prefix_index_) {
@@ -477,6 +485,72 @@ bool BlockIter::HashSeek(const Slice& target, uint32_t* index) {
   return BinarySeek(target, left, right, index);
 }
 
+bool BlockIter::HasHashIndexKey(const Slice& key, const Slice& hash_index_key) const {
+  if (key.size() < kLastInternalComponentSize) {
+    return false;
+  }
+  const auto user_key = ExtractUserKey(key);
+  return user_key.starts_with(hash_index_key) &&
+         data_block_hash_index_key_extractor_->Extract(user_key).size() == hash_index_key.size();
+}
+
+bool BlockIter::DataBlockHashSeek(const Slice& target) {
+  if (target.size() < kLastInternalComponentSize) {
+    return false;
+  }
+  const auto hash_index_key = data_block_hash_index_key_extractor_->Extract(
+      ExtractUserKey(target));
+  if (hash_index_key.empty()) {
+    return false;
+  }
+  // Also handles kDataBlockHashIndexNoEntry and kDataBlockHashIndexCollision.
+  const uint32_t restart_index = data_block_hash_index_->Lookup(hash_index_key);
+  if (restart_index >= num_restarts_) {
+    return false;
+  }
+
+  // All keys before the next restart interval are less than target, when its first key is. It
+  // happens when target is a late column or version of a document that spans several restart
+  // intervals, since the document is indexed by its first restart interval. So binary search the
+  // following restart intervals, instead of decoding all the keys of the document one by one.
+  if (restart_index + 1 < num_restarts_ && CompareBlockKey(restart_index + 1, target) < 0) {
+    uint32_t index = 0;
+    if (!BinarySeek(target, restart_index + 1, num_restarts_ - 1, &index)) {
+      // Got corruption error.
+      return true;
+    }
+    SeekToRestartPoint(index);
+    while (ParseNextKey() && Compare(key_.GetKey(), target) < 0) {
+    }
+    return true;
+  }
+
+  // Bucket could also be filled by a different hash index key with the same hash. So the result is
+  // trusted only after we met a key with the same hash index key. In this case the first key that
+  // has it is located in this restart interval, the following ones are reached by the linear scan,
+  // and due to DataBlockHashIndexKeyExtractor requirements keys before this restart interval are
+  // less than target.
+  const uint32_t interval_end =
+      restart_index + 1 < num_restarts_ ? GetRestartPoint(restart_index + 1) : restarts_;
+  SeekToRestartPoint(restart_index);
+  bool seen = false;
+  while (ParseNextKey()) {
+    const auto key = key_.GetKey();
+    if (!seen) {
+      if (current_ >= interval_end) {
+        // Hash index key is not present in the block.
+        return false;
+      }
+      seen = HasHashIndexKey(key, hash_index_key);
+    }
+    if (Compare(key, target) >= 0) {
+      return seen;
+    }
+  }
+  // Reached the end of the block, or got corruption error.
+  return seen || !status_.ok();
+}
+
 bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
   assert(prefix_index_);
   uint32_t* block_ids = nullptr;
@@ -492,7 +566,7 @@ bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
 
 uint32_t Block::NumRestarts() const {
   assert(size_ >= kMinBlockSize);
-  return DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  return DecodeFixed32(data_ + size_ - sizeof(uint32_t)) & ~kDataBlockHashIndexFlag;
 }
 
 Block::Block(BlockContents&& contents)
@@ -501,20 +575,29 @@ Block::Block(BlockContents&& contents)
       size_(contents_.data.size()) {
   if (size_ < sizeof(uint32_t)) {
     size_ = 0;  // Error marker
-  } else {
-    restart_offset_ =
-        static_cast<uint32_t>(size_) - (1 + NumRestarts()) * sizeof(uint32_t);
-    if (restart_offset_ > size_ - sizeof(uint32_t)) {
-      // The size is too small for NumRestarts() and therefore
-      // restart_offset_ wrapped around.
+    return;
+  }
+  size_t restarts_end = size_ - sizeof(uint32_t);
+  if (DecodeFixed32(data_ + restarts_end) & kDataBlockHashIndexFlag) {
+    const auto index_size = data_block_hash_index_.Initialize(data_, restarts_end);
+    if (index_size == 0) {
       size_ = 0;
+      return;
     }
+    restarts_end -= index_size;
   }
+  const size_t restarts_size = static_cast<size_t>(NumRestarts()) * sizeof(uint32_t);
+  if (restarts_size > restarts_end) {
+    // The size is too small for NumRestarts().
+    size_ = 0;
+    return;
+  }
+  restart_offset_ = static_cast<uint32_t>(restarts_end - restarts_size);
 }
 
 InternalIterator* Block::NewIterator(
     const Comparator* cmp, const KeyValueEncodingFormat key_value_encoding_format, BlockIter* iter,
-    bool total_order_seek) {
+    bool total_order_seek, const DataBlockHashIndexKeyExtractor* hash_index_key_extractor) {
   if (size_ < kMinBlockSize) {
     if (iter != nullptr) {
       iter->SetStatus(BadBlockContentsError());
@@ -536,13 +619,17 @@ InternalIterator* Block::NewIterator(
         total_order_seek ? nullptr : hash_index_.get();
     BlockPrefixIndex* prefix_index_ptr =
         total_order_seek ? nullptr : prefix_index_.get();
+    const DataBlockHashIndex* data_block_hash_index_ptr =
+        data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr;
 
     if (iter != nullptr) {
       iter->Initialize(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
-                    hash_index_ptr, prefix_index_ptr);
+                    hash_index_ptr, prefix_index_ptr, data_block_hash_index_ptr,
+                    hash_index_key_extractor);
     } else {
       iter = new BlockIter(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
-                           hash_index_ptr, prefix_index_ptr);
+                           hash_index_ptr, prefix_index_ptr, data_block_hash_index_ptr,
+                           hash_index_key_extractor);
     }
   }
 
@@ -576,8 +663,29 @@ yb::Result<Slice> Block::GetMiddleKey(
     return STATUS(Incomplete, "Empty block");
   }
 
-  const auto restart_idx = (NumRestarts() - 1) / 2;
+  return GetRestartKey(key_value_encoding_format, (NumRestarts() - 1) / 2);
+}
+
+yb::Result<std::vector<Slice>> Block::GetSampleKeys(
+    const KeyValueEncodingFormat key_value_encoding_format, const size_t max_keys) const {
+  if (size_ < kMinBlockSize) {
+    return BadBlockContentsError();
+  }
+
+  std::vector<Slice> result;
+  const size_t num_restarts = size_ == kMinBlockSize ? 0 : NumRestarts();
+  const size_t num_keys = std::min(max_keys, num_restarts);
+  result.reserve(num_keys);
+  for (size_t i = 0; i != num_keys; ++i) {
+    // Take the middle restart of each of num_keys equal parts of the block.
+    const auto restart_idx = static_cast<uint32_t>((2 * i + 1) * num_restarts / (2 * num_keys));
+    result.push_back(VERIFY_RESULT(GetRestartKey(key_value_encoding_format, restart_idx)));
+  }
+  return result;
+}
 
+yb::Result<Slice> Block::GetRestartKey(
+    const KeyValueEncodingFormat key_value_encoding_format, const uint32_t restart_idx) const {
   const auto entry_offset = DecodeFixed32(data_ + restart_offset_ + restart_idx * sizeof(uint32_t));
   uint32_t key_size;
   const char* key_ptr = DecodeRestartEntry(
@@ -30,11 +30,14 @@
 #include <malloc.h>
 #endif
 
+#include <vector>
+
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
 #include "yb/rocksdb/table/block_hash_index.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/internal_iterator.h"
 
@@ -83,10 +86,16 @@ class Block {
   // This option only applies for index block. For data block, hash_index_
   // and prefix_index_ are null, so this option does not matter.
   // key_value_encoding_format specifies what kind of algorithm to use for decoding entries.
+  //
+  // If hash_index_key_extractor is specified and the block contains data block hash index, it is
+  // used by Seek, see DataBlockHashIndex. The extractor should be the same that was used to build
+  // the block.
   InternalIterator* NewIterator(const Comparator* comparator,
                                 KeyValueEncodingFormat key_value_encoding_format,
                                 BlockIter* iter = nullptr,
-                                bool total_order_seek = true);
+                                bool total_order_seek = true,
+                                const DataBlockHashIndexKeyExtractor* hash_index_key_extractor =
+                                    nullptr);
 
   inline InternalIterator* NewIndexIterator(
       const Comparator* comparator, BlockIter* iter = nullptr, bool total_order_seek = true) {
@@ -104,13 +113,21 @@ class Block {
   // points description).
   yb::Result<Slice> GetMiddleKey(KeyValueEncodingFormat key_value_encoding_format) const;
 
+  // Returns up to max_keys restart keys evenly distributed over this block.
+  yb::Result<std::vector<Slice>> GetSampleKeys(
+      KeyValueEncodingFormat key_value_encoding_format, size_t max_keys) const;
+
  private:
+  yb::Result<Slice> GetRestartKey(
+      KeyValueEncodingFormat key_value_encoding_format, uint32_t restart_idx) const;
+
   BlockContents contents_;
   const char* data_;            // contents_.data.data()
   size_t size_;                 // contents_.data.size()
   uint32_t restart_offset_;     // Offset in data_ of restart array
   std::unique_ptr<BlockHashIndex> hash_index_;
   std::unique_ptr<BlockPrefixIndex> prefix_index_;
+  DataBlockHashIndex data_block_hash_index_;
 
   // No copying allowed
   Block(const Block&);
@@ -133,17 +150,21 @@ class BlockIter : public InternalIterator {
   BlockIter(
       const Comparator* comparator, const char* data,
       KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts, uint32_t num_restarts,
-      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index)
+      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index,
+      const DataBlockHashIndex* data_block_hash_index = nullptr,
+      const DataBlockHashIndexKeyExtractor* data_block_hash_index_key_extractor = nullptr)
       : BlockIter() {
     Initialize(
         comparator, data, key_value_encoding_format, restarts, num_restarts, hash_index,
-        prefix_index);
+        prefix_index, data_block_hash_index, data_block_hash_index_key_extractor);
   }
 
   void Initialize(
       const Comparator* comparator, const char* data,
       KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts, uint32_t num_restarts,
-      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index);
+      BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index,
+      const DataBlockHashIndex* data_block_hash_index = nullptr,
+      const DataBlockHashIndexKeyExtractor* data_block_hash_index_key_extractor = nullptr);
 
   void SetStatus(Status s) {
     status_ = s;
@@ -197,6 +218,8 @@ class BlockIter : public InternalIterator {
   Status status_;
   BlockHashIndex* hash_index_;
   BlockPrefixIndex* prefix_index_;
+  const DataBlockHashIndex* data_block_hash_index_ = nullptr;
+  const DataBlockHashIndexKeyExtractor* data_block_hash_index_key_extractor_ = nullptr;
 
   inline int Compare(const Slice& a, const Slice& b) const {
     return comparator_->Compare(a, b);
@@ -241,6 +264,13 @@ class BlockIter : public InternalIterator {
 
   bool PrefixSeek(const Slice& target, uint32_t* index);
 
+  // Tries to seek using data block hash index. Returns false if hash index could not be used for
+  // the target, so regular seek should be performed.
+  bool DataBlockHashSeek(const Slice& target);
+
+  // Returns true if the block key has the specified hash index key.
+  bool HasHashIndexKey(const Slice& key, const Slice& hash_index_key) const;
+
 };
 
 }  // namespace rocksdb
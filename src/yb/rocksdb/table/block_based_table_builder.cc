@@ -49,6 +49,7 @@
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_builder.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/table/filter_block.h"
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/table/format.h"
@@ -101,6 +102,18 @@ FilterBlockBuilder* CreateFilterBlockBuilder(const ImmutableCFOptions& opt,
   return nullptr;
 }
 
+// Returns extractor for data block hash index, or nullptr if data blocks are built without it.
+const DataBlockHashIndexKeyExtractor* GetDataBlockHashIndexKeyExtractor(
+    const BlockBasedTableOptions& table_opt, const InternalKeyComparator& icomparator) {
+  if (table_opt.data_block_index_type != DataBlockIndexType::kBinarySearchAndHash ||
+      icomparator.user_comparator() != BytewiseComparator()) {
+    return nullptr;
+  }
+  return table_opt.data_block_hash_index_key_extractor
+      ? table_opt.data_block_hash_index_key_extractor.get()
+      : &WholeUserKeyHashIndexKeyExtractor();
+}
+
 bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
   // Check to see if compressed less than 12.5%
   return compressed_size < raw_size - (raw_size / 8u);
@@ -110,7 +123,8 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
-                    std::string* compressed_output) {
+                    std::string* compressed_output,
+                    const ZSTDCompressionDict* compression_dict = nullptr) {
   if (*type == kNoCompression) {
     return raw;
   }
@@ -163,7 +177,7 @@ Slice CompressBlock(const Slice& raw,
       break;     // fall back to no compression.
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -278,6 +292,7 @@ struct BlockBasedTableBuilder::Rep {
 
   FilterType filter_type;
   std::unique_ptr<FilterBlockBuilder> filter_block_builder;
+  const DataBlockHashIndexKeyExtractor* const data_block_hash_index_key_extractor;
   BlockBuilder data_block_builder;
 
   InternalKeySliceTransform internal_prefix_transform;
@@ -301,9 +316,19 @@ struct BlockBasedTableBuilder::Rep {
   std::string compressed_output;
   std::unique_ptr<FlushBlockPolicy> flush_block_policy;
 
+  // Zstd dictionary compression of data blocks, see CompressionOptions::max_dict_bytes.
+  // Raw data blocks are sampled until there is enough data to train the dictionary.
+  bool sample_for_compression_dict;
+  std::string compression_dict_samples;
+  std::vector<size_t> compression_dict_sample_lens;
+  std::string compression_dict;
+  std::unique_ptr<ZSTDCompressionDict> zstd_compression_dict;
+
   std::vector<std::unique_ptr<IntTblPropCollector>> table_properties_collectors;
 
   yb::MemTrackerPtr mem_tracker;
+  // Memory used by compression dictionary samples and the trained dictionary.
+  yb::ScopedTrackedConsumption compression_dict_consumption;
 
   bool TEST_skip_writing_key_value_encoding_format_ = false;
 
@@ -340,6 +365,11 @@ Status BlockBasedTableBuilder::BlockBasedTablePropertiesCollector::Finish(
     PutFixed8(&val, static_cast<uint8_t>(key_value_encoding_format_));
     properties->emplace(BlockBasedTablePropertyNames::kDataBlockKeyValueEncodingFormat, val);
   }
+  if (rep_->data_block_hash_index_key_extractor) {
+    properties->emplace(
+        BlockBasedTablePropertyNames::kDataBlockHashIndexKeyExtractor,
+        rep_->data_block_hash_index_key_extractor->Name());
+  }
   return Status::OK();
 }
 
@@ -360,9 +390,12 @@ BlockBasedTableBuilder::Rep::Rep(
       filter_type(GetFilterType(table_options)),
       filter_block_builder(skip_filters ? nullptr : CreateFilterBlockBuilder(
           _ioptions, table_options, filter_type)),
+      data_block_hash_index_key_extractor(
+          GetDataBlockHashIndexKeyExtractor(table_options, *icomparator)),
       data_block_builder(
           table_options.block_restart_interval,
-          table_options.data_block_key_value_encoding_format, table_options.use_delta_encoding),
+          table_options.data_block_key_value_encoding_format, table_options.use_delta_encoding,
+          data_block_hash_index_key_extractor, table_options.data_block_hash_table_util_ratio),
       internal_prefix_transform(_ioptions.prefix_extractor),
       filter_key_transformer(table_opt.filter_policy ?
           table_opt.filter_policy->GetKeyTransformer() : nullptr),
@@ -380,10 +413,15 @@ BlockBasedTableBuilder::Rep::Rep(
       compression_opts(_compression_opts),
       flush_block_policy(
           table_options.flush_block_policy_factory->NewFlushBlockPolicy(
-              table_options, data_block_builder)) {
+              table_options, data_block_builder)),
+      sample_for_compression_dict(
+          _compression_type == kZSTDNotFinalCompression && _compression_opts.max_dict_bytes > 0) {
   if (_ioptions.mem_tracker) {
     mem_tracker = yb::MemTracker::FindOrCreateTracker(
         "BlockBasedTableBuilder", _ioptions.mem_tracker);
+    if (sample_for_compression_dict) {
+      compression_dict_consumption = yb::ScopedTrackedConsumption(mem_tracker, 0);
+    }
   }
 
   metadata_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
@@ -501,8 +539,13 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   size_t data_block_size = 0;
 
   if (!r->data_block_builder.empty()) {
-    data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+    const Slice raw_block_contents = r->data_block_builder.Finish();
+    if (r->sample_for_compression_dict) {
+      SampleForCompressionDict(raw_block_contents);
+    }
+    data_block_size = WriteBlock(raw_block_contents, &r->data_pending_handle,
+        r->data_writer.get(), r->zstd_compression_dict.get());
+    r->data_block_builder.Reset();
   }
   if (!ok()) return;
 
@@ -581,9 +624,42 @@ size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
   return block_size;
 }
 
+void BlockBasedTableBuilder::SampleForCompressionDict(const Slice& raw_block_contents) {
+  // Train dictionary on about 100 times its size of samples, as recommended by zstd.
+  constexpr size_t kSamplesToDictRatio = 100;
+
+  Rep* r = rep_;
+  r->compression_dict_samples.append(raw_block_contents.cdata(), raw_block_contents.size());
+  r->compression_dict_sample_lens.push_back(raw_block_contents.size());
+  if (r->compression_dict_consumption) {
+    r->compression_dict_consumption.Reset(
+        r->compression_dict_samples.capacity() +
+        r->compression_dict_sample_lens.capacity() * sizeof(size_t));
+  }
+  if (r->compression_dict_samples.size() <
+          kSamplesToDictRatio * r->compression_opts.max_dict_bytes) {
+    return;
+  }
+
+  r->sample_for_compression_dict = false;
+  r->compression_dict = ZSTD_TrainDictionary(
+      r->compression_dict_samples, r->compression_dict_sample_lens,
+      r->compression_opts.max_dict_bytes);
+  if (!r->compression_dict.empty()) {
+    r->zstd_compression_dict = std::make_unique<ZSTDCompressionDict>(
+        r->compression_dict, r->compression_opts);
+  }
+  std::string().swap(r->compression_dict_samples);
+  std::vector<size_t>().swap(r->compression_dict_sample_lens);
+  if (r->compression_dict_consumption) {
+    r->compression_dict_consumption.Reset(r->compression_dict.size());
+  }
+}
+
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
     BlockHandle* handle,
-    FileWriterWithOffsetAndCachePrefix* writer_info) {
+    FileWriterWithOffsetAndCachePrefix* writer_info,
+    const ZSTDCompressionDict* compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -596,7 +672,8 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, &r->compressed_output,
+                      compression_dict);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -733,8 +810,9 @@ Status BlockBasedTableBuilder::Finish() {
   // Write meta blocks and metaindex block with the following order.
   //    1. [meta block: filter]
   //    2. [other meta blocks]
-  //    3. [meta block: properties]
-  //    4. [metaindex block]
+  //    3. [meta block: compression dictionary]
+  //    4. [meta block: properties]
+  //    5. [metaindex block]
   // write meta blocks
   MetaIndexBuilder meta_index_builder;
   for (const auto& item : r->data_index_blocks.meta_blocks) {
@@ -781,6 +859,16 @@ Status BlockBasedTableBuilder::Finish() {
       }
     }
 
+    // Write compression dictionary block, data blocks are already compressed with it.
+    if (!r->compression_dict.empty()) {
+      BlockHandle compression_dict_block_handle;
+      WriteRawBlock(
+          r->compression_dict, kNoCompression, &compression_dict_block_handle,
+          r->metadata_writer.get());
+      meta_index_builder.Add(
+          block_based_table::kCompressionDictBlock, compression_dict_block_handle);
+    }
+
     // Write properties block.
     {
       PropertyBlockBuilder property_block_builder;
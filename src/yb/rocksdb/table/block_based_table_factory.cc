@@ -217,6 +217,8 @@ const char BlockBasedTablePropertyNames::kPrefixFiltering[] =
     "rocksdb.block.based.table.prefix.filtering";
 const char BlockBasedTablePropertyNames::kDataBlockKeyValueEncodingFormat[] =
     "rocksdb.block.based.table.data.block.key.value.encoding.format";
+const char BlockBasedTablePropertyNames::kDataBlockHashIndexKeyExtractor[] =
+    "rocksdb.block.based.table.data.block.hash.index.key.extractor";
 const char kHashIndexPrefixesBlock[] = "rocksdb.hashindex.prefixes";
 const char kHashIndexPrefixesMetadataBlock[] =
     "rocksdb.hashindex.metadata";
@@ -43,6 +43,7 @@
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_hash_index.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/table/filter_block.h"
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/table/format.h"
@@ -55,6 +56,7 @@
 #include "yb/rocksdb/table/two_level_iterator.h"
 #include "yb/rocksdb/table_properties.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/statistics.h"
@@ -234,6 +236,8 @@ struct BlockBasedTable::Rep {
   bool prefix_filtering = false;
   KeyValueEncodingFormat data_block_key_value_encoding_format =
       KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
+  // Set when data blocks could contain hash index, that was built using this extractor.
+  const DataBlockHashIndexKeyExtractor* data_block_hash_index_key_extractor = nullptr;
   // TODO(kailiu) It is very ugly to use internal key in table, since table
   // module should not be relying on db module. However to make things easier
   // and compatible with existing code, we introduce a wrapper that allows
@@ -242,6 +246,9 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+
+  // Zstd dictionary used to compress data blocks, nullptr if the file has no dictionary.
+  std::unique_ptr<ZSTDUncompressionDict> compression_dict;
 };
 
 // BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
@@ -425,6 +432,8 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->ReadPropertiesBlock(meta_iter.get()));
 
+  RETURN_NOT_OK(new_table->ReadCompressionDictBlock(meta_iter.get()));
+
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
@@ -567,11 +576,47 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
       rep_->data_block_key_value_encoding_format =
           static_cast<KeyValueEncodingFormat>(DecodeFixed8(it->second.c_str()));
     }
+    it = props.find(BlockBasedTablePropertyNames::kDataBlockHashIndexKeyExtractor);
+    if (it != props.end()) {
+      const auto* extractor = rep_->table_options.data_block_hash_index_key_extractor
+          ? rep_->table_options.data_block_hash_index_key_extractor.get()
+          : &WholeUserKeyHashIndexKeyExtractor();
+      if (it->second == extractor->Name()) {
+        rep_->data_block_hash_index_key_extractor = extractor;
+      } else {
+        RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+            "Data block hash index key extractor %s does not match configured %s, "
+            "hash index is not used", it->second.c_str(), extractor->Name());
+      }
+    }
   }
 
   return Status::OK();
 }
 
+Status BlockBasedTable::ReadCompressionDictBlock(InternalIterator* meta_iter) {
+  BlockHandle handle;
+  if (!FindMetaBlock(meta_iter, block_based_table::kCompressionDictBlock, &handle).ok()) {
+    // File was written without compression dictionary.
+    return Status::OK();
+  }
+
+  BlockContents contents;
+  auto s = ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      handle, &contents, rep_->ioptions.env, rep_->mem_tracker,
+      /* do_uncompress = */ false);
+  if (!s.ok()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, rep_->ioptions.info_log,
+        "Encountered error while reading compression dictionary block %s",
+        s.ToString().c_str());
+    return s;
+  }
+  // ZSTDUncompressionDict keeps its own copy of the dictionary.
+  rep_->compression_dict = std::make_unique<ZSTDUncompressionDict>(contents.data);
+  return Status::OK();
+}
+
 Status BlockBasedTable::SetupFilter(InternalIterator* meta_iter) {
   // Find filter handle and filter type.
   if (!rep_->filter_policy) {
@@ -758,7 +803,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const ZSTDUncompressionDict* compression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -802,7 +848,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, compression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -830,7 +876,8 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const ZSTDUncompressionDict* compression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -839,7 +886,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, compression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -1211,7 +1258,8 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker,
+        rep_->compression_dict.get());
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1219,13 +1267,14 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr, rep_->compression_dict.get());
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                rep_->compression_dict.get());
       }
     }
   }
@@ -1244,7 +1293,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, /* do_uncompress = */ true, rep_->compression_dict.get());
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1253,7 +1302,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   InternalIterator* iter;
   if (s.ok() && block.value != nullptr) {
     iter = block.value->NewIterator(
-        rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter);
+        rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter,
+        /* total_order_seek = */ true,
+        block_type == BlockType::kData ? rep_->data_block_hash_index_key_extractor : nullptr);
     if (block.cache_handle != nullptr) {
       iter->RegisterCleanup(&ReleaseCachedEntry, block_cache,
           block.cache_handle);
@@ -1554,7 +1605,8 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
   Slice ckey;
 
   s = GetDataBlockFromCache(cache_key, ckey, block_cache, nullptr, nullptr, options, &block,
-      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker,
+      rep_->compression_dict.get());
   assert(s.ok());
   bool in_cache = block.value != nullptr;
   if (in_cache) {
@@ -1935,4 +1987,32 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
   return iter->key().ToBuffer();
 }
 
+yb::Result<std::vector<std::string>> BlockBasedTable::GetSampleKeys(size_t max_keys) {
+  auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
+
+  // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
+  auto se = yb::ScopeExit([this, &index_reader] {
+    index_reader.Release(rep_->table_options.block_cache.get());
+  });
+
+  const auto index_keys = VERIFY_RESULT(index_reader.value->GetSampleKeys(max_keys));
+  std::unique_ptr<InternalIterator> iter(
+      NewIterator(ReadOptions::kDefault, nullptr, /* skip_filters =*/ true));
+  std::vector<std::string> result;
+  result.reserve(index_keys.size());
+  // Index keys could be shortened, so use the first key actually present in SST after each of them.
+  for (const auto& index_key : index_keys) {
+    iter->Seek(index_key);
+    if (!iter->Valid()) {
+      break;
+    }
+    auto user_key = ExtractUserKey(iter->key());
+    if (result.empty() || user_key != Slice(result.back())) {
+      result.push_back(user_key.ToBuffer());
+    }
+  }
+  RETURN_NOT_OK(iter->status());
+  return result;
+}
+
 }  // namespace rocksdb
@@ -53,6 +53,7 @@ class Iterator;
 class TableCache;
 class TableReader;
 class WritableFile;
+class ZSTDUncompressionDict;
 struct BlockBasedTableOptions;
 struct EnvOptions;
 struct ReadOptions;
@@ -188,6 +189,8 @@ class BlockBasedTable : public TableReader {
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) override;
+
   ~BlockBasedTable();
 
   bool TEST_filter_block_preloaded() const;
@@ -251,7 +254,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const ZSTDUncompressionDict* compression_dict = nullptr);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -266,7 +270,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const ZSTDUncompressionDict* compression_dict = nullptr);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -289,6 +294,9 @@ class BlockBasedTable : public TableReader {
 
   CHECKED_STATUS ReadPropertiesBlock(InternalIterator* meta_iter);
 
+  // Load zstd dictionary used to compress data blocks, if the file has one.
+  CHECKED_STATUS ReadCompressionDictBlock(InternalIterator* meta_iter);
+
   CHECKED_STATUS SetupFilter(InternalIterator* meta_iter);
 
   // Read the meta block from sst.
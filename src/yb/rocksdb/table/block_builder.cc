@@ -44,6 +44,8 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+// Data block could also contain hash index between restarts and num_restarts, see
+// DataBlockHashIndex.
 
 #include "yb/rocksdb/table/block_builder.h"
 
@@ -53,6 +55,7 @@
 
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/block_builder_internal.h"
 #include "yb/rocksdb/util/coding.h"
 
@@ -62,13 +65,16 @@ namespace rocksdb {
 
 BlockBuilder::BlockBuilder(
     int block_restart_interval, const KeyValueEncodingFormat key_value_encoding_format,
-    const bool use_delta_encoding)
+    const bool use_delta_encoding, const DataBlockHashIndexKeyExtractor* hash_index_key_extractor,
+    double hash_table_util_ratio)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       key_value_encoding_format_(key_value_encoding_format),
       restarts_(),
       counter_(0),
-      finished_(false) {
+      finished_(false),
+      hash_index_key_extractor_(hash_index_key_extractor),
+      hash_index_builder_(hash_table_util_ratio) {
   assert(block_restart_interval_ >= 1);
   restarts_.push_back(0);       // First restart point is at offset 0
 }
@@ -80,6 +86,7 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  hash_index_builder_.Reset();
 }
 
 size_t BlockBuilder::CurrentSizeEstimate() const {
@@ -88,6 +95,9 @@ size_t BlockBuilder::CurrentSizeEstimate() const {
     // Restarts haven't been flushed to buffer yet.
     size += restarts_.size() * sizeof(uint32_t) +    // Restart array.
             sizeof(uint32_t);                        // Restart array length.
+    if (hash_index_key_extractor_) {
+      size += hash_index_builder_.EstimateSize();
+    }
   }
   return size;
 }
@@ -335,7 +345,12 @@ Slice BlockBuilder::Finish() {
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
-  PutFixed32(&buffer_, static_cast<uint32_t>(restarts_.size()));
+  auto num_restarts = static_cast<uint32_t>(restarts_.size());
+  if (hash_index_key_extractor_ && hash_index_builder_.Valid() && counter_ != 0) {
+    hash_index_builder_.Finish(&buffer_);
+    num_restarts |= kDataBlockHashIndexFlag;
+  }
+  PutFixed32(&buffer_, num_restarts);
   finished_ = true;
   return Slice(buffer_);
 }
@@ -405,6 +420,16 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
 
   assert(Slice(last_key_) == key);
   counter_++;
+
+  if (hash_index_key_extractor_ && hash_index_builder_.Valid()) {
+    auto hash_index_key = key.size() >= kLastInternalComponentSize
+        ? hash_index_key_extractor_->Extract(ExtractUserKey(key)) : Slice();
+    if (hash_index_key.empty()) {
+      hash_index_builder_.Invalidate();
+    } else {
+      hash_index_builder_.Add(hash_index_key, restarts_.size() - 1);
+    }
+  }
 }
 
 }  // namespace rocksdb
@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <vector>
 
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/types.h"
 
 #include "yb/util/slice.h"
@@ -38,9 +39,13 @@ class BlockBuilder {
   BlockBuilder(const BlockBuilder&) = delete;
   void operator=(const BlockBuilder&) = delete;
 
+  // When hash_index_key_extractor is specified, block keys are treated as internal keys and
+  // data block hash index is built for them, see DataBlockHashIndex.
   explicit BlockBuilder(int block_restart_interval,
                         KeyValueEncodingFormat key_value_encoding_format,
-                        bool use_delta_encoding = true);
+                        bool use_delta_encoding = true,
+                        const DataBlockHashIndexKeyExtractor* hash_index_key_extractor = nullptr,
+                        double hash_table_util_ratio = 0.75);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -78,6 +83,9 @@ class BlockBuilder {
   int                   counter_;   // Number of entries emitted since restart
   bool                  finished_;  // Has Finish() been called?
   std::string           last_key_;
+
+  const DataBlockHashIndexKeyExtractor* const hash_index_key_extractor_;
+  DataBlockHashIndexBuilder hash_index_builder_;
 };
 
 }  // namespace rocksdb
@@ -29,14 +29,17 @@
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/slice_transform.h"
+#include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/block.h"
 #include "yb/rocksdb/table/block_builder.h"
 #include "yb/rocksdb/table/block_builder_internal.h"
 #include "yb/rocksdb/table/block_hash_index.h"
 #include "yb/rocksdb/table/block_internal.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/util/random.h"
 #include "yb/rocksdb/util/testutil.h"
 
+#include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_macros.h"
@@ -436,6 +439,159 @@ TEST_F(BlockTest, GetMiddleKey) {
   }
 }
 
+TEST_F(BlockTest, GetSampleKeys) {
+  const auto block_restart_interval = 1;
+  const auto kNumKeys = 100;
+
+  for (auto key_value_encoding_format : kKeyValueEncodingFormatList) {
+    BlockBuilder builder(block_restart_interval, key_value_encoding_format);
+    for (int i = 1; i <= kNumKeys; ++i) {
+      const auto padded_num = GetPaddedNum(i);
+      builder.Add("k" + padded_num, "v" + padded_num);
+    }
+    BlockContents contents;
+    contents.data = builder.Finish();
+    contents.cachable = false;
+    Block reader(std::move(contents));
+
+    const auto keys = ASSERT_RESULT(reader.GetSampleKeys(key_value_encoding_format, 4));
+    ASSERT_EQ(keys.size(), 4U);
+    int idx = 0;
+    for (const auto expected_key : {13, 38, 63, 88}) {
+      ASSERT_EQ(keys[idx++].ToString(), "k" + GetPaddedNum(expected_key));
+    }
+
+    const auto all_keys = ASSERT_RESULT(reader.GetSampleKeys(key_value_encoding_format, 1000));
+    ASSERT_EQ(all_keys.size(), static_cast<size_t>(kNumKeys));
+  }
+}
+
+namespace {
+
+// Uses primary key part generated by GenerateKey as hash index key.
+class PrimaryKeyHashIndexKeyExtractor : public DataBlockHashIndexKeyExtractor {
+ public:
+  const char* Name() const override { return "PrimaryKey"; }
+
+  Slice Extract(Slice user_key) const override {
+    constexpr size_t kPrimaryKeySize = 6;
+    return user_key.size() >= kPrimaryKeySize ? Slice(user_key.data(), kPrimaryKeySize) : Slice();
+  }
+};
+
+} // namespace
+
+TEST_F(BlockTest, DataBlockHashIndex) {
+  constexpr int kNumPrimaryKeys = 200;
+  constexpr int kKeysSharePrefix = 3;
+  constexpr SequenceNumber kSeqNo = 100;
+
+  InternalKeyComparator comparator(BytewiseComparator());
+  PrimaryKeyHashIndexKeyExtractor primary_key_extractor;
+  Random rnd(301);
+
+  std::vector<std::string> user_keys;
+  std::vector<std::string> values;
+  // Only even primary keys are present in the block.
+  GenerateRandomKVs(
+      &user_keys, &values, 0, kNumPrimaryKeys, /* step = */ 2, /* padding_size = */ 0,
+      kKeysSharePrefix);
+
+  for (auto key_value_encoding_format : kKeyValueEncodingFormatList) {
+    for (const DataBlockHashIndexKeyExtractor* extractor :
+         {&WholeUserKeyHashIndexKeyExtractor(),
+          static_cast<const DataBlockHashIndexKeyExtractor*>(&primary_key_extractor)}) {
+      for (int restart_interval : {1, 2, 16}) {
+        SCOPED_TRACE(yb::Format(
+            "Format: $0, extractor: $1, restart interval: $2", key_value_encoding_format,
+            extractor->Name(), restart_interval));
+        BlockBuilder plain_builder(restart_interval, key_value_encoding_format);
+        BlockBuilder hash_builder(
+            restart_interval, key_value_encoding_format, /* use_delta_encoding = */ true,
+            extractor);
+        for (size_t i = 0; i != user_keys.size(); ++i) {
+          const auto key = InternalKey(user_keys[i], kSeqNo, kTypeValue).Encode();
+          plain_builder.Add(key, values[i]);
+          hash_builder.Add(key, values[i]);
+        }
+
+        BlockContents plain_contents;
+        plain_contents.data = plain_builder.Finish();
+        plain_contents.cachable = false;
+        Block plain_block(std::move(plain_contents));
+
+        BlockContents hash_contents;
+        hash_contents.data = hash_builder.Finish();
+        hash_contents.cachable = false;
+        const bool has_hash_index =
+            DecodeFixed32(hash_contents.data.cend() - sizeof(uint32_t)) & kDataBlockHashIndexFlag;
+        Block hash_block(std::move(hash_contents));
+        ASSERT_EQ(plain_block.NumRestarts(), hash_block.NumRestarts());
+        // Index is not built when there are too many restart intervals.
+        ASSERT_EQ(has_hash_index, hash_block.NumRestarts() <= kDataBlockHashIndexMaxRestart + 1U);
+
+        std::unique_ptr<InternalIterator> plain_iter(
+            plain_block.NewIterator(&comparator, key_value_encoding_format));
+        std::unique_ptr<InternalIterator> hash_iter(hash_block.NewIterator(
+            &comparator, key_value_encoding_format, /* iter = */ nullptr,
+            /* total_order_seek = */ true, extractor));
+
+        // Seek to present and missing keys, before and after present versions of the key.
+        for (int primary_key = -1; primary_key <= kNumPrimaryKeys; ++primary_key) {
+          for (int secondary_key = 0; secondary_key <= kKeysSharePrefix; ++secondary_key) {
+            const auto user_key = GenerateKey(primary_key, secondary_key, 0, &rnd);
+            for (auto seq_no : {kMaxSequenceNumber, kSeqNo, kSeqNo - 1}) {
+              const auto target = InternalKey(user_key, seq_no, kTypeValue).Encode();
+              plain_iter->Seek(target);
+              hash_iter->Seek(target);
+              ASSERT_OK(hash_iter->status());
+              ASSERT_EQ(plain_iter->Valid(), hash_iter->Valid()) << user_key << ", " << seq_no;
+              if (plain_iter->Valid()) {
+                ASSERT_EQ(plain_iter->key(), hash_iter->key()) << user_key << ", " << seq_no;
+                ASSERT_EQ(plain_iter->value(), hash_iter->value());
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Keys with the same hash index key that span several restart intervals should be mapped to the
+// first of them, instead of being treated as a collision.
+TEST_F(BlockTest, DataBlockHashIndexKeySpanningRestarts) {
+  DataBlockHashIndexBuilder builder(/* util_ratio = */ 0.5);
+  std::string buffer;
+  DataBlockHashIndex index;
+
+  builder.Add("a", 0);
+  builder.Add("a", 1);
+  builder.Add("a", 2);
+  ASSERT_TRUE(builder.Valid());
+  builder.Finish(&buffer);
+  ASSERT_EQ(index.Initialize(buffer.data(), buffer.size()), buffer.size());
+  ASSERT_EQ(index.Lookup("a"), 0);
+
+  builder.Reset();
+  buffer.clear();
+  builder.Add("a", 1);
+  builder.Add("a", 2);
+  builder.Add("b", 2);
+  builder.Add("c", 3);
+  builder.Add("c", 4);
+  builder.Finish(&buffer);
+  ASSERT_EQ(index.Initialize(buffer.data(), buffer.size()), buffer.size());
+  for (const auto& key_and_restart : std::vector<std::pair<std::string, uint8_t>>{
+           {"a", 1}, {"b", 2}, {"c", 3}}) {
+    const auto restart = index.Lookup(key_and_restart.first);
+    // Different keys could still fall into the same bucket.
+    if (restart != kDataBlockHashIndexCollision) {
+      ASSERT_EQ(restart, key_and_restart.second) << key_and_restart.first;
+    }
+  }
+}
+
 TEST_F(BlockTest, EncodeThreeSharedPartsSizes) {
   constexpr auto kNumIters = 100000;
 
@@ -0,0 +1,123 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include "yb/rocksdb/table/data_block_hash_index.h"
+
+#include <algorithm>
+
+#include "yb/rocksdb/table.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Bucket count is stored as uint32, but there is no reason to have more buckets than keys in block.
+constexpr size_t kMaxBuckets = 1u << 16;
+
+class WholeUserKeyExtractor : public DataBlockHashIndexKeyExtractor {
+ public:
+  const char* Name() const override { return "rocksdb.WholeUserKey"; }
+
+  Slice Extract(Slice user_key) const override { return user_key; }
+};
+
+} // namespace
+
+const DataBlockHashIndexKeyExtractor& WholeUserKeyHashIndexKeyExtractor() {
+  static const WholeUserKeyExtractor instance;
+  return instance;
+}
+
+DataBlockHashIndexBuilder::DataBlockHashIndexBuilder(double util_ratio)
+    : util_ratio_(util_ratio > 0 ? util_ratio : 0.75) {
+}
+
+void DataBlockHashIndexBuilder::Add(const Slice& hash_index_key, size_t restart_index) {
+  if (!valid_) {
+    return;
+  }
+  if (restart_index > kDataBlockHashIndexMaxRestart) {
+    valid_ = false;
+    entries_.clear();
+    return;
+  }
+  // Keys with the same hash index key are adjacent, so the restart interval of the first of them
+  // is enough to find any of them.
+  if (!entries_.empty() && hash_index_key == last_hash_index_key_) {
+    return;
+  }
+  last_hash_index_key_.assign(hash_index_key.cdata(), hash_index_key.size());
+  const auto hash = GetSliceHash(hash_index_key);
+  const auto restart = static_cast<uint8_t>(restart_index);
+  if (!entries_.empty() && entries_.back().first == hash && entries_.back().second == restart) {
+    return;
+  }
+  entries_.emplace_back(hash, restart);
+}
+
+size_t DataBlockHashIndexBuilder::NumBuckets() const {
+  auto result = static_cast<size_t>(entries_.size() / util_ratio_);
+  // Odd number of buckets distributes hashes better.
+  return std::min(result | 1, kMaxBuckets - 1);
+}
+
+size_t DataBlockHashIndexBuilder::EstimateSize() const {
+  return valid_ ? NumBuckets() + sizeof(uint32_t) : 0;
+}
+
+void DataBlockHashIndexBuilder::Finish(std::string* buffer) {
+  const auto num_buckets = NumBuckets();
+  std::vector<uint8_t> buckets(num_buckets, kDataBlockHashIndexNoEntry);
+  for (const auto& entry : entries_) {
+    auto& bucket = buckets[entry.first % num_buckets];
+    if (bucket == kDataBlockHashIndexNoEntry) {
+      bucket = entry.second;
+    } else if (bucket != entry.second) {
+      bucket = kDataBlockHashIndexCollision;
+    }
+  }
+  buffer->append(reinterpret_cast<const char*>(buckets.data()), buckets.size());
+  PutFixed32(buffer, static_cast<uint32_t>(num_buckets));
+}
+
+void DataBlockHashIndexBuilder::Reset() {
+  valid_ = true;
+  entries_.clear();
+  last_hash_index_key_.clear();
+}
+
+size_t DataBlockHashIndex::Initialize(const char* data, size_t size) {
+  num_buckets_ = 0;
+  buckets_ = nullptr;
+  if (size < sizeof(uint32_t)) {
+    return 0;
+  }
+  const auto num_buckets = DecodeFixed32(data + size - sizeof(uint32_t));
+  const size_t index_size = num_buckets + sizeof(uint32_t);
+  if (num_buckets == 0 || index_size > size) {
+    return 0;
+  }
+  num_buckets_ = num_buckets;
+  buckets_ = reinterpret_cast<const uint8_t*>(data + size - index_size);
+  return index_size;
+}
+
+uint8_t DataBlockHashIndex::Lookup(const Slice& hash_index_key) const {
+  return buckets_[GetSliceHash(hash_index_key) % num_buckets_];
+}
+
+}  // namespace rocksdb
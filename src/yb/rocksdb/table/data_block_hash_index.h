@@ -0,0 +1,109 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#ifndef YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+#define YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+class DataBlockHashIndexKeyExtractor;
+
+// Data block hash index maps hash index keys (see DataBlockHashIndexKeyExtractor) of the data block
+// keys to the restart intervals containing them, so exact-match seek could find the restart
+// interval with a single hash probe instead of a binary search over restart points.
+//
+// The index is appended to the data block after the restart array:
+//     buckets: uint8[num_buckets]
+//     num_buckets: uint32
+//     num_restarts: uint32 with kDataBlockHashIndexFlag set
+// Each bucket contains either index of the restart interval, or kNoEntry when no key is mapped to
+// it, or kCollision when keys from different restart intervals are mapped to it. When keys with the
+// same hash index key span several restart intervals, the first of them is stored, the following
+// keys are reached by the linear scan from it.
+
+constexpr uint8_t kDataBlockHashIndexNoEntry = 255;
+constexpr uint8_t kDataBlockHashIndexCollision = 254;
+constexpr uint8_t kDataBlockHashIndexMaxRestart = 253;
+
+// Set in the num_restarts field of the block footer, when the block has hash index.
+constexpr uint32_t kDataBlockHashIndexFlag = 1u << 31;
+
+class DataBlockHashIndexBuilder {
+ public:
+  explicit DataBlockHashIndexBuilder(double util_ratio);
+
+  // Adds hash index key of the next block key, that is stored in the specified restart interval.
+  // Only the restart interval of the first key with the same hash index key is recorded.
+  void Add(const Slice& hash_index_key, size_t restart_index);
+
+  // Returns false if the index could not be built for the current block, for instance because
+  // it has too many restart intervals.
+  bool Valid() const { return valid_; }
+
+  void Invalidate() { valid_ = false; }
+
+  size_t EstimateSize() const;
+
+  // Appends index to the buffer. Requires Valid().
+  void Finish(std::string* buffer);
+
+  void Reset();
+
+ private:
+  size_t NumBuckets() const;
+
+  const double util_ratio_;
+  bool valid_ = true;
+  // Pairs of hash and restart index, consecutive duplicates are not added.
+  std::vector<std::pair<uint32_t, uint8_t>> entries_;
+  // Hash index key of the last added key.
+  std::string last_hash_index_key_;
+};
+
+class DataBlockHashIndex {
+ public:
+  DataBlockHashIndex() = default;
+
+  // Parses index located at the end of the block data, i.e. right before num_restarts field.
+  // Returns size of the index, or 0 if the index is corrupted.
+  size_t Initialize(const char* data, size_t size);
+
+  bool Valid() const { return num_buckets_ != 0; }
+
+  // Returns restart index for the hash index key, or one of kDataBlockHashIndexNoEntry,
+  // kDataBlockHashIndexCollision.
+  uint8_t Lookup(const Slice& hash_index_key) const;
+
+  size_t NumBuckets() const { return num_buckets_; }
+
+ private:
+  const uint8_t* buckets_ = nullptr;
+  uint32_t num_buckets_ = 0;
+};
+
+// Extractor that uses the whole user key as hash index key.
+const DataBlockHashIndexKeyExtractor& WholeUserKeyHashIndexKeyExtractor();
+
+}  // namespace rocksdb
+
+#endif // YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
@@ -40,6 +40,7 @@ class MemTracker;
 namespace rocksdb {
 
 class Block;
+class ZSTDUncompressionDict;
 struct ReadOptions;
 
 // the length of the magic number in bytes.
@@ -256,7 +257,8 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                const ZSTDUncompressionDict* compression_dict = nullptr);
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -265,10 +267,12 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 // free this buffer.
 // For description of compress_format_version and possible values, see
 // util/compression.h
+// compression_dict is the zstd dictionary of the file the block belongs to, if any.
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const ZSTDUncompressionDict* compression_dict = nullptr);
 
 // Implementation details follow.  Clients should ignore,
 
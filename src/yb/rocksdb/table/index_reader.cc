@@ -43,6 +43,10 @@ Result<Slice> BinarySearchIndexReader::GetMiddleKey() {
   return index_block_->GetMiddleKey(kIndexBlockKeyValueEncodingFormat);
 }
 
+Result<std::vector<Slice>> BinarySearchIndexReader::GetSampleKeys(size_t max_keys) {
+  return index_block_->GetSampleKeys(kIndexBlockKeyValueEncodingFormat, max_keys);
+}
+
 Status HashIndexReader::Create(const SliceTransform* hash_key_extractor,
                        const Footer& footer, RandomAccessFileReader* file,
                        Env* env, const ComparatorPtr& comparator,
@@ -132,6 +136,10 @@ Result<Slice> HashIndexReader::GetMiddleKey() {
   return index_block_->GetMiddleKey(kIndexBlockKeyValueEncodingFormat);
 }
 
+Result<std::vector<Slice>> HashIndexReader::GetSampleKeys(size_t max_keys) {
+  return index_block_->GetSampleKeys(kIndexBlockKeyValueEncodingFormat, max_keys);
+}
+
 class MultiLevelIterator : public InternalIterator {
  public:
   static constexpr auto kIterChainInitialCapacity = 4;
@@ -310,4 +318,8 @@ Result<Slice> MultiLevelIndexReader::GetMiddleKey() {
   return top_level_index_block_->GetMiddleKey(kIndexBlockKeyValueEncodingFormat);
 }
 
+Result<std::vector<Slice>> MultiLevelIndexReader::GetSampleKeys(size_t max_keys) {
+  return top_level_index_block_->GetSampleKeys(kIndexBlockKeyValueEncodingFormat, max_keys);
+}
+
 } // namespace rocksdb
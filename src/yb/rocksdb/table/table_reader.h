@@ -25,6 +25,8 @@
 #define YB_ROCKSDB_TABLE_TABLE_READER_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "yb/rocksdb/status.h"
 
@@ -124,6 +126,12 @@ class TableReader {
   virtual yb::Result<std::string> GetMiddleKey() {
     return STATUS(NotSupported, "GetMiddleKey() not supported");
   }
+
+  // Returns up to max_keys user keys present in SST file, that divide it into parts containing
+  // roughly the same amount of data.
+  virtual yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) {
+    return STATUS(NotSupported, "GetSampleKeys() not supported");
+  }
 };
 
 }  // namespace rocksdb
@@ -66,6 +66,8 @@
 #include "yb/rocksdb/util/testutil.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/monotime.h"
 #include "yb/util/string_util.h"
 #include "yb/util/test_macros.h"
 
@@ -307,7 +309,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
@@ -2186,6 +2188,109 @@ TEST_F(GeneralTableTest, ApproximateOffsetOfCompressed) {
   }
 }
 
+namespace {
+
+struct CompressedTableInfo {
+  uint64_t data_size = 0;
+  yb::MonoDelta read_time;
+};
+
+// Builds table with the given compression, checks that it is read back correctly and returns
+// size of its data blocks and time of reading all entries num_reads times without block cache.
+CompressedTableInfo BuildCompressedTable(
+    CompressionType compression, uint32_t max_dict_bytes,
+    const std::shared_ptr<yb::MemTracker>& mem_tracker = nullptr, int num_reads = 1) {
+  const std::vector<std::string> kFragments = {
+      "\"customer_name\": \"", "\", \"shipping_address\": \"", "\", \"status\": \"shipped\"",
+      "\", \"status\": \"pending\"", "\", \"payment_method\": \"credit_card\""};
+  Random rnd(301);
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i < 5000; ++i) {
+    std::string value;
+    for (int j = 0; j < 4; ++j) {
+      value += kFragments[rnd.Uniform(static_cast<int>(kFragments.size()))];
+      value += RandomString(&rnd, 4);
+    }
+    c.Add("k" + std::to_string(i), value);
+  }
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  Options options;
+  auto ikc = std::make_shared<test::PlainInternalKeyComparator>(options.comparator);
+  options.compression = compression;
+  options.compression_opts.max_dict_bytes = max_dict_bytes;
+  options.mem_tracker = mem_tracker;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  table_options.no_block_cache = true;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options, ikc, &keys, &kvmap);
+
+  // Blocks compressed with and without dictionary should be read back correctly.
+  std::unique_ptr<InternalIterator> iter(c.NewIterator());
+  iter->SeekToFirst();
+  for (const auto& kv : kvmap) {
+    EXPECT_TRUE(iter->Valid());
+    EXPECT_EQ(kv.first, iter->key().ToString());
+    EXPECT_EQ(kv.second, iter->value().ToString());
+    iter->Next();
+  }
+  EXPECT_FALSE(iter->Valid());
+  EXPECT_OK(iter->status());
+
+  CompressedTableInfo result;
+  result.data_size = c.GetTableProperties().data_size;
+  const auto read_start = yb::MonoTime::Now();
+  for (int i = 0; i < num_reads; ++i) {
+    size_t num_entries = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_entries;
+    }
+    EXPECT_EQ(kvmap.size(), num_entries);
+  }
+  result.read_time = yb::MonoTime::Now() - read_start;
+  return result;
+}
+
+} // namespace
+
+TEST_F(GeneralTableTest, ZSTDDictionaryCompression) {
+  if (!ZSTD_Supported()) {
+    fprintf(stderr, "skipping zstd dictionary compression test\n");
+    return;
+  }
+  auto mem_tracker = yb::MemTracker::CreateTracker("zstd-dictionary-test");
+  const auto data_size_without_dict =
+      BuildCompressedTable(kZSTDNotFinalCompression, /* max_dict_bytes = */ 0).data_size;
+  const auto data_size_with_dict = BuildCompressedTable(
+      kZSTDNotFinalCompression, /* max_dict_bytes = */ 2048, mem_tracker).data_size;
+  LOG(INFO) << "Data size without dictionary: " << data_size_without_dict
+            << ", with dictionary: " << data_size_with_dict;
+  ASSERT_LT(data_size_with_dict, data_size_without_dict);
+
+  // Dictionary is trained on about 100 times its size of samples, they should be tracked.
+  auto builder_tracker = yb::MemTracker::FindOrCreateTracker("BlockBasedTableBuilder", mem_tracker);
+  ASSERT_GE(builder_tracker->peak_consumption(), 100 * 2048);
+}
+
+// Compares size of data blocks and time of reading them back for LZ4 and zstd compression.
+TEST_F(GeneralTableTest, ZSTDCompressionBenchmark) {
+  if (!ZSTD_Supported() || !LZ4_Supported()) {
+    fprintf(stderr, "skipping zstd compression benchmark\n");
+    return;
+  }
+  constexpr int kNumReads = 20;
+  const auto lz4 = BuildCompressedTable(kLZ4Compression, 0, nullptr, kNumReads);
+  const auto zstd = BuildCompressedTable(kZSTDNotFinalCompression, 0, nullptr, kNumReads);
+  const auto zstd_dict = BuildCompressedTable(kZSTDNotFinalCompression, 2048, nullptr, kNumReads);
+  for (const auto& p : {std::make_pair("LZ4", lz4), std::make_pair("zstd", zstd),
+                        std::make_pair("zstd with dictionary", zstd_dict)}) {
+    LOG(INFO) << p.first << ": data size " << p.second.data_size << ", read time "
+              << p.second.read_time;
+  }
+  ASSERT_LT(zstd_dict.data_size, lz4.data_size);
+}
+
 TEST_F(HarnessTest, Randomized) {
 #if defined(THREAD_SANITIZER)
   static constexpr int kMaxNumEntries = 200;
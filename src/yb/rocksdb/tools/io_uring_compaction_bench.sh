@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+#
+# Copyright (c) YugaByte, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+# in compliance with the License.  You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under the License
+# is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+# or implied.  See the License for the specific language governing permissions and limitations
+# under the License.
+#
+# Compares full compaction time of db_bench when compaction inputs are read ahead with pread and
+# with io_uring. The same database is generated for every run, and page cache is dropped before
+# the compaction when it is possible, so input files are read from the device.
+#
+# Usage: io_uring_compaction_bench.sh <db_bench binary> <database directory>
+# Environment: NUM (number of keys), VALUE_SIZE, READAHEAD_BYTES, CHUNK_BYTES, RUNS.
+
+set -euo pipefail
+
+if [[ $# -ne 2 ]]; then
+  echo "Usage: $0 <db_bench binary> <database directory>" >&2
+  exit 1
+fi
+
+db_bench=$1
+db_dir=$2
+num=${NUM:-5000000}
+value_size=${VALUE_SIZE:-400}
+readahead_bytes=${READAHEAD_BYTES:-$(( 2 * 1024 * 1024 ))}
+chunk_bytes=${CHUNK_BYTES:-$(( 128 * 1024 ))}
+runs=${RUNS:-3}
+
+common_args=(
+  --db="$db_dir"
+  --num="$num"
+  --value_size="$value_size"
+  --seed=1
+  --threads=1
+  --compression_type=none
+  --cache_size=0
+  --disable_auto_compactions=1
+  --write_buffer_size=$(( 64 * 1024 * 1024 ))
+  --target_file_size_base=$(( 64 * 1024 * 1024 ))
+  --compaction_readahead_size="$readahead_bytes"
+  --io_uring_read_chunk_bytes="$chunk_bytes"
+)
+
+drop_page_cache() {
+  sync
+  if [[ -w /proc/sys/vm/drop_caches ]]; then
+    echo 3 > /proc/sys/vm/drop_caches
+  else
+    echo "Could not drop page cache, compaction inputs could be read from memory" >&2
+  fi
+}
+
+compaction_micros() {
+  local use_io_uring=$1
+  "$db_bench" "${common_args[@]}" --benchmarks=fillrandom --use_existing_db=0 >/dev/null
+  drop_page_cache
+  "$db_bench" "${common_args[@]}" --benchmarks=compact --use_existing_db=1 \
+      --use_io_uring_reads="$use_io_uring" |
+    awk '$1 == "compact" { print $3 }'
+}
+
+for (( run = 1; run <= runs; ++run )); do
+  pread_micros=$(compaction_micros false)
+  io_uring_micros=$(compaction_micros true)
+  echo "Run $run: pread $pread_micros us, io_uring $io_uring_micros us"
+done
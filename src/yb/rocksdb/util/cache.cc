@@ -24,6 +24,9 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <atomic>
+#include <mutex>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -35,7 +38,9 @@
 #include "yb/util/cache_metrics.h"
 #include "yb/util/enums.h"
 #include "yb/util/metrics.h"
+#include "yb/util/locks.h"
 #include "yb/util/random_util.h"
+#include "yb/util/shared_lock.h"
 
 // 0 value means that there exist no single_touch cache and
 // 1 means that the entire cache is treated as a multi-touch cache.
@@ -376,6 +381,8 @@ class LRUHandleDeleter {
 // A single shard of sharded cache.
 class LRUCache {
  public:
+  typedef LRUHandle HandleType;
+
   LRUCache();
   ~LRUCache();
 
@@ -838,11 +845,660 @@ void LRUCache::Erase(const Slice& key, uint32_t hash) {
   }
 }
 
+// CLOCK cache implementation
+
+// ClockHandle is the entry of the CLOCK cache. Unlike LRUHandle it is never linked into a list,
+// the eviction order is defined by the position of the entry in the hash table that the clock
+// hand sweeps. All mutable state that is touched by Lookup and Release is kept in atomics,
+// so hits only require the shared lock of the shard and never modify shared structures.
+//
+// flags contains:
+// bit 0 - entry is referenced by the hash table (in_cache),
+// bit 1 - entry was accessed since the clock hand passed it last time (usage bit),
+// bits 2.. - number of external references.
+//
+// The number of external references could only be increased while holding the shard lock, in
+// shared mode by Lookup or in exclusive mode by Insert. Release decrements it without the lock.
+// Entry is freed by the party that observes both zero references and cleared in_cache bit:
+// Release of the last reference to an entry that was removed from the hash table, or the
+// thread that removes an unreferenced entry from the hash table.
+struct ClockHandle {
+  static constexpr uint32_t kInCacheBit = 1;
+  static constexpr uint32_t kUsageBit = 2;
+  static constexpr uint32_t kRefsShift = 2;
+  static constexpr uint32_t kOneRef = 1 << kRefsShift;
+
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  ClockHandle* next_hash;
+  size_t charge;
+  size_t key_length;
+  uint32_t hash;
+  std::atomic<uint32_t> flags;
+  // Query id that added the value to the cache, kInMultiTouchId for multi touch entries.
+  std::atomic<QueryId> query_id;
+  char key_data[1];   // Beginning of key
+
+  static uint32_t Refs(uint32_t flags) {
+    return flags >> kRefsShift;
+  }
+
+  Slice key() const {
+    return Slice(key_data, key_length);
+  }
+
+  SubCacheType GetSubCacheType() const {
+    return (query_id.load(std::memory_order_acquire) == kInMultiTouchId) ? MULTI_TOUCH
+                                                                           : SINGLE_TOUCH;
+  }
+
+  void Free(yb::CacheMetrics* metrics) {
+    (*deleter)(key(), value);
+    if (metrics != nullptr) {
+      if (GetSubCacheType() == MULTI_TOUCH) {
+        metrics->multi_touch_cache_usage->DecrementBy(charge);
+      } else {
+        metrics->single_touch_cache_usage->DecrementBy(charge);
+      }
+      metrics->cache_usage->DecrementBy(charge);
+    }
+    this->~ClockHandle();
+    delete[] reinterpret_cast<char*>(this);
+  }
+};
+
+// Hash table of the CLOCK cache, the same chaining scheme as HandleTable, but also exposes
+// buckets, so the clock hand can sweep them.
+class ClockHandleTable {
+ public:
+  ClockHandleTable() { Resize(); }
+
+  template <typename T>
+  void ApplyToAllCacheEntries(T func) const {
+    for (auto* h : list_) {
+      while (h != nullptr) {
+        auto n = h->next_hash;
+        func(h);
+        h = n;
+      }
+    }
+  }
+
+  ClockHandle* Lookup(const Slice& key, uint32_t hash) const {
+    return *FindPointer(key, hash);
+  }
+
+  ClockHandle* Insert(ClockHandle* h) {
+    ClockHandle** ptr = FindPointer(h->key(), h->hash);
+    ClockHandle* old = *ptr;
+    h->next_hash = (old == nullptr ? nullptr : old->next_hash);
+    *ptr = h;
+    if (old == nullptr) {
+      ++elems_;
+      if (elems_ > list_.size()) {
+        Resize();
+      }
+    }
+    return old;
+  }
+
+  ClockHandle* Remove(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = FindPointer(key, hash);
+    ClockHandle* result = *ptr;
+    if (result != nullptr) {
+      *ptr = result->next_hash;
+      --elems_;
+    }
+    return result;
+  }
+
+  // Number of buckets, always power of 2.
+  size_t NumBuckets() const {
+    return list_.size();
+  }
+
+  // Invokes func for all entries of the specified bucket.
+  template <class Func>
+  void ApplyToBucket(size_t bucket, const Func& func) const {
+    for (auto* h = list_[bucket]; h != nullptr; h = h->next_hash) {
+      func(h);
+    }
+  }
+
+ private:
+  ClockHandle* const* FindPointer(const Slice& key, uint32_t hash) const {
+    return const_cast<ClockHandleTable*>(this)->FindPointer(key, hash);
+  }
+
+  ClockHandle** FindPointer(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = &list_[hash & (list_.size() - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+      ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+  }
+
+  void Resize() {
+    size_t new_length = 16;
+    while (new_length < elems_ * 1.5) {
+      new_length *= 2;
+    }
+    std::vector<ClockHandle*> new_list(new_length);
+    for (auto* h : list_) {
+      while (h != nullptr) {
+        auto next = h->next_hash;
+        auto& bucket = new_list[h->hash & (new_length - 1)];
+        h->next_hash = bucket;
+        bucket = h;
+        h = next;
+      }
+    }
+    list_.swap(new_list);
+  }
+
+  size_t elems_ = 0;
+  std::vector<ClockHandle*> list_;
+};
+
+// A single shard of sharded CLOCK cache.
+//
+// Lookup and Release do not take exclusive locks, instead of moving entry to the head of the LRU
+// list Lookup just sets the usage bit of the entry. The hash table lock is a per CPU lock, so
+// Lookup only takes the lock of the current CPU in shared mode and concurrent hits on different
+// CPUs do not contend on the same cache line.
+//
+// Insert, Erase and eviction are serialized by the shard modify mutex. Eviction sweeps the hash
+// table buckets with the clock hand while holding only this mutex, giving a second chance to
+// entries with the usage bit set and selecting unreferenced entries as eviction candidates. The
+// locks of all CPUs are then taken just to unlink the candidates and the inserted entry.
+//
+// Scan resistance is the same as in LRUCache: entries are accounted to the single touch or multi
+// touch sub cache, and an entry is promoted to the multi touch sub cache when it is accessed by a
+// query different from the one that added it.
+class ClockCache {
+ public:
+  typedef ClockHandle HandleType;
+
+  ClockCache() {}
+  ~ClockCache();
+
+  void SetCapacity(size_t capacity);
+
+  void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) {
+    metrics_ = metrics;
+  }
+
+  // Set the flag to reject insertion if cache if full.
+  void SetStrictCapacityLimit(bool strict_capacity_limit);
+
+  // Like Cache methods, but with an extra "hash" parameter.
+  Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
+                Cache::Handle** handle, Statistics* statistics);
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                        Statistics* statistics = nullptr);
+  void Release(Cache::Handle* handle);
+  void Erase(const Slice& key, uint32_t hash);
+  size_t Evict(size_t required);
+
+  size_t GetUsage() const {
+    return Usage(SINGLE_TOUCH) + Usage(MULTI_TOUCH);
+  }
+
+  size_t GetPinnedUsage() const;
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe);
+
+  std::pair<size_t, size_t> TEST_GetIndividualUsages() {
+    return std::pair<size_t, size_t>(Usage(SINGLE_TOUCH), Usage(MULTI_TOUCH));
+  }
+
+ private:
+  typedef autovector<ClockHandle*> ClockHandles;
+
+  // Returns the sub cache used to account entries of the specified type.
+  static SubCacheType EffectiveSubCacheType(SubCacheType subcache_type) {
+    if (FLAGS_cache_single_touch_ratio == 0) {
+      return MULTI_TOUCH;
+    } else if (FLAGS_cache_single_touch_ratio == 1) {
+      return SINGLE_TOUCH;
+    }
+    return subcache_type;
+  }
+
+  std::atomic<size_t>& UsageRef(SubCacheType subcache_type) {
+    return usage_[EffectiveSubCacheType(subcache_type)];
+  }
+
+  size_t Usage(SubCacheType subcache_type) const {
+    return usage_[EffectiveSubCacheType(subcache_type)].load(std::memory_order_acquire);
+  }
+
+  // Returns the capacity of the subcache, the same rules as in LRUCache.
+  // Should be called while holding the modify_mutex_.
+  size_t GetSubCacheCapacity(SubCacheType subcache_type);
+
+  // Sweeps the clock hand until usage of the specified sub cache plus charge, minus the charge
+  // of the selected candidates, fits its capacity. The sweep is limited to two passes over the
+  // hash table, if the usage does not fit after that, the caller fails the insert when the strict
+  // capacity limit is set, or over-commits otherwise.
+  // Should be called while holding the modify_mutex_ and without holding the mutex_.
+  void SweepClock(size_t charge, SubCacheType subcache_type, ClockHandles* candidates);
+
+  // Unlinks candidates that were not referenced or used since the sweep and adds them to evicted.
+  // Should be called while holding the modify_mutex_ and the mutex_ in exclusive mode.
+  void EvictCandidates(const ClockHandles& candidates, ClockHandles* evicted);
+
+  // Frees evicted entries, should be called without holding the mutex_.
+  void FreeEntries(const ClockHandles& entries);
+
+  // Marks the entry removed from hash table. Returns true if it was the last reference.
+  static bool DetachFromCache(ClockHandle* e) {
+    auto old_flags = e->flags.fetch_and(~ClockHandle::kInCacheBit, std::memory_order_acq_rel);
+    return ClockHandle::Refs(old_flags) == 0;
+  }
+
+  void FreeEntry(ClockHandle* e) {
+    UsageRef(e->GetSubCacheType()).fetch_sub(e->charge, std::memory_order_acq_rel);
+    e->Free(metrics_.get());
+  }
+
+  // Usage for entries residing in the cache, including entries that were removed from the
+  // hash table but still referenced by callers. Indexed by SubCacheType.
+  std::atomic<size_t> usage_[2] = {{0}, {0}};
+
+  size_t total_capacity_ = 0;
+  size_t multi_touch_capacity_ = 0;
+
+  // Whether to reject insertion if cache reaches its full capacity.
+  bool strict_capacity_limit_ = false;
+
+  // Serializes operations that modify the hash table, capacity or the clock hand.
+  std::mutex modify_mutex_;
+
+  // Lock of the current CPU is taken in shared mode by Lookup and other readers, the hash table
+  // is modified while holding all of them and the modify_mutex_.
+  mutable yb::percpu_rwlock mutex_;
+
+  ClockHandleTable table_;
+
+  // Bucket of the hash table that would be checked next by eviction.
+  size_t clock_hand_ = 0;
+
+  shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+ClockCache::~ClockCache() {
+  table_.ApplyToAllCacheEntries([this](ClockHandle* h) {
+    if (ClockHandle::Refs(h->flags.load(std::memory_order_acquire)) == 0) {
+      h->Free(metrics_.get());
+    }
+  });
+}
+
+size_t ClockCache::GetPinnedUsage() const {
+  yb::SharedLock<yb::rw_spinlock> lock(mutex_.get_lock());
+  size_t result = 0;
+  table_.ApplyToAllCacheEntries([&result](ClockHandle* h) {
+    if (ClockHandle::Refs(h->flags.load(std::memory_order_acquire)) != 0) {
+      result += h->charge;
+    }
+  });
+  return result;
+}
+
+void ClockCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+  yb::rw_spinlock* lock = thread_safe ? &mutex_.get_lock() : nullptr;
+  if (lock) {
+    lock->lock_shared();
+  }
+  table_.ApplyToAllCacheEntries([callback](ClockHandle* h) {
+    callback(h->value, h->charge);
+  });
+  if (lock) {
+    lock->unlock_shared();
+  }
+}
+
+size_t ClockCache::GetSubCacheCapacity(const SubCacheType subcache_type) {
+  switch (subcache_type) {
+    case SINGLE_TOUCH :
+      if (strict_capacity_limit_ || !FLAGS_cache_overflow_single_touch) {
+        return total_capacity_ - multi_touch_capacity_;
+      }
+      return total_capacity_ - std::min(
+          total_capacity_, usage_[MULTI_TOUCH].load(std::memory_order_acquire));
+    case MULTI_TOUCH :
+      return multi_touch_capacity_;
+  }
+  FATAL_INVALID_ENUM_VALUE(SubCacheType, subcache_type);
+}
+
+void ClockCache::SweepClock(
+    size_t charge, SubCacheType subcache_type, ClockHandles* candidates) {
+  subcache_type = EffectiveSubCacheType(subcache_type);
+  auto& usage = UsageRef(subcache_type);
+  const size_t capacity = GetSubCacheCapacity(subcache_type);
+  size_t to_free = 0;
+  auto over_capacity = [&usage, &to_free, charge, capacity] {
+    return usage.load(std::memory_order_acquire) + charge > capacity + to_free;
+  };
+  if (!over_capacity()) {
+    return;
+  }
+  // The first pass could only clear usage bits of some entries, so the second pass is required
+  // only when it did so. Otherwise all the remaining entries are referenced.
+  // Other threads could only look up entries while we hold the modify_mutex_, so the hash table
+  // could be traversed without locking the mutex_.
+  const size_t num_buckets = table_.NumBuckets();
+  bool usage_cleared = true;
+  for (int pass = 0; pass != 2 && usage_cleared && over_capacity(); ++pass) {
+    usage_cleared = false;
+    for (size_t i = 0; i != num_buckets && over_capacity(); ++i) {
+      clock_hand_ = (clock_hand_ + 1) & (num_buckets - 1);
+      table_.ApplyToBucket(
+          clock_hand_, [subcache_type, &to_free, &usage_cleared, candidates](ClockHandle* h) {
+        if (EffectiveSubCacheType(h->GetSubCacheType()) != subcache_type) {
+          return;
+        }
+        auto flags = h->flags.load(std::memory_order_acquire);
+        if (ClockHandle::Refs(flags) != 0) {
+          return;
+        }
+        if (flags & ClockHandle::kUsageBit) {
+          h->flags.fetch_and(~ClockHandle::kUsageBit, std::memory_order_acq_rel);
+          usage_cleared = true;
+          return;
+        }
+        to_free += h->charge;
+        candidates->push_back(h);
+      });
+    }
+  }
+}
+
+void ClockCache::EvictCandidates(const ClockHandles& candidates, ClockHandles* evicted) {
+  for (auto* h : candidates) {
+    // Nobody could add a reference while we hold the mutex_ in exclusive mode. Candidates that
+    // were looked up after the sweep stay in the cache.
+    auto flags = h->flags.load(std::memory_order_acquire);
+    if (!(flags & ClockHandle::kInCacheBit) || ClockHandle::Refs(flags) != 0 ||
+        (flags & ClockHandle::kUsageBit)) {
+      continue;
+    }
+    table_.Remove(h->key(), h->hash);
+    DetachFromCache(h);
+    // Evicted entries are not visible to other threads, so account them right away, so following
+    // capacity checks see the correct usage.
+    UsageRef(h->GetSubCacheType()).fetch_sub(h->charge, std::memory_order_acq_rel);
+    evicted->push_back(h);
+  }
+}
+
+void ClockCache::FreeEntries(const ClockHandles& entries) {
+  // Usage of evicted entries is already accounted by EvictCandidates.
+  for (auto* e : entries) {
+    e->Free(metrics_.get());
+  }
+}
+
+void ClockCache::SetCapacity(size_t capacity) {
+  ClockHandles deleted;
+  {
+    std::lock_guard<std::mutex> modify_lock(modify_mutex_);
+    {
+      std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+      multi_touch_capacity_ = round((1 - FLAGS_cache_single_touch_ratio) * capacity);
+      total_capacity_ = capacity;
+    }
+    ClockHandles candidates;
+    SweepClock(0, MULTI_TOUCH, &candidates);
+    SweepClock(0, SINGLE_TOUCH, &candidates);
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    EvictCandidates(candidates, &deleted);
+  }
+  FreeEntries(deleted);
+}
+
+void ClockCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
+  std::lock_guard<std::mutex> modify_lock(modify_mutex_);
+  std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+  assert(GetUsage() == 0 || !FLAGS_cache_overflow_single_touch);
+  strict_capacity_limit_ = strict_capacity_limit;
+}
+
+Cache::Handle* ClockCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                                  Statistics* statistics) {
+  ClockHandle* e;
+  SubCacheType subcache_type = SINGLE_TOUCH;
+  {
+    yb::SharedLock<yb::rw_spinlock> lock(mutex_.get_lock());
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      auto old_flags = e->flags.fetch_add(ClockHandle::kOneRef, std::memory_order_acq_rel);
+      if (!(old_flags & ClockHandle::kUsageBit)) {
+        e->flags.fetch_or(ClockHandle::kUsageBit, std::memory_order_acq_rel);
+      }
+
+      // Promote the entry to the multi touch sub cache when it is accessed by another query.
+      // Lookup does not evict, so the multi touch sub cache could temporarily overflow, it will
+      // be shrunk by the next insert.
+      auto entry_query_id = e->query_id.load(std::memory_order_acquire);
+      if (FLAGS_cache_single_touch_ratio < 1 && entry_query_id != kInMultiTouchId &&
+          entry_query_id != query_id &&
+          (!strict_capacity_limit_ ||
+           Usage(MULTI_TOUCH) + e->charge <= multi_touch_capacity_) &&
+          e->query_id.compare_exchange_strong(entry_query_id, kInMultiTouchId)) {
+        usage_[SINGLE_TOUCH].fetch_sub(e->charge, std::memory_order_acq_rel);
+        usage_[MULTI_TOUCH].fetch_add(e->charge, std::memory_order_acq_rel);
+        if (metrics_) {
+          metrics_->multi_touch_cache_usage->IncrementBy(e->charge);
+          metrics_->single_touch_cache_usage->DecrementBy(e->charge);
+        }
+      }
+      subcache_type = e->GetSubCacheType();
+    }
+  }
+
+  if (statistics != nullptr) {
+    if (e != nullptr) {
+      RecordTick(statistics, BLOCK_CACHE_HIT);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+      if (subcache_type == SubCacheType::SINGLE_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, e->charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, e->charge);
+      }
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_MISS);
+    }
+  }
+
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (e != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+  return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCache::Release(Cache::Handle* handle) {
+  if (handle == nullptr) {
+    return;
+  }
+  ClockHandle* e = reinterpret_cast<ClockHandle*>(handle);
+  auto old_flags = e->flags.fetch_sub(ClockHandle::kOneRef, std::memory_order_acq_rel);
+  assert(ClockHandle::Refs(old_flags) > 0);
+  if (ClockHandle::Refs(old_flags) == 1 && !(old_flags & ClockHandle::kInCacheBit)) {
+    // Entry was already removed from the hash table, and it was the last reference.
+    FreeEntry(e);
+  }
+}
+
+size_t ClockCache::Evict(size_t required) {
+  ClockHandles evicted;
+  {
+    std::lock_guard<std::mutex> modify_lock(modify_mutex_);
+    ClockHandles candidates;
+    SweepClock(required, SINGLE_TOUCH, &candidates);
+    size_t candidates_charge = 0;
+    for (auto* e : candidates) {
+      candidates_charge += e->charge;
+    }
+    if (required > candidates_charge &&
+        EffectiveSubCacheType(SINGLE_TOUCH) != EffectiveSubCacheType(MULTI_TOUCH)) {
+      SweepClock(required, MULTI_TOUCH, &candidates);
+    }
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    EvictCandidates(candidates, &evicted);
+  }
+  size_t result = 0;
+  for (auto* e : evicted) {
+    result += e->charge;
+  }
+  FreeEntries(evicted);
+  return result;
+}
+
+Status ClockCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                          void* value, size_t charge,
+                          void (*deleter)(const Slice& key, void* value),
+                          Cache::Handle** handle, Statistics* statistics) {
+  // Don't use the cache if disabled by the caller using the special query id.
+  if (query_id == kNoCacheQueryId) {
+    return Status::OK();
+  }
+  // Allocate the memory here outside of the mutex.
+  ClockHandle* e = new (new char[sizeof(ClockHandle) - 1 + key.size()]) ClockHandle;
+  e->value = value;
+  e->deleter = deleter;
+  e->next_hash = nullptr;
+  e->charge = charge;
+  e->key_length = key.size();
+  e->hash = hash;
+  e->flags.store(
+      ClockHandle::kInCacheBit | (handle == nullptr ? 0 : ClockHandle::kOneRef),
+      std::memory_order_release);
+  e->query_id.store(
+      FLAGS_cache_single_touch_ratio == 0 ? kInMultiTouchId : query_id, std::memory_order_release);
+  memcpy(e->key_data, key.data(), key.size());
+
+  Status s;
+  ClockHandles deleted;
+  ClockHandle* old = nullptr;
+  bool old_last_reference = false;
+  SubCacheType subcache_type;
+  {
+    std::lock_guard<std::mutex> modify_lock(modify_mutex_);
+    subcache_type = e->GetSubCacheType();
+    if (subcache_type == SINGLE_TOUCH && FLAGS_cache_single_touch_ratio != 1) {
+      // The same rule as in HandleTable::GetSubCacheTypeCandidate.
+      ClockHandle* existing = table_.Lookup(key, hash);
+      if (existing != nullptr &&
+          (existing->GetSubCacheType() == MULTI_TOUCH ||
+           existing->query_id.load(std::memory_order_acquire) != query_id)) {
+        e->query_id.store(kInMultiTouchId, std::memory_order_release);
+        subcache_type = MULTI_TOUCH;
+      }
+    }
+    ClockHandles candidates;
+    SweepClock(charge, subcache_type, &candidates);
+    // Also shrink the other sub cache, it could overflow because of promotions by Lookup, or
+    // because single touch entries could take space of the multi touch sub cache.
+    const auto other_subcache_type = subcache_type == MULTI_TOUCH ? SINGLE_TOUCH : MULTI_TOUCH;
+    if (EffectiveSubCacheType(other_subcache_type) != EffectiveSubCacheType(subcache_type)) {
+      SweepClock(0, other_subcache_type, &candidates);
+    }
+
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    EvictCandidates(candidates, &deleted);
+    if (strict_capacity_limit_ &&
+        Usage(subcache_type) + charge > GetSubCacheCapacity(subcache_type)) {
+      s = STATUS(Incomplete, "Insert failed due to CLOCK cache being full.");
+    } else {
+      old = table_.Insert(e);
+      UsageRef(subcache_type).fetch_add(charge, std::memory_order_acq_rel);
+      if (old != nullptr) {
+        old_last_reference = DetachFromCache(old);
+      }
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      if (metrics_ != nullptr) {
+        if (subcache_type == MULTI_TOUCH) {
+          metrics_->multi_touch_cache_usage->IncrementBy(charge);
+        } else {
+          metrics_->single_touch_cache_usage->IncrementBy(charge);
+        }
+        metrics_->cache_usage->IncrementBy(charge);
+      }
+    }
+  }
+
+  if (!s.ok()) {
+    if (handle == nullptr) {
+      e->Free(nullptr);
+    } else {
+      e->~ClockHandle();
+      delete[] reinterpret_cast<char*>(e);
+      *handle = nullptr;
+    }
+  }
+  if (old_last_reference) {
+    FreeEntry(old);
+  }
+  FreeEntries(deleted);
+
+  if (statistics != nullptr) {
+    if (s.ok()) {
+      RecordTick(statistics, BLOCK_CACHE_ADD);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+      if (subcache_type == SubCacheType::SINGLE_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_WRITE, charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_ADD);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, charge);
+      }
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    }
+  }
+
+  return s;
+}
+
+void ClockCache::Erase(const Slice& key, uint32_t hash) {
+  ClockHandle* e;
+  bool last_reference = false;
+  {
+    std::lock_guard<std::mutex> modify_lock(modify_mutex_);
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    e = table_.Remove(key, hash);
+    if (e != nullptr) {
+      last_reference = DetachFromCache(e);
+    }
+  }
+  // last_reference will only be true if e != nullptr
+  if (last_reference) {
+    FreeEntry(e);
+  }
+}
+
 static int kNumShardBits = 4;          // default values, can be overridden
 
-class ShardedLRUCache : public Cache {
+// Cache that is sharded to 2^num_shard_bits shards of type ShardType, by hash of the key.
+template <class ShardType>
+class ShardedCache : public Cache {
  private:
-  LRUCache* shards_;
+  typedef typename ShardType::HandleType HandleType;
+
+  ShardType* shards_;
   port::Mutex id_mutex_;
   port::Mutex capacity_mutex_;
   uint64_t last_id_;
@@ -865,15 +1521,14 @@ class ShardedLRUCache : public Cache {
   }
 
  public:
-  ShardedLRUCache(size_t capacity, int num_shard_bits,
-                  bool strict_capacity_limit)
+  ShardedCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
       : last_id_(0),
         num_shard_bits_(num_shard_bits),
         capacity_(capacity),
         strict_capacity_limit_(strict_capacity_limit),
         metrics_(nullptr) {
     int num_shards = 1 << num_shard_bits_;
-    shards_ = new LRUCache[num_shards];
+    shards_ = new ShardType[num_shards];
     const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
@@ -881,7 +1536,7 @@ class ShardedLRUCache : public Cache {
     }
   }
 
-  virtual ~ShardedLRUCache() {
+  virtual ~ShardedCache() {
     delete[] shards_;
   }
 
@@ -930,7 +1585,7 @@ class ShardedLRUCache : public Cache {
   }
 
   void Release(Handle* handle) override {
-    LRUHandle* h = reinterpret_cast<LRUHandle*>(handle);
+    HandleType* h = reinterpret_cast<HandleType*>(handle);
     shards_[Shard(h->hash)].Release(handle);
   }
 
@@ -940,7 +1595,7 @@ class ShardedLRUCache : public Cache {
   }
 
   void* Value(Handle* handle) override {
-    return reinterpret_cast<LRUHandle*>(handle)->value;
+    return reinterpret_cast<HandleType*>(handle)->value;
   }
 
   uint64_t NewId() override {
@@ -965,7 +1620,7 @@ class ShardedLRUCache : public Cache {
   }
 
   size_t GetUsage(Handle* handle) const override {
-    return reinterpret_cast<LRUHandle*>(handle)->charge;
+    return reinterpret_cast<HandleType*>(handle)->charge;
   }
 
   size_t GetPinnedUsage() const override {
@@ -979,7 +1634,7 @@ class ShardedLRUCache : public Cache {
   }
 
   SubCacheType GetSubCacheType(Handle* e) const override {
-    LRUHandle* h = reinterpret_cast<LRUHandle*>(e);
+    HandleType* h = reinterpret_cast<HandleType*>(e);
     return h->GetSubCacheType();
   }
 
@@ -1029,8 +1684,17 @@ shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
   if (num_shard_bits >= 20) {
     return nullptr;  // the cache cannot be sharded into too many fine pieces
   }
-  return std::make_shared<ShardedLRUCache>(capacity, num_shard_bits,
-                                           strict_capacity_limit);
+  return std::make_shared<ShardedCache<LRUCache>>(capacity, num_shard_bits,
+                                                  strict_capacity_limit);
+}
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedCache<ClockCache>>(capacity, num_shard_bits,
+                                                    strict_capacity_limit);
 }
 
 }  // namespace rocksdb
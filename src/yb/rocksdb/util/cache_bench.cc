@@ -41,6 +41,8 @@ int main() {
 #include "yb/rocksdb/util/mutexlock.h"
 #include "yb/rocksdb/util/random.h"
 
+#include "yb/util/status_log.h"
+
 using GFLAGS::ParseCommandLineFlags;
 
 static const uint32_t KB = 1024;
@@ -49,6 +51,7 @@ DEFINE_int32(threads, 16, "Number of concurrent threads to run.");
 DEFINE_int64(cache_size, 8 * KB * KB,
              "Number of bytes to use as a cache of uncompressed data.");
 DEFINE_int32(num_shard_bits, 4, "shard_bits.");
+DEFINE_string(cache_type, "lru", "Type of the cache: lru or clock.");
 
 DEFINE_int64(max_key, 1 * KB * KB * KB, "Max number of key to place in cache");
 DEFINE_uint64(ops_per_thread, 1200000, "Number of operations per thread.");
@@ -61,6 +64,13 @@ DEFINE_int32(lookup_percent, 50,
 DEFINE_int32(erase_percent, 10,
              "Ratio of erase to total workload (expressed as a percentage)");
 
+DEFINE_int32(hit_scaling_max_threads, 0,
+             "When positive, instead of the mixed workload run lookups of keys that are always "
+             "present in the cache with 1, 2, 4, ... up to this number of threads and report "
+             "hit throughput for each number of threads.");
+DEFINE_int64(hit_scaling_keys, 64 * KB,
+             "Number of keys that are looked up by the hit scaling benchmark.");
+
 namespace rocksdb {
 
 class CacheBench;
@@ -72,9 +82,9 @@ void deleter(const Slice& key, void* value) {
 // State shared by all concurrent executions of the same benchmark.
 class SharedState {
  public:
-  explicit SharedState(CacheBench* cache_bench)
+  SharedState(CacheBench* cache_bench, uint32_t num_threads)
       : cv_(&mu_),
-        num_threads_(FLAGS_threads),
+        num_threads_(num_threads),
         num_initialized_(0),
         start_(false),
         num_done_(0),
@@ -145,7 +155,9 @@ struct ThreadState {
 class CacheBench {
  public:
   CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+      cache_(FLAGS_cache_type == "clock"
+                 ? NewClockCache(FLAGS_cache_size, FLAGS_num_shard_bits, false)
+                 : NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
@@ -157,19 +169,55 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      CHECK_OK(cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter));
     }
   }
 
   bool Run() {
-    rocksdb::Env* env = rocksdb::Env::Default();
+    PrintEnv();
+    RunThreads(&CacheBench::OperateCache, FLAGS_ops_per_thread);
+    return true;
+  }
 
+  // Measures how throughput of cache hits scales with number of threads.
+  bool RunHitScaling() {
+    if (FLAGS_hit_scaling_keys > FLAGS_cache_size) {
+      fprintf(stderr, "hit_scaling_keys should not exceed cache_size\n");
+      return false;
+    }
     PrintEnv();
-    SharedState shared(this);
-    std::vector<ThreadState*> threads(num_threads_);
+    for (int64_t i = 0; i < FLAGS_hit_scaling_keys; i++) {
+      uint64_t key_value = i;
+      Slice key(reinterpret_cast<char*>(&key_value), 8);
+      CHECK_OK(cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter));
+    }
+    const auto max_threads = static_cast<uint32_t>(FLAGS_hit_scaling_max_threads);
+    for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+      num_threads_ = threads;
+      fprintf(stdout, "Threads: %u ", threads);
+      RunThreads(&CacheBench::LookupHits, FLAGS_ops_per_thread);
+    }
+    return true;
+  }
+
+ private:
+  typedef void (CacheBench::*Operation)(ThreadState* thread);
+
+  struct ThreadArgs {
+    ThreadState* state;
+    Operation operation;
+  };
+
+  void RunThreads(Operation operation, uint64_t ops_per_thread) {
+    rocksdb::Env* env = rocksdb::Env::Default();
+
+    SharedState shared(this, num_threads_);
+    std::vector<std::unique_ptr<ThreadState>> threads(num_threads_);
+    std::vector<ThreadArgs> args(num_threads_);
     for (uint32_t i = 0; i < num_threads_; i++) {
-      threads[i] = new ThreadState(i, &shared);
-      env->StartThread(ThreadBody, threads[i]);
+      threads[i] = std::make_unique<ThreadState>(i, &shared);
+      args[i] = ThreadArgs{threads[i].get(), operation};
+      env->StartThread(ThreadBody, &args[i]);
     }
     {
       MutexLock l(shared.GetMutex());
@@ -191,19 +239,18 @@ class CacheBench {
       // Record end time
       uint64_t end_time = env->NowMicros();
       double elapsed = static_cast<double>(end_time - start_time) * 1e-6;
-      uint32_t qps = static_cast<uint32_t>(
-          static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
-      fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
+      uint64_t qps = static_cast<uint64_t>(
+          static_cast<double>(num_threads_ * ops_per_thread) / elapsed);
+      fprintf(stdout, "Complete in %.3f s; QPS = %" PRIu64 "\n", elapsed, qps);
     }
-    return true;
   }
 
- private:
   std::shared_ptr<Cache> cache_;
   uint32_t num_threads_;
 
   static void ThreadBody(void* v) {
-    ThreadState* thread = reinterpret_cast<ThreadState*>(v);
+    ThreadArgs* args = reinterpret_cast<ThreadArgs*>(v);
+    ThreadState* thread = args->state;
     SharedState* shared = thread->shared;
 
     {
@@ -216,7 +263,7 @@ class CacheBench {
         shared->GetCondVar()->Wait();
       }
     }
-    thread->shared->GetCacheBench()->OperateCache(thread);
+    (thread->shared->GetCacheBench()->*args->operation)(thread);
 
     {
       MutexLock l(shared->GetMutex());
@@ -235,11 +282,12 @@ class CacheBench {
       int32_t prob_op = thread->rnd.Uniform(100);
       if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
+        WARN_NOT_OK(cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter),
+                    "Insert failed");
       } else if (prob_op -= FLAGS_insert_percent &&
                  prob_op < FLAGS_lookup_percent) {
         // do lookup
-        auto handle = cache_->Lookup(key);
+        auto handle = cache_->Lookup(key, kDefaultQueryId);
         if (handle) {
           cache_->Release(handle);
         }
@@ -251,7 +299,18 @@ class CacheBench {
     }
   }
 
+  void LookupHits(ThreadState* thread) {
+    for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
+      uint64_t key_value = thread->rnd.Next() % FLAGS_hit_scaling_keys;
+      Slice key(reinterpret_cast<char*>(&key_value), 8);
+      auto handle = cache_->Lookup(key, kDefaultQueryId);
+      CHECK(handle != nullptr);
+      cache_->Release(handle);
+    }
+  }
+
   void PrintEnv() const {
+    printf("Cache type          : %s\n", FLAGS_cache_type.c_str());
     printf("Number of threads   : %d\n", FLAGS_threads);
     printf("Ops per thread      : %" PRIu64 "\n", FLAGS_ops_per_thread);
     printf("Cache size          : %" PRIu64 "\n", FLAGS_cache_size);
@@ -261,6 +320,10 @@ class CacheBench {
     printf("Insert percentage   : %d%%\n", FLAGS_insert_percent);
     printf("Lookup percentage   : %d%%\n", FLAGS_lookup_percent);
     printf("Erase percentage    : %d%%\n", FLAGS_erase_percent);
+    if (FLAGS_hit_scaling_max_threads > 0) {
+      printf("Hit scaling threads : %d\n", FLAGS_hit_scaling_max_threads);
+      printf("Hit scaling keys    : %" PRIu64 "\n", FLAGS_hit_scaling_keys);
+    }
     printf("----------------------------\n");
   }
 };
@@ -275,6 +338,9 @@ int main(int argc, char** argv) {
   }
 
   rocksdb::CacheBench bench;
+  if (FLAGS_hit_scaling_max_threads > 0) {
+    return bench.RunHitScaling() ? 0 : 1;
+  }
   if (FLAGS_populate_cache) {
     bench.PopulateCache();
   }
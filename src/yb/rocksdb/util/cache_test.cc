@@ -23,6 +23,7 @@
 
 #include <forward_list>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -743,6 +744,167 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+TEST_F(CacheTest, ClockCacheEntriesArePinned) {
+  auto cache = NewClockCache(kCacheSize, kNumShardBits, false);
+  ASSERT_OK(Insert(cache, 100, 101));
+  Cache::Handle* h1 = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(101, DecodeValue(cache->Value(h1)));
+  ASSERT_EQ(1U, cache->GetUsage());
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+
+  ASSERT_OK(Insert(cache, 100, 102));
+  Cache::Handle* h2 = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(102, DecodeValue(cache->Value(h2)));
+  ASSERT_EQ(0U, deleted_keys_.size());
+  ASSERT_EQ(2U, cache->GetUsage());
+
+  cache->Release(h1);
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[0]);
+  ASSERT_EQ(101, deleted_values_[0]);
+  ASSERT_EQ(1U, cache->GetUsage());
+
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(1U, cache->GetUsage());
+
+  cache->Release(h2);
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[1]);
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(0U, cache->GetUsage());
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
+TEST_F(CacheTest, ClockCacheSecondChance) {
+  const int kCapacity = 10;
+  auto cache = NewClockCache(kCapacity, 0, false);
+  for (int i = 0; i != kCapacity; ++i) {
+    ASSERT_OK(Insert(cache, i, 1000 + i));
+  }
+  // Recently used entry should survive the next eviction.
+  ASSERT_EQ(1000, Lookup(cache, 0));
+  ASSERT_OK(Insert(cache, kCapacity, 1000 + kCapacity));
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_NE(0, deleted_keys_[0]);
+  ASSERT_EQ(1000, Lookup(cache, 0));
+
+  // Pinned entries are never evicted.
+  Cache::Handle* handle = cache->Lookup(EncodeKey(kCapacity), kTestQueryId);
+  ASSERT_NE(nullptr, handle);
+  for (int i = 0; i != 3 * kCapacity; ++i) {
+    ASSERT_OK(Insert(cache, 100 + i, 2000 + i));
+  }
+  ASSERT_EQ(1000 + kCapacity, DecodeValue(cache->Value(handle)));
+  ASSERT_EQ(1000 + kCapacity, Lookup(cache, kCapacity));
+  cache->Release(handle);
+}
+
+TEST_F(CacheTest, ClockCacheMultiTouch) {
+  auto cache = NewClockCache(kCacheSize, kNumShardBits, false);
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(cache, 100, 101));
+  // Lookup from another query moves the entry to the multi touch cache.
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 100, 101, kTestQueryId + 1));
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 100, 101));
+
+  // Insert of the existing key from another query goes directly to the multi touch cache.
+  ASSERT_OK(Insert(cache, 200, 201));
+  ASSERT_OK(Insert(cache, 200, 202, 1, kTestQueryId + 1));
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 200, 202));
+}
+
+TEST_F(CacheTest, ClockCacheStrictCapacityLimit) {
+  std::shared_ptr<Cache> cache = NewClockCache(10, 0, true);
+  std::vector<Cache::Handle*> handles(2);
+
+  for (size_t i = 0; i < 2; i++) {
+    std::string key = ToString(i + 1);
+    ASSERT_OK(cache->Insert(key, kTestQueryId, new Value(i + 1), 1, &deleter, &handles[i]));
+    ASSERT_NE(nullptr, handles[i]);
+  }
+
+  Cache::Handle* handle;
+  Status s = cache->Insert("extra", kTestQueryId, new Value(0), 1, &deleter, &handle);
+  ASSERT_TRUE(s.IsIncomplete());
+  ASSERT_EQ(nullptr, handle);
+  s = cache->Insert("extra", kTestQueryId, new Value(0), 1, &deleter);
+  ASSERT_TRUE(s.IsIncomplete());
+  ASSERT_EQ(2, cache->GetUsage());
+
+  for (size_t i = 0; i < 2; i++) {
+    cache->Release(handles[i]);
+  }
+}
+
+// When all entries are pinned, eviction gives up after sweeping the hash table and the insert
+// over-commits the cache.
+TEST_F(CacheTest, ClockCacheOverCommit) {
+  const int kCapacity = 10;
+  auto cache = NewClockCache(kCapacity, 0, false);
+  std::vector<Cache::Handle*> handles(kCapacity);
+  for (int i = 0; i != kCapacity; ++i) {
+    ASSERT_OK(cache->Insert(
+        EncodeKey(i), kTestQueryId, EncodeValue(1000 + i), 1, &CacheTest::Deleter, &handles[i]));
+  }
+
+  ASSERT_OK(Insert(cache, kCapacity, 1000 + kCapacity));
+  ASSERT_EQ(kCapacity + 1, cache->GetUsage());
+  ASSERT_EQ(kCapacity, cache->GetPinnedUsage());
+  ASSERT_EQ(0U, deleted_keys_.size());
+
+  for (auto* handle : handles) {
+    cache->Release(handle);
+  }
+  // Next insert evicts unpinned entries to fit the capacity again.
+  ASSERT_OK(Insert(cache, kCapacity + 1, 1000 + kCapacity + 1));
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+  ASSERT_EQ(2U, deleted_keys_.size());
+}
+
+TEST_F(CacheTest, ClockCacheConcurrentAccess) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 200;
+  constexpr int kOpsPerThread = 20000;
+  auto cache = NewClockCache(kNumKeys / 2, 2, false);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([&cache, t] {
+      Random rnd(t + 1);
+      for (int i = 0; i != kOpsPerThread; ++i) {
+        auto key = ToString(rnd.Uniform(kNumKeys));
+        switch (rnd.Uniform(10)) {
+          case 0:
+            cache->Erase(key);
+            break;
+          case 1: case 2: case 3:
+            ASSERT_OK(cache->Insert(key, t, nullptr, 1, &dumbDeleter));
+            break;
+          default: {
+            auto handle = cache->Lookup(key, t);
+            if (handle != nullptr) {
+              cache->Release(handle);
+            }
+            break;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(0, cache->GetPinnedUsage());
+  for (int i = 0; i != kNumKeys; ++i) {
+    cache->Erase(ToString(i));
+  }
+  ASSERT_EQ(0, cache->GetUsage());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
@@ -48,6 +49,7 @@
 #endif
 
 #if defined(ZSTD)
+#include <zdict.h>
 #include <zstd.h>
 #endif
 
@@ -620,8 +622,111 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   return false;
 }
 
+#ifdef ZSTD
+// Level used when CompressionOptions::level is left at its default (-1), which zstd would
+// otherwise interpret as a fast negative level.
+constexpr int kZSTDDefaultLevel = 3;
+
+inline int ZSTD_Level(const CompressionOptions& opts) {
+  return opts.level < 0 ? kZSTDDefaultLevel : opts.level;
+}
+
+// Compression and decompression contexts are expensive to create, so each thread keeps its own
+// pair for all blocks it processes.
+inline ZSTD_CCtx* ZSTD_ThreadLocalCCtx() {
+  struct Holder {
+    ZSTD_CCtx* ctx = ZSTD_createCCtx();
+    ~Holder() { ZSTD_freeCCtx(ctx); }
+  };
+  static thread_local Holder holder;
+  return holder.ctx;
+}
+
+inline ZSTD_DCtx* ZSTD_ThreadLocalDCtx() {
+  struct Holder {
+    ZSTD_DCtx* ctx = ZSTD_createDCtx();
+    ~Holder() { ZSTD_freeDCtx(ctx); }
+  };
+  static thread_local Holder holder;
+  return holder.ctx;
+}
+#endif
+
+// Digested zstd dictionary used by the table builder to compress data blocks of a single SST
+// file. See CompressionOptions::max_dict_bytes.
+class ZSTDCompressionDict {
+ public:
+  ZSTDCompressionDict(const Slice& dict, const CompressionOptions& opts) {
+#ifdef ZSTD
+    cdict_ = ZSTD_createCDict(dict.data(), dict.size(), ZSTD_Level(opts));
+#endif
+  }
+
+  ZSTDCompressionDict(const ZSTDCompressionDict&) = delete;
+  void operator=(const ZSTDCompressionDict&) = delete;
+
+  ~ZSTDCompressionDict() {
+#ifdef ZSTD
+    ZSTD_freeCDict(cdict_);
+#endif
+  }
+
+#ifdef ZSTD
+  const ZSTD_CDict* get() const { return cdict_; }
+
+ private:
+  ZSTD_CDict* cdict_ = nullptr;
+#endif
+};
+
+// Digested zstd dictionary used by the table reader to decompress data blocks.
+class ZSTDUncompressionDict {
+ public:
+  explicit ZSTDUncompressionDict(const Slice& dict) {
+#ifdef ZSTD
+    ddict_ = ZSTD_createDDict(dict.data(), dict.size());
+#endif
+  }
+
+  ZSTDUncompressionDict(const ZSTDUncompressionDict&) = delete;
+  void operator=(const ZSTDUncompressionDict&) = delete;
+
+  ~ZSTDUncompressionDict() {
+#ifdef ZSTD
+    ZSTD_freeDDict(ddict_);
+#endif
+  }
+
+#ifdef ZSTD
+  const ZSTD_DDict* get() const { return ddict_; }
+
+ private:
+  ZSTD_DDict* ddict_ = nullptr;
+#endif
+};
+
+// Trains zstd dictionary of at most max_dict_bytes from concatenated samples.
+// Returns empty string if there is not enough data to train a dictionary.
+inline std::string ZSTD_TrainDictionary(const std::string& samples,
+                                        const std::vector<size_t>& sample_lens,
+                                        size_t max_dict_bytes) {
+#ifdef ZSTD
+  std::string dict(max_dict_bytes, '\0');
+  size_t dict_len = ZDICT_trainFromBuffer(
+      &dict[0], max_dict_bytes, samples.data(), sample_lens.data(),
+      static_cast<unsigned>(sample_lens.size()));
+  if (ZDICT_isError(dict_len)) {
+    return std::string();
+  }
+  dict.resize(dict_len);
+  return dict;
+#endif
+  return std::string();
+}
+
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const ZSTDCompressionDict* dict = nullptr) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +738,17 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  size_t outlen;
+  if (dict != nullptr && dict->get() != nullptr) {
+    outlen = ZSTD_compress_usingCDict(
+        ZSTD_ThreadLocalCCtx(), &(*output)[output_header_len], compressBound, input, length,
+        dict->get());
+  } else {
+    outlen = ZSTD_compressCCtx(
+        ZSTD_ThreadLocalCCtx(), &(*output)[output_header_len], compressBound, input, length,
+        ZSTD_Level(opts));
+  }
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -644,8 +757,11 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
   return false;
 }
 
+// Blocks compressed with a dictionary carry its id in the frame header, so dict is only used for
+// such blocks. Blocks written before the dictionary was trained are decompressed without it.
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const ZSTDUncompressionDict* dict = nullptr) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -654,9 +770,22 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   }
 
   char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
-  assert(actual_output_length == output_len);
+  size_t actual_output_length;
+  if (ZSTD_getDictID_fromFrame(input_data, input_length) != 0) {
+    if (dict == nullptr || dict->get() == nullptr) {
+      delete[] output;
+      return nullptr;
+    }
+    actual_output_length = ZSTD_decompress_usingDDict(
+        ZSTD_ThreadLocalDCtx(), output, output_len, input_data, input_length, dict->get());
+  } else {
+    actual_output_length = ZSTD_decompressDCtx(
+        ZSTD_ThreadLocalDCtx(), output, output_len, input_data, input_length);
+  }
+  if (ZSTD_isError(actual_output_length) || actual_output_length != output_len) {
+    delete[] output;
+    return nullptr;
+  }
   *decompress_size = static_cast<int>(actual_output_length);
   return output;
 #endif
@@ -290,6 +290,11 @@ class StackableDB : public DB {
     return db_->GetMiddleKey();
   };
 
+  yb::Result<std::vector<std::string>> GetApproximateSplitKeys(
+      const Slice& lower, const Slice& upper, size_t num_parts, uint64_t min_part_size) override {
+    return db_->GetApproximateSplitKeys(lower, upper, num_parts, min_part_size);
+  }
+
   virtual void GetColumnFamilyMetaData(
       ColumnFamilyHandle *column_family,
       ColumnFamilyMetaData* cf_meta) override {
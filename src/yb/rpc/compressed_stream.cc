@@ -17,6 +17,9 @@
 #include <snappy-sinksource.h>
 #include <snappy.h>
 #include <zlib.h>
+#ifdef ZSTD
+#include <zstd.h>
+#endif
 
 #include <boost/preprocessor/cat.hpp>
 #include <boost/range/iterator_range.hpp>
@@ -29,13 +32,18 @@
 
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 
 using namespace std::literals;
 
 DEFINE_int32(stream_compression_algo, 0, "Algorithm used for stream compression. "
-                                         "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4.");
+                                         "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4, "
+                                         "4 - zstd (when built with zstd).");
+
+DEFINE_int32(stream_compression_zstd_level, 1,
+             "Compression level used by zstd stream compression.");
 
 namespace yb {
 namespace rpc {
@@ -728,8 +736,143 @@ class LZ4Compressor : public Compressor {
   ScopedTrackedConsumption consumption_;
 };
 
+#ifdef ZSTD
+
+class ZstdCompressor : public Compressor {
+ public:
+  static const char kId = 'Z';
+  static const int kIndex = 4;
+
+  explicit ZstdCompressor(MemTrackerPtr mem_tracker) {
+    if (mem_tracker) {
+      consumption_ = ScopedTrackedConsumption(std::move(mem_tracker), 0);
+    }
+  }
+
+  ~ZstdCompressor() {
+    // ZSTD_free* functions accept nullptr.
+    ZSTD_freeCStream(compress_stream_);
+    ZSTD_freeDStream(decompress_stream_);
+  }
+
+  OutboundDataPtr ConnectionHeader() override {
+    return GetConnectionHeader<ZstdCompressor>();
+  }
+
+  CHECKED_STATUS Init() override {
+    compress_stream_ = ZSTD_createCStream();
+    if (!compress_stream_) {
+      return STATUS(RuntimeError, "Cannot create zstd compression stream");
+    }
+    auto res = ZSTD_initCStream(compress_stream_, FLAGS_stream_compression_zstd_level);
+    if (ZSTD_isError(res)) {
+      return STATUS_FORMAT(
+          RuntimeError, "Cannot init zstd compression stream: $0", ZSTD_getErrorName(res));
+    }
+
+    decompress_stream_ = ZSTD_createDStream();
+    if (!decompress_stream_) {
+      return STATUS(RuntimeError, "Cannot create zstd decompression stream");
+    }
+    res = ZSTD_initDStream(decompress_stream_);
+    if (ZSTD_isError(res)) {
+      return STATUS_FORMAT(
+          RuntimeError, "Cannot init zstd decompression stream: $0", ZSTD_getErrorName(res));
+    }
+
+    UpdateConsumption();
+    return Status::OK();
+  }
+
+  std::string ToString() const override {
+    return "Zstd";
+  }
+
+  CHECKED_STATUS Compress(
+      const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) override {
+    // Input is compressed as part of single endless frame, so frame header is sent only once.
+    // But we reserve space for it in every output to be safe.
+    RefCntBuffer output(ZSTD_compressBound(TotalLen(input)) + ZSTD_FRAMEHEADERSIZE_MAX);
+    ZSTD_outBuffer out_buffer = { output.data(), output.size(), 0 };
+
+    for (auto it = input.begin(); it != input.end();) {
+      const auto& buf = *it++;
+      ZSTD_inBuffer in_buffer = { buf.data(), buf.size(), 0 };
+      while (in_buffer.pos != in_buffer.size) {
+        auto res = ZSTD_compressStream(compress_stream_, &out_buffer, &in_buffer);
+        if (ZSTD_isError(res)) {
+          return STATUS_FORMAT(RuntimeError, "Compression failed: $0", ZSTD_getErrorName(res));
+        }
+        if (out_buffer.pos == out_buffer.size) {
+          return STATUS(RuntimeError, "Compression output buffer overflow");
+        }
+      }
+    }
+
+    // Flush, so receiver could decompress all sent data.
+    for (;;) {
+      auto res = ZSTD_flushStream(compress_stream_, &out_buffer);
+      if (ZSTD_isError(res)) {
+        return STATUS_FORMAT(RuntimeError, "Compression flush failed: $0", ZSTD_getErrorName(res));
+      }
+      if (res == 0) {
+        break;
+      }
+      if (out_buffer.pos == out_buffer.size) {
+        return STATUS(RuntimeError, "Compression output buffer overflow");
+      }
+    }
+
+    output.Shrink(out_buffer.pos);
+    UpdateConsumption();
+
+    // Send compressed data to underlying stream.
+    return stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
+        std::move(output), std::move(data)));
+  }
+
+  Result<ReadBufferFull> Decompress(StreamReadBuffer* inp, StreamReadBuffer* out) override {
+    // Decompression stream allocates its window lazily, so consumption is updated after it.
+    auto se = ScopeExit([this] { UpdateConsumption(); });
+    return DecompressBySlices(
+        inp, out, [this](Slice* input, void* out, size_t outlen) -> Result<size_t> {
+      ZSTD_inBuffer in_buffer = { input->data(), input->size(), 0 };
+      ZSTD_outBuffer out_buffer = { out, outlen, 0 };
+      auto res = ZSTD_decompressStream(decompress_stream_, &out_buffer, &in_buffer);
+      if (ZSTD_isError(res)) {
+        return STATUS_FORMAT(RuntimeError, "Decompression failed: $0", ZSTD_getErrorName(res));
+      }
+
+      input->remove_prefix(in_buffer.pos);
+      return out_buffer.pos;
+    });
+  }
+
+ private:
+  // Zstd streams allocate their buffers internally, so we track their actual size.
+  void UpdateConsumption() {
+    if (consumption_) {
+      consumption_.Reset(
+          ZSTD_sizeof_CStream(compress_stream_) + ZSTD_sizeof_DStream(decompress_stream_));
+    }
+  }
+
+  ZSTD_CStream* compress_stream_ = nullptr;
+  ZSTD_DStream* decompress_stream_ = nullptr;
+  ScopedTrackedConsumption consumption_;
+};
+
+#define YB_ZSTD_COMPRESSION_ALGORITHM (Zstd)
+
+#else
+
+// Without zstd, algorithm 4 and zstd connection header are rejected as unknown.
+#define YB_ZSTD_COMPRESSION_ALGORITHM
+
+#endif // ZSTD
+
 #undef LZ4
-#define YB_COMPRESSION_ALGORITHMS (Zlib)(Snappy)(LZ4)
+#define YB_COMPRESSION_ALGORITHMS (Zlib)(Snappy)(LZ4) YB_ZSTD_COMPRESSION_ALGORITHM
 
 #define YB_CREATE_COMPRESSOR_CASE(r, data, name) \
   case BOOST_PP_CAT(name, Compressor)::data: \
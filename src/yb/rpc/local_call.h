@@ -83,6 +83,12 @@ class LocalYBInboundCall : public YBInboundCall, public RpcCallParams {
     return sidecars_.size() - 1;
   }
 
+  size_t AddRpcSidecar(RefCntBuffer car, size_t allocated_size) override {
+    sidecar_pointers_.push_back({car.ubegin(), car.uend()});
+    sidecars_.push_back(std::move(car));
+    return sidecars_.size() - 1;
+  }
+
   std::shared_ptr<LocalOutboundCall> outbound_call() const {
     return outbound_call_.lock();
   }
@@ -395,7 +395,7 @@ rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
       }
       const ThreadPoolOptions& options = normal_thread_pool_->options();
       high_priority_thread_pool_.reset(new rpc::ThreadPool(
-          name_ + "-high-pri", options.queue_limit, options.max_workers));
+          name_ + "-high-pri", options.queue_limit, options.max_workers, options.num_shards));
       return *high_priority_thread_pool_.get();
   }
   FATAL_INVALID_ENUM_VALUE(ServicePriority, priority);
@@ -551,7 +551,8 @@ Messenger::Messenger(const MessengerBuilder &bld)
       metric_entity_(bld.metric_entity_),
       io_thread_pool_(name_, FLAGS_io_thread_pool_size),
       scheduler_(&io_thread_pool_.io_service()),
-      normal_thread_pool_(new rpc::ThreadPool(name_, bld.queue_limit_, bld.workers_limit_)),
+      normal_thread_pool_(new rpc::ThreadPool(
+          name_, bld.queue_limit_, bld.workers_limit_, static_cast<size_t>(bld.num_reactors_))),
       resolver_(new DnsResolver(&io_thread_pool_.io_service())),
       rpc_metrics_(std::make_shared<RpcMetrics>(bld.metric_entity_)),
       num_connections_to_server_(bld.num_connections_to_server_) {
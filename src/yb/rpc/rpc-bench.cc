@@ -30,23 +30,31 @@
 // under the License.
 //
 
+#include <limits>
 #include <string>
 #include <thread>
 
 #include <gtest/gtest.h>
 
+#include "yb/gutil/casts.h"
+
+#include "yb/rpc/lightweight_message.h"
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rtest.messages.h"
 #include "yb/rpc/rtest.proxy.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
 using namespace std::literals; // NOLINT
+using namespace yb::size_literals;
 
 using std::string;
 using std::shared_ptr;
@@ -155,6 +163,127 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+namespace {
+
+// Fills request with a batch of operations, similar to write and read requests of the hot paths.
+void FillBatchRequest(rpc_test::LightweightRequestPB* req) {
+  constexpr int kNumOperations = 64;
+  req->set_i64(std::numeric_limits<int64_t>::max());
+  req->set_str("tablet-00000000000000000000000000000000");
+  for (int i = 0; i != kNumOperations; ++i) {
+    auto* op = req->add_repeated_messages();
+    op->set_sf32(i);
+    op->set_str(Format("table-$0", i));
+    for (int j = 0; j != 4; ++j) {
+      op->add_rsi32(i * j);
+      op->add_rbytes(std::string(32, static_cast<char>('a' + j)));
+    }
+    req->add_packed_u64(i);
+    auto* pair = req->add_pairs();
+    pair->set_s1(Format("column-$0", i));
+    pair->set_s2(std::string(16, 'v'));
+  }
+}
+
+template <class F>
+MonoDelta Measure(int iterations, const F& f) {
+  auto start = MonoTime::Now();
+  for (int i = 0; i != iterations; ++i) {
+    f();
+  }
+  return MonoTime::Now() - start;
+}
+
+} // namespace
+
+// Compares parsing and serialization of the same request by protobuf and by lightweight messages.
+TEST_F(RpcBench, BenchmarkLightweightMessages) {
+#if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
+  constexpr int kIterations = 1000;
+#else
+  constexpr int kIterations = 20000;
+#endif
+
+  rpc_test::LightweightRequestPB req;
+  FillBatchRequest(&req);
+  const auto serialized = req.SerializeAsString();
+  const Slice input(serialized);
+  std::string output;
+
+  auto protobuf_time = Measure(kIterations, [&input, &output] {
+    rpc_test::LightweightRequestPB message;
+    CHECK(message.ParseFromArray(input.data(), narrow_cast<int>(input.size())));
+    output.clear();
+    CHECK(message.SerializeToString(&output));
+  });
+  ASSERT_EQ(output.size(), serialized.size());
+
+  Arena arena;
+  auto lightweight_time = Measure(kIterations, [&arena, &input, &output] {
+    arena.Reset();
+    rpc_test::LWLightweightRequestPB message(&arena);
+    CHECK_OK(message.ParseFromSlice(input));
+    output.resize(message.SerializedSize());
+    message.SerializeToArray(pointer_cast<uint8_t*>(&output[0]));
+  });
+  ASSERT_EQ(output.size(), serialized.size());
+
+  LOG(INFO) << "Message size:           " << serialized.size();
+  LOG(INFO) << "Protobuf per message:    "
+            << protobuf_time.ToMicroseconds() * 1.0 / kIterations << "us";
+  LOG(INFO) << "Lightweight per message: "
+            << lightweight_time.ToMicroseconds() * 1.0 / kIterations << "us";
+#if !defined(THREAD_SANITIZER) && !defined(ADDRESS_SANITIZER)
+  ASSERT_LE(lightweight_time, protobuf_time);
+#endif
+}
+
+namespace {
+
+// Sends requests for a page of rows data of the specified size, like a scan does.
+MonoDelta MeasureScanPages(Proxy* proxy, int num_pages, size_t page_size, bool zero_copy) {
+  rpc_test::SendStringsRequestPB req;
+  req.set_random_seed(42);
+  req.add_sizes(page_size);
+  req.add_zero_copy(zero_copy);
+  return Measure(num_pages, [proxy, &req, page_size] {
+    rpc_test::SendStringsResponsePB resp;
+    RpcController controller;
+    controller.set_timeout(MonoDelta::FromSeconds(30));
+    CHECK_OK(proxy->SyncRequest(
+        CalculatorServiceMethods::SendStringsMethod(), /* method_metrics= */ nullptr, req, &resp,
+        &controller));
+    CHECK_EQ(CHECK_RESULT(controller.GetSidecar(resp.sidecars(0))).size(), page_size);
+  });
+}
+
+} // namespace
+
+// Compares end-to-end latency of reading 10MB pages, when page is copied to the sidecar buffer and
+// when it is attached to the response without copying.
+TEST_F(RpcBench, BenchmarkLargeSidecars) {
+  constexpr size_t kPageSize = 10_MB;
+#if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
+  constexpr int kNumPages = 5;
+#else
+  constexpr int kNumPages = 100;
+#endif
+
+  HostPort server_hostport;
+  StartTestServer(&server_hostport);
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy proxy(client_messenger.get(), server_hostport);
+
+  // Warm up connection and allocator.
+  MeasureScanPages(&proxy, 1, kPageSize, /* zero_copy= */ false);
+
+  auto copy_time = MeasureScanPages(&proxy, kNumPages, kPageSize, /* zero_copy= */ false);
+  auto zero_copy_time = MeasureScanPages(&proxy, kNumPages, kPageSize, /* zero_copy= */ true);
+
+  LOG(INFO) << "Copied page:      " << copy_time.ToMicroseconds() * 1.0 / kNumPages << "us";
+  LOG(INFO) << "Zero copy page:   " << zero_copy_time.ToMicroseconds() * 1.0 / kNumPages << "us";
+}
+
 } // namespace rpc
 } // namespace yb
 
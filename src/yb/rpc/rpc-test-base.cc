@@ -162,7 +162,17 @@ void GenericCalculatorService::DoSendStrings(InboundCall* incoming) {
   Random r(req.random_seed());
   SendStringsResponsePB resp;
   auto* yb_call = down_cast<YBInboundCall*>(incoming);
-  for (auto size : req.sizes()) {
+  for (int i = 0; i != req.sizes_size(); ++i) {
+    auto size = req.sizes(i);
+    if (i < req.zero_copy_size() && req.zero_copy(i)) {
+      faststring sidecar;
+      sidecar.resize(size);
+      RandomString(sidecar.data(), size, &r);
+      const auto allocated_size = sidecar.capacity();
+      resp.add_sidecars(narrow_cast<uint32_t>(
+          yb_call->AddRpcSidecar(RefCntBuffer(std::move(sidecar)), allocated_size)));
+      continue;
+    }
     auto sidecar = RefCntBuffer(size);
     RandomString(sidecar.udata(), size, &r);
     resp.add_sidecars(narrow_cast<uint32_t>(yb_call->AddRpcSidecar(sidecar.as_slice())));
@@ -492,13 +502,17 @@ CHECKED_STATUS RpcTestBase::DoTestSyncCall(Proxy* proxy, const RemoteMethod* met
 
 void RpcTestBase::DoTestSidecar(Proxy* proxy,
                                 std::vector<size_t> sizes,
-                                Status::Code expected_code) {
+                                Status::Code expected_code,
+                                const std::vector<bool>& zero_copy) {
   const uint32_t kSeed = 12345;
 
   SendStringsRequestPB req;
   for (auto size : sizes) {
     req.add_sizes(size);
   }
+  for (bool value : zero_copy) {
+    req.add_zero_copy(value);
+  }
   req.set_random_seed(kSeed);
 
   SendStringsResponsePB resp;
@@ -195,7 +195,8 @@ class RpcTestBase : public YBTest {
 
   void DoTestSidecar(Proxy* proxy,
                      std::vector<size_t> sizes,
-                     Status::Code expected_code = Status::Code::kOk);
+                     Status::Code expected_code = Status::Code::kOk,
+                     const std::vector<bool>& zero_copy = {});
 
   void DoTestExpectTimeout(Proxy* proxy, const MonoDelta &timeout);
 
@@ -64,6 +64,7 @@
 #include "yb/util/format.h"
 #include "yb/util/logging_test_util.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
@@ -479,6 +480,11 @@ TEST_F(TestRpc, TestRpcSidecar) {
   std::vector<size_t> sizes(20);
   std::fill(sizes.begin(), sizes.end(), 123);
   DoTestSidecar(&p, sizes);
+
+  // Test sidecars attached without copying, mixed with copied ones.
+  DoTestSidecar(&p, {123, 3_MB, 456, 20, 2_MB}, Status::Code::kOk,
+                {false, true, false, true, true});
+  DoTestSidecar(&p, {3_MB, 2_MB, 240_MB}, Status::Code::kOk, {true, true, true});
 }
 
 // Test that timeouts are properly handled.
@@ -1304,16 +1310,72 @@ TEST_P(TestRpcCompression, Compression) {
   });
 }
 
+// Measures throughput and compression ratio of echo calls with text payload, for comparison of
+// stream compression algorithms.
+void BenchmarkCompression(
+    CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity, int algo) {
+  constexpr size_t kNumDistinctPayloads = 16;
+  const size_t kNumCalls = RegularBuildVsSanitizers(2000, 100);
+  const size_t kPayloadLen = 64_KB;
+
+  std::vector<std::string> payloads;
+  for (size_t i = 0; i != kNumDistinctPayloads; ++i) {
+    // Repeated random words give compression ratio similar to row data.
+    std::string payload;
+    while (payload.size() < kPayloadLen) {
+      payload += RandomHumanReadableString(8 + i);
+      payload += ' ';
+    }
+    payloads.push_back(std::move(payload));
+  }
+
+  auto sent_counter = ASSERT_RESULT(GetCounter(metric_entity, METRIC_tcp_bytes_sent));
+  auto start_sent = sent_counter->value();
+  auto start = MonoTime::Now();
+  for (size_t i = 0; i != kNumCalls; ++i) {
+    RpcController controller;
+    controller.set_timeout(5s * kTimeMultiplier);
+    rpc_test::EchoRequestPB req;
+    req.set_data(payloads[i % payloads.size()]);
+    rpc_test::EchoResponsePB resp;
+    ASSERT_OK(proxy->Echo(req, &resp, &controller));
+    ASSERT_EQ(req.data().size(), resp.data().size());
+  }
+  auto passed = MonoTime::Now() - start;
+  auto sent = sent_counter->value() - start_sent;
+  auto raw = 2 * kNumCalls * kPayloadLen;
+  LOG(INFO) << "Compression " << algo << ": " << kNumCalls << " calls of " << kPayloadLen
+            << " bytes took " << passed << ", "
+            << kNumCalls * MonoTime::kMillisecondsPerSecond / std::max<int64_t>(
+                   passed.ToMilliseconds(), 1) << " calls/s, sent " << sent
+            << " bytes for " << raw << " bytes of payload in both directions, ratio "
+            << static_cast<double>(raw) / std::max<int64_t>(sent, 1);
+}
+
+TEST_P(TestRpcCompression, Benchmark) {
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    BenchmarkCompression(proxy, metric_entity(), GetParam());
+  });
+}
+
 std::string CompressionName(const testing::TestParamInfo<int>& info) {
   switch (info.param) {
     case 1: return "Zlib";
     case 2: return "Snappy";
     case 3: return "LZ4";
+    case 4: return "Zstd";
   }
   return Format("Unknown compression $0", info.param);
 }
 
-INSTANTIATE_TEST_CASE_P(, TestRpcCompression, testing::Range(1, 4), CompressionName);
+#ifdef ZSTD
+constexpr int kNumCompressionAlgorithms = 4;
+#else
+constexpr int kNumCompressionAlgorithms = 3;
+#endif
+
+INSTANTIATE_TEST_CASE_P(
+    , TestRpcCompression, testing::Range(1, kNumCompressionAlgorithms + 1), CompressionName);
 
 class TestRpcSecureCompression : public TestRpcSecure {
  public:
@@ -194,6 +194,10 @@ size_t RpcContext::AddRpcSidecar(const Slice& car) {
   return call_->AddRpcSidecar(car);
 }
 
+size_t RpcContext::AddRpcSidecar(RefCntBuffer car, size_t allocated_size) {
+  return call_->AddRpcSidecar(std::move(car), allocated_size);
+}
+
 void RpcContext::ResetRpcSidecars() {
   call_->ResetRpcSidecars();
 }
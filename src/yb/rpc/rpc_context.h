@@ -278,6 +278,12 @@ class RpcContext {
   // Returns the index of the sidecar.
   size_t AddRpcSidecar(const Slice& car);
 
+  // Same as above, but the sidecar data is not copied. The buffer is sent as is, so the response
+  // could be written to the socket directly from the memory where it was produced.
+  // allocated_size is the amount of memory held by the buffer, it is charged to the call memory
+  // tracker, and could be greater than the size of the sidecar.
+  size_t AddRpcSidecar(RefCntBuffer car, size_t allocated_size);
+
   // Removes all RpcSidecars.
   void ResetRpcSidecars();
 
@@ -37,6 +37,7 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/gutil/casts.h"
 #include "yb/gutil/stl_util.h"
 
 #include "yb/rpc/proxy.h"
@@ -1021,6 +1022,104 @@ TEST_F(RpcStubTest, Lightweight) {
   ASSERT_STR_EQ(AsString(resp.short_debug_string()), req_str);
 }
 
+TEST_F(RpcStubTest, LightweightDefaults) {
+  rpc_test::LightweightDefaultsPB pb;
+  auto check_defaults = [&pb](const rpc_test::LWLightweightDefaultsPB& lw) {
+    ASSERT_EQ(lw.i32(), pb.i32());
+    ASSERT_EQ(lw.i64(), pb.i64());
+    ASSERT_EQ(lw.u64(), pb.u64());
+    ASSERT_EQ(lw.r64(), pb.r64());
+    ASSERT_EQ(lw.r32(), pb.r32());
+    ASSERT_EQ(lw.b(), pb.b());
+    ASSERT_EQ(lw.str().ToBuffer(), pb.str());
+    ASSERT_EQ(lw.first_en(), pb.first_en());
+    ASSERT_EQ(lw.en(), pb.en());
+    ASSERT_FALSE(lw.has_i32());
+    ASSERT_EQ(lw.SerializedSize(), 0);
+  };
+
+  Arena arena;
+  rpc_test::LWLightweightDefaultsPB lw(&arena);
+  ASSERT_NO_FATALS(check_defaults(lw));
+
+  lw.set_i32(1);
+  lw.set_i64(2);
+  lw.set_u64(3);
+  lw.set_r64(4);
+  lw.set_r32(5);
+  lw.set_b(false);
+  lw.ref_str("str");
+  lw.set_first_en(rpc_test::LightweightDefaultsEnum::SECOND);
+  lw.set_en(rpc_test::LightweightEnum::ZERO);
+  lw.Clear();
+  ASSERT_NO_FATALS(check_defaults(lw));
+
+  ASSERT_NO_FATALS(check_defaults(*CopySharedMessage<rpc_test::LWLightweightDefaultsPB>(pb)));
+}
+
+TEST_F(RpcStubTest, LightweightOneof) {
+  using OneofPB = rpc_test::LightweightOneofPB;
+
+  Arena arena;
+  rpc_test::LWLightweightOneofPB lw(&arena);
+  ASSERT_EQ(lw.value_case(), OneofPB::VALUE_NOT_SET);
+  lw.set_after(1);
+
+  // Setting a member clears the member that was set before.
+  lw.set_i32(5);
+  ASSERT_EQ(lw.value_case(), OneofPB::kI32);
+  lw.ref_str("str");
+  ASSERT_EQ(lw.value_case(), OneofPB::kStr);
+  ASSERT_FALSE(lw.has_i32());
+  lw.mutable_pair()->ref_s1("s1");
+  ASSERT_EQ(lw.value_case(), OneofPB::kPair);
+  ASSERT_FALSE(lw.has_str());
+  lw.mutable_nested()->set_i32(7);
+  ASSERT_EQ(lw.value_case(), OneofPB::kNested);
+  ASSERT_FALSE(lw.has_pair());
+  lw.set_i32(8);
+  ASSERT_EQ(lw.value_case(), OneofPB::kI32);
+  ASSERT_FALSE(lw.has_nested());
+  ASSERT_TRUE(lw.has_after());
+
+  // Updating the member that is set keeps it.
+  lw.mutable_pair()->ref_s2("s2");
+  lw.mutable_pair()->ref_s1("s1");
+  ASSERT_EQ(lw.pair().s2().ToBuffer(), "s2");
+
+  lw.clear_value();
+  ASSERT_EQ(lw.value_case(), OneofPB::VALUE_NOT_SET);
+  ASSERT_TRUE(lw.has_after());
+
+  // Round trip through the wire format and protobuf.
+  lw.mutable_nested()->mutable_pair()->ref_s1("nested");
+  std::string serialized(lw.SerializedSize(), '\0');
+  lw.SerializeToArray(pointer_cast<uint8_t*>(&serialized[0]));
+  OneofPB pb;
+  ASSERT_TRUE(pb.ParseFromString(serialized));
+  ASSERT_EQ(pb.value_case(), OneofPB::kNested);
+  ASSERT_EQ(pb.nested().value_case(), OneofPB::kPair);
+  ASSERT_EQ(pb.nested().pair().s1(), "nested");
+  ASSERT_EQ(pb.after(), 1);
+  ASSERT_EQ(lw.ToGoogleProtobuf().ShortDebugString(), pb.ShortDebugString());
+
+  pb.set_str("pb");
+  auto copy = CopySharedMessage<rpc_test::LWLightweightOneofPB>(pb);
+  ASSERT_EQ(copy->value_case(), OneofPB::kStr);
+  ASSERT_EQ(copy->str().ToBuffer(), "pb");
+
+  // When a member is met in the input more than once, the last one wins as in protobuf.
+  OneofPB first;
+  first.set_i32(1);
+  OneofPB second;
+  second.set_str("last");
+  const auto input = first.SerializeAsString() + second.SerializeAsString();
+  rpc_test::LWLightweightOneofPB parsed(&arena);
+  ASSERT_OK(parsed.ParseFromSlice(input));
+  ASSERT_EQ(parsed.value_case(), OneofPB::kStr);
+  ASSERT_FALSE(parsed.has_i32());
+}
+
 TEST_F(RpcStubTest, CustomServiceName) {
   SendSimpleCall();
 
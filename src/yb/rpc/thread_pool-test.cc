@@ -13,6 +13,7 @@
 //
 //
 
+#include <algorithm>
 #include <atomic>
 #include <thread>
 
@@ -26,6 +27,7 @@
 #include "yb/util/thread.h"
 #include "yb/util/tsan_util.h"
 
+DECLARE_int32(rpc_worker_spin_iterations);
 DECLARE_int32(TEST_strand_done_inject_delay_ms);
 
 using namespace std::literals;
@@ -119,11 +121,10 @@ TEST_F(ThreadPoolTest, TestSingleProducer) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestMultiProducers) {
+void TestMultiProducers(size_t num_workers, size_t num_shards) {
   constexpr size_t kTotalTasks = 10000;
-  constexpr size_t kTotalWorkers = 4;
   constexpr size_t kProducers = 4;
-  ThreadPool pool("test", kTotalTasks, kTotalWorkers);
+  ThreadPool pool("test", kTotalTasks, num_workers, num_shards);
 
   CountDownLatch latch(kTotalTasks);
   std::vector<TestTask> tasks(kTotalTasks);
@@ -149,6 +150,19 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   }
 }
 
+TEST_F(ThreadPoolTest, TestMultiProducers) {
+  TestMultiProducers(/* num_workers= */ 4, /* num_shards= */ 1);
+}
+
+TEST_F(ThreadPoolTest, TestShardedMultiProducers) {
+  TestMultiProducers(/* num_workers= */ 4, /* num_shards= */ 4);
+}
+
+// Tasks of shards without workers should be stolen by workers of other shards.
+TEST_F(ThreadPoolTest, TestWorkStealing) {
+  TestMultiProducers(/* num_workers= */ 1, /* num_shards= */ 4);
+}
+
 TEST_F(ThreadPoolTest, TestQueueOverflow) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
@@ -218,6 +232,109 @@ TEST_F(ThreadPoolTest, TestShutdown) {
   }
 }
 
+namespace {
+
+// Measures time of round trips made by producers, each of them enqueues the next task only after
+// the previous one is done. So tasks are enqueued while workers are idle.
+MonoDelta MeasureRoundTrips(size_t num_shards, size_t num_round_trips) {
+  constexpr size_t kProducers = 4;
+  ThreadPool pool("test", kProducers, kProducers, num_shards);
+
+  std::vector<std::thread> threads;
+  const auto start = MonoTime::Now();
+  for (size_t i = 0; i != kProducers; ++i) {
+    threads.emplace_back([&pool, num_round_trips] {
+      CDSAttacher attacher;
+      CountDownLatch latch(1);
+      std::vector<TestTask> tasks(num_round_trips);
+      for (auto& task : tasks) {
+        latch.Reset(1);
+        task.SetLatch(&latch);
+        ASSERT_TRUE(pool.Enqueue(&task));
+        latch.Wait();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return MonoTime::Now() - start;
+}
+
+// Measures time of enqueueing and executing tasks by concurrent producers, each of them enqueues
+// batches of tasks and waits for the batch to complete.
+MonoDelta MeasureThroughput(size_t num_producers, size_t num_shards, size_t num_batches) {
+  constexpr size_t kBatchSize = 100;
+  ThreadPool pool("test", num_producers * kBatchSize, num_producers, num_shards);
+
+  std::vector<std::thread> threads;
+  const auto start = MonoTime::Now();
+  for (size_t i = 0; i != num_producers; ++i) {
+    threads.emplace_back([&pool, num_batches] {
+      CDSAttacher attacher;
+      CountDownLatch latch(kBatchSize);
+      std::vector<TestTask> tasks(kBatchSize);
+      for (size_t batch = 0; batch != num_batches; ++batch) {
+        latch.Reset(kBatchSize);
+        for (auto& task : tasks) {
+          task.SetLatch(&latch);
+          ASSERT_TRUE(pool.Enqueue(&task));
+        }
+        latch.Wait();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return MonoTime::Now() - start;
+}
+
+} // namespace
+
+// Compares throughput of a pool with a single shard and a pool with a shard per producer, the way
+// the messenger creates a shard per reactor.
+TEST_F(ThreadPoolTest, BenchmarkShardedThroughput) {
+  const auto kBatches = RegularBuildVsSanitizers<size_t>(2000, 100);
+  const size_t kProducers = std::max<size_t>(std::thread::hardware_concurrency() / 2, 2);
+
+  MonoDelta single_shard_time;
+  MonoDelta sharded_time;
+  // Run each configuration twice and keep the best time to reduce noise.
+  for (int run = 0; run != 2; ++run) {
+    auto time = MeasureThroughput(kProducers, 1, kBatches);
+    if (!single_shard_time || time < single_shard_time) {
+      single_shard_time = time;
+    }
+    time = MeasureThroughput(kProducers, kProducers, kBatches);
+    if (!sharded_time || time < sharded_time) {
+      sharded_time = time;
+    }
+  }
+  const auto num_tasks = kProducers * kBatches * 100;
+  LOG(INFO) << "Producers: " << kProducers
+            << ", single shard: " << single_shard_time.ToMicroseconds() * 1000.0 / num_tasks
+            << "ns per task, sharded: " << sharded_time.ToMicroseconds() * 1000.0 / num_tasks
+            << "ns per task";
+#if !defined(THREAD_SANITIZER) && !defined(ADDRESS_SANITIZER)
+  ASSERT_LE(sharded_time.ToMicroseconds(), single_shard_time.ToMicroseconds() * 1.1);
+#endif
+}
+
+// Compares latency of tasks executed by idle workers, with different rpc_worker_spin_iterations.
+TEST_F(ThreadPoolTest, BenchmarkSpinIterations) {
+  const auto kRoundTrips = RegularBuildVsSanitizers<size_t>(20000, 1000);
+
+  for (size_t num_shards : {1, 4}) {
+    for (int spin_iterations : {0, 10, 100, 1000}) {
+      ANNOTATE_UNPROTECTED_WRITE(FLAGS_rpc_worker_spin_iterations) = spin_iterations;
+      const auto time = MeasureRoundTrips(num_shards, kRoundTrips);
+      LOG(INFO) << "Shards: " << num_shards << ", spin iterations: " << spin_iterations
+                << ", round trip: " << time.ToMicroseconds() * 1.0 / kRoundTrips << "us";
+    }
+  }
+}
+
 TEST_F(ThreadPoolTest, TestOwns) {
   class TestTask : public ThreadPoolTask {
    public:
@@ -15,16 +15,31 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/gutil/atomicops.h"
+#include "yb/gutil/port.h"
+
+#include "yb/util/flag_tags.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
 #include "yb/util/thread.h"
 
+DEFINE_int32(rpc_worker_spin_iterations, 0,
+             "Number of times idle rpc worker checks task queues, before going to sleep. "
+             "Spinning could lower latency of tasks enqueued at a high rate, at the cost of CPU "
+             "burnt by idle workers. 0 disables spinning. Should be tuned with "
+             "ThreadPoolTest.BenchmarkSpinIterations, rpc-bench or mt-rpc-test on the target "
+             "hardware.");
+TAG_FLAG(rpc_worker_spin_iterations, advanced);
+TAG_FLAG(rpc_worker_spin_iterations, runtime);
+
 namespace yb {
 namespace rpc {
 
@@ -35,13 +50,72 @@ class Worker;
 typedef cds::container::BasketQueue<cds::gc::DHP, ThreadPoolTask*> TaskQueue;
 typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
-struct ThreadPoolShare {
-  ThreadPoolOptions options;
+// Shard of the thread pool. Tasks are added to the shard of the thread that enqueues them, and
+// workers process tasks of their own shard first, so a task is usually executed on the same
+// core, where it was received.
+struct ThreadPoolShard {
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
+  char padding1[CACHELINE_SIZE];
+  // Upper bound of the number of workers in waiting_workers. Padded, so workers of different
+  // shards do not contend on the same cache line when they go to sleep or wake up.
+  std::atomic<size_t> num_waiting_workers{0};
+  char padding2[CACHELINE_SIZE];
+};
+
+// Shard of the current thread in the thread pool with the specified id.
+struct ProducerShard {
+  uint64_t pool_id = 0;
+  size_t shard = 0;
+};
+
+// Shards of the current thread in the pools it enqueues to, indexed by pool id. A thread usually
+// enqueues to a few pools only, e.g. a reactor to the normal and high priority pools of its
+// messenger, so a collision just assigns another shard to the thread.
+constexpr size_t kProducerShardsSize = 4;
+thread_local ProducerShard producer_shards[kProducerShardsSize];
+
+std::atomic<uint64_t> next_pool_id{1};
+
+struct ThreadPoolShare {
+  ThreadPoolOptions options;
+  const uint64_t id;
+  const size_t num_shards;
+  std::unique_ptr<ThreadPoolShard[]> shards;
+  // Shard assigned to the next thread that enqueues to this pool.
+  std::atomic<size_t> next_producer_shard{0};
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)),
+        id(next_pool_id.fetch_add(1, std::memory_order_relaxed)),
+        num_shards(std::max<size_t>(options.num_shards, 1)),
+        shards(new ThreadPoolShard[num_shards]) {}
+
+  // Returns the shard of the current thread. Threads get shards of the pool in round robin on
+  // their first enqueue, so reactors, that are the usual producers, get distinct shards.
+  size_t CurrentShard() {
+    auto& producer_shard = producer_shards[id % kProducerShardsSize];
+    if (producer_shard.pool_id != id) {
+      SetCurrentShard(next_producer_shard.fetch_add(1, std::memory_order_relaxed) % num_shards);
+    }
+    return producer_shard.shard;
+  }
+
+  void SetCurrentShard(size_t shard) {
+    producer_shards[id % kProducerShardsSize] = ProducerShard{id, shard};
+  }
+
+  // Pops task from the specified shard, or steals it from another shard.
+  bool PopTask(size_t shard, ThreadPoolTask** task) {
+    for (size_t i = 0; i != num_shards; ++i) {
+      if (shards[(shard + i) % num_shards].task_queue.pop(*task)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool NotifyWaitingWorker(size_t shard);
 };
 
 namespace {
@@ -52,8 +126,8 @@ const std::string kRpcThreadCategory = "rpc_thread_pool";
 
 class Worker {
  public:
-  explicit Worker(ThreadPoolShare* share)
-      : share_(share) {
+  Worker(ThreadPoolShare* share, size_t shard)
+      : share_(share), shard_(shard) {
   }
 
   CHECKED_STATUS Start(size_t index) {
@@ -79,6 +153,7 @@ class Worker {
   bool Notify() {
     std::lock_guard<std::mutex> lock(mutex_);
     added_to_waiting_workers_ = false;
+    share_->shards[shard_].num_waiting_workers.fetch_sub(1, std::memory_order_acq_rel);
     // There could be cases when we popped task after adding ourselves to worker queue (see below).
     // So we are already processing task, but reside in worker queue.
     // To handle this case we use waiting_task_ flag.
@@ -92,12 +167,14 @@ class Worker {
   }
 
  private:
-  // Our main invariant is empty task queue or empty worker queue.
-  // In other words, one of those queues should be empty.
-  // Meaning that we does not have work (task queue empty) or
-  // does not have free hands (worker queue empty)
+  // Our main invariant is empty task queues or empty worker queues.
+  // In other words, one of those should be empty.
+  // Meaning that we does not have work (task queues empty) or
+  // does not have free hands (worker queues empty)
   void Execute() {
     Thread::current_thread()->SetUserData(share_);
+    // Tasks enqueued by this worker are added to its own shard.
+    share_->SetCurrentShard(shard_);
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
       if (PopTask(&task)) {
@@ -109,10 +186,18 @@ class Worker {
 
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
-    // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    // Spin for some time before going to sleep, since waking up a sleeping worker is much more
+    // expensive than checking the queues.
+    if (share_->PopTask(shard_, task)) {
       return true;
     }
+    for (auto i = FLAGS_rpc_worker_spin_iterations; i > 0 && !stop_requested_; --i) {
+      base::subtle::PauseCPU();
+      if (share_->PopTask(shard_, task)) {
+        return true;
+      }
+    }
+
     std::unique_lock<std::mutex> lock(mutex_);
     waiting_task_ = true;
     auto se = ScopeExit([this] {
@@ -126,7 +211,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(shard_, task)) {
         return true;
       }
 
@@ -134,7 +219,7 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(shard_, task)) {
         return true;
       }
     }
@@ -143,13 +228,19 @@ class Worker {
 
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
-      auto pushed = share_->waiting_workers.push(this);
+      auto& shard = share_->shards[shard_];
+      shard.num_waiting_workers.fetch_add(1, std::memory_order_acq_rel);
+      auto pushed = shard.waiting_workers.push(this);
       DCHECK(pushed); // BasketQueue always succeed.
       added_to_waiting_workers_ = true;
+      // Pairs with the fence in Enqueue, so either we see the queued task, or the enqueuing
+      // thread sees us waiting.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
     }
   }
 
   ThreadPoolShare* share_;
+  const size_t shard_;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::condition_variable cond_;
@@ -158,6 +249,23 @@ class Worker {
   bool added_to_waiting_workers_ = false;
 };
 
+// Notifies waiting worker, preferring workers of the specified shard.
+bool ThreadPoolShare::NotifyWaitingWorker(size_t shard) {
+  for (size_t i = 0; i != num_shards; ++i) {
+    auto& current_shard = shards[(shard + i) % num_shards];
+    if (current_shard.num_waiting_workers.load(std::memory_order_acquire) == 0) {
+      continue;
+    }
+    Worker* worker = nullptr;
+    while (current_shard.waiting_workers.pop(worker)) {
+      if (worker->Notify()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 } // namespace
 
 class ThreadPool::Impl {
@@ -182,14 +290,14 @@ class ThreadPool::Impl {
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
+    const auto shard = share_.CurrentShard();
+    bool added = share_.shards[shard].task_queue.push(task);
     DCHECK(added); // BasketQueue always succeed.
-    Worker* worker = nullptr;
-    while (share_.waiting_workers.pop(worker)) {
-      if (worker->Notify()) {
-        --adding_;
-        return true;
-      }
+    // Pairs with the fence in Worker::AddToWaitingWorkers.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (share_.NotifyWaitingWorker(shard)) {
+      --adding_;
+      return true;
     }
     --adding_;
 
@@ -200,7 +308,7 @@ class ThreadPool::Impl {
     if (index < share_.options.max_workers) {
       std::lock_guard<std::mutex> lock(mutex_);
       if (!closing_) {
-        auto new_worker = std::make_unique<Worker>(&share_);
+        auto new_worker = std::make_unique<Worker>(&share_, workers_.size() % share_.num_shards);
         auto status = new_worker->Start(workers_.size());
         if (status.ok()) {
           workers_.push_back(std::move(new_worker));
@@ -222,7 +330,9 @@ class ThreadPool::Impl {
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (size_t i = 0; i != share_.num_shards; ++i) {
+          CHECK(share_.shards[i].task_queue.empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -241,7 +351,7 @@ class ThreadPool::Impl {
     }
     workers_.clear();
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
+    while (share_.PopTask(0, &task)) {
       task->Done(shutdown_status_);
     }
   }
@@ -76,9 +76,12 @@ struct ThreadPoolOptions {
   std::string name;
   size_t queue_limit;
   size_t max_workers;
+  // Number of task queues. Each worker is bound to a queue and steals tasks from other queues
+  // when its own queue is empty. Usually equal to the number of reactors.
+  size_t num_shards = 1;
 
   std::string ToString() const {
-    return YB_STRUCT_TO_STRING(name, queue_limit, max_workers);
+    return YB_STRUCT_TO_STRING(name, queue_limit, max_workers, num_shards);
   }
 };
 
@@ -319,12 +319,44 @@ size_t YBInboundCall::AddRpcSidecar(Slice car) {
   return num_sidecars_++;
 }
 
+size_t YBInboundCall::AddRpcSidecar(RefCntBuffer car, size_t allocated_size) {
+  DCHECK_GE(allocated_size, car.size());
+  sidecar_offsets_.Add(narrow_cast<uint32_t>(total_sidecars_size_));
+  total_sidecars_size_ += car.size();
+  if (car.size() == 0) {
+    return num_sidecars_++;
+  }
+
+  // Sidecars are sent as a contiguous sequence of bytes, so unused tail of the last buffer
+  // should not be sent, and following sidecars would be copied after the attached buffer.
+  if (!sidecar_buffers_.empty()) {
+    auto& last_buffer = sidecar_buffers_.back();
+    if (consumption_) {
+      consumption_.Add(
+          static_cast<int64_t>(filled_bytes_in_last_sidecar_buffer_) -
+          static_cast<int64_t>(last_buffer.size()));
+    }
+    last_buffer.Shrink(filled_bytes_in_last_sidecar_buffer_);
+  }
+
+  if (consumption_) {
+    consumption_.Add(allocated_size);
+  }
+  attached_sidecars_overhead_ += allocated_size - car.size();
+  filled_bytes_in_last_sidecar_buffer_ = car.size();
+  sidecar_buffers_.push_back(std::move(car));
+
+  return num_sidecars_++;
+}
+
 void YBInboundCall::ResetRpcSidecars() {
   if (consumption_) {
     for (const auto& buffer : sidecar_buffers_) {
       consumption_.Add(-buffer.size());
     }
+    consumption_.Add(-attached_sidecars_overhead_);
   }
+  attached_sidecars_overhead_ = 0;
   num_sidecars_ = 0;
   filled_bytes_in_last_sidecar_buffer_ = 0;
   total_sidecars_size_ = 0;
@@ -0,0 +1,87 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/key_access_sampler.h"
+
+#include "yb/util/format.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+class KeyAccessSamplerTest : public YBTest {
+};
+
+TEST_F(KeyAccessSamplerTest, Disabled) {
+  KeyAccessSampler sampler(0);
+  sampler.Record("key");
+  ASSERT_TRUE(sampler.SortedSamples().empty());
+}
+
+TEST_F(KeyAccessSamplerTest, Sorted) {
+  KeyAccessSampler sampler(100);
+  for (int i = 10; i-- > 0;) {
+    sampler.Record(Format("key-$0", i));
+  }
+  auto samples = sampler.SortedSamples();
+  ASSERT_EQ(10U, samples.size());
+  for (int i = 0; i != 10; ++i) {
+    ASSERT_EQ(Format("key-$0", i), samples[i]);
+  }
+}
+
+TEST_F(KeyAccessSamplerTest, FollowsRecentAccesses) {
+  constexpr size_t kCapacity = 64;
+  constexpr int kNumAccesses = 10000;
+
+  KeyAccessSampler sampler(kCapacity);
+  for (int i = 0; i != kNumAccesses; ++i) {
+    sampler.Record(Format("a-$0", i % 100));
+  }
+  for (int i = 0; i != kNumAccesses; ++i) {
+    sampler.Record(Format("b-$0", i % 100));
+  }
+  auto samples = sampler.SortedSamples();
+  ASSERT_EQ(kCapacity, samples.size());
+  for (const auto& sample : samples) {
+    ASSERT_EQ('b', sample[0]) << sample;
+  }
+}
+
+TEST_F(KeyAccessSamplerTest, Concurrent) {
+  constexpr size_t kCapacity = 128;
+  constexpr int kNumThreads = 8;
+  constexpr int kAccessesPerThread = 5000;
+
+  KeyAccessSampler sampler(kCapacity);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([&sampler, t] {
+      for (int i = 0; i != kAccessesPerThread; ++i) {
+        sampler.Record(Format("key-$0-$1", t, i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(static_cast<uint64_t>(kNumThreads * kAccessesPerThread), sampler.num_recorded());
+  ASSERT_EQ(kCapacity, sampler.SortedSamples().size());
+}
+
+} // namespace tablet
+} // namespace yb
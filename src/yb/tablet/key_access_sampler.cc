@@ -0,0 +1,65 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/key_access_sampler.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "yb/util/random_util.h"
+
+namespace yb {
+namespace tablet {
+
+KeyAccessSampler::KeyAccessSampler(size_t capacity) : capacity_(capacity) {
+}
+
+void KeyAccessSampler::Record(Slice key) {
+  if (capacity_ == 0 || key.empty()) {
+    return;
+  }
+  const auto num_recorded = num_recorded_.fetch_add(1, std::memory_order_acq_rel);
+  uint64_t index = num_recorded;
+  if (index >= capacity_) {
+    index = RandomUniformInt<uint64_t>(
+        0, std::min<uint64_t>(num_recorded, capacity_ * kHistoryFactor));
+    if (index >= capacity_) {
+      return;
+    }
+  }
+
+  std::lock_guard<simple_spinlock> lock(mutex_);
+  // Concurrent callers could fill the first capacity_ samples out of order.
+  if (index >= samples_.size()) {
+    samples_.resize(index + 1);
+  }
+  samples_[index].assign(key.cdata(), key.size());
+}
+
+std::vector<std::string> KeyAccessSampler::SortedSamples() const {
+  std::vector<std::string> result;
+  {
+    std::lock_guard<simple_spinlock> lock(mutex_);
+    result.reserve(samples_.size());
+    for (const auto& sample : samples_) {
+      if (!sample.empty()) {
+        result.push_back(sample);
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+} // namespace tablet
+} // namespace yb
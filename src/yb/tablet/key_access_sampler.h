@@ -0,0 +1,67 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_KEY_ACCESS_SAMPLER_H
+#define YB_TABLET_KEY_ACCESS_SAMPLER_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace tablet {
+
+// Keeps a bounded random sample of the keys accessed by the tablet requests, used to pick a split
+// key that divides the load of the tablet instead of its data.
+//
+// It is a reservoir sample, except that the probability of a new key to get into the sample does
+// not decrease below 1 / kHistoryFactor, so the sample follows recent accesses.
+//
+// This class is thread-safe. Recording a key that does not get into the sample takes no locks.
+class KeyAccessSampler {
+ public:
+  // The sample contains keys from approximately last capacity * kHistoryFactor recorded accesses.
+  static constexpr uint64_t kHistoryFactor = 4;
+
+  // Zero capacity disables sampling.
+  explicit KeyAccessSampler(size_t capacity);
+
+  KeyAccessSampler(const KeyAccessSampler&) = delete;
+  void operator=(const KeyAccessSampler&) = delete;
+
+  void Record(Slice key);
+
+  // Returns sampled keys in sorted order.
+  std::vector<std::string> SortedSamples() const;
+
+  uint64_t num_recorded() const {
+    return num_recorded_.load(std::memory_order_acquire);
+  }
+
+ private:
+  const size_t capacity_;
+  std::atomic<uint64_t> num_recorded_{0};
+
+  mutable simple_spinlock mutex_;
+  std::vector<std::string> samples_ GUARDED_BY(mutex_);
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_KEY_ACCESS_SAMPLER_H
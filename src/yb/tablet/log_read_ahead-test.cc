@@ -0,0 +1,157 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log-test-base.h"
+#include "yb/consensus/log_index.h"
+#include "yb/consensus/log_reader.h"
+#include "yb/consensus/opid_util.h"
+
+#include "yb/tablet/log_read_ahead.h"
+
+#include "yb/util/size_literals.h"
+#include "yb/util/test_macros.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tablet {
+
+constexpr size_t kNumSegments = 3;
+constexpr size_t kEntriesPerSegment = 100;
+
+class LogReadAheadTest : public log::LogTestBase {
+ protected:
+  // Writes kNumSegments segments of no op entries with indexes starting from 1 and closes the log.
+  void WriteLog() {
+    BuildLog();
+    OpIdPB op_id = consensus::MakeOpId(1, 1);
+    for (size_t i = 0; i != kNumSegments; ++i) {
+      if (i != 0) {
+        ASSERT_OK(RollLog());
+      }
+      ASSERT_OK(AppendNoOps(&op_id, kEntriesPerSegment));
+    }
+    ASSERT_OK(log_->Close());
+  }
+
+  // Opens a new reader, so segment headers and footers are not cached.
+  Result<log::SegmentSequence> ReadSegments() {
+    std::unique_ptr<log::LogReader> reader;
+    RETURN_NOT_OK(log::LogReader::Open(
+        fs_manager_->env(), make_scoped_refptr(new log::LogIndex(tablet_wal_path_)),
+        "Log reader: ", tablet_wal_path_, nullptr, nullptr, &reader));
+    log::SegmentSequence segments;
+    RETURN_NOT_OK(reader->GetSegmentsSnapshot(&segments));
+    return segments;
+  }
+
+  // Reads the remaining chunks and checks that entries are returned in order, starting from the
+  // given segment. Returns the number of read entries.
+  size_t ReadAndCheckOrder(LogReadAhead* read_ahead, size_t first_segment = 0) {
+    const int64_t first_index = first_segment * kEntriesPerSegment + 1;
+    int64_t expected_index = first_index;
+    size_t segment_index = first_segment;
+    size_t finished_segments = 0;
+    LogReadAhead::Chunk chunk;
+    while (read_ahead->Next(&chunk)) {
+      EXPECT_OK(chunk.read_result.status);
+      EXPECT_LE(chunk.segment_index, segment_index + 1);
+      EXPECT_GE(chunk.segment_index, segment_index);
+      segment_index = chunk.segment_index;
+      for (const auto& entry : chunk.read_result.entries) {
+        EXPECT_EQ(expected_index, entry->replicate().id().index());
+        ++expected_index;
+      }
+      if (chunk.last_in_segment) {
+        ++finished_segments;
+      }
+    }
+    EXPECT_EQ(kNumSegments - first_segment, finished_segments);
+    return expected_index - first_index;
+  }
+};
+
+TEST_F(LogReadAheadTest, Order) {
+  ASSERT_NO_FATALS(WriteLog());
+  auto segments = ASSERT_RESULT(ReadSegments());
+  ASSERT_EQ(kNumSegments, segments.size());
+
+  // Without read ahead, with chunks of a few entries and with whole segments read ahead.
+  for (size_t memory_budget : {0_KB, 1_KB, 64_MB}) {
+    LogReadAhead read_ahead(segments, memory_budget);
+    ASSERT_OK(read_ahead.Start("test"));
+    ASSERT_EQ(kNumSegments * kEntriesPerSegment, ReadAndCheckOrder(&read_ahead));
+  }
+}
+
+TEST_F(LogReadAheadTest, SharedBudget) {
+  ASSERT_NO_FATALS(WriteLog());
+  auto segments = ASSERT_RESULT(ReadSegments());
+
+  // The shared budget is exhausted, so only one chunk could be read ahead at a time, while the
+  // tablet budget allows reading all segments ahead.
+  auto tracker = MemTracker::CreateTracker(0, "log-read-ahead-test");
+  {
+    LogReadAhead read_ahead(segments, 64_MB, tracker);
+    ASSERT_OK(read_ahead.Start("test"));
+    ASSERT_OK(WaitFor([&tracker] { return tracker->consumption() > 0; }, 10s, "Chunk read"));
+    // Give read ahead time to read more chunks, if it ignores the shared budget.
+    SleepFor(100ms);
+    const auto queued_bytes = tracker->consumption();
+    LogReadAhead::Chunk chunk;
+    ASSERT_TRUE(read_ahead.Next(&chunk));
+    ASSERT_EQ(queued_bytes, static_cast<int64_t>(chunk.bytes));
+    ASSERT_EQ(0U, chunk.segment_index);
+    ASSERT_TRUE(chunk.last_in_segment);
+    ASSERT_EQ((kNumSegments - 1) * kEntriesPerSegment, ReadAndCheckOrder(&read_ahead, 1));
+  }
+  ASSERT_EQ(0, tracker->consumption());
+
+  // Chunks that are read ahead but not replayed are released when read ahead is destroyed.
+  {
+    LogReadAhead read_ahead(segments, 64_MB, tracker);
+    ASSERT_OK(read_ahead.Start("test"));
+    ASSERT_OK(WaitFor([&tracker] { return tracker->consumption() > 0; }, 10s, "Chunk read"));
+  }
+  ASSERT_EQ(0, tracker->consumption());
+}
+
+TEST_F(LogReadAheadTest, ReadError) {
+  ASSERT_NO_FATALS(WriteLog());
+  {
+    auto segments = ASSERT_RESULT(ReadSegments());
+    const auto& segment = segments.front();
+    const auto offset =
+        segment->first_entry_offset() + (segment->file_size() - segment->first_entry_offset()) / 2;
+    ASSERT_OK(log::CorruptLogFile(env_.get(), segment->path(), log::FLIP_BYTE, offset));
+  }
+  auto segments = ASSERT_RESULT(ReadSegments());
+
+  for (size_t memory_budget : {0_KB, 64_MB}) {
+    LogReadAhead read_ahead(segments, memory_budget);
+    ASSERT_OK(read_ahead.Start("test"));
+    LogReadAhead::Chunk chunk;
+    Status status;
+    while (status.ok()) {
+      ASSERT_TRUE(read_ahead.Next(&chunk));
+      ASSERT_EQ(0U, chunk.segment_index);
+      status = chunk.read_result.status;
+    }
+    ASSERT_NOK(status);
+    // Segments after the broken one are not read.
+    ASSERT_FALSE(read_ahead.Next(&chunk));
+  }
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,171 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/log_read_ahead.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "yb/util/format.h"
+#include "yb/util/size_literals.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+constexpr size_t kChunkBytes = 4_MB;
+
+// Interval between attempts to reserve memory in the shared tracker, that is released by other
+// tablets without notifying this one.
+constexpr auto kSharedBudgetRetryInterval = 10ms;
+
+} // namespace
+
+LogReadAhead::LogReadAhead(
+    log::SegmentSequence segments, size_t memory_budget, MemTrackerPtr shared_tracker)
+    : segments_(std::move(segments)),
+      memory_budget_(memory_budget),
+      chunk_bytes_(memory_budget == 0 ? kChunkBytes : std::min(memory_budget, kChunkBytes)),
+      shared_tracker_(std::move(shared_tracker)) {
+}
+
+LogReadAhead::~LogReadAhead() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  if (thread_) {
+    thread_->Join();
+  }
+  if (shared_tracker_ && queued_bytes_ != 0) {
+    shared_tracker_->Release(queued_bytes_);
+  }
+}
+
+Status LogReadAhead::Start(const std::string& tablet_id) {
+  if (memory_budget_ == 0 || segments_.empty()) {
+    return Status::OK();
+  }
+  return Thread::Create(
+      "tablet", Format("log-read-ahead-$0", tablet_id), &LogReadAhead::Run, this, &thread_);
+}
+
+bool LogReadAhead::Next(Chunk* chunk) {
+  if (!thread_) {
+    return ReadChunk(chunk);
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return !chunks_.empty() || finished_; });
+    if (chunks_.empty()) {
+      return false;
+    }
+    *chunk = std::move(chunks_.front());
+    chunks_.pop_front();
+    queued_bytes_ -= chunk->bytes;
+  }
+  if (shared_tracker_) {
+    shared_tracker_->Release(chunk->bytes);
+  }
+  cond_.notify_all();
+  return true;
+}
+
+bool LogReadAhead::ReadChunk(Chunk* chunk) {
+  if (segment_index_ == segments_.size()) {
+    return false;
+  }
+
+  const auto& segment = segments_[segment_index_];
+  const auto start_offset =
+      read_state_.offset < 0 ? segment->first_entry_offset() : read_state_.offset;
+  chunk->segment_index = segment_index_;
+  chunk->read_result = segment->ReadEntries(
+      &read_state_, std::numeric_limits<int64_t>::max(), chunk_bytes_);
+  chunk->bytes = chunk->read_result.end_offset - start_offset;
+  chunk->last_in_segment = read_state_.finished;
+  if (!chunk->read_result.status.ok()) {
+    // Replay fails after this chunk, so there is no reason to read further.
+    segment_index_ = segments_.size();
+  } else if (read_state_.finished) {
+    ++segment_index_;
+    read_state_ = log::ReadableLogSegment::ReadEntriesState();
+  }
+  return true;
+}
+
+bool LogReadAhead::WaitForBudget(std::unique_lock<std::mutex>* lock) {
+  for (;;) {
+    if (stop_) {
+      return false;
+    }
+    if (queued_bytes_ >= memory_budget_) {
+      cond_.wait(*lock);
+      continue;
+    }
+    if (!shared_tracker_) {
+      return true;
+    }
+    if (queued_bytes_ == 0) {
+      shared_tracker_->Consume(chunk_bytes_);
+      return true;
+    }
+    if (shared_tracker_->TryConsume(chunk_bytes_)) {
+      return true;
+    }
+    cond_.wait_for(*lock, kSharedBudgetRetryInterval);
+  }
+}
+
+void LogReadAhead::Run() {
+  Chunk chunk;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!WaitForBudget(&lock)) {
+        return;
+      }
+    }
+    const bool has_chunk = ReadChunk(&chunk);
+    if (shared_tracker_) {
+      // Replace the reservation with the actual size of the chunk.
+      const auto bytes = has_chunk ? chunk.bytes : 0;
+      if (bytes > chunk_bytes_) {
+        shared_tracker_->Consume(bytes - chunk_bytes_);
+      } else if (bytes < chunk_bytes_) {
+        shared_tracker_->Release(chunk_bytes_ - bytes);
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (has_chunk) {
+        queued_bytes_ += chunk.bytes;
+        chunks_.push_back(std::move(chunk));
+      } else {
+        finished_ = true;
+      }
+    }
+    cond_.notify_all();
+    if (!has_chunk) {
+      return;
+    }
+  }
+}
+
+} // namespace tablet
+} // namespace yb
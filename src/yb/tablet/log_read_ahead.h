@@ -0,0 +1,93 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_LOG_READ_AHEAD_H
+#define YB_TABLET_LOG_READ_AHEAD_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "yb/consensus/log_util.h"
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/status.h"
+#include "yb/util/thread.h"
+
+namespace yb {
+namespace tablet {
+
+// Reads entries of log segments chunk by chunk, so a segment is never materialized in memory all
+// at once. When read ahead is enabled, chunks are read and decoded by a separate thread while
+// previously read chunks are replayed.
+//
+// The size of chunks that are read but not yet taken for replay is bounded by memory_budget.
+// When shared_tracker is specified, it is also consumed by the queued chunks, so read ahead of all
+// tablets sharing this tracker is bounded by the tracker limit. A chunk is always read when
+// nothing is queued, so replay makes progress even when the shared limit is exceeded.
+class LogReadAhead {
+ public:
+  struct Chunk {
+    // Index of the segment in the sequence passed to the constructor.
+    size_t segment_index = 0;
+    log::ReadEntriesResult read_result;
+    // Size of the read entries in the segment file.
+    size_t bytes = 0;
+    // Whether it is the last chunk read from its segment.
+    bool last_in_segment = false;
+  };
+
+  LogReadAhead(log::SegmentSequence segments, size_t memory_budget,
+               MemTrackerPtr shared_tracker = nullptr);
+
+  ~LogReadAhead();
+
+  CHECKED_STATUS Start(const std::string& tablet_id);
+
+  // Returns the next chunk, waiting for it to be read if necessary.
+  // Returns false when all segments were read. A chunk with read error is the last one returned.
+  bool Next(Chunk* chunk);
+
+ private:
+  bool ReadChunk(Chunk* chunk);
+
+  // Waits until the next chunk could be read ahead and reserves chunk_bytes_ in shared_tracker_.
+  // Returns false if read ahead was stopped.
+  bool WaitForBudget(std::unique_lock<std::mutex>* lock);
+
+  void Run();
+
+  const log::SegmentSequence segments_;
+  const size_t memory_budget_;
+  const size_t chunk_bytes_;
+  const MemTrackerPtr shared_tracker_;
+
+  // Reading position, accessed by the reading thread only.
+  size_t segment_index_ = 0;
+  log::ReadableLogSegment::ReadEntriesState read_state_;
+
+  scoped_refptr<Thread> thread_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<Chunk> chunks_;
+  size_t queued_bytes_ = 0;
+  bool finished_ = false;
+  bool stop_ = false;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_LOG_READ_AHEAD_H
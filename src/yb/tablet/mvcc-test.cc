@@ -30,7 +30,9 @@
 // under the License.
 //
 
+#include <deque>
 #include <sstream>
+#include <thread>
 
 #include <glog/logging.h>
 
@@ -47,6 +49,8 @@
 #include "yb/util/status.h"
 #include "yb/util/test_util.h"
 
+DECLARE_bool(TEST_mvcc_disable_lock_free_safe_time);
+
 using namespace std::literals;
 using std::vector;
 
@@ -367,5 +371,86 @@ TEST_F(MvccTest, WaitForSafeTime) {
   ASSERT_FALSE(manager_.SafeTime(ht3, CoarseMonoClock::now() + 100ms, FixedHybridTimeLease()));
 }
 
+namespace {
+
+// Safe time requests of the read path are executed concurrently with operations that are added and
+// replicated by the write path. Returns the number of safe time requests per second.
+double MeasureSafeTimeContention(server::Clock* clock) {
+  constexpr int kNumReaders = 8;
+  constexpr size_t kMaxPendingOperations = 8;
+  const auto kTestTime = 2s;
+
+  MvccManager manager(std::string(), clock);
+  std::atomic<bool> stopped{false};
+  std::atomic<size_t> num_safe_time_requests{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i != kNumReaders; ++i) {
+    readers.emplace_back([clock, &manager, &stopped, &num_safe_time_requests] {
+      HybridTime prev_safe_time = HybridTime::kMin;
+      size_t num_requests = 0;
+      while (!stopped.load(std::memory_order_acquire)) {
+        auto now = clock->Now();
+        auto safe_time = manager.SafeTime({
+          .time = now,
+          .lease = now,
+        });
+        ASSERT_GE(safe_time, prev_safe_time);
+        prev_safe_time = safe_time;
+        ++num_requests;
+      }
+      num_safe_time_requests += num_requests;
+    });
+  }
+
+  std::deque<std::pair<HybridTime, OpId>> pending;
+  size_t num_operations = 0;
+  int64_t op_index = 0;
+  const auto start = CoarseMonoClock::now();
+  const auto deadline = start + kTestTime;
+  while (CoarseMonoClock::now() < deadline) {
+    OpId op_id(1, ++op_index);
+    pending.emplace_back(manager.AddLeaderPending(op_id), op_id);
+    if (pending.size() >= kMaxPendingOperations) {
+      manager.Replicated(pending.front().first, pending.front().second);
+      pending.pop_front();
+      ++num_operations;
+    }
+  }
+  for (const auto& operation : pending) {
+    manager.Replicated(operation.first, operation.second);
+    ++num_operations;
+  }
+  stopped = true;
+  for (auto& thread : readers) {
+    thread.join();
+  }
+
+  const auto passed_seconds = MonoDelta(CoarseMonoClock::now() - start).ToSeconds();
+  const auto requests_per_second = num_safe_time_requests.load() / passed_seconds;
+  LOG(INFO) << "Safe time requests: " << num_safe_time_requests.load() << " ("
+            << requests_per_second << "/s), operations: "
+            << num_operations << " (" << num_operations / passed_seconds << "/s)";
+  EXPECT_GT(num_safe_time_requests.load(), 0U);
+  EXPECT_GT(num_operations, 0U);
+  return requests_per_second;
+}
+
+} // namespace
+
+// Compares safe time throughput with and without taking the MvccManager mutex, so it could be
+// used as a benchmark of MvccManager contention.
+TEST_F(MvccTest, SafeTimeContention) {
+  const auto lock_free_requests_per_second = MeasureSafeTimeContention(clock_.get());
+
+  FLAGS_TEST_mvcc_disable_lock_free_safe_time = true;
+  const auto mutex_requests_per_second = MeasureSafeTimeContention(clock_.get());
+
+  LOG(INFO) << "Lock free: " << lock_free_requests_per_second << "/s, mutex: "
+            << mutex_requests_per_second << "/s";
+#if !defined(THREAD_SANITIZER) && !defined(ADDRESS_SANITIZER)
+  ASSERT_GE(lock_free_requests_per_second, mutex_requests_per_second);
+#endif
+}
+
 } // namespace tablet
 } // namespace yb
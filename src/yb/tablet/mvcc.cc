@@ -32,6 +32,8 @@
 
 #include "yb/tablet/mvcc.h"
 
+#include <mutex>
+
 #include <boost/circular_buffer.hpp>
 #include <boost/variant.hpp>
 
@@ -53,6 +55,9 @@ DEFINE_test_flag(int64, mvcc_op_trace_num_items, 32,
 DEFINE_test_flag(int32, inject_mvcc_delay_add_leader_pending_ms, 0,
                  "Inject delay after MvccManager::AddLeaderPending read clock.");
 
+DEFINE_test_flag(bool, mvcc_disable_lock_free_safe_time, false,
+                 "Always take the MvccManager mutex to calculate safe time.");
+
 namespace yb {
 namespace tablet {
 
@@ -150,14 +155,6 @@ struct SafeTimeForFollowerTraceItem {
   }
 };
 
-struct LastReplicatedHybridTimeTraceItem {
-  HybridTime last_replicated;
-
-  std::string ToString() const {
-    return Format("LastReplicatedHybridTime $0", YB_STRUCT_TO_STRING(last_replicated));
-  }
-};
-
 typedef boost::variant<
     SetLeaderOnlyModeTraceItem,
     SetLastReplicatedTraceItem,
@@ -168,8 +165,7 @@ typedef boost::variant<
     ReplicatedTraceItem,
     AbortedTraceItem,
     SafeTimeTraceItem,
-    SafeTimeForFollowerTraceItem,
-    LastReplicatedHybridTimeTraceItem
+    SafeTimeForFollowerTraceItem
     > TraceItemVariant;
 
 class ItemPrintingVisitor : public boost::static_visitor<>{
@@ -241,6 +237,29 @@ std::string SafeTimeWithSource::ToString() const {
   return Format("{ safe_time: $0 source: $1 }", safe_time, source);
 }
 
+// ------------------------------------------------------------------------------------------------
+// AtomicSafeTimeWithSource
+// ------------------------------------------------------------------------------------------------
+
+SafeTimeWithSource AtomicSafeTimeWithSource::Load() const {
+  return SafeTimeWithSource {
+    .safe_time = safe_time(),
+    .source = source_.load(std::memory_order_acquire),
+  };
+}
+
+void AtomicSafeTimeWithSource::UpdateMax(const SafeTimeWithSource& value) {
+  auto current = safe_time_.load(std::memory_order_acquire);
+  while (value.safe_time > current) {
+    if (safe_time_.compare_exchange_weak(current, value.safe_time, std::memory_order_acq_rel)) {
+      if (source_.load(std::memory_order_relaxed) != value.source) {
+        source_.store(value.source, std::memory_order_release);
+      }
+      return;
+    }
+  }
+}
+
 // ------------------------------------------------------------------------------------------------
 // MvccManager
 // ------------------------------------------------------------------------------------------------
@@ -269,8 +288,10 @@ void MvccManager::Replicated(HybridTime ht, const OpId& op_id) {
     CHECK(!queue_.empty()) << InvariantViolationLogPrefix();
     CHECK_EQ(queue_.front(),
              (QueueItem{ .hybrid_time = ht, .op_id = op_id })) << InvariantViolationLogPrefix();
+    BeginStateChange();
     queue_.pop_front();
     last_replicated_ = ht;
+    EndStateChange();
   }
   cond_.notify_all();
 }
@@ -287,7 +308,9 @@ void MvccManager::Aborted(HybridTime ht, const OpId& op_id) {
     CHECK_EQ(queue_.back(),
              (QueueItem{ .hybrid_time = ht, .op_id = op_id }))
         << InvariantViolationLogPrefix() << "It is allowed to abort only last operation";
+    BeginStateChange();
     queue_.pop_back();
+    EndStateChange();
   }
   cond_.notify_all();
 }
@@ -304,10 +327,15 @@ bool BadNextOpId(const OpId& prev, const OpId& next) {
 
 HybridTime MvccManager::AddLeaderPending(const OpId& op_id) {
   std::lock_guard<std::mutex> lock(mutex_);
+  // When there are no pending operations, safe time served without the mutex is picked from the
+  // clock. So the state change should start before the time of the new operation is picked, to
+  // make such requests that could race with this operation fall back to the mutex.
+  BeginStateChange();
   auto ht = clock_->Now();
   AtomicFlagSleepMs(&FLAGS_TEST_inject_mvcc_delay_add_leader_pending_ms);
   VLOG_WITH_PREFIX(1) << __func__ << "(" << op_id << "), time: " << ht;
   AddPending(ht, op_id, /* is_follower_side= */ false);
+  EndStateChange();
 
   if (op_trace_) {
     op_trace_->Add(AddLeaderPendingTraceItem {
@@ -323,7 +351,9 @@ void MvccManager::AddFollowerPending(HybridTime ht, const OpId& op_id) {
   std::lock_guard<std::mutex> lock(mutex_);
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ", " << op_id << ")";
 
+  BeginStateChange();
   AddPending(ht, op_id, /* is_follower_side= */ true);
+  EndStateChange();
 
   if (op_trace_) {
     op_trace_->Add(AddFollowerPendingTraceItem {
@@ -337,11 +367,13 @@ void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_
   CHECK(!op_id.empty());
 
   HybridTime last_ht_in_queue = queue_.empty() ? HybridTime::kMin : queue_.back().hybrid_time;
+  const auto max_safe_time_returned_with_lease = max_safe_time_returned_with_lease_.Load();
+  const auto max_safe_time_returned_without_lease = max_safe_time_returned_without_lease_.Load();
 
   HybridTime sanity_check_lower_bound =
       std::max({
-          max_safe_time_returned_with_lease_.safe_time,
-          max_safe_time_returned_without_lease_.safe_time,
+          max_safe_time_returned_with_lease.safe_time,
+          max_safe_time_returned_without_lease.safe_time,
           max_safe_time_returned_for_follower_.safe_time,
           propagated_safe_time_,
           last_replicated_,
@@ -362,8 +394,8 @@ void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_
 #define LOG_INFO_FOR_HT_LOWER_BOUND(t) LOG_INFO_FOR_HT_LOWER_BOUND_IMPL(t, t)
 
       ss << "New operation's hybrid time too low: " << ht << ", op id: " << op_id
-         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_with_lease_)
-         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_without_lease_)
+         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_with_lease)
+         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_without_lease)
          << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_for_follower_)
          << LOG_INFO_FOR_HT_LOWER_BOUND(last_replicated_)
          << LOG_INFO_FOR_HT_LOWER_BOUND(last_ht_in_queue)
@@ -413,7 +445,9 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
     if (op_trace_) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
+    BeginStateChange();
     last_replicated_ = ht;
+    EndStateChange();
   }
   cond_.notify_all();
 }
@@ -544,6 +578,13 @@ HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
     CoarseTimePoint deadline,
     const FixedHybridTimeLease& ht_lease) const NO_THREAD_SAFETY_ANALYSIS {
+  // Requests served without the mutex are not traced, so they do not write to shared memory.
+  if (!FLAGS_TEST_mvcc_disable_lock_free_safe_time) {
+    auto safe_time = TryGetSafeTimeWithoutLock(min_allowed, ht_lease);
+    if (safe_time) {
+      return safe_time;
+    }
+  }
   std::unique_lock<std::mutex> lock(mutex_);
   auto safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
   if (op_trace_) {
@@ -573,34 +614,19 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
     LOG_IF_WITH_PREFIX(DFATAL, !ht_lease.time.is_valid()) << "Bad ht lease: " << ht_lease;
   }
 
-  HybridTime result;
-  SafeTimeSource source = SafeTimeSource::kUnknown;
-  auto predicate = [this, &result, &source, min_allowed, ht_lease, has_lease] {
-    if (queue_.empty()) {
-      result = ht_lease.time.is_valid()
-          ? std::max(max_safe_time_returned_with_lease_.safe_time, ht_lease.time)
-          : clock_->Now();
-      source = SafeTimeSource::kNow;
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result;
-    } else {
-      result = queue_.front().hybrid_time.Decremented();
-      source = SafeTimeSource::kNextInQueue;
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Queue front (decremented): " << result;
-    }
-
-    if (has_lease) {
-      auto used_lease = std::max({ht_lease.lease, max_safe_time_returned_with_lease_.safe_time});
-      if (result > used_lease) {
-        result = used_lease;
-        source = SafeTimeSource::kHybridTimeLease;
-      }
-    }
-
-    // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
-    // is safe to read at least at last_replicated_.
-    result = std::max(result, last_replicated_);
-
-    return result >= min_allowed;
+  auto& max_safe_time_returned = has_lease ? max_safe_time_returned_with_lease_
+                                           : max_safe_time_returned_without_lease_;
+  SafeTimeWithSource result;
+  HybridTime enforced_min_time;
+  auto predicate = [this, &result, &enforced_min_time, &max_safe_time_returned, min_allowed,
+                    ht_lease, has_lease] {
+    // Safe time could be concurrently returned by TryGetSafeTimeWithoutLock, so the enforced
+    // minimum is read before the safe time is calculated.
+    enforced_min_time = max_safe_time_returned.safe_time();
+    result = CalculateSafeTime(
+        queue_.empty() ? HybridTime::kMax : queue_.front().hybrid_time, last_replicated_,
+        ht_lease, has_lease);
+    return result.safe_time >= min_allowed;
   };
 
   // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid time
@@ -611,14 +637,12 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
     return HybridTime::kInvalid;
   }
   VLOG_WITH_PREFIX_AND_FUNC(1)
-      << "(" << min_allowed << ", " << ht_lease << "),  result = " << result;
+      << "(" << min_allowed << ", " << ht_lease << "),  result = " << result.ToString();
 
-  auto enforced_min_time = has_lease ? max_safe_time_returned_with_lease_.safe_time
-                                     : max_safe_time_returned_without_lease_.safe_time;
-  CHECK_GE(result, enforced_min_time)
+  CHECK_GE(result.safe_time, enforced_min_time)
       << InvariantViolationLogPrefix()
       << ": " << EXPR_VALUE_FOR_LOG(has_lease)
-      << ", " << EXPR_VALUE_FOR_LOG(enforced_min_time.ToUint64() - result.ToUint64())
+      << ", " << EXPR_VALUE_FOR_LOG(enforced_min_time.ToUint64() - result.safe_time.ToUint64())
       << ", " << EXPR_VALUE_FOR_LOG(ht_lease)
       << ", " << EXPR_VALUE_FOR_LOG(last_replicated_)
       << ", " << EXPR_VALUE_FOR_LOG(clock_->Now())
@@ -626,23 +650,87 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
       << ", " << EXPR_VALUE_FOR_LOG(queue_.size())
       << ", " << EXPR_VALUE_FOR_LOG(queue_);
 
-  if (has_lease) {
-    max_safe_time_returned_with_lease_ = { result, source };
+  max_safe_time_returned.UpdateMax(result);
+  return result.safe_time;
+}
+
+SafeTimeWithSource MvccManager::CalculateSafeTime(
+    HybridTime queue_front, HybridTime last_replicated, const FixedHybridTimeLease& ht_lease,
+    bool has_lease) const {
+  SafeTimeWithSource result;
+  if (queue_front == HybridTime::kMax) {
+    result.safe_time = ht_lease.time.is_valid()
+        ? std::max(max_safe_time_returned_with_lease_.safe_time(), ht_lease.time)
+        : clock_->Now();
+    result.source = SafeTimeSource::kNow;
+    VLOG_WITH_PREFIX(2) << "CalculateSafeTime, Now: " << result.safe_time;
   } else {
-    max_safe_time_returned_without_lease_ = { result, source };
+    result.safe_time = queue_front.Decremented();
+    result.source = SafeTimeSource::kNextInQueue;
+    VLOG_WITH_PREFIX(2) << "CalculateSafeTime, Queue front (decremented): " << result.safe_time;
   }
+
+  if (has_lease) {
+    auto used_lease = std::max(
+        {ht_lease.lease, max_safe_time_returned_with_lease_.safe_time()});
+    if (result.safe_time > used_lease) {
+      result.safe_time = used_lease;
+      result.source = SafeTimeSource::kHybridTimeLease;
+    }
+  }
+
+  // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
+  // is safe to read at least at last_replicated.
+  result.safe_time = std::max(result.safe_time, last_replicated);
   return result;
 }
 
-HybridTime MvccManager::LastReplicatedHybridTime() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated_;
-  if (op_trace_) {
-    op_trace_->Add(LastReplicatedHybridTimeTraceItem {
-      .last_replicated = last_replicated_
-    });
+HybridTime MvccManager::TryGetSafeTimeWithoutLock(
+    HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const {
+  const bool has_lease = !ht_lease.empty();
+  // Invalid arguments are reported by DoGetSafeTime.
+  if (!ht_lease.lease.is_valid() || min_allowed > ht_lease.lease ||
+      (has_lease && !ht_lease.time.is_valid())) {
+    return HybridTime::kInvalid;
+  }
+
+  const auto version = state_version_.load(std::memory_order_acquire);
+  if (version & 1) {
+    return HybridTime::kInvalid;
   }
-  return last_replicated_;
+  auto& max_safe_time_returned = has_lease ? max_safe_time_returned_with_lease_
+                                           : max_safe_time_returned_without_lease_;
+  const auto enforced_min_time = max_safe_time_returned.safe_time();
+  const auto result = CalculateSafeTime(
+      published_queue_front_.load(std::memory_order_acquire),
+      published_last_replicated_.load(std::memory_order_acquire), ht_lease, has_lease);
+
+  // The clock could be read by CalculateSafeTime, so the fence orders it with the version check.
+  // If an operation started after the check, it would pick its hybrid time after this read.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (state_version_.load(std::memory_order_relaxed) != version ||
+      result.safe_time < min_allowed || result.safe_time < enforced_min_time) {
+    return HybridTime::kInvalid;
+  }
+  max_safe_time_returned.UpdateMax(result);
+  return result.safe_time;
+}
+
+void MvccManager::BeginStateChange() {
+  state_version_.fetch_add(1, std::memory_order_seq_cst);
+}
+
+void MvccManager::EndStateChange() {
+  published_queue_front_.store(
+      queue_.empty() ? HybridTime::kMax : queue_.front().hybrid_time, std::memory_order_release);
+  published_last_replicated_.store(last_replicated_, std::memory_order_release);
+  state_version_.fetch_add(1, std::memory_order_release);
+}
+
+HybridTime MvccManager::LastReplicatedHybridTime() const {
+  const auto last_replicated = published_last_replicated_.load(std::memory_order_acquire);
+  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated;
+  return last_replicated;
 }
 
 // Using NO_THREAD_SAFETY_ANALYSIS here because we're only reading op_trace_ here and it is set
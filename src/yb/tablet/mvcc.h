@@ -32,10 +32,12 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <vector>
 
+#include "yb/gutil/port.h"
 #include "yb/gutil/thread_annotations.h"
 
 #include "yb/server/clock.h"
@@ -59,6 +61,32 @@ struct SafeTimeWithSource {
   std::string ToString() const;
 };
 
+// Safe time with source that could be read and updated without holding the MvccManager mutex.
+// The safe time and its source are updated separately, so the source is for logging only.
+class AtomicSafeTimeWithSource {
+ public:
+  AtomicSafeTimeWithSource() = default;
+
+  explicit AtomicSafeTimeWithSource(HybridTime safe_time) : safe_time_(safe_time) {}
+
+  HybridTime safe_time() const {
+    return safe_time_.load(std::memory_order_acquire);
+  }
+
+  SafeTimeWithSource Load() const;
+
+  // Stores the value if its safe time is greater than the stored one.
+  void UpdateMax(const SafeTimeWithSource& value);
+
+  std::string ToString() const {
+    return Load().ToString();
+  }
+
+ private:
+  std::atomic<HybridTime> safe_time_{HybridTime::kMin};
+  std::atomic<SafeTimeSource> source_{SafeTimeSource::kUnknown};
+};
+
 struct FixedHybridTimeLease {
   HybridTime time;
   HybridTime lease = HybridTime::kMax;
@@ -80,6 +108,10 @@ inline std::ostream& operator<<(std::ostream& out, const FixedHybridTimeLease& h
 // methods.
 // Operations could be replicated only in the same order as they were added.
 // Time of newly added operation should be after time of all previously added operations.
+//
+// Operations are added and removed under the mutex, since they are serialized by Raft anyway.
+// The state required to calculate safe time is published using a sequence lock, so SafeTime
+// requests of the read path that do not have to wait are served without taking the mutex.
 class MvccManager {
  public:
   // `prefix` is used for logging.
@@ -157,6 +189,21 @@ class MvccManager {
                            const FixedHybridTimeLease& ht_lease,
                            std::unique_lock<std::mutex>* lock) const REQUIRES(mutex_);
 
+  // Tries to calculate safe time using the published state without taking the mutex. Returns
+  // invalid hybrid time if the state is being changed concurrently or the safe time is less than
+  // min_allowed, so the caller should fall back to DoGetSafeTime.
+  HybridTime TryGetSafeTimeWithoutLock(
+      HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const;
+
+  // Calculates safe time from the specified state, returns the safe time and its source.
+  SafeTimeWithSource CalculateSafeTime(
+      HybridTime queue_front, HybridTime last_replicated, const FixedHybridTimeLease& ht_lease,
+      bool has_lease) const;
+
+  // A change of the state used by TryGetSafeTimeWithoutLock should be wrapped by these calls.
+  void BeginStateChange() REQUIRES(mutex_);
+  void EndStateChange() REQUIRES(mutex_);
+
   const std::string& LogPrefix() const { return prefix_; }
 
   struct InvariantViolationLoggingHelper;
@@ -201,6 +248,13 @@ class MvccManager {
 
   HybridTime last_replicated_ = HybridTime::kMin;
 
+  // Sequence lock for the state published to TryGetSafeTimeWithoutLock, it is odd while the state
+  // is being changed.
+  std::atomic<uint64_t> state_version_{0};
+  // Hybrid time of the first operation in queue_, or kMax if it is empty.
+  std::atomic<HybridTime> published_queue_front_{HybridTime::kMax};
+  std::atomic<HybridTime> published_last_replicated_{HybridTime::kMin};
+
   // If we are a follower, this is the latest safe time sent by the leader to us. If we are the
   // leader, this is a safe time that gets updated every time the majority-replicated watermarks
   // change.
@@ -208,8 +262,12 @@ class MvccManager {
   // Special flag for RF==1 mode when propagated_safe_time_ can be not up-to-date.
   bool leader_only_mode_ = false;
 
-  mutable SafeTimeWithSource max_safe_time_returned_with_lease_;
-  mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
+  // Watermarks are updated by readers served without the mutex, so they are padded to avoid
+  // false sharing with the published state, that such readers only load.
+  char padding1_[CACHELINE_SIZE];
+  mutable AtomicSafeTimeWithSource max_safe_time_returned_with_lease_;
+  mutable AtomicSafeTimeWithSource max_safe_time_returned_without_lease_;
+  char padding2_[CACHELINE_SIZE];
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 
   std::unique_ptr<MvccOpTrace> op_trace_ GUARDED_BY(mutex_);
@@ -16,6 +16,7 @@
 #include <boost/algorithm/string/join.hpp>
 
 #include "yb/common/partition.h"
+#include "yb/common/pgsql_protocol.pb.h"
 #include "yb/common/ql_protocol_util.h"
 #include "yb/common/ql_rowblock.h"
 #include "yb/common/ql_value.h"
@@ -34,9 +35,11 @@
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 
+DECLARE_int64(db_block_size_bytes);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
+DECLARE_uint64(tablet_scan_split_min_part_size_bytes);
 
 namespace yb {
 namespace tablet {
@@ -227,6 +230,110 @@ TEST_F(TabletSplitTest, SplitTablet) {
   ASSERT_TRUE(source_docdb_dump.empty()) << boost::algorithm::join(source_docdb_dump, "\n");
 }
 
+class TabletScanSplitTest : public YBTabletTest {
+ public:
+  TabletScanSplitTest() : YBTabletTest(Schema({ ColumnSchema("key", INT32),
+                                                ColumnSchema("val", STRING) },
+                                              1)) {}
+
+  void SetUp() override {
+    FLAGS_db_block_size_bytes = 4_KB;
+    FLAGS_rocksdb_level0_file_num_compaction_trigger = -1;
+    YBTabletTest::SetUp();
+  }
+
+ protected:
+  static std::string EncodedKey(int key) {
+    return docdb::DocKey({ docdb::PrimitiveValue::Int32(key) }).Encode().ToStringBuffer();
+  }
+
+  // Checks that split keys are increasing whole doc keys, that split the [begin, end) range of
+  // rows into parts of approximately the same size.
+  static void CheckSplitKeys(const std::vector<std::string>& keys, int begin, int end) {
+    // Split keys are sampled, so they are only expected to be close to the exact ones.
+    const auto max_deviation = (end - begin) / 10;
+    const auto num_parts = static_cast<int>(keys.size()) + 1;
+    int prev_key = begin;
+    for (size_t i = 0; i != keys.size(); ++i) {
+      docdb::DocKey doc_key;
+      ASSERT_OK(doc_key.FullyDecodeFrom(keys[i]));
+      ASSERT_EQ(doc_key.range_group().size(), 1U);
+      const auto key = doc_key.range_group()[0].GetInt32();
+      LOG(INFO) << "Split key " << i << ": " << key;
+      ASSERT_GT(key, prev_key);
+      ASSERT_LT(key, end);
+      const auto expected = begin + (end - begin) * static_cast<int>(i + 1) / num_parts;
+      ASSERT_GE(key, expected - max_deviation);
+      ASSERT_LE(key, expected + max_deviation);
+      prev_key = key;
+    }
+  }
+};
+
+TEST_F(TabletScanSplitTest, GetPgsqlScanSplitKeys) {
+  constexpr int kNumRows = 4000;
+  constexpr int kNumFlushes = 4;
+  constexpr int kValueLength = 1024;
+
+  LocalTabletWriter writer(tablet().get());
+  LocalTabletWriter::Batch batch;
+  for (int i = 0; i != kNumRows; ++i) {
+    QLWriteRequestPB* req = batch.Add();
+    req->set_type(QLWriteRequestPB::QL_STMT_INSERT);
+    QLAddInt32RangeValue(req, i);
+    QLAddStringColumnValue(req, kFirstColumnId + 1, RandomHumanReadableString(kValueLength));
+    if ((i + 1) % (kNumRows / kNumFlushes) == 0) {
+      ASSERT_OK(writer.WriteBatch(&batch));
+      batch.Clear();
+      ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+    }
+  }
+
+  PgsqlReadRequestPB req;
+  req.set_scan_split_parts(4);
+
+  // Tablet holds less data than required for a single part by default.
+  ASSERT_TRUE(tablet()->GetPgsqlScanSplitKeys(req, schema_).empty());
+
+  FLAGS_tablet_scan_split_min_part_size_bytes = 1;
+  auto keys = tablet()->GetPgsqlScanSplitKeys(req, schema_);
+  ASSERT_EQ(keys.size(), 3U);
+  ASSERT_NO_FATALS(CheckSplitKeys(keys, 0, kNumRows));
+
+  // Split keys are limited by request bounds.
+  req.mutable_lower_bound()->set_key(EncodedKey(kNumRows / 4));
+  req.mutable_lower_bound()->set_is_inclusive(true);
+  req.mutable_upper_bound()->set_key(EncodedKey(kNumRows * 3 / 4));
+  req.mutable_upper_bound()->set_is_inclusive(false);
+  keys = tablet()->GetPgsqlScanSplitKeys(req, schema_);
+  ASSERT_EQ(keys.size(), 3U);
+  ASSERT_NO_FATALS(CheckSplitKeys(keys, kNumRows / 4, kNumRows * 3 / 4));
+
+  // Number of parts is limited by the minimal part size.
+  FLAGS_tablet_scan_split_min_part_size_bytes = kNumRows * kValueLength / 5;
+  keys = tablet()->GetPgsqlScanSplitKeys(req, schema_);
+  ASSERT_EQ(keys.size(), 1U);
+  ASSERT_NO_FATALS(CheckSplitKeys(keys, kNumRows / 4, kNumRows * 3 / 4));
+  FLAGS_tablet_scan_split_min_part_size_bytes = 1;
+
+  // Only the first page of a forward scan is split.
+  {
+    auto backward_req = req;
+    backward_req.set_is_forward_scan(false);
+    ASSERT_TRUE(tablet()->GetPgsqlScanSplitKeys(backward_req, schema_).empty());
+  }
+  {
+    auto next_page_req = req;
+    next_page_req.mutable_paging_state()->set_next_partition_key(EncodedKey(kNumRows / 2));
+    ASSERT_TRUE(tablet()->GetPgsqlScanSplitKeys(next_page_req, schema_).empty());
+  }
+  {
+    auto single_part_req = req;
+    single_part_req.set_scan_split_parts(1);
+    ASSERT_TRUE(tablet()->GetPgsqlScanSplitKeys(single_part_req, schema_).empty());
+  }
+}
+
 // TODO: Need to test with distributed transactions both pending and committed
 // (but not yet applied) during split.
 // Split tablets should not return unexpected data for not yet applied, but committed transactions
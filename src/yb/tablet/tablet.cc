@@ -66,6 +66,7 @@
 #include "yb/docdb/docdb_compaction_filter_intents.h"
 #include "yb/docdb/docdb_debug.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/key_bytes.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/redis_operation.h"
@@ -80,6 +81,7 @@
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/tablet/key_access_sampler.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
 #include "yb/tablet/operations/operation.h"
 #include "yb/tablet/operations/snapshot_operation.h"
@@ -108,7 +110,9 @@
 #include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/pg_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/stopwatch.h"
@@ -117,6 +121,8 @@
 
 #include "yb/yql/pgwrapper/libpq_utils.h"
 
+using namespace yb::size_literals;
+
 DEFINE_bool(tablet_do_dup_key_checks, true,
             "Whether to check primary keys for duplicate on insertion. "
             "Use at your own risk!");
@@ -262,6 +268,23 @@ DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DEFINE_test_flag(uint64, inject_sleep_before_applying_intents_ms, 0,
                  "Sleep before applying intents to docdb after transaction commit");
 
+DEFINE_uint64(tablet_key_access_sample_size, 0,
+              "Number of recently accessed keys sampled by each tablet, used to choose the split "
+              "key of a tablet split because of its load. 0 disables sampling. Should be set "
+              "together with the tablet_split_load_threshold_* master flags, that enable load "
+              "based splitting. Otherwise the middle key of the tablet data is used as the split "
+              "key.");
+
+DEFINE_uint64(tablet_split_min_key_access_samples, 64,
+              "Minimal number of sampled accessed keys required to choose the split key by the "
+              "access distribution, otherwise the middle key of the tablet data is used.");
+TAG_FLAG(tablet_split_min_key_access_samples, runtime);
+
+DEFINE_uint64(tablet_scan_split_min_part_size_bytes, 64_MB,
+              "Minimal estimated size of SST data in each sub-range a range scan is split into. "
+              "Scans of less than twice this amount of data are not split.");
+TAG_FLAG(tablet_scan_split_min_part_size_bytes, runtime);
+
 using namespace std::placeholders;
 
 using std::shared_ptr;
@@ -415,6 +438,11 @@ Tablet::Tablet(const TabletInitData& data)
     metrics_.reset(new TabletMetrics(table_metrics_entity_, tablet_metrics_entity_));
 
     mem_tracker_->SetMetricEntity(tablet_metrics_entity_);
+    shared_lock_manager_.SetMetricEntity(tablet_metrics_entity_);
+  }
+
+  if (FLAGS_tablet_key_access_sample_size > 0) {
+    key_access_sampler_ = std::make_unique<KeyAccessSampler>(FLAGS_tablet_key_access_sample_size);
   }
 
   auto table_info = metadata_->primary_table_info();
@@ -1129,6 +1157,9 @@ Status Tablet::ApplyRowOperations(
             << put_batch.ShortDebugString();
     metrics_->rows_inserted->IncrementBy(put_batch.write_pairs().size());
   }
+  if (key_access_sampler_ && !put_batch.write_pairs().empty()) {
+    key_access_sampler_->Record(RandomElement(put_batch.write_pairs()).key());
+  }
 
   return ApplyOperation(
       *operation, write_request.batch_idx(), put_batch, already_applied_to_regular_db);
@@ -1362,6 +1393,11 @@ Status Tablet::HandleQLReadRequest(
   Result<TransactionOperationContext> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata, /* is_ysql_catalog_table */ false);
   RETURN_NOT_OK(txn_op_ctx);
+  if (key_access_sampler_ && !ql_read_request.hashed_column_values().empty()) {
+    docdb::KeyBytes hash_key;
+    docdb::AppendHash(ql_read_request.hash_code(), &hash_key);
+    key_access_sampler_->Record(hash_key.AsSlice());
+  }
   return AbstractTablet::HandleQLReadRequest(
       deadline, read_time, ql_read_request, *txn_op_ctx, result);
 }
@@ -1447,9 +1483,99 @@ Status Tablet::HandlePgsqlReadRequest(
           table_info->schema->table_properties().is_ysql_catalog_table(),
           &subtransaction_metadata);
   RETURN_NOT_OK(txn_op_ctx);
-  return AbstractTablet::HandlePgsqlReadRequest(
+
+  if (key_access_sampler_) {
+    const auto& ybctid = pgsql_read_request.ybctid_column_value().value().binary_value();
+    if (!ybctid.empty()) {
+      key_access_sampler_->Record(ybctid);
+    } else if (!pgsql_read_request.partition_column_values().empty()) {
+      docdb::KeyBytes hash_key;
+      docdb::AppendHash(pgsql_read_request.hash_code(), &hash_key);
+      key_access_sampler_->Record(hash_key.AsSlice());
+    } else if (!pgsql_read_request.paging_state().next_row_key().empty()) {
+      // Every page of a range scan is sampled by the key it starts from, so long scans contribute
+      // samples along the scanned range.
+      key_access_sampler_->Record(pgsql_read_request.paging_state().next_row_key());
+    } else if (!pgsql_read_request.lower_bound().key().empty()) {
+      key_access_sampler_->Record(pgsql_read_request.lower_bound().key());
+    }
+  }
+
+  // Large range scan could be split into several sub-range scans executed in parallel by the
+  // caller. In this case only the first sub-range is read by this request.
+  auto split_keys = GetPgsqlScanSplitKeys(pgsql_read_request, *table_info->schema);
+  if (split_keys.empty()) {
+    return AbstractTablet::HandlePgsqlReadRequest(
+        deadline, read_time, is_explicit_request_read_time,
+        pgsql_read_request, *txn_op_ctx, result, num_rows_read);
+  }
+
+  PgsqlReadRequestPB first_part_request(pgsql_read_request);
+  auto* upper_bound = first_part_request.mutable_upper_bound();
+  upper_bound->set_key(split_keys.front());
+  upper_bound->set_is_inclusive(false);
+  RETURN_NOT_OK(AbstractTablet::HandlePgsqlReadRequest(
       deadline, read_time, is_explicit_request_read_time,
-      pgsql_read_request, *txn_op_ctx, result, num_rows_read);
+      first_part_request, *txn_op_ctx, result, num_rows_read));
+  if (result->response.status() == PgsqlResponsePB::PGSQL_STATUS_OK) {
+    for (auto& key : split_keys) {
+      result->response.add_scan_split_keys(std::move(key));
+    }
+  }
+  return Status::OK();
+}
+
+std::vector<std::string> Tablet::GetPgsqlScanSplitKeys(
+    const PgsqlReadRequestPB& pgsql_read_request, const Schema& schema) const {
+  // Maximal number of parts a single scan could be split into.
+  constexpr size_t kMaxScanSplitParts = 64;
+
+  // Only the first page of a forward range scan is split, hash partitioned tables are already
+  // scanned in parallel by hash ranges.
+  if (pgsql_read_request.scan_split_parts() < 2 ||
+      pgsql_read_request.has_paging_state() ||
+      !pgsql_read_request.is_forward_scan() ||
+      schema.num_hash_key_columns() != 0 ||
+      pgsql_read_request.range_column_values_size() != 0 ||
+      pgsql_read_request.has_ybctid_column_value() ||
+      pgsql_read_request.batch_arguments_size() != 0 ||
+      pgsql_read_request.has_index_request() ||
+      pgsql_read_request.has_sampling_state() ||
+      pgsql_read_request.is_for_backfill()) {
+    return {};
+  }
+
+  // Scanned range is limited by request bounds, tablet partition and, for colocated tables, by
+  // the table prefix.
+  std::string lower = metadata_->partition()->partition_key_start();
+  std::string upper = metadata_->partition()->partition_key_end();
+  if (pgsql_read_request.has_lower_bound() && pgsql_read_request.lower_bound().key() > lower) {
+    lower = pgsql_read_request.lower_bound().key();
+  }
+  if (pgsql_read_request.has_upper_bound() &&
+      (upper.empty() || pgsql_read_request.upper_bound().key() < upper)) {
+    upper = pgsql_read_request.upper_bound().key();
+  }
+  docdb::KeyBytes table_prefix;
+  docdb::DocKeyEncoder(&table_prefix).Schema(schema);
+  if (!table_prefix.empty()) {
+    if (table_prefix.AsSlice().compare(lower) > 0) {
+      lower = table_prefix.ToStringBuffer();
+    }
+    table_prefix.AppendValueType(docdb::ValueType::kMaxByte);
+    if (upper.empty() || table_prefix.AsSlice().compare(upper) < 0) {
+      upper = table_prefix.ToStringBuffer();
+    }
+  }
+
+  auto split_keys = GetEncodedScanSplitKeys(
+      lower, upper, std::min<size_t>(pgsql_read_request.scan_split_parts(), kMaxScanSplitParts));
+  if (!split_keys.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to get scan split keys: " << split_keys.status();
+    return {};
+  }
+  VLOG_WITH_PREFIX(2) << "Split scan into " << split_keys->size() + 1 << " parts";
+  return std::move(*split_keys);
 }
 
 // Returns true if the query can be satisfied by rows present in current tablet.
@@ -3451,33 +3577,76 @@ const std::string& Tablet::tablet_id() const {
 }
 
 Result<std::string> Tablet::GetEncodedMiddleSplitKey() const {
-  auto error_prefix = [this]() {
+  // TODO(tsplit): should take key_bounds_ into account.
+  auto middle_key = VERIFY_RESULT(regular_db_->GetMiddleKey());
+  return ToEncodedSplitKey("middle", std::move(middle_key));
+}
+
+Result<std::string> Tablet::GetEncodedAccessSplitKey() const {
+  if (!key_access_sampler_) {
+    return STATUS(IllegalState, "Key access sampling is disabled");
+  }
+  const auto samples = key_access_sampler_->SortedSamples();
+  const auto min_samples = GetAtomicFlag(&FLAGS_tablet_split_min_key_access_samples);
+  std::vector<std::string> keys;
+  keys.reserve(samples.size());
+  for (const auto& sample : samples) {
+    // Sampled keys that could not be used as a split key are just skipped. Truncated keys are still
+    // sorted, since truncation keeps the order of keys with different prefixes.
+    auto key = ToEncodedSplitKey("access", sample);
+    if (key.ok()) {
+      keys.push_back(std::move(*key));
+    }
+  }
+  if (keys.empty() || keys.size() < min_samples) {
+    return STATUS_FORMAT(
+        IllegalState, "Not enough sampled keys to detect access split key for tablet $0: $1",
+        tablet_id(), keys.size());
+  }
+
+  // Split key is the first key of the second child, so when more than half of accesses are to the
+  // same key, the next sampled key is used to split off the rest of the accesses.
+  auto it = keys.begin() + keys.size() / 2;
+  if (*it == keys.front()) {
+    it = std::upper_bound(it, keys.end(), keys.front());
+    if (it == keys.end()) {
+      return STATUS_FORMAT(
+          IllegalState, "All sampled accesses of tablet $0 are to the same split key $1",
+          tablet_id(), Slice(keys.front()).ToDebugHexString());
+    }
+  }
+  return std::move(*it);
+}
+
+Result<std::string> Tablet::ToEncodedSplitKey(const char* method, std::string split_key) const {
+  auto error_prefix = [this, method]() {
     return Format(
-        "Failed to detect middle key for tablet $0 (key_bounds: $1 - $2)",
+        "Failed to detect $0 key for tablet $1 (key_bounds: $2 - $3)",
+        method,
         tablet_id(),
         Slice(key_bounds_.lower).ToDebugHexString(),
         Slice(key_bounds_.upper).ToDebugHexString());
   };
+  if (PREDICT_FALSE(split_key.empty())) {
+    return STATUS_FORMAT(IllegalState, "$0: got empty key", error_prefix());
+  }
 
-  // TODO(tsplit): should take key_bounds_ into account.
-  auto middle_key = VERIFY_RESULT(regular_db_->GetMiddleKey());
-
-  // In some rare cases middle key can point to a special internal record which is not visible
+  // In some rare cases the key can point to a special internal record which is not visible
   // for a user, but tablet splitting routines expect the specific structure for partition keys
   // that does not match the struct of the internally used records. Moreover, it is expected
   // to have two child tablets with alive user records after the splitting, but the split
   // by the internal record will lead to a case when one tablet will consist of internal records
   // only and these records will be compacted out at some point making an empty tablet.
-  if (PREDICT_FALSE(docdb::IsInternalRecordKeyType(docdb::DecodeValueType(middle_key[0])))) {
+  if (PREDICT_FALSE(docdb::IsInternalRecordKeyType(docdb::DecodeValueType(split_key[0])))) {
     return STATUS_FORMAT(
         IllegalState, "$0: got internal record \"$1\"",
-        error_prefix(), Slice(middle_key).ToDebugHexString());
+        error_prefix(), Slice(split_key).ToDebugHexString());
   }
 
   const auto key_part = metadata()->partition_schema()->IsHashPartitioning()
                             ? docdb::DocKeyPart::kUpToHashCode
                             : docdb::DocKeyPart::kWholeDocKey;
-  const auto split_key_size = VERIFY_RESULT(DocKey::EncodedSize(middle_key, key_part));
+  const auto split_key_size = VERIFY_RESULT(DocKey::EncodedSize(split_key, key_part));
   if (PREDICT_FALSE(split_key_size == 0)) {
     // Using this verification just to have a more sensible message. The below verification will
     // not pass with split_key_size == 0 also, but its message is not accurate enough. This failure
@@ -3485,19 +3654,46 @@ Result<std::string> Tablet::GetEncodedMiddleSplitKey() const {
     // still valid for any reason (e.g. gettining non-hash key for hash partitioning).
     return STATUS_FORMAT(
         IllegalState, "$0: got unexpected key \"$1\"",
-        error_prefix(), Slice(middle_key).ToDebugHexString());
+        error_prefix(), Slice(split_key).ToDebugHexString());
   }
 
-  middle_key.resize(split_key_size);
-  const Slice middle_key_slice(middle_key);
-  if (middle_key_slice.compare(key_bounds_.lower) <= 0 ||
-      (!key_bounds_.upper.empty() && middle_key_slice.compare(key_bounds_.upper) >= 0)) {
+  split_key.resize(split_key_size);
+  const Slice split_key_slice(split_key);
+  if (split_key_slice.compare(key_bounds_.lower) <= 0 ||
+      (!key_bounds_.upper.empty() && split_key_slice.compare(key_bounds_.upper) >= 0)) {
     return STATUS_FORMAT(
         IllegalState,
         "$0: got \"$1\". This can happen if post-split tablet wasn't fully compacted after split",
-        error_prefix(), middle_key_slice.ToDebugHexString());
+        error_prefix(), split_key_slice.ToDebugHexString());
   }
-  return middle_key;
+  return split_key;
+}
+
+Result<std::vector<std::string>> Tablet::GetEncodedScanSplitKeys(
+    Slice lower, Slice upper, size_t num_parts) const {
+  auto keys = VERIFY_RESULT(regular_db_->GetApproximateSplitKeys(
+      lower, upper, num_parts, FLAGS_tablet_scan_split_min_part_size_bytes));
+  std::vector<std::string> result;
+  result.reserve(keys.size());
+  for (auto& key : keys) {
+    // Skip internal records, they could not be used as a scan bound.
+    if (key.empty() ||
+        docdb::IsInternalRecordKeyType(docdb::DecodeValueType(key[0]))) {
+      continue;
+    }
+    const auto doc_key_size = DocKey::EncodedSize(key, docdb::DocKeyPart::kWholeDocKey);
+    if (!doc_key_size.ok() || *doc_key_size == 0) {
+      continue;
+    }
+    key.resize(*doc_key_size);
+    // Split keys should be strictly inside the range and unique.
+    if (Slice(key).compare(lower) <= 0 || (!upper.empty() && Slice(key).compare(upper) >= 0) ||
+        (!result.empty() && result.back() == key)) {
+      continue;
+    }
+    result.push_back(std::move(key));
+  }
+  return result;
 }
 
 Status Tablet::TriggerPostSplitCompactionIfNeeded(
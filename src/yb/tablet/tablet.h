@@ -560,6 +560,22 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // - for range-based partitions: encoded doc key in order to split by row.
   Result<std::string> GetEncodedMiddleSplitKey() const;
 
+  // Returns split key that divides recently accessed keys of the tablet into two halves, so the
+  // load of a hot tablet is divided between the child tablets. Encoded the same way as the key
+  // returned by GetEncodedMiddleSplitKey.
+  Result<std::string> GetEncodedAccessSplitKey() const;
+
+  // Returns encoded doc keys that split regular DB data within [lower, upper) into up to num_parts
+  // parts of approximately the same size. Empty upper means no upper limit. Parts are not smaller
+  // than tablet_scan_split_min_part_size_bytes.
+  Result<std::vector<std::string>> GetEncodedScanSplitKeys(
+      Slice lower, Slice upper, size_t num_parts) const;
+
+  // Returns keys to split the range scanned by the first page of a range scan into the number of
+  // parts requested by scan_split_parts, empty if the scan should not be split.
+  std::vector<std::string> GetPgsqlScanSplitKeys(
+      const PgsqlReadRequestPB& pgsql_read_request, const Schema& schema) const;
+
   std::string TEST_DocDBDumpStr(IncludeIntents include_intents = IncludeIntents::kFalse);
 
   void TEST_DocDBDumpToContainer(
@@ -744,6 +760,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void DocDBDebugDump(std::vector<std::string> *lines);
 
+  // Converts key found by the specified method to the split key, i.e. truncates it to the hash
+  // code or doc key and checks that it could be used to split the tablet.
+  Result<std::string> ToEncodedSplitKey(const char* method, std::string key) const;
+
   CHECKED_STATUS WriteTransactionalBatch(
       int64_t batch_idx, // index of this batch in its transaction
       const docdb::KeyValueWriteBatchPB& put_batch,
@@ -876,6 +896,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Optional key bounds (see docdb::KeyBounds) served by this tablet.
   docdb::KeyBounds key_bounds_;
 
+  std::unique_ptr<KeyAccessSampler> key_access_sampler_;
+
   std::unique_ptr<docdb::YQLStorageIf> ql_storage_;
 
   // This is for docdb fine-grained locking.
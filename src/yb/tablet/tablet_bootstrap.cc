@@ -65,6 +65,7 @@
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tablet/tablet_fwd.h"
+#include "yb/tablet/log_read_ahead.h"
 #include "yb/tablet/mvcc.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
 #include "yb/tablet/operations/history_cutoff_operation.h"
@@ -76,6 +77,7 @@
 #include "yb/tablet/snapshot_coordinator.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_snapshots.h"
 #include "yb/tablet/tablet_splitter.h"
@@ -91,6 +93,7 @@
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/metric_entity.h"
+#include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/scope_exit.h"
@@ -127,6 +130,16 @@ DECLARE_int32(retryable_request_timeout_secs);
 
 DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
               "The segment size for transaction status tablet log roll-overs, in bytes.");
+DEFINE_uint64(bootstrap_log_read_ahead_bytes, 64_MB,
+              "Memory budget for log entries that are read and decoded ahead of their replay by a "
+              "separate thread during tablet bootstrap. 0 disables read ahead, so entries are read "
+              "by the replaying thread.");
+TAG_FLAG(bootstrap_log_read_ahead_bytes, advanced);
+DEFINE_uint64(bootstrap_log_read_ahead_total_bytes, 1_GB,
+              "Memory budget for log entries read ahead by all tablets bootstrapping at the same "
+              "time, see bootstrap_log_read_ahead_bytes.");
+TAG_FLAG(bootstrap_log_read_ahead_total_bytes, advanced);
+
 DEFINE_test_flag(int32, tablet_bootstrap_delay_ms, 0,
                  "Time (in ms) to delay tablet bootstrap by.");
 
@@ -1262,14 +1275,34 @@ class TabletBootstrap {
     // Find the earliest log segment we need to read, so the rest can be ignored.
     auto iter = FLAGS_skip_flushed_entries ? SkipFlushedEntries(&segments) : segments.begin();
 
+    // Entries are read in chunks, possibly ahead of their replay, see LogReadAhead.
+    const size_t first_segment_index = iter - segments.begin();
+    LogReadAhead read_ahead(
+        log::SegmentSequence(iter, segments.end()), FLAGS_bootstrap_log_read_ahead_bytes,
+        MemTracker::FindOrCreateTracker(
+            FLAGS_bootstrap_log_read_ahead_total_bytes, "LogReadAhead", mem_tracker_));
+    RETURN_NOT_OK(read_ahead.Start(tablet_->tablet_id()));
+
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
-    for (; iter != segments.end(); ++iter) {
-      const scoped_refptr<ReadableLogSegment>& segment = *iter;
+    // Committed op id, number of entries and last entry metadata of the segment being replayed.
+    yb::OpId segment_committed_op_id;
+    size_t segment_num_entries = 0;
+    boost::optional<log::LogEntryMetadata> segment_last_entry_metadata;
+    LogReadAhead::Chunk chunk;
+    for (;;) {
+      const auto read_start = MonoTime::Now();
+      if (!read_ahead.Next(&chunk)) {
+        break;
+      }
+      const auto apply_start = MonoTime::Now();
+      const size_t segment_index = first_segment_index + chunk.segment_index;
+      const scoped_refptr<ReadableLogSegment>& segment = segments[segment_index];
+      auto& read_result = chunk.read_result;
 
-      auto read_result = segment->ReadEntries();
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
+      segment_committed_op_id = std::max(segment_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
       }
@@ -1281,13 +1314,16 @@ class TabletBootstrap {
           DumpReplayStateToLog();
           RETURN_NOT_OK_PREPEND(s, DebugInfo(tablet_->tablet_id(),
                                             segment->header().sequence_number(),
-                                            entry_idx, segment->path(),
+                                            segment_num_entries + entry_idx, segment->path(),
                                             read_result.entries[entry_idx].get()));
         }
       }
+      segment_num_entries += read_result.entries.size();
       if (!read_result.entry_metadata.empty()) {
         last_entry_time = read_result.entry_metadata.back().entry_time;
+        segment_last_entry_metadata = read_result.entry_metadata.back();
       }
+      ChunkReplayed(chunk, apply_start - read_start, MonoTime::Now() - apply_start);
 
       // If the LogReader failed to read for some reason, we'll still try to replay as many entries
       // as possible, and then fail with Corruption.
@@ -1297,25 +1333,33 @@ class TabletBootstrap {
                                 "(Read up to entry $2 of segment $3, in path $4)",
                             tablet_->tablet_id(),
                             read_result.status,
-                            read_result.entries.size(),
+                            segment_num_entries,
                             segment->header().sequence_number(),
                             segment->path());
       }
 
+      if (!chunk.last_in_segment) {
+        continue;
+      }
+
       // TODO: could be more granular here and log during the segments as well, plus give info about
       // number of MB processed, but this is better than nothing.
       auto status = Format(
           "Bootstrap replayed $0/$1 log segments. $2. Pending: $3 replicates. "
               "Last read committed op id: $4",
-          (iter - segments.begin()) + 1, segments.size(), stats_,
-          replay_state_->pending_replicates.size(), read_result.committed_op_id);
-      if (read_result.entry_metadata.empty()) {
+          segment_index + 1, segments.size(), stats_,
+          replay_state_->pending_replicates.size(), segment_committed_op_id);
+      if (!segment_last_entry_metadata) {
         status += ", no entries in last segment";
       } else {
-        status += ", last entry metadata: " + read_result.entry_metadata.back().ToString() +
+        status += ", last entry metadata: " + segment_last_entry_metadata->ToString() +
                   ", last read entry op id: " + last_read_entry_op_id.ToString();
       }
       listener_->StatusMessage(status);
+
+      segment_committed_op_id = yb::OpId();
+      segment_num_entries = 0;
+      segment_last_entry_metadata = boost::none;
     }
 
     replay_state_->UpdateCommittedFromStored();
@@ -1380,6 +1424,23 @@ class TabletBootstrap {
     return Status::OK();
   }
 
+  void ChunkReplayed(const LogReadAhead::Chunk& chunk, MonoDelta read_wait_time,
+                     MonoDelta apply_time) {
+    const auto num_entries = chunk.read_result.entries.size();
+    stats_.bytes_read += chunk.bytes;
+    stats_.entries_read += num_entries;
+    stats_.read_wait_time += read_wait_time;
+    stats_.apply_time += apply_time;
+
+    auto* metrics = tablet_->metrics();
+    if (metrics) {
+      metrics->bootstrap_log_bytes_read->IncrementBy(chunk.bytes);
+      metrics->bootstrap_log_entries_read->IncrementBy(num_entries);
+      metrics->bootstrap_log_read_wait_us->IncrementBy(read_wait_time.ToMicroseconds());
+      metrics->bootstrap_log_apply_us->IncrementBy(apply_time.ToMicroseconds());
+    }
+  }
+
   CHECKED_STATUS PlayWriteRequest(
       ReplicateMsg* replicate_msg, AlreadyAppliedToRegularDB already_applied_to_regular_db) {
     SCHECK(replicate_msg->has_hybrid_time(), IllegalState,
@@ -1645,6 +1706,14 @@ class TabletBootstrap {
 
     // Number of REPLICATE messages which were overwritten by later entries.
     int ops_overwritten = 0;
+
+    // Size and number of log entries read from the log.
+    int64_t bytes_read = 0;
+    int64_t entries_read = 0;
+
+    // Time spent waiting for log entries to be read and time spent applying them.
+    MonoDelta read_wait_time = MonoDelta::kZero;
+    MonoDelta apply_time = MonoDelta::kZero;
   } stats_;
 
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
@@ -1669,8 +1738,9 @@ class TabletBootstrap {
 // ============================================================================
 
 string TabletBootstrap::Stats::ToString() const {
-  return Format("Read operations: $0, overwritten operations: $1",
-                ops_read, ops_overwritten);
+  return Format("Read operations: $0, overwritten operations: $1, read entries: $2, "
+                "read bytes: $3, read wait time: $4, apply time: $5",
+                ops_read, ops_overwritten, entries_read, bytes_read, read_wait_time, apply_time);
 }
 
 CHECKED_STATUS BootstrapTabletImpl(
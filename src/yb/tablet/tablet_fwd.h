@@ -44,6 +44,7 @@ class TabletPeer;
 typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 
 class ChangeMetadataOperation;
+class KeyAccessSampler;
 class Operation;
 class OperationFilter;
 class SnapshotCoordinator;
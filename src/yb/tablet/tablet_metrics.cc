@@ -130,6 +130,51 @@ METRIC_DEFINE_counter(tablet, tablet_data_corruptions,
   yb::MetricUnit::kUnits,
   "Number of times this tablet was flagged for corrupted data");
 
+METRIC_DEFINE_counter(tablet, bootstrap_log_bytes_read,
+  "Bootstrap Log Bytes Read",
+  yb::MetricUnit::kBytes,
+  "Number of bytes of log entries read while replaying the log during tablet bootstrap");
+
+METRIC_DEFINE_counter(tablet, bootstrap_log_entries_read,
+  "Bootstrap Log Entries Read",
+  yb::MetricUnit::kEntries,
+  "Number of log entries read and decoded while replaying the log during tablet bootstrap");
+
+METRIC_DEFINE_counter(tablet, bootstrap_log_read_wait_us,
+  "Bootstrap Log Read Wait Time",
+  yb::MetricUnit::kMicroseconds,
+  "Time spent by tablet bootstrap waiting for log entries to be read and decoded");
+
+METRIC_DEFINE_counter(tablet, bootstrap_log_apply_us,
+  "Bootstrap Log Apply Time",
+  yb::MetricUnit::kMicroseconds,
+  "Time spent by tablet bootstrap applying replayed log entries");
+
+METRIC_DEFINE_counter(tablet, read_ops,
+  "Read Operations",
+  yb::MetricUnit::kOperations,
+  "Number of read requests served by this tablet");
+
+METRIC_DEFINE_counter(tablet, read_bytes,
+  "Read Bytes",
+  yb::MetricUnit::kBytes,
+  "Number of bytes returned by read requests served by this tablet");
+
+METRIC_DEFINE_counter(tablet, write_ops,
+  "Write Operations",
+  yb::MetricUnit::kOperations,
+  "Number of write requests served by this tablet");
+
+METRIC_DEFINE_counter(tablet, write_bytes,
+  "Write Bytes",
+  yb::MetricUnit::kBytes,
+  "Number of bytes of write requests served by this tablet");
+
+METRIC_DEFINE_counter(tablet, request_cpu_time_us,
+  "Request CPU Time",
+  yb::MetricUnit::kMicroseconds,
+  "CPU time spent by threads executing read and write requests of this tablet");
+
 using strings::Substitute;
 
 namespace yb {
@@ -152,6 +197,15 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
     MINIT(tablet_entity, consistent_prefix_read_requests),
     MINIT(tablet_entity, pgsql_consistent_prefix_read_rows),
     MINIT(tablet_entity, tablet_data_corruptions),
+    MINIT(tablet_entity, bootstrap_log_bytes_read),
+    MINIT(tablet_entity, bootstrap_log_entries_read),
+    MINIT(tablet_entity, bootstrap_log_read_wait_us),
+    MINIT(tablet_entity, bootstrap_log_apply_us),
+    MINIT(tablet_entity, read_ops),
+    MINIT(tablet_entity, read_bytes),
+    MINIT(tablet_entity, write_ops),
+    MINIT(tablet_entity, write_bytes),
+    MINIT(tablet_entity, request_cpu_time_us),
     MINIT(tablet_entity, rows_inserted) {
 }
 #undef MINIT
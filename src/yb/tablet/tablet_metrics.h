@@ -71,6 +71,18 @@ struct TabletMetrics {
   scoped_refptr<Counter> pgsql_consistent_prefix_read_rows;
   scoped_refptr<Counter> tablet_data_corruptions;
 
+  scoped_refptr<Counter> bootstrap_log_bytes_read;
+  scoped_refptr<Counter> bootstrap_log_entries_read;
+  scoped_refptr<Counter> bootstrap_log_read_wait_us;
+  scoped_refptr<Counter> bootstrap_log_apply_us;
+
+  // Served requests, reported to the master to balance the actual load of tablet servers.
+  scoped_refptr<Counter> read_ops;
+  scoped_refptr<Counter> read_bytes;
+  scoped_refptr<Counter> write_ops;
+  scoped_refptr<Counter> write_bytes;
+  scoped_refptr<Counter> request_cpu_time_us;
+
   scoped_refptr<Counter> rows_inserted;
 };
 
@@ -30,6 +30,7 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/transaction_dump.h"
+#include "yb/docdb/transaction_status_cache.h"
 
 #include "yb/rpc/poller.h"
 
@@ -86,6 +87,10 @@ DEFINE_int32(max_transactions_in_status_request, 128,
 
 DEFINE_uint64(transactions_cleanup_cache_size, 256, "Transactions cleanup cache size.");
 
+DEFINE_uint64(transactions_terminal_status_cache_size, 10000,
+              "Max number of committed or aborted transactions, whose status was received from "
+              "the transaction coordinator, cached per tablet for reads. 0 disables the cache.");
+
 DEFINE_uint64(transactions_status_poll_interval_ms, 500 * yb::kTimeMultiplier,
               "Transactions poll interval.");
 
@@ -125,6 +130,7 @@ class TransactionParticipant::Impl
       : RunningTransactionContext(context, applier),
         log_prefix_(context->LogPrefix()),
         loader_(this, entity),
+        terminal_status_cache_(FLAGS_transactions_terminal_status_cache_size, entity),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)) {
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
@@ -230,6 +236,21 @@ class TransactionParticipant::Impl
     });
   }
 
+  boost::optional<CommitMetadata> CachedCommitData(const TransactionId& id) {
+    return terminal_status_cache_.Get(id);
+  }
+
+  void CacheCommitData(const TransactionId& id, const CommitMetadata& data) {
+    // Transaction could be removed while its status was requested from the coordinator. Check it
+    // under the mutex, since Erase is also performed under it, so removed transaction is not
+    // resurrected in the cache.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (transactions_.find(id) == transactions_.end()) {
+      return;
+    }
+    terminal_status_cache_.Insert(id, data);
+  }
+
   std::pair<size_t, size_t> TEST_CountIntents() {
     {
       MinRunningNotifier min_running_notifier(&applier_);
@@ -1270,6 +1291,9 @@ class TransactionParticipant::Impl
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
     VLOG_WITH_PREFIX(4) << "Remove transaction: " << transaction.id();
+    // Provisional records of the transaction are already removed, so reads will not ask for its
+    // status anymore.
+    terminal_status_cache_.Erase(transaction.id());
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
@@ -1559,6 +1583,8 @@ class TransactionParticipant::Impl
 
   LRUCache<TransactionId> cleanup_cache_{FLAGS_transactions_cleanup_cache_size};
 
+  docdb::TerminalTransactionStatusCache terminal_status_cache_;
+
   rpc::Poller poller_;
 };
 
@@ -1604,6 +1630,16 @@ boost::optional<CommitMetadata> TransactionParticipant::LocalCommitData(const Tr
   return impl_->LocalCommitData(id);
 }
 
+boost::optional<CommitMetadata> TransactionParticipant::CachedCommitData(
+    const TransactionId& id) {
+  return impl_->CachedCommitData(id);
+}
+
+void TransactionParticipant::CacheCommitData(
+    const TransactionId& id, const CommitMetadata& data) {
+  impl_->CacheCommitData(id, data);
+}
+
 std::pair<size_t, size_t> TransactionParticipant::TEST_CountIntents() const {
   return impl_->TEST_CountIntents();
 }
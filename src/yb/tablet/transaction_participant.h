@@ -138,6 +138,10 @@ class TransactionParticipant : public TransactionStatusManager {
 
   boost::optional<CommitMetadata> LocalCommitData(const TransactionId& id) override;
 
+  boost::optional<CommitMetadata> CachedCommitData(const TransactionId& id) override;
+
+  void CacheCommitData(const TransactionId& id, const CommitMetadata& data) override;
+
   void RequestStatusAt(const StatusRequest& request) override;
 
   void Abort(const TransactionId& id, TransactionStatusCallback callback) override;
@@ -31,6 +31,8 @@
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/redis_operation.h"
 
+#include "yb/gutil/walltime.h"
+
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/tablet.h"
@@ -42,6 +44,7 @@
 
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
 
 using namespace std::placeholders;
@@ -169,6 +172,11 @@ void WriteQuery::Finished(WriteOperation* operation, const Status& status) {
     if (metrics) {
       auto op_duration_usec = MonoDelta(CoarseMonoClock::now() - start_time_).ToMicroseconds();
       metrics->write_op_duration_client_propagated_consistency->Increment(op_duration_usec);
+      metrics->write_ops->Increment();
+      if (client_request_) {
+        metrics->write_bytes->IncrementBy(client_request_->ByteSizeLong());
+      }
+      metrics->request_cpu_time_us->IncrementBy(cpu_time_us_);
     }
   }
 
@@ -374,7 +382,9 @@ Result<bool> WriteQuery::PgsqlPrepareExecute() {
 }
 
 void WriteQuery::Execute(std::unique_ptr<WriteQuery> query) {
+  const auto start_cpu_time = GetThreadCpuTimeMicros();
   auto prepare_result = query->PrepareExecute();
+  query->cpu_time_us_ += GetThreadCpuTimeMicros() - start_cpu_time;
   if (!prepare_result.ok()) {
     StartSynchronization(std::move(query), prepare_result.status());
     return;
@@ -517,6 +527,10 @@ void WriteQuery::CompleteExecute() {
 }
 
 CHECKED_STATUS WriteQuery::DoCompleteExecute() {
+  const auto start_cpu_time = GetThreadCpuTimeMicros();
+  auto se = ScopeExit([this, start_cpu_time] {
+    cpu_time_us_ += GetThreadCpuTimeMicros() - start_cpu_time;
+  });
   auto read_op = prepare_result_.need_read_snapshot
       ? VERIFY_RESULT(ScopedReadOperation::Create(&tablet(), RequireLease::kTrue, read_time_))
       : ScopedReadOperation();
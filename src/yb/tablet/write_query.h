@@ -207,6 +207,9 @@ class WriteQuery {
   // this transaction's start time
   CoarseTimePoint start_time_;
 
+  // CPU time spent on preparing and executing this write, reported as a part of the tablet load.
+  int64_t cpu_time_us_ = 0;
+
   HybridTime restart_read_ht_;
 
   docdb::DocOperations doc_ops_;
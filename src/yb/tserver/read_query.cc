@@ -17,6 +17,7 @@
 #include "yb/common/transaction.h"
 
 #include "yb/gutil/bind.h"
+#include "yb/gutil/walltime.h"
 
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/read_result.h"
@@ -35,10 +36,13 @@
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
 
 using namespace std::literals;
+using namespace yb::size_literals;
 
 DEFINE_test_flag(int32, transactional_read_delay_ms, 0,
                  "Amount of time to delay between transaction status check and reading start.");
@@ -59,11 +63,26 @@ DEFINE_bool(parallelize_read_ops, true,
 TAG_FLAG(parallelize_read_ops, advanced);
 TAG_FLAG(parallelize_read_ops, runtime);
 
+DEFINE_uint64(read_rows_data_zero_copy_min_size, 64_KB,
+              "Rows data of a read result that is at least this size is attached to the response "
+              "without copying. Smaller rows data is copied to the shared sidecar buffer.");
+TAG_FLAG(read_rows_data_zero_copy_min_size, advanced);
+TAG_FLAG(read_rows_data_zero_copy_min_size, runtime);
+
 namespace yb {
 namespace tserver {
 
 namespace {
 
+size_t AddRowsDataSidecar(faststring* rows_data, rpc::RpcContext* context) {
+  if (rows_data->size() < FLAGS_read_rows_data_zero_copy_min_size) {
+    return context->AddRpcSidecar(*rows_data);
+  }
+  // Buffer keeps the whole capacity of the string, so it is charged to the call memory tracker.
+  const auto allocated_size = rows_data->capacity();
+  return context->AddRpcSidecar(RefCntBuffer(std::move(*rows_data)), allocated_size);
+}
+
 void HandleRedisReadRequestAsync(
     tablet::AbstractTablet* tablet,
     CoarseTimePoint deadline,
@@ -124,6 +143,9 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
 
   void UpdateConsistentPrefixMetrics();
 
+  // Updates tablet metrics used to report the load of the tablet to the master.
+  void UpdateLoadMetrics(MicrosecondsInt64 start_cpu_time);
+
   // Used when we write intents during read, i.e. for serializable isolation.
   // We cannot proceed with read from completion callback, to avoid holding
   // replica state lock for too long.
@@ -155,6 +177,8 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
   tablet::RequireLease require_lease_ = tablet::RequireLease::kFalse;
   HostPortPB host_port_pb_;
   bool allow_retry_ = false;
+  // Total size of sidecars added to the response.
+  size_t sidecars_size_ = 0;
   RequestScope request_scope_;
   std::shared_ptr<ReadQuery> retained_self_;
 };
@@ -411,9 +435,11 @@ CHECKED_STATUS ReadQuery::DoPickReadTime(server::Clock* clock) {
 }
 
 CHECKED_STATUS ReadQuery::Complete() {
+  const auto start_cpu_time = GetThreadCpuTimeMicros();
   for (;;) {
     resp_->Clear();
     context_.ResetRpcSidecars();
+    sidecars_size_ = 0;
     VLOG(1) << "Read time: " << read_time_ << ", safe: " << safe_ht_to_read_;
     const auto result = VERIFY_RESULT(DoRead());
     if (allow_retry_ && read_time_ && read_time_ == result) {
@@ -487,6 +513,8 @@ CHECKED_STATUS ReadQuery::Complete() {
   }
 #endif
 
+  UpdateLoadMetrics(start_cpu_time);
+
   MakeRpcOperationCompletionCallback<ReadResponsePB>(
       std::move(context_), resp_, server_.Clock())(Status::OK());
   TRACE("Done Read");
@@ -494,6 +522,17 @@ CHECKED_STATUS ReadQuery::Complete() {
   return Status::OK();
 }
 
+void ReadQuery::UpdateLoadMetrics(MicrosecondsInt64 start_cpu_time) {
+  auto* metrics = tablet()->metrics();
+  if (!metrics) {
+    return;
+  }
+  metrics->read_ops->Increment();
+  metrics->read_bytes->IncrementBy(resp_->ByteSizeLong() + sidecars_size_);
+  metrics->request_cpu_time_us->IncrementBy(
+      std::max<MicrosecondsInt64>(GetThreadCpuTimeMicros() - start_cpu_time, 0));
+}
+
 Result<ReadHybridTime> ReadQuery::DoRead() {
   Result<ReadHybridTime> result{ReadHybridTime()};
   {
@@ -594,8 +633,9 @@ Result<ReadHybridTime> ReadQuery::DoReadImpl() {
       if (result.restart_read_ht.is_valid()) {
         return FormRestartReadHybridTime(result.restart_read_ht);
       }
+      sidecars_size_ += result.rows_data.size();
       result.response.set_rows_data_sidecar(
-          narrow_cast<int32_t>(context_.AddRpcSidecar(result.rows_data)));
+          narrow_cast<int32_t>(AddRowsDataSidecar(&result.rows_data, &context_)));
       resp_->add_ql_batch()->Swap(&result.response);
     }
     return ReadHybridTime();
@@ -619,8 +659,9 @@ Result<ReadHybridTime> ReadQuery::DoReadImpl() {
       if (result.restart_read_ht.is_valid()) {
         return FormRestartReadHybridTime(result.restart_read_ht);
       }
+      sidecars_size_ += result.rows_data.size();
       result.response.set_rows_data_sidecar(
-          narrow_cast<int32_t>(context_.AddRpcSidecar(result.rows_data)));
+          narrow_cast<int32_t>(AddRowsDataSidecar(&result.rows_data, &context_)));
       resp_->add_pgsql_batch()->Swap(&result.response);
     }
 
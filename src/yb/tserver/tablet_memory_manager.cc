@@ -76,6 +76,21 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_string(db_block_cache_type, "lru",
+              "Eviction policy of the block cache: lru or clock. CLOCK cache does not take "
+              "exclusive locks on cache hits, so it scales better with a large number of cores.");
+TAG_FLAG(db_block_cache_type, advanced);
+
+static bool ValidateBlockCacheType(const char* flagname, const std::string& value) {
+  if (value == "lru" || value == "clock") {
+    return true;
+  }
+  LOG(ERROR) << "Invalid value for " << flagname << ": " << value << ", expected lru or clock";
+  return false;
+}
+static bool db_block_cache_type_dummy = google::RegisterFlagValidator(
+    &FLAGS_db_block_cache_type, &ValidateBlockCacheType);
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
@@ -196,8 +211,14 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    if (FLAGS_db_block_cache_type == "clock") {
+      options->block_cache = rocksdb::NewClockCache(
+          block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits,
+          false /* strict_capacity_limit */);
+    } else {
+      options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
+                                                  FLAGS_db_block_cache_num_shard_bits);
+    }
     options->block_cache->SetMetrics(metrics);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
@@ -2250,13 +2250,25 @@ void TabletServiceImpl::GetSplitKey(
     const GetSplitKeyRequestPB* req, GetSplitKeyResponsePB* resp, RpcContext context) {
   TEST_PAUSE_IF_FLAG(TEST_pause_tserver_get_split_key);
   PerformAtLeader(req, resp, &context,
-      [resp](const LeaderTabletPeer& leader_tablet_peer) -> Status {
+      [req, resp](const LeaderTabletPeer& leader_tablet_peer) -> Status {
         const auto& tablet = leader_tablet_peer.tablet;
 
         if (tablet->MayHaveOrphanedPostSplitData()) {
           return STATUS(IllegalState, "Tablet has orphaned post-split data");
         }
-        const auto split_encoded_key = VERIFY_RESULT(tablet->GetEncodedMiddleSplitKey());
+        std::string split_encoded_key;
+        if (req->by_access_distribution()) {
+          auto access_split_key = tablet->GetEncodedAccessSplitKey();
+          if (access_split_key.ok()) {
+            split_encoded_key = std::move(*access_split_key);
+          } else {
+            LOG(INFO) << "Using middle split key for tablet " << tablet->tablet_id() << ": "
+                      << access_split_key.status();
+          }
+        }
+        if (split_encoded_key.empty()) {
+          split_encoded_key = VERIFY_RESULT(tablet->GetEncodedMiddleSplitKey());
+        }
         resp->set_split_encoded_key(split_encoded_key);
         const auto doc_key_hash = VERIFY_RESULT(docdb::DecodeDocKeyHash(split_encoded_key));
         if (doc_key_hash.has_value()) {
@@ -19,12 +19,15 @@
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_service.service.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
@@ -36,6 +39,11 @@ DEFINE_int32(tserver_heartbeat_metrics_interval_ms, 5000,
 DEFINE_bool(tserver_heartbeat_metrics_add_drive_data, true,
             "Add drive data to metrics which tserver sends to master");
 
+DEFINE_bool(tserver_heartbeat_metrics_add_tablet_load, true,
+            "Add load of each tablet, i.e. rates of served requests and CPU time spent on them, "
+            "to metrics which tserver sends to master. Used by load-aware balancing.");
+TAG_FLAG(tserver_heartbeat_metrics_add_tablet_load, runtime);
+
 using namespace std::literals;
 
 namespace yb {
@@ -61,7 +69,12 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   bool no_full_tablet_report = !req->has_tablet_report() || req->tablet_report().is_incremental();
   bool should_add_tablet_data =
       FLAGS_tserver_heartbeat_metrics_add_drive_data && no_full_tablet_report;
+  bool should_add_tablet_load =
+      GetAtomicFlag(&FLAGS_tserver_heartbeat_metrics_add_tablet_load) && no_full_tablet_report;
 
+  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
+  double_t div = diff.ToSeconds();
+  std::unordered_map<std::string, TabletLoadCounters> tablet_load;
 
   for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
     if (tablet_peer) {
@@ -82,12 +95,36 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
           tablet_metadata->set_may_have_orphaned_post_split_data(
                 tablet->MayHaveOrphanedPostSplitData());
         }
+        auto* tablet_metrics = tablet->metrics();
+        if (tablet_metrics) {
+          auto& counters = tablet_load[tablet_peer->tablet_id()];
+          counters.read_ops = tablet_metrics->read_ops->value();
+          counters.read_bytes = tablet_metrics->read_bytes->value();
+          counters.write_ops = tablet_metrics->write_ops->value();
+          counters.write_bytes = tablet_metrics->write_bytes->value();
+          counters.cpu_time_us = tablet_metrics->request_cpu_time_us->value();
+          auto it = prev_tablet_load_.find(tablet_peer->tablet_id());
+          if (should_add_tablet_load && div > 0 && it != prev_tablet_load_.end()) {
+            const auto& prev = it->second;
+            auto rate = [div](int64_t value, int64_t prev_value) {
+              return value > prev_value ? static_cast<double>(value - prev_value) / div : 0.0;
+            };
+            auto* load = req->add_tablet_load_metrics();
+            load->set_tablet_id(tablet_peer->tablet_id());
+            load->set_read_ops_per_sec(rate(counters.read_ops, prev.read_ops));
+            load->set_read_bytes_per_sec(rate(counters.read_bytes, prev.read_bytes));
+            load->set_write_ops_per_sec(rate(counters.write_ops, prev.write_ops));
+            load->set_write_bytes_per_sec(rate(counters.write_bytes, prev.write_bytes));
+            load->set_cpu_time_us_per_sec(rate(counters.cpu_time_us, prev.cpu_time_us));
+          }
+        }
       }
     }
   }
   metrics->set_total_sst_file_size(total_file_sizes);
   metrics->set_uncompressed_sst_file_size(uncompressed_file_sizes);
   metrics->set_num_sst_files(num_files);
+  prev_tablet_load_ = std::move(tablet_load);
 
   // Get the total number of read and write operations.
   auto reads_hist = server().GetMetricsHistogram(
@@ -99,9 +136,6 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
   // Calculate the read and write ops per second.
-  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
-  double_t div = diff.ToSeconds();
-
   double rops_per_sec = (div > 0 && num_reads > 0) ?
       (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
@@ -15,6 +15,8 @@
 #define YB_TSERVER_TSERVER_METRICS_HEARTBEAT_DATA_PROVIDER_H
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "yb/tserver/heartbeater.h"
 
@@ -31,11 +33,23 @@ class TServerMetricsHeartbeatDataProvider : public PeriodicalHeartbeatDataProvid
 
   uint64_t CalculateUptime();
 
+  // Counters of requests served by a tablet, used to calculate the load of the tablet.
+  struct TabletLoadCounters {
+    int64_t read_ops = 0;
+    int64_t read_bytes = 0;
+    int64_t write_ops = 0;
+    int64_t write_bytes = 0;
+    int64_t cpu_time_us = 0;
+  };
+
   MonoTime start_time_;
 
   // Stores the total read and writes ops for computing iops.
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
+
+  // Tablet counters at the time of the previous heartbeat with metrics.
+  std::unordered_map<std::string, TabletLoadCounters> prev_tablet_load_;
 };
 
 } // namespace tserver
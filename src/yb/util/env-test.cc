@@ -47,11 +47,14 @@
 #include "yb/util/crc.h"
 #include "yb/util/env.h"
 #include "yb/util/env_util.h"
+#include "yb/util/errno.h"
+#include "yb/util/io_uring.h"
 #include "yb/util/memenv/memenv.h"
 #include "yb/util/os-util.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
 #include "yb/util/path_util.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
@@ -59,6 +62,11 @@
 
 DECLARE_int32(o_direct_block_size_bytes);
 DECLARE_bool(TEST_simulate_fs_without_fallocate);
+DECLARE_bool(use_io_uring_reads);
+DECLARE_uint64(io_uring_read_chunk_bytes);
+DECLARE_int32(TEST_io_uring_fail_after_submitted_reads);
+DECLARE_bool(use_io_uring_async_sync);
+DECLARE_bool(never_fsync);
 
 #if !defined(__APPLE__)
 #include <linux/falloc.h>
@@ -546,6 +554,131 @@ TEST_P(TestEnv, TestAppendVector) {
   }
 }
 
+// Large reads are split into chunks read with io_uring, or with pread when io_uring is not
+// available, the result should be the same.
+TEST_F(TestEnv, TestIoUringReads) {
+  constexpr size_t kChunkSize = 4096;
+  constexpr size_t kFileSize = kChunkSize * 100 + 123;
+  FLAGS_use_io_uring_reads = true;
+  FLAGS_io_uring_read_chunk_bytes = kChunkSize;
+
+  Env* env = Env::Default();
+  string test_file = JoinPathSegments(GetTestDataDirectory(), "test_file");
+  ASSERT_NO_FATALS(WriteTestFile(env, test_file, kFileSize));
+  std::unique_ptr<RandomAccessFile> file;
+  ASSERT_OK(env->NewRandomAccessFile(test_file, &file));
+
+  std::unique_ptr<uint8_t[]> scratch(new uint8_t[kFileSize + kChunkSize]);
+  for (auto offset : {0UL, 1UL, kChunkSize * 3 + 17}) {
+    // Read past the end of file, to check short reads.
+    for (auto size : {kChunkSize * 2, kChunkSize * 7 + 5, kFileSize - offset,
+                      kFileSize + kChunkSize - offset}) {
+      SCOPED_TRACE(Format("Offset: $0, size: $1", offset, size));
+      Slice result;
+      ASSERT_OK(file->Read(offset, size, &result, scratch.get()));
+      ASSERT_EQ(std::min<size_t>(size, kFileSize - offset), result.size());
+      for (size_t i = 0; i != result.size(); ++i) {
+        ASSERT_EQ(((offset + i) * 31) & 0xff, result[i]);
+      }
+    }
+  }
+}
+
+// Submission of a batch fails in the middle, the submitted reads should be completed before
+// the failure is returned, and the ring should be usable afterwards.
+TEST_F(TestEnv, TestIoUringSubmitFailure) {
+  constexpr size_t kChunkSize = 4096;
+  constexpr size_t kNumReads = 10;
+  constexpr size_t kNumSubmitted = 4;
+  constexpr size_t kFileSize = kChunkSize * kNumReads;
+
+  Env* env = Env::Default();
+  string test_file = JoinPathSegments(GetTestDataDirectory(), "test_file");
+  ASSERT_NO_FATALS(WriteTestFile(env, test_file, kFileSize));
+  int fd = open(test_file.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0) << ErrnoToString(errno);
+  auto se = ScopeExit([fd] { close(fd); });
+
+  auto* ring = IoUring::ForCurrentThread();
+  if (!ring) {
+    LOG(INFO) << "io_uring is not supported, skipping test";
+    return;
+  }
+
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[kFileSize]);
+  std::vector<IoUringRead> reads(kNumReads);
+  for (size_t i = 0; i != kNumReads; ++i) {
+    reads[i].offset = i * kChunkSize;
+    reads[i].size = kChunkSize;
+    reads[i].buffer = buffer.get() + i * kChunkSize;
+  }
+
+  FLAGS_TEST_io_uring_fail_after_submitted_reads = kNumSubmitted;
+  ASSERT_NOK(ring->Read(fd, reads.data(), reads.size()));
+  FLAGS_TEST_io_uring_fail_after_submitted_reads = -1;
+  for (size_t i = 0; i != kNumReads; ++i) {
+    SCOPED_TRACE(Format("Read: $0", i));
+    if (i < kNumSubmitted) {
+      ASSERT_EQ(static_cast<ssize_t>(kChunkSize), reads[i].result);
+    } else {
+      ASSERT_EQ(-ECANCELED, reads[i].result);
+    }
+  }
+  for (size_t i = 0; i != kNumSubmitted * kChunkSize; ++i) {
+    ASSERT_EQ((i * 31) & 0xff, buffer[i]);
+  }
+
+  // Nothing should write to the buffer after the failed read returned.
+  memset(buffer.get(), 0, kFileSize);
+  ring = IoUring::ForCurrentThread();
+  ASSERT_NE(ring, nullptr);
+  ASSERT_OK(ring->Read(fd, reads.data(), reads.size()));
+  for (size_t i = 0; i != kNumReads; ++i) {
+    ASSERT_EQ(static_cast<ssize_t>(kChunkSize), reads[i].result);
+  }
+  for (size_t i = 0; i != kFileSize; ++i) {
+    ASSERT_EQ((i * 31) & 0xff, buffer[i]);
+  }
+}
+
+// Syncs started with io_uring are completed by the background thread, and their failures are
+// returned to the waiter.
+TEST_F(TestEnv, TestIoUringAsyncSync) {
+  FLAGS_never_fsync = false;
+  FLAGS_use_io_uring_async_sync = true;
+
+  string test_file = JoinPathSegments(GetTestDataDirectory(), "test_file");
+  std::unique_ptr<WritableFile> writer;
+  ASSERT_OK(env_->NewWritableFile(test_file, &writer));
+  std::string expected;
+  for (int i = 0; i != 100; ++i) {
+    auto data = Format("Entry $0;", i);
+    ASSERT_OK(writer->Append(data));
+    expected += data;
+    ASSERT_OK(writer->SyncAsync());
+  }
+  ASSERT_OK(writer->Close());
+
+  faststring content;
+  ASSERT_OK(ReadFileToString(env_.get(), test_file, &content));
+  ASSERT_EQ(expected, content.ToString());
+
+  int fd = open(test_file.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0) << ErrnoToString(errno);
+  auto sync = IoUring::StartSync(fd, /* data_only= */ true);
+  if (!sync) {
+    close(fd);
+    LOG(INFO) << "io_uring is not supported, skipping the rest of the test";
+    return;
+  }
+  ASSERT_OK(sync->Wait());
+  close(fd);
+
+  sync = IoUring::StartSync(-1, /* data_only= */ true);
+  ASSERT_NE(sync, nullptr);
+  ASSERT_NOK(sync->Wait());
+}
+
 TEST_F(TestEnv, TestRandomData) {
   WritableFileOptions opts;
   opts.o_direct = true;
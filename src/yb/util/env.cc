@@ -239,6 +239,10 @@ Status WritableFileWrapper::Sync() {
   return target_->Sync();
 }
 
+Status WritableFileWrapper::SyncAsync() {
+  return target_->SyncAsync();
+}
+
 Status EnvWrapper::NewSequentialFile(const std::string& f,
     std::unique_ptr<SequentialFile>* r) {
   return target_->NewSequentialFile(f, r);
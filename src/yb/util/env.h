@@ -522,6 +522,11 @@ class WritableFile {
 
   virtual CHECKED_STATUS Sync() = 0;
 
+  // Starts syncing the file without waiting for the sync to complete. Its result is returned by
+  // the following Sync, SyncAsync or Close, that also wait for it. Files that could not sync
+  // asynchronously sync synchronously.
+  virtual CHECKED_STATUS SyncAsync() { return Sync(); }
+
   virtual uint64_t Size() const = 0;
 
   // Returns the filename provided when the WritableFile was constructed.
@@ -552,6 +557,7 @@ class WritableFileWrapper : public WritableFile {
   CHECKED_STATUS Close() override;
   CHECKED_STATUS Flush(FlushMode mode) override;
   CHECKED_STATUS Sync() override;
+  CHECKED_STATUS SyncAsync() override;
   uint64_t Size() const override { return target_->Size(); }
   const std::string& filename() const override { return target_->filename(); }
 
@@ -59,6 +59,7 @@
 #include "yb/util/file_system_posix.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
+#include "yb/util/io_uring.h"
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/malloc.h"
@@ -97,6 +98,12 @@ DEFINE_bool(writable_file_use_fsync, false,
             "data to disk.");
 TAG_FLAG(writable_file_use_fsync, advanced);
 
+DEFINE_bool(use_io_uring_async_sync, false,
+            "Start asynchronous syncs of writable files, like periodic WAL syncs, with io_uring on "
+            "Linux instead of syncing them synchronously.");
+TAG_FLAG(use_io_uring_async_sync, advanced);
+TAG_FLAG(use_io_uring_async_sync, runtime);
+
 #ifdef __APPLE__
 // Never fsync on Mac OS X as we are getting many slow fsync errors in Jenkins and the fsync
 // implementation is very different in production (on Linux) anyway.
@@ -363,7 +370,8 @@ class PosixWritableFile : public WritableFile {
   Status Close() override {
     TRACE_EVENT1("io", "PosixWritableFile::Close", "path", filename_);
     ThreadRestrictions::AssertIOAllowed();
-    Status s;
+    // The file descriptor should not be closed while it is being synced.
+    Status s = WaitForAsyncSync();
 
     // If we've allocated more space than we used, truncate to the
     // actual size of the file and perform Sync().
@@ -420,6 +428,7 @@ class PosixWritableFile : public WritableFile {
     TRACE_EVENT1("io", "PosixWritableFile::Sync", "path", filename_);
     ThreadRestrictions::AssertIOAllowed();
     LOG_SLOW_EXECUTION(WARNING, 1000, Substitute("sync call for $0", filename_)) {
+      RETURN_NOT_OK(WaitForAsyncSync());
       if (pending_sync_) {
         pending_sync_ = false;
         RETURN_NOT_OK(DoSync(fd_, filename_));
@@ -428,6 +437,26 @@ class PosixWritableFile : public WritableFile {
     return Status::OK();
   }
 
+  Status SyncAsync() override {
+    TRACE_EVENT1("io", "PosixWritableFile::SyncAsync", "path", filename_);
+    ThreadRestrictions::AssertIOAllowed();
+    if (!FLAGS_use_io_uring_async_sync || FLAGS_never_fsync) {
+      return Sync();
+    }
+    // Data written after a sync was started is not necessarily synced by it, so syncs are not
+    // coalesced.
+    RETURN_NOT_OK(WaitForAsyncSync());
+    if (!pending_sync_) {
+      return Status::OK();
+    }
+    async_sync_ = IoUring::StartSync(fd_, !FLAGS_writable_file_use_fsync);
+    if (!async_sync_) {
+      return Sync();
+    }
+    pending_sync_ = false;
+    return Status::OK();
+  }
+
   uint64_t Size() const override {
     return filesize_;
   }
@@ -443,6 +472,18 @@ class PosixWritableFile : public WritableFile {
     bool pending_sync_;
 
  private:
+  Status WaitForAsyncSync() {
+    if (!async_sync_) {
+      return Status::OK();
+    }
+    auto sync = std::move(async_sync_);
+    RETURN_NOT_OK_PREPEND(sync->Wait(), filename_);
+    return Status::OK();
+  }
+
+  // Sync started by SyncAsync, that was not waited for yet.
+  std::shared_ptr<IoUringSync> async_sync_;
+
   Status DoWritev(const Slice* slices, size_t n) {
     ThreadRestrictions::AssertIOAllowed();
     DCHECK_LE(n, IOV_MAX);
@@ -574,6 +615,11 @@ class PosixDirectIOWritableFile final : public PosixWritableFile {
     return DoWrite();
   }
 
+  // Data is buffered until it is synced, so it could not be synced asynchronously.
+  Status SyncAsync() override {
+    return Sync();
+  }
+
   uint64_t Size() const override {
     return real_size_;
   }
@@ -32,10 +32,10 @@
 
 #include "yb/util/faststring.h"
 
-#include <memory>
-
 #include <glog/logging.h>
 
+#include "yb/util/malloc.h"
+
 namespace yb {
 
 void faststring::GrowByAtLeast(size_t count) {
@@ -53,20 +53,41 @@ void faststring::GrowByAtLeast(size_t count) {
 
 void faststring::GrowArray(size_t newcapacity) {
   DCHECK_GE(newcapacity, capacity_);
-  std::unique_ptr<uint8_t[]> newdata(new uint8_t[newcapacity]);
+  uint8_t* newdata = AllocateArray(newcapacity);
   if (len_ > 0) {
-    memcpy(&newdata[0], &data_[0], len_);
+    memcpy(newdata, data_, len_);
   }
   capacity_ = newcapacity;
   if (data_ != initial_data_) {
-    delete[] data_;
+    FreeArray(data_);
   } else {
     ASAN_POISON_MEMORY_REGION(initial_data_, arraysize(initial_data_));
   }
 
-  data_ = newdata.release();
+  data_ = newdata;
   ASAN_POISON_MEMORY_REGION(data_ + len_, capacity_ - len_);
 }
 
+uint8_t* faststring::AllocateArray(size_t capacity) {
+  return reinterpret_cast<uint8_t*>(malloc_with_check(kHeaderSize + capacity)) + kHeaderSize;
+}
+
+void faststring::FreeArray(uint8_t* data) {
+  free(data - kHeaderSize);
+}
+
+uint8_t* faststring::DetachArray() {
+  if (data_ == initial_data_) {
+    return nullptr;
+  }
+  uint8_t* result = data_;
+  ASAN_UNPOISON_MEMORY_REGION(result, capacity_);
+  len_ = 0;
+  capacity_ = kInitialCapacity;
+  data_ = initial_data_;
+  ASAN_POISON_MEMORY_REGION(data_, capacity_);
+  return result;
+}
+
 
 } // namespace yb
@@ -61,7 +61,7 @@ class faststring {
         len_(0),
         capacity_(kInitialCapacity) {
     if (capacity > capacity_) {
-      data_ = new uint8_t[capacity];
+      data_ = AllocateArray(capacity);
       capacity_ = capacity;
     }
     ASAN_POISON_MEMORY_REGION(data_, capacity_);
@@ -70,7 +70,7 @@ class faststring {
   ~faststring() {
     ASAN_UNPOISON_MEMORY_REGION(initial_data_, arraysize(initial_data_));
     if (data_ != initial_data_) {
-      delete[] data_;
+      FreeArray(data_);
     }
   }
 
@@ -96,14 +96,17 @@ class faststring {
     ASAN_UNPOISON_MEMORY_REGION(data_, len_);
   }
 
-  // Releases the underlying array; after this, the buffer is left empty.
+  // Releases the underlying data as an array that should be freed with delete[]; after this, the
+  // buffer is left empty.
   //
-  // NOTE: the data pointer returned by release() is not necessarily the pointer
+  // NOTE: the returned array is always a new copy of the data, since the heap allocated array of
+  // the string is preceded by the RefCntBuffer header and could not be freed with delete[]. Use
+  // RefCntBuffer(faststring&&) to take the data without copying.
   uint8_t *release() WARN_UNUSED_RESULT {
-    uint8_t *ret = data_;
-    if (ret == initial_data_) {
-      ret = new uint8_t[len_];
-      memcpy(ret, data_, len_);
+    uint8_t *ret = new uint8_t[len_];
+    memcpy(ret, data_, len_);
+    if (data_ != initial_data_) {
+      FreeArray(data_);
     }
     len_ = 0;
     capacity_ = kInitialCapacity;
@@ -261,10 +264,23 @@ class faststring {
   // the current capacity.
   void GrowArray(size_t newcapacity);
 
+  // Heap allocated array is preceded by kHeaderSize bytes, so RefCntBuffer could take ownership
+  // of it without copying the data. See RefCntBuffer(faststring&&).
+  static uint8_t* AllocateArray(size_t capacity);
+  static void FreeArray(uint8_t* data);
+
+  // Returns the heap allocated array and leaves the string empty. Returns nullptr if the data is
+  // stored in initial_data_, in this case the string is not changed.
+  uint8_t* DetachArray();
+
+  friend class RefCntBuffer;
+
   enum {
     kInitialCapacity = 32
   };
 
+  static constexpr size_t kHeaderSize = 2 * sizeof(size_t);
+
   uint8_t* data_;
   uint8_t initial_data_[kInitialCapacity];
   size_t len_;
@@ -19,19 +19,42 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <vector>
+
 #ifdef __linux__
 #include <linux/fs.h>
 #include <sys/statfs.h>
 #include <sys/syscall.h>
 #endif // __linux__
 
+#include <gflags/gflags.h>
+
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/io_uring.h"
+#include "yb/util/logging.h"
 #include "yb/util/malloc.h"
 #include "yb/util/result.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/thread_restrictions.h"
 
+using namespace yb::size_literals;
+
+DEFINE_bool(use_io_uring_reads, false,
+            "Whether large reads of random access files, like readahead of SST files by "
+            "iterators and compactions, should be split into chunks submitted at once with "
+            "io_uring on Linux. Falls back to pread when io_uring is not supported.");
+TAG_FLAG(use_io_uring_reads, advanced);
+TAG_FLAG(use_io_uring_reads, runtime);
+
+DEFINE_uint64(io_uring_read_chunk_bytes, 128_KB,
+              "Size of chunks large reads are split into when use_io_uring_reads is enabled. "
+              "Only reads of at least two chunks are done with io_uring.");
+TAG_FLAG(io_uring_read_chunk_bytes, advanced);
+
 // For platforms without fdatasync (like OS X)
 #ifndef fdatasync
 #define fdatasync fsync
@@ -160,6 +183,44 @@ PosixRandomAccessFile::PosixRandomAccessFile(const std::string& fname, int fd,
 
 PosixRandomAccessFile::~PosixRandomAccessFile() { close(fd_); }
 
+size_t PosixRandomAccessFile::ReadWithIoUring(
+    uint64_t offset, size_t n, uint8_t* scratch) const {
+  const size_t chunk_size = std::max<size_t>(FLAGS_io_uring_read_chunk_bytes, 4_KB);
+  if (n < 2 * chunk_size) {
+    return 0;
+  }
+  auto* ring = IoUring::ForCurrentThread();
+  if (!ring) {
+    return 0;
+  }
+
+  std::vector<IoUringRead> reads;
+  reads.reserve((n + chunk_size - 1) / chunk_size);
+  for (size_t pos = 0; pos < n; pos += chunk_size) {
+    reads.emplace_back();
+    auto& read = reads.back();
+    read.offset = offset + pos;
+    read.size = std::min(chunk_size, n - pos);
+    read.buffer = scratch + pos;
+  }
+  auto status = ring->Read(fd_, reads.data(), reads.size());
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 10) << "io_uring read of " << filename_ << " failed: " << status;
+    return 0;
+  }
+
+  // Return the size of the prefix read completely, the rest is read by the caller, that also
+  // handles the end of file and reports errors.
+  size_t result = 0;
+  for (const auto& read : reads) {
+    if (read.result < 0 || static_cast<size_t>(read.result) != read.size) {
+      break;
+    }
+    result += read.size;
+  }
+  return result;
+}
+
 Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
                                    uint8_t* scratch) const {
   ThreadRestrictions::AssertIOAllowed();
@@ -167,6 +228,15 @@ Status PosixRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
   ssize_t r = -1;
   size_t left = n;
   uint8_t* ptr = scratch;
+  if (FLAGS_use_io_uring_reads) {
+    const size_t read_with_io_uring = ReadWithIoUring(offset, n, scratch);
+    if (read_with_io_uring != 0) {
+      r = 0;
+      ptr += read_with_io_uring;
+      offset += read_with_io_uring;
+      left -= read_with_io_uring;
+    }
+  }
   while (left > 0) {
     r = pread(fd_, ptr, left, static_cast<off_t>(offset));
 
@@ -65,6 +65,9 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual CHECKED_STATUS InvalidateCache(size_t offset, size_t length) override;
 
  private:
+  // Reads a large range with io_uring, returns the size of its prefix that was read.
+  size_t ReadWithIoUring(uint64_t offset, size_t n, uint8_t* scratch) const;
+
   std::string filename_;
   int fd_;
   bool use_os_buffer_;
@@ -0,0 +1,458 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/io_uring.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define YB_IO_URING_SUPPORTED 1
+#endif
+#endif
+
+#if YB_IO_URING_SUPPORTED
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#endif
+
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/status_format.h"
+#include "yb/util/thread.h"
+
+using namespace std::literals;
+
+DEFINE_test_flag(int32, io_uring_fail_after_submitted_reads, -1,
+                 "When non negative, io_uring submission of a batch of reads fails after "
+                 "submitting the specified number of reads.");
+
+namespace yb {
+
+namespace {
+
+constexpr unsigned kRingEntries = 64;
+
+// Set when io_uring could not be created, so there is no reason to try it again.
+std::atomic<bool> io_uring_unavailable{false};
+
+} // namespace
+
+Status IoUringSync::Wait() {
+  int result;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return done_; });
+    result = result_;
+  }
+  if (result < 0) {
+    return STATUS_FROM_ERRNO("io_uring sync", -result);
+  }
+  return Status::OK();
+}
+
+void IoUringSync::Complete(int result) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    result_ = result;
+    done_ = true;
+  }
+  cond_.notify_all();
+}
+
+IoUring* IoUring::ForCurrentThread() {
+#if YB_IO_URING_SUPPORTED
+  if (io_uring_unavailable.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  static thread_local std::unique_ptr<IoUring> ring;
+  if (ring && ring->broken_) {
+    // All the reads of a broken ring were completed before the failure was returned, so it is
+    // safe to destroy it.
+    ring.reset();
+  }
+  if (!ring) {
+    std::unique_ptr<IoUring> new_ring(new IoUring());
+    auto status = new_ring->Init(kRingEntries);
+    if (!status.ok()) {
+      if (!io_uring_unavailable.exchange(true)) {
+        LOG(WARNING) << "io_uring is not available, falling back to synchronous IO: " << status;
+      }
+      return nullptr;
+    }
+    ring = std::move(new_ring);
+  }
+  return ring.get();
+#else
+  return nullptr;
+#endif
+}
+
+IoUring::~IoUring() {
+#if YB_IO_URING_SUPPORTED
+  if (sqes_) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+  }
+#endif
+}
+
+#if YB_IO_URING_SUPPORTED
+
+namespace {
+
+template <class T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+} // namespace
+
+Status IoUring::Init(unsigned entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+  if (ring_fd_ < 0) {
+    return STATUS_FROM_ERRNO("io_uring_setup", errno);
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    return STATUS_FROM_ERRNO("mmap of io_uring submission queue", errno);
+  }
+  sq_tail_ = RingField<unsigned>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = *RingField<unsigned>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = *RingField<unsigned>(sq_ring_, params.sq_off.ring_entries);
+  sq_array_ = RingField<unsigned>(sq_ring_, params.sq_off.array);
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               ring_fd_, IORING_OFF_SQES);
+  if (sqes_ == MAP_FAILED) {
+    sqes_ = nullptr;
+    return STATUS_FROM_ERRNO("mmap of io_uring submission entries", errno);
+  }
+
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ring_fd_, IORING_OFF_CQ_RING);
+  if (cq_ring_ == MAP_FAILED) {
+    cq_ring_ = nullptr;
+    return STATUS_FROM_ERRNO("mmap of io_uring completion queue", errno);
+  }
+  cq_head_ = RingField<unsigned>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<unsigned>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *RingField<unsigned>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  return Status::OK();
+}
+
+Status IoUring::Submit(unsigned to_submit, unsigned* submitted) {
+  *submitted = 0;
+  if (FLAGS_TEST_io_uring_fail_after_submitted_reads >= 0) {
+    const auto limit = static_cast<unsigned>(FLAGS_TEST_io_uring_fail_after_submitted_reads);
+    if (limit < to_submit) {
+      if (limit != 0) {
+        RETURN_NOT_OK(Submit(limit, submitted));
+      }
+      return STATUS(IOError, "Injected io_uring submission failure");
+    }
+  }
+  while (*submitted != to_submit) {
+    auto result = syscall(
+        __NR_io_uring_enter, ring_fd_, to_submit - *submitted, 0, 0, nullptr, 0);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return STATUS_FROM_ERRNO("io_uring_enter", errno);
+    }
+    if (result == 0) {
+      return STATUS(IOError, "io_uring_enter did not submit any requests");
+    }
+    *submitted += static_cast<unsigned>(result);
+  }
+  return Status::OK();
+}
+
+Status IoUring::WaitForCompletion() {
+  for (;;) {
+    auto result = syscall(
+        __NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    if (result >= 0) {
+      return Status::OK();
+    }
+    if (errno != EINTR) {
+      return STATUS_FROM_ERRNO("io_uring_enter", errno);
+    }
+  }
+}
+
+Status IoUring::Read(int fd, IoUringRead* reads, size_t num_reads) {
+  std::vector<iovec> iovecs(std::min<size_t>(num_reads, sq_entries_));
+  auto* sqes = static_cast<io_uring_sqe*>(sqes_);
+  auto* cqes = static_cast<io_uring_cqe*>(cqes_);
+  while (num_reads != 0) {
+    const auto batch_size = static_cast<unsigned>(std::min<size_t>(num_reads, sq_entries_));
+    const unsigned batch_start = *sq_tail_;
+    unsigned tail = batch_start;
+    for (unsigned i = 0; i != batch_size; ++i) {
+      auto& read = reads[i];
+      read.result = 0;
+      iovecs[i].iov_base = read.buffer;
+      iovecs[i].iov_len = read.size;
+      const unsigned index = tail & sq_mask_;
+      auto& sqe = sqes[index];
+      memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_READV;
+      sqe.fd = fd;
+      sqe.off = read.offset;
+      sqe.addr = reinterpret_cast<uint64_t>(&iovecs[i]);
+      sqe.len = 1;
+      sqe.user_data = i;
+      sq_array_[index] = index;
+      ++tail;
+    }
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+    unsigned submitted = 0;
+    auto status = Submit(batch_size, &submitted);
+    if (!status.ok()) {
+      // The kernel consumes submission entries in order, so the tail of the batch is still in the
+      // submission queue. Those entries refer to iovecs and buffers that are about to go away,
+      // turn them into no-ops, and do not use this ring anymore.
+      for (unsigned i = submitted; i != batch_size; ++i) {
+        auto& sqe = sqes[(batch_start + i) & sq_mask_];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_NOP;
+        sqe.user_data = i;
+        reads[i].result = -ECANCELED;
+      }
+      broken_ = true;
+    }
+
+    // Reads that were submitted write to the caller buffers, so wait for all of them even if
+    // something failed, and only then return.
+    unsigned completed = 0;
+    while (completed != submitted) {
+      unsigned head = *cq_head_;
+      const unsigned cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      if (head == cq_tail) {
+        auto wait_status = WaitForCompletion();
+        if (!wait_status.ok()) {
+          // Completions are still posted to the completion queue, poll it until all the reads
+          // are done.
+          YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to wait for io_uring completions: "
+                                           << wait_status;
+          if (status.ok()) {
+            status = wait_status;
+          }
+          broken_ = true;
+          std::this_thread::sleep_for(1ms);
+        }
+        continue;
+      }
+      for (; head != cq_tail; ++head) {
+        const auto& cqe = cqes[head & cq_mask_];
+        if (cqe.user_data >= submitted) {
+          if (status.ok()) {
+            status = STATUS_FORMAT(
+                IllegalState, "Unexpected io_uring completion: $0", cqe.user_data);
+          }
+          broken_ = true;
+          continue;
+        }
+        reads[cqe.user_data].result = cqe.res;
+        ++completed;
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+    RETURN_NOT_OK(status);
+
+    reads += batch_size;
+    num_reads -= batch_size;
+  }
+  return Status::OK();
+}
+
+// Process wide io_uring used to start syncs, its submission queue is protected by the mutex,
+// while the completion queue is processed by the background thread.
+class IoUring::SyncRing {
+ public:
+  static SyncRing& Instance() {
+    // Completion thread could still be running at exit, so the instance is never destroyed.
+    static SyncRing* instance = new SyncRing();
+    return *instance;
+  }
+
+  std::shared_ptr<IoUringSync> StartSync(int fd, bool data_only) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!EnsureStarted() || ring_->broken_) {
+      return nullptr;
+    }
+    // Completion queue is twice as large as the submission queue, so limiting the number of syncs
+    // in flight by the submission queue size guarantees that completions are not dropped.
+    if (in_flight_ >= ring_->sq_entries_) {
+      return nullptr;
+    }
+    auto& ring = *ring_;
+    auto sync = std::make_shared<IoUringSync>();
+    const unsigned tail = *ring.sq_tail_;
+    const unsigned index = tail & ring.sq_mask_;
+    auto& sqe = static_cast<io_uring_sqe*>(ring.sqes_)[index];
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_FSYNC;
+    sqe.fd = fd;
+    sqe.fsync_flags = data_only ? IORING_FSYNC_DATASYNC : 0;
+    // Reference is released by the completion thread.
+    auto* sync_ref = new std::shared_ptr<IoUringSync>(sync);
+    sqe.user_data = reinterpret_cast<uint64_t>(sync_ref);
+    ring.sq_array_[index] = index;
+    __atomic_store_n(ring.sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+    unsigned submitted = 0;
+    auto status = ring.Submit(1, &submitted);
+    if (!status.ok() && submitted == 0) {
+      // The entry is left in the submission queue, so it is turned into no-op that is never
+      // submitted, because the ring is not used for new syncs anymore.
+      memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_NOP;
+      ring.broken_ = true;
+      delete sync_ref;
+      YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to submit io_uring sync: " << status;
+      return nullptr;
+    }
+    ++in_flight_;
+    return sync;
+  }
+
+ private:
+  SyncRing() = default;
+
+  bool EnsureStarted() {
+    if (ring_ || failed_) {
+      return ring_ != nullptr;
+    }
+    std::unique_ptr<IoUring> ring(new IoUring());
+    auto status = ring->Init(kRingEntries);
+    if (status.ok()) {
+      ring_ = std::move(ring);
+      status = Thread::Create(
+          "io_uring", "sync_completion", &SyncRing::CompleteSyncs, this, &thread_);
+      if (!status.ok()) {
+        ring_.reset();
+      }
+    }
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to start io_uring for syncs, falling back to synchronous syncs: "
+                   << status;
+      failed_ = true;
+    }
+    return ring_ != nullptr;
+  }
+
+  void CompleteSyncs() {
+    auto& ring = *ring_;
+    auto* cqes = static_cast<io_uring_cqe*>(ring.cqes_);
+    for (;;) {
+      unsigned head = *ring.cq_head_;
+      const unsigned cq_tail = __atomic_load_n(ring.cq_tail_, __ATOMIC_ACQUIRE);
+      if (head == cq_tail) {
+        auto status = ring.WaitForCompletion();
+        if (!status.ok()) {
+          YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to wait for io_uring sync completions: "
+                                           << status;
+          std::this_thread::sleep_for(1ms);
+        }
+        continue;
+      }
+      const unsigned completed = cq_tail - head;
+      for (; head != cq_tail; ++head) {
+        const auto& cqe = cqes[head & ring.cq_mask_];
+        std::unique_ptr<std::shared_ptr<IoUringSync>> sync(
+            reinterpret_cast<std::shared_ptr<IoUringSync>*>(cqe.user_data));
+        (*sync)->Complete(cqe.res);
+      }
+      __atomic_store_n(ring.cq_head_, head, __ATOMIC_RELEASE);
+      std::lock_guard<std::mutex> lock(mutex_);
+      in_flight_ -= completed;
+    }
+  }
+
+  std::mutex mutex_;
+  // Set once and never reset, so the completion thread accesses it without the mutex.
+  std::unique_ptr<IoUring> ring_;
+  bool failed_ = false;
+  unsigned in_flight_ = 0;
+  scoped_refptr<Thread> thread_;
+};
+
+std::shared_ptr<IoUringSync> IoUring::StartSync(int fd, bool data_only) {
+  return SyncRing::Instance().StartSync(fd, data_only);
+}
+
+#else
+
+std::shared_ptr<IoUringSync> IoUring::StartSync(int fd, bool data_only) {
+  return nullptr;
+}
+
+Status IoUring::Init(unsigned entries) {
+  return STATUS(NotSupported, "io_uring is not supported on this platform");
+}
+
+Status IoUring::Submit(unsigned to_submit, unsigned* submitted) {
+  return STATUS(NotSupported, "io_uring is not supported on this platform");
+}
+
+Status IoUring::WaitForCompletion() {
+  return STATUS(NotSupported, "io_uring is not supported on this platform");
+}
+
+Status IoUring::Read(int fd, IoUringRead* reads, size_t num_reads) {
+  return STATUS(NotSupported, "io_uring is not supported on this platform");
+}
+
+#endif
+
+} // namespace yb
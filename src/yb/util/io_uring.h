@@ -0,0 +1,126 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_IO_URING_H
+#define YB_UTIL_IO_URING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "yb/gutil/macros.h"
+
+#include "yb/util/status.h"
+
+namespace yb {
+
+// Read of a file range, submitted as a part of a batch.
+struct IoUringRead {
+  uint64_t offset;
+  size_t size;
+  uint8_t* buffer;
+  // Number of bytes read, or negated errno in case of failure.
+  ssize_t result = 0;
+};
+
+// Sync of a file started with IoUring::StartSync.
+class IoUringSync {
+ public:
+  IoUringSync() = default;
+
+  // Waits until the sync is completed and returns its result.
+  CHECKED_STATUS Wait();
+
+ private:
+  friend class IoUring;
+
+  void Complete(int result);
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool done_ = false;
+  // Result of the sync, 0 or negated errno.
+  int result_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUringSync);
+};
+
+// Minimal io_uring based reader, that submits a batch of reads with a single system call and
+// waits for all of them to complete. Implemented directly on top of the io_uring system calls,
+// so it does not depend on liburing. Also starts file syncs, that are completed asynchronously.
+//
+// An instance is not thread-safe, use ForCurrentThread to get the instance of the current thread.
+class IoUring {
+ public:
+  ~IoUring();
+
+  // Returns io_uring of the current thread, or nullptr if io_uring is not supported by the
+  // kernel or could not be created. Creation failure is remembered, so it is not retried.
+  static IoUring* ForCurrentThread();
+
+  // Reads all the ranges from the file, each read is submitted as a separate request, so they
+  // are executed in parallel by the device. Result of each read is stored to its result field.
+  // Returns failure only if the reads could not be submitted or waited for. Even in this case all
+  // the submitted reads are completed before return, and the reads that were not submitted have
+  // -ECANCELED result. The ring is recreated after such a failure.
+  CHECKED_STATUS Read(int fd, IoUringRead* reads, size_t num_reads);
+
+  // Starts fdatasync of the file, or fsync when data_only is false, with the process wide
+  // io_uring, whose completions are processed by a background thread. The file should not be
+  // closed until the sync is completed. Returns nullptr when the sync could not be started, so
+  // the caller should sync the file itself.
+  static std::shared_ptr<IoUringSync> StartSync(int fd, bool data_only);
+
+ private:
+  class SyncRing;
+
+  IoUring() = default;
+
+  CHECKED_STATUS Init(unsigned entries);
+  // Submits entries from the submission queue, stores the number of submitted entries to
+  // submitted, also when failure is returned.
+  CHECKED_STATUS Submit(unsigned to_submit, unsigned* submitted);
+  CHECKED_STATUS WaitForCompletion();
+
+  int ring_fd_ = -1;
+
+  // Set when the ring could be left in an inconsistent state, so it should not be used anymore.
+  bool broken_ = false;
+
+  // Submission queue.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned* sq_array_ = nullptr;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  // Completion queue.
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  void* cqes_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+} // namespace yb
+
+#endif // YB_UTIL_IO_URING_H
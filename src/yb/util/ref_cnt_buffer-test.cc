@@ -20,6 +20,7 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <gtest/gtest.h>
 
+#include "yb/util/faststring.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/test_util.h"
 
@@ -69,6 +70,33 @@ TEST_F(RefCntBufferTest, TestFromData) {
   }
 }
 
+// Test taking ownership of faststring data.
+TEST_F(RefCntBufferTest, TestFromFaststring) {
+  unsigned int seed = SeedRandom();
+  for (auto i = 1000; i--;) {
+    size_t size = rand_r(&seed) % (kSizeLimit + 1); // Zero size is also allowed
+    faststring str;
+    for (size_t index = 0; index != size; ++index) {
+      str.push_back(static_cast<char>(index));
+    }
+    const auto* old_data = str.data();
+    faststring copy;
+    copy.append(str.data(), str.size());
+
+    RefCntBuffer buffer(std::move(str));
+    ASSERT_EQ(size, buffer.size());
+    ASSERT_EQ(Slice(copy), buffer.AsSlice());
+    ASSERT_TRUE(str.empty());
+    // Only data that does not fit into the string itself is taken without copying.
+    if (size > sizeof(faststring)) {
+      ASSERT_EQ(old_data, buffer.udata());
+    }
+    // The string should remain usable after its data was taken.
+    str.append("abc", 3);
+    ASSERT_EQ("abc", str.ToString());
+  }
+}
+
 // Test vector of buffers.
 TEST_F(RefCntBufferTest, TestVector) {
   std::vector<RefCntBuffer> v;
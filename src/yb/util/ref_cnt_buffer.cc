@@ -47,6 +47,22 @@ RefCntBuffer::RefCntBuffer(const faststring& str)
     : RefCntBuffer(str.data(), str.size()) {
 }
 
+RefCntBuffer::RefCntBuffer(faststring&& str) {
+  static_assert(sizeof(CounterType) + sizeof(size_t) == faststring::kHeaderSize,
+                "faststring header does not match RefCntBuffer header");
+  const auto size = str.size();
+  auto* array = str.DetachArray();
+  if (!array) {
+    data_ = malloc_with_check(GetInternalBufSize(size));
+    memcpy(this->data(), str.data(), size);
+    str.clear();
+  } else {
+    data_ = reinterpret_cast<char*>(array) - faststring::kHeaderSize;
+  }
+  size_reference() = size;
+  new (&counter_reference()) CounterType(1);
+}
+
 RefCntBuffer::~RefCntBuffer() {
   Reset();
 }
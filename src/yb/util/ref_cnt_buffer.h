@@ -46,6 +46,10 @@ class RefCntBuffer {
 
   explicit RefCntBuffer(const faststring& str);
 
+  // Takes ownership of the heap allocated data of the string without copying it. Falls back to
+  // copying when the data is small enough to be stored inside the string. The string is left empty.
+  explicit RefCntBuffer(faststring&& str);
+
   explicit RefCntBuffer(const Slice& slice) :
       RefCntBuffer(slice.data(), slice.size()) {}
 
@@ -236,29 +236,36 @@ void CQLServiceImpl::ReturnProcessor(const CQLProcessorListPos& pos) {
   next_available_processor_ = pos;
 }
 
+CQLServiceImpl::PreparedStatementsShard& CQLServiceImpl::PreparedStatementsShardFor(
+    const ql::CQLMessage::QueryId& query_id) {
+  return prepared_stmts_shards_[
+      std::hash<ql::CQLMessage::QueryId>()(query_id) % kNumPreparedStatementsShards];
+}
+
 shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
     const ql::CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
+  auto& shard = PreparedStatementsShardFor(query_id);
   // Get exclusive lock before allocating a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<std::mutex> guard(shard.mutex);
 
   shared_ptr<CQLStatement> stmt;
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  const auto itr = shard.map.find(query_id);
+  if (itr == shard.map.end()) {
     // Allocate the prepared statement placeholder that multiple clients trying to prepare the same
     // statement to contend on. The statement will then be prepared by one client while the rest
     // wait for the results.
-    stmt = prepared_stmts_map_.emplace(
+    stmt = shard.map.emplace(
         query_id, std::make_shared<CQLStatement>(
-            keyspace, query, prepared_stmts_list_.end())).first->second;
-    InsertLruPreparedStatementUnlocked(stmt);
+            keyspace, query, shard.list.end())).first->second;
+    InsertLruPreparedStatementUnlocked(&shard, stmt);
   } else {
     // Return existing statement if found.
     stmt = itr->second;
-    MoveLruPreparedStatementUnlocked(stmt);
+    MoveLruPreparedStatementUnlocked(&shard, stmt);
   }
 
-  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "InsertPreparedStatement: CQL prepared statement cache shard count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 
   return stmt;
@@ -266,11 +273,12 @@ shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
 
 shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
     const ql::CQLMessage::QueryId& query_id) {
+  auto& shard = PreparedStatementsShardFor(query_id);
   // Get exclusive lock before looking up a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<std::mutex> guard(shard.mutex);
 
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
+  const auto itr = shard.map.find(query_id);
+  if (itr == shard.map.end()) {
     return nullptr;
   }
 
@@ -282,22 +290,23 @@ shared_ptr<const CQLStatement> CQLServiceImpl::GetPreparedStatement(
   }
   // If the statement is stale, delete it.
   if (stmt->stale()) {
-    DeletePreparedStatementUnlocked(stmt);
+    DeletePreparedStatementUnlocked(&shard, stmt);
     return nullptr;
   }
 
-  MoveLruPreparedStatementUnlocked(stmt);
+  MoveLruPreparedStatementUnlocked(&shard, stmt);
   return stmt;
 }
 
 void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  auto& shard = PreparedStatementsShardFor(stmt->query_id());
   // Get exclusive lock before deleting the prepared statement.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<std::mutex> guard(shard.mutex);
 
-  DeletePreparedStatementUnlocked(stmt);
+  DeletePreparedStatementUnlocked(&shard, stmt);
 
-  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "DeletePreparedStatement: CQL prepared statement cache shard count = "
+          << shard.map.size() << "/" << shard.list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
@@ -340,44 +349,65 @@ bool CQLServiceImpl::CheckPassword(
   return correct;
 }
 
-void CQLServiceImpl::InsertLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
+void CQLServiceImpl::InsertLruPreparedStatementUnlocked(
+    PreparedStatementsShard* shard, const shared_ptr<CQLStatement>& stmt) {
   // Insert the statement at the front of the LRU list.
-  stmt->set_pos(prepared_stmts_list_.insert(prepared_stmts_list_.begin(), stmt));
+  stmt->set_pos(shard->list.insert(shard->list.begin(), stmt));
+  stmt->set_last_access_time(CoarseMonoClock::Now());
 }
 
-void CQLServiceImpl::MoveLruPreparedStatementUnlocked(const shared_ptr<CQLStatement>& stmt) {
+void CQLServiceImpl::MoveLruPreparedStatementUnlocked(
+    PreparedStatementsShard* shard, const shared_ptr<CQLStatement>& stmt) {
   // Move the statement to the front of the LRU list.
-  prepared_stmts_list_.splice(prepared_stmts_list_.begin(), prepared_stmts_list_, stmt->pos());
+  shard->list.splice(shard->list.begin(), shard->list, stmt->pos());
+  stmt->set_last_access_time(CoarseMonoClock::Now());
 }
 
 void CQLServiceImpl::DeletePreparedStatementUnlocked(
-    const std::shared_ptr<const CQLStatement> stmt) {
+    PreparedStatementsShard* shard, const std::shared_ptr<const CQLStatement> stmt) {
   // Remove statement from cache by looking it up by query ID and only when it is same statement
   // object. Note that the "stmt" parameter above is not a ref ("&") intentionally so that we have
-  // a separate copy of the shared_ptr and not the very shared_ptr in prepared_stmts_map_ or
-  // prepared_stmt_list_ we are deleting.
-  const auto itr = prepared_stmts_map_.find(stmt->query_id());
-  if (itr != prepared_stmts_map_.end() && itr->second == stmt) {
-    prepared_stmts_map_.erase(itr);
+  // a separate copy of the shared_ptr and not the very shared_ptr in the shard map or list we are
+  // deleting.
+  const auto itr = shard->map.find(stmt->query_id());
+  if (itr != shard->map.end() && itr->second == stmt) {
+    shard->map.erase(itr);
   }
   // Remove statement from LRU list only when it is in the list, i.e. pos() != end().
-  if (stmt->pos() != prepared_stmts_list_.end()) {
-    prepared_stmts_list_.erase(stmt->pos());
-    stmt->set_pos(prepared_stmts_list_.end());
+  if (stmt->pos() != shard->list.end()) {
+    shard->list.erase(stmt->pos());
+    stmt->set_pos(shard->list.end());
   }
 }
 
 void CQLServiceImpl::CollectGarbage(size_t required) {
-  // Get exclusive lock before deleting the least recently used statement at the end of the LRU
-  // list from the cache.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  // Each shard has its own LRU list, so find the shard whose least recently used statement was
+  // accessed earliest.
+  PreparedStatementsShard* oldest_shard = nullptr;
+  CoarseTimePoint oldest_access_time;
+  for (auto& shard : prepared_stmts_shards_) {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    if (!shard.list.empty() &&
+        (oldest_shard == nullptr || shard.list.back()->last_access_time() < oldest_access_time)) {
+      oldest_shard = &shard;
+      oldest_access_time = shard.list.back()->last_access_time();
+    }
+  }
+  if (oldest_shard == nullptr) {
+    return;
+  }
 
-  if (!prepared_stmts_list_.empty()) {
-    DeletePreparedStatementUnlocked(prepared_stmts_list_.back());
+  // Get exclusive lock before deleting the least recently used statement at the end of the LRU
+  // list from the cache. The statement could be accessed after the shard was picked, then the
+  // statement that became the least recently used one in this shard is deleted.
+  std::lock_guard<std::mutex> guard(oldest_shard->mutex);
+  if (oldest_shard->list.empty()) {
+    return;
   }
+  DeletePreparedStatementUnlocked(oldest_shard, oldest_shard->list.back());
 
-  VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement cache count = "
-          << prepared_stmts_map_.size() << "/" << prepared_stmts_list_.size()
+  VLOG(1) << "DeleteLruPreparedStatement: CQL prepared statement cache shard count = "
+          << oldest_shard->map.size() << "/" << oldest_shard->list.size()
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
@@ -17,6 +17,9 @@
 #ifndef YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 #define YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include <boost/compute/detail/lru_cache.hpp>
@@ -114,19 +117,44 @@ class CQLServiceImpl : public CQLServerServiceIf,
  private:
   constexpr static int kRpcTimeoutSec = 5;
 
-  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
+  // Number of shards of the prepared statements cache. Statements are distributed between shards
+  // by their query ids, so connections executing different statements do not contend on a single
+  // mutex.
+  constexpr static size_t kNumPreparedStatementsShards = 16;
+
+  // Shard of the prepared statements cache.
+  struct PreparedStatementsShard {
+    // Prepared statements of the shard.
+    CQLStatementMap map;
+
+    // LRU list of the shard (least recently used one at the end).
+    CQLStatementList list;
+
+    // Mutex that protects the prepared statements and the LRU list of the shard.
+    std::mutex mutex;
+  };
+
+  // Returns the shard of the prepared statements cache that the statement with specified query id
+  // belongs to.
+  PreparedStatementsShard& PreparedStatementsShardFor(const ql::CQLMessage::QueryId& query_id);
+
+  // Insert a prepared statement at the front of the LRU list. The shard mutex needs to be
   // locked before this call.
-  void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  void InsertLruPreparedStatementUnlocked(
+      PreparedStatementsShard* shard, const std::shared_ptr<CQLStatement>& stmt);
 
-  // Move a prepared statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
+  // Move a prepared statement to the front of the LRU list. The shard mutex needs to be
   // locked before this call.
-  void MoveLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
+  void MoveLruPreparedStatementUnlocked(
+      PreparedStatementsShard* shard, const std::shared_ptr<CQLStatement>& stmt);
 
-  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
+  // Delete a prepared statement from the cache and the LRU list. The shard mutex needs to
   // be locked before this call.
-  void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
+  void DeletePreparedStatementUnlocked(
+      PreparedStatementsShard* shard, const std::shared_ptr<const CQLStatement> stmt);
 
-  // Delete the least recently used prepared statement from the cache to free up memory.
+  // Delete the least recently used prepared statement of all shards from the cache to free up
+  // memory.
   void CollectGarbage(size_t required) override;
 
   // CQLServer of this service.
@@ -148,13 +176,7 @@ class CQLServiceImpl : public CQLServerServiceIf,
   std::mutex processors_mutex_;
 
   // Prepared statements cache.
-  CQLStatementMap prepared_stmts_map_;
-
-  // Prepared statements LRU list (least recently used one at the end).
-  CQLStatementList prepared_stmts_list_;
-
-  // Mutex that protects the prepared statements and the LRU list.
-  std::mutex prepared_stmts_mutex_;
+  std::array<PreparedStatementsShard, kNumPreparedStatementsShards> prepared_stmts_shards_;
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
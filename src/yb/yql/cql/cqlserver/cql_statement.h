@@ -21,6 +21,8 @@
 
 #include <list>
 
+#include "yb/util/monotime.h"
+
 #include "yb/yql/cql/ql/statement.h"
 #include "yb/yql/cql/ql/util/cql_message.h"
 
@@ -51,12 +53,20 @@ class CQLStatement : public ql::Statement {
   CQLStatementListPos pos() const { return pos_; }
   void set_pos(CQLStatementListPos pos) const { pos_ = pos; }
 
+  // Get/set time of the last access to the statement. Used to find the least recently used
+  // statement across the shards of the cache.
+  CoarseTimePoint last_access_time() const { return last_access_time_; }
+  void set_last_access_time(CoarseTimePoint time) const { last_access_time_ = time; }
+
   // Return the query id of a statement.
   static ql::CQLMessage::QueryId GetQueryId(const std::string& keyspace, const std::string& query);
 
  private:
   // Position of the statement in the LRU.
   mutable CQLStatementListPos pos_;
+
+  // Time of the last access to the statement.
+  mutable CoarseTimePoint last_access_time_;
 };
 
 }  // namespace cqlserver
@@ -11,10 +11,13 @@
 // under the License.
 //
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "yb/gutil/casts.h"
+#include "yb/gutil/endian.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/substitute.h"
 
@@ -29,7 +32,9 @@
 #include "yb/util/net/net_util.h"
 #include "yb/util/net/socket.h"
 #include "yb/util/result.h"
+#include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
+#include "yb/util/test_thread_holder.h"
 #include "yb/util/test_util.h"
 
 #include "yb/yql/cql/cqlserver/cql_server.h"
@@ -40,6 +45,7 @@ DECLARE_bool(use_cassandra_authentication);
 namespace yb {
 namespace cqlserver {
 
+using namespace std::literals;
 using namespace yb::ql; // NOLINT
 using std::string;
 using std::unique_ptr;
@@ -571,5 +577,190 @@ TEST_F(TestCQLServiceWithCassAuth, TestReadSystemTableAuthenticated) {
                     "\x00\x00\x00\x05" "local"));
 }
 
+
+namespace {
+
+constexpr uint8_t kStartupOpcode = 0x01;
+constexpr uint8_t kReadyOpcode = 0x02;
+constexpr uint8_t kQueryOpcode = 0x07;
+constexpr uint8_t kResultOpcode = 0x08;
+constexpr uint8_t kPrepareOpcode = 0x09;
+constexpr uint8_t kExecuteOpcode = 0x0A;
+constexpr size_t kHeaderLength = 9;
+
+// Appends CQL [long string] to the buffer.
+void AppendLongString(const string& value, string* buffer) {
+  char length[sizeof(uint32_t)];
+  NetworkByteOrder::Store32(length, narrow_cast<uint32_t>(value.size()));
+  buffer->append(length, sizeof(length));
+  *buffer += value;
+}
+
+// Client connection to the CQL server that sends requests using version V4 and waits for their
+// responses.
+class CQLTestConnection {
+ public:
+  Status Connect(const Endpoint& remote) {
+    RETURN_NOT_OK(sock_.Init(0));
+    RETURN_NOT_OK(sock_.Connect(remote));
+    string response;
+    return Expect(
+        kReadyOpcode,
+        kStartupOpcode, BINARY_STRING("\x00\x01" "\x00\x0b" "CQL_VERSION" "\x00\x05" "3.0.0"),
+        &response);
+  }
+
+  // Sends request with specified opcode and body. Returns opcode of the response, while its
+  // body is stored to response_body.
+  Result<uint8_t> Send(uint8_t opcode, const string& body, string* response_body) {
+    char header[kHeaderLength] = { '\x04', '\x00', '\x00', '\x00' };
+    header[4] = opcode;
+    NetworkByteOrder::Store32(header + 5, narrow_cast<uint32_t>(body.size()));
+    string request(header, kHeaderLength);
+    request += body;
+    auto deadline = MonoTime::Now() + MonoDelta::FromSeconds(60);
+    RETURN_NOT_OK(sock_.BlockingWrite(to_uchar_ptr(request.c_str()), request.size(), deadline));
+
+    uint8_t response_header[kHeaderLength];
+    RETURN_NOT_OK(sock_.BlockingRecv(response_header, kHeaderLength, deadline));
+    response_body->resize(NetworkByteOrder::Load32(response_header + 5));
+    if (!response_body->empty()) {
+      RETURN_NOT_OK(sock_.BlockingRecv(
+          to_uchar_ptr(&(*response_body)[0]), response_body->size(), deadline));
+    }
+    return response_header[4];
+  }
+
+  // Executes query without bind markers.
+  Status Query(const string& query) {
+    string request;
+    AppendLongString(query, &request);
+    request += BINARY_STRING("\x00\x01"  // consistency: 0x0001 = ONE
+                             "\x00");    // bit flags
+    string response;
+    return Expect(kResultOpcode, kQueryOpcode, request, &response);
+  }
+
+  // Prepares query and returns id of the prepared statement, as [short bytes].
+  Result<string> Prepare(const string& query) {
+    string request;
+    AppendLongString(query, &request);
+    string response;
+    RETURN_NOT_OK(Expect(kResultOpcode, kPrepareOpcode, request, &response));
+    // Prepared result: result kind followed by the prepared statement id.
+    SCHECK_GE(response.size(), 6U, IllegalState, "Too short prepared result");
+    const size_t id_length = NetworkByteOrder::Load16(response.data() + 4);
+    SCHECK_GE(response.size(), 6 + id_length, IllegalState, "Too short prepared result");
+    return response.substr(4, 2 + id_length);
+  }
+
+  // Executes prepared statement, binding the specified int values to its bind markers.
+  Status Execute(const string& id, std::initializer_list<int32_t> values) {
+    execute_request_ = id;
+    execute_request_ += BINARY_STRING("\x00\x01"  // consistency: 0x0001 = ONE
+                                      "\x01");    // bit flags: 0x01 = values
+    char buffer[sizeof(uint32_t)];
+    NetworkByteOrder::Store16(buffer, narrow_cast<uint16_t>(values.size()));
+    execute_request_.append(buffer, sizeof(uint16_t));
+    for (auto value : values) {
+      NetworkByteOrder::Store32(buffer, sizeof(value));
+      execute_request_.append(buffer, sizeof(buffer));
+      NetworkByteOrder::Store32(buffer, static_cast<uint32_t>(value));
+      execute_request_.append(buffer, sizeof(buffer));
+    }
+    return Expect(kResultOpcode, kExecuteOpcode, execute_request_, &execute_response_);
+  }
+
+ private:
+  Status Expect(
+      uint8_t expected_opcode, uint8_t opcode, const string& body, string* response_body) {
+    auto response_opcode = VERIFY_RESULT(Send(opcode, body, response_body));
+    SCHECK_EQ(static_cast<int>(response_opcode), static_cast<int>(expected_opcode), IllegalState,
+              Format("Unexpected response: $0", FormatBytesAsStr(*response_body)));
+    return Status::OK();
+  }
+
+  Socket sock_;
+  string execute_request_;
+  string execute_response_;
+};
+
+} // namespace
+
+// Benchmark of prepared INSERT and SELECT executions with bind markers on a user table, sent by
+// concurrent connections. Prepared SELECT is compared with the same SELECT sent as a query.
+TEST_F(TestCQLService, PreparedStatementsBenchmark) {
+  constexpr int kNumConnections = 8;
+  const auto kTestTime = 2s;
+  const Endpoint remote(IpAddress(), server_port());
+
+  {
+    CQLTestConnection connection;
+    ASSERT_OK(connection.Connect(remote));
+    ASSERT_OK(connection.Query("CREATE KEYSPACE IF NOT EXISTS prepared_bench"));
+    ASSERT_OK(connection.Query(
+        "CREATE TABLE prepared_bench.kv (k INT PRIMARY KEY, v INT)"));
+  }
+
+  // Number of rows inserted by each connection, connection i inserts keys i + kNumConnections * j.
+  std::vector<int> inserted(kNumConnections);
+  const string kSelect = "SELECT v FROM prepared_bench.kv WHERE k = ";
+  // Runs the specified operation by all connections and returns the number of executions.
+  // Operation is executed as a query with the key literal when prepare is false.
+  auto run = [&](const string& name, const string& query, bool insert, bool prepare) {
+    std::atomic<size_t> executions{0};
+    TestThreadHolder thread_holder;
+    for (int i = 0; i != kNumConnections; ++i) {
+      thread_holder.AddThreadFunctor(
+          [i, insert, prepare, &remote, &query, &inserted, &stop = thread_holder.stop_flag(),
+           &executions] {
+        CQLTestConnection connection;
+        ASSERT_OK(connection.Connect(remote));
+        string id;
+        if (prepare) {
+          id = ASSERT_RESULT(connection.Prepare(query));
+        }
+        for (int j = 0; !stop.load(std::memory_order_acquire); ++j) {
+          if (insert) {
+            const int32_t key = i + kNumConnections * j;
+            ASSERT_OK(connection.Execute(id, {key, key}));
+            inserted[i] = j + 1;
+          } else {
+            const int32_t key = i + kNumConnections * (j % inserted[i]);
+            if (prepare) {
+              ASSERT_OK(connection.Execute(id, {key}));
+            } else {
+              ASSERT_OK(connection.Query(query + std::to_string(key)));
+            }
+          }
+          executions.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+    thread_holder.WaitAndStop(kTestTime);
+
+    LOG(INFO) << name << " executions: " << executions.load() << ", per second: "
+              << executions.load() * 1000 / ToMilliseconds(kTestTime);
+    return executions.load();
+  };
+
+  ASSERT_GT(run("Insert", "INSERT INTO prepared_bench.kv (k, v) VALUES (?, ?)",
+                /* insert= */ true, /* prepare= */ true),
+            0U);
+  for (auto count : inserted) {
+    ASSERT_GT(count, 0);
+  }
+  const auto prepared_selects = run(
+      "Prepared select", kSelect + "?", /* insert= */ false, /* prepare= */ true);
+  const auto query_selects = run(
+      "Query select", kSelect, /* insert= */ false, /* prepare= */ false);
+  ASSERT_GT(prepared_selects, 0U);
+  ASSERT_GT(query_selects, 0U);
+#if !defined(THREAD_SANITIZER) && !defined(ADDRESS_SANITIZER)
+  // Prepared statement skips parsing and analysis, so it should not be slower than the query.
+  ASSERT_GE(prepared_selects, query_selects);
+#endif
+}
+
 }  // namespace cqlserver
 }  // namespace yb
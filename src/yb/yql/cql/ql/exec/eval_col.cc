@@ -16,7 +16,10 @@
 #include "yb/common/jsonb.h"
 #include "yb/common/ql_value.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/util/result.h"
+#include "yb/util/status_log.h"
 
 #include "yb/yql/cql/ql/exec/exec_context.h"
 #include "yb/yql/cql/ql/exec/executor.h"
@@ -32,17 +35,34 @@ namespace ql {
 
 using std::shared_ptr;
 
+namespace {
+
+// Serialized jsonb null, bound values equal to it are ignored by UPDATE statements with
+// ignore_null_jsonb_attributes. Parsed once instead of for every executed statement.
+const std::string& SerializedJsonbNull() {
+  static const std::string result = [] {
+    common::Jsonb jsonb_null;
+    CHECK_OK(jsonb_null.FromString("null"));
+    return jsonb_null.MoveSerializedJsonb();
+  }();
+  return result;
+}
+
+} // namespace
+
 //--------------------------------------------------------------------------------------------------
 
 CHECKED_STATUS Executor::ColumnRefsToPB(const PTDmlStmt *tnode,
                                         QLReferencedColumnsPB *columns_pb) {
   // Write a list of columns to be read before executing the statement.
   const MCSet<int32>& column_refs = tnode->column_refs();
+  columns_pb->mutable_ids()->Reserve(narrow_cast<int>(column_refs.size()));
   for (auto column_ref : column_refs) {
     columns_pb->add_ids(column_ref);
   }
 
   const MCSet<int32>& static_column_refs = tnode->static_column_refs();
+  columns_pb->mutable_static_ids()->Reserve(narrow_cast<int>(static_column_refs.size()));
   for (auto column_ref : static_column_refs) {
     columns_pb->add_static_ids(column_ref);
   }
@@ -100,8 +120,6 @@ CHECKED_STATUS Executor::ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB
     }
   }
 
-  common::Jsonb jsonb_null;
-  RETURN_NOT_OK(jsonb_null.FromString("null"));
   const MCVector<JsonColumnArg>& jsoncol_args = tnode->json_col_args();
   for (const JsonColumnArg& col : jsoncol_args) {
     QLExpressionPB expr_pb;
@@ -113,7 +131,7 @@ CHECKED_STATUS Executor::ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB
           update_tnode->update_properties()->ignore_null_jsonb_attributes()) {
         if (expr_pb.expr_case() == QLExpressionPB::kValue &&
             expr_pb.value().value_case() == QLValuePB::kJsonbValue &&
-            expr_pb.value().jsonb_value() == jsonb_null.SerializedJsonb()) {
+            expr_pb.value().jsonb_value() == SerializedJsonbNull()) {
           // TODO(Piyush): Log attribute json path as well.
           VLOG(1) << "Ignoring null for json attribute in UPDATE statement " \
             "for column " << col.desc()->MangledName();
@@ -125,7 +143,7 @@ CHECKED_STATUS Executor::ColumnArgsToPB(const PTDmlStmt *tnode, QLWriteRequestPB
     const ColumnDesc *col_desc = col.desc();
     QLColumnValuePB *col_pb = req->add_column_values();
     col_pb->set_column_id(col_desc->id());
-    *(col_pb->mutable_expr()) = expr_pb;
+    col_pb->mutable_expr()->Swap(&expr_pb);
 
     for (auto& col_arg : col.args()->node_list()) {
       QLJsonOperationPB *arg_pb = col_pb->add_json_args();
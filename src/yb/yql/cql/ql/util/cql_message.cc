@@ -64,7 +64,7 @@ constexpr char CQLMessage::kTopologyChangeEvent[];
 constexpr char CQLMessage::kStatusChangeEvent[];
 constexpr char CQLMessage::kSchemaChangeEvent[];
 
-CHECKED_STATUS CQLMessage::QueryParameters::GetBindVariableValue(const std::string& name,
+CHECKED_STATUS CQLMessage::QueryParameters::GetBindVariableValue(const char* name,
                                                                  const size_t pos,
                                                                  const Value** value) const {
   if (!value_map.empty()) {
@@ -84,14 +84,14 @@ CHECKED_STATUS CQLMessage::QueryParameters::GetBindVariableValue(const std::stri
   return Status::OK();
 }
 
-Result<bool> CQLMessage::QueryParameters::IsBindVariableUnset(const std::string& name,
+Result<bool> CQLMessage::QueryParameters::IsBindVariableUnset(const char* name,
                                                               const int64_t pos) const {
   const Value* value = nullptr;
   RETURN_NOT_OK(GetBindVariableValue(name, pos, &value));
   return (value->kind == Value::Kind::NOT_SET);
 }
 
-Status CQLMessage::QueryParameters::GetBindVariable(const std::string& name,
+Status CQLMessage::QueryParameters::GetBindVariable(const char* name,
                                                     const int64_t pos,
                                                     const shared_ptr<QLType>& type,
                                                     QLValue* value) const {
@@ -652,7 +652,7 @@ Status AuthResponseRequest::ParseBody() {
 }
 
 CHECKED_STATUS AuthResponseRequest::AuthQueryParameters::GetBindVariable(
-    const std::string& name,
+    const char* name,
     int64_t pos,
     const std::shared_ptr<QLType>& type,
     QLValue* value) const {
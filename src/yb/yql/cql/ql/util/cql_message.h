@@ -236,17 +236,17 @@ class CQLMessage {
 
     QueryParameters() : ql::StatementParameters() { }
 
-    virtual CHECKED_STATUS GetBindVariable(const std::string& name,
+    virtual CHECKED_STATUS GetBindVariable(const char* name,
                                            int64_t pos,
                                            const std::shared_ptr<QLType>& type,
                                            QLValue* value) const override;
-    virtual Result<bool> IsBindVariableUnset(const std::string& name,
+    virtual Result<bool> IsBindVariableUnset(const char* name,
                                              int64_t pos) const override;
 
     CHECKED_STATUS ValidateConsistency();
 
    private:
-    CHECKED_STATUS GetBindVariableValue(const std::string& name,
+    CHECKED_STATUS GetBindVariableValue(const char* name,
                                         size_t pos,
                                         const Value** value) const;
   };
@@ -364,7 +364,7 @@ class AuthResponseRequest : public CQLRequest {
    public:
     AuthQueryParameters() : ql::StatementParameters() {}
 
-    CHECKED_STATUS GetBindVariable(const std::string& name,
+    CHECKED_STATUS GetBindVariable(const char* name,
                                    int64_t pos,
                                    const std::shared_ptr<QLType>& type,
                                    QLValue* value) const override;
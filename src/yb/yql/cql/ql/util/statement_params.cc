@@ -63,14 +63,14 @@ Status StatementParameters::SetPagingState(const std::string& paging_state) {
   return Status::OK();
 }
 
-Result<bool> StatementParameters::IsBindVariableUnset(const std::string& name,
+Result<bool> StatementParameters::IsBindVariableUnset(const char* name,
                                          int64_t pos) const {
   return STATUS(RuntimeError, "no bind variable available");
 }
 
 // Retrieve a bind variable for the execution of the statement. To be overridden by subclasses
 // to return actual bind variables.
-Status StatementParameters::GetBindVariable(const std::string& name,
+Status StatementParameters::GetBindVariable(const char* name,
                                             int64_t pos,
                                             const std::shared_ptr<QLType>& type,
                                             QLValue* value) const {
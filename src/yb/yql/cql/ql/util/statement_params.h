@@ -68,12 +68,16 @@ class StatementParameters {
 
   // Check if a bind variable is unset. To be overridden by subclasses
   // to return actual bind variables status.
-  virtual Result<bool> IsBindVariableUnset(const std::string& name,
+  //
+  // The variable is identified by its name when values are bound by name and by its position
+  // otherwise. The name is passed as a C string, so no string is constructed in the common case
+  // of positional binding.
+  virtual Result<bool> IsBindVariableUnset(const char* name,
                                            int64_t pos) const;
 
   // Retrieve a bind variable for the execution of the statement. To be overridden by subclasses
   // to return actual bind variables.
-  virtual CHECKED_STATUS GetBindVariable(const std::string& name,
+  virtual CHECKED_STATUS GetBindVariable(const char* name,
                                          int64_t pos,
                                          const std::shared_ptr<QLType>& type,
                                          QLValue* value) const;
@@ -15,6 +15,8 @@
 
 #include "yb/yql/pggate/pg_dml_read.h"
 
+#include <algorithm>
+
 #include "yb/client/yb_op.h"
 
 #include "yb/common/partition.h"
@@ -30,6 +32,7 @@
 
 #include "yb/yql/pggate/pg_select_index.h"
 #include "yb/yql/pggate/pg_tools.h"
+#include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
 namespace yb {
@@ -142,12 +145,22 @@ void PgDmlRead::SetColumnRefs() {
     DCHECK(!has_aggregate_targets()) << "Aggregate pushdown should not happen with index";
   }
   read_req_->set_is_aggregate(has_aggregate_targets());
+  read_req_->set_columnar_result(CanUseColumnarResult());
   // Populate column references in the read request
   ColRefsToPB();
   // Compatibility: set column ids in a form that is expected by legacy nodes
   ColumnRefsToPB(read_req_->mutable_column_refs());
 }
 
+bool PgDmlRead::CanUseColumnarResult() {
+  if (!FLAGS_ysql_enable_columnar_result || targets_.empty() || has_aggregate_targets()) {
+    return false;
+  }
+  return std::all_of(targets_.begin(), targets_.end(), [](const PgExpr* target) {
+    return target->supports_columnar_data();
+  });
+}
+
 // Method removes empty primary binds and moves tailing non empty range primary binds
 // which are following after empty binds into the 'condition_expr' field.
 Status PgDmlRead::ProcessEmptyPrimaryBinds() {
@@ -119,6 +119,8 @@ class PgDmlRead : public PgDml {
  private:
   // Indicates that current operation reads concrete row by specifying row's DocKey.
   bool IsConcreteRowRead() const;
+  // Whether rows could be requested in the columnar format, i.e. all targets support it.
+  bool CanUseColumnarResult();
   CHECKED_STATUS ProcessEmptyPrimaryBinds();
   bool CanBuildYbctidsFromPrimaryBinds();
   Result<std::vector<std::string>> BuildYbctidsFromPrimaryBinds();
@@ -49,13 +49,24 @@ using yb::client::YBPgsqlWriteOp;
 namespace yb {
 namespace pggate {
 
-PgDocResult::PgDocResult(rpc::SidecarPtr&& data) : data_(std::move(data)) {
+namespace {
+
+// Bounds on the number of requests sent in parallel by PopulateParallelSelectOps.
+constexpr size_t kMinParSelParallelism = 1;
+constexpr size_t kMaxParSelParallelism = 16;
+
+} // namespace
+
+PgDocResult::PgDocResult(rpc::SidecarPtr&& data, bool columnar)
+    : data_(std::move(data)), columnar_(columnar) {
   PgDocData::LoadCache(data_, &row_count_, &row_iterator_);
+  data_size_ = row_iterator_.size();
 }
 
 PgDocResult::PgDocResult(rpc::SidecarPtr&& data, std::list<int64_t>&& row_orders)
     : data_(std::move(data)), row_orders_(move(row_orders)) {
   PgDocData::LoadCache(data_, &row_count_, &row_iterator_);
+  data_size_ = row_iterator_.size();
 }
 
 PgDocResult::~PgDocResult() {
@@ -67,7 +78,21 @@ int64_t PgDocResult::NextRowOrder() {
 
 Status PgDocResult::WritePgTuple(const std::vector<PgExpr*>& targets, PgTuple *pg_tuple,
                                  int64_t *row_order) {
+  if (columnar_ && !columns_parsed_) {
+    for (const PgExpr *target : targets) {
+      SCHECK(target->supports_columnar_data(), InternalError,
+             "Unexpected expression, columnar data format is not supported for it");
+    }
+    RETURN_NOT_OK(PgColumnarReader::Parse(
+        row_iterator_, static_cast<size_t>(row_count_), targets.size(), &columns_));
+    for (size_t i = 0; i != targets.size(); ++i) {
+      RETURN_NOT_OK(targets[i]->CheckColumnarColumn(columns_[i]));
+    }
+    columns_parsed_ = true;
+  }
+
   int attr_num = 0;
+  size_t column_index = 0;
   for (const PgExpr *target : targets) {
     if (!target->is_colref() && !target->is_aggregate()) {
       return STATUS(InternalError,
@@ -79,9 +104,14 @@ Status PgDocResult::WritePgTuple(const std::vector<PgExpr*>& targets, PgTuple *p
       attr_num++;
     }
 
-    PgWireDataHeader header = PgDocData::ReadDataHeader(&row_iterator_);
-    target->TranslateData(&row_iterator_, header, attr_num - 1, pg_tuple);
+    if (columnar_) {
+      target->TranslateColumnarData(columns_[column_index++], next_row_, attr_num - 1, pg_tuple);
+    } else {
+      PgWireDataHeader header = PgDocData::ReadDataHeader(&row_iterator_);
+      target->TranslateData(&row_iterator_, header, attr_num - 1, pg_tuple);
+    }
   }
+  ++next_row_;
 
   if (row_orders_.size()) {
     *row_order = row_orders_.front();
@@ -96,6 +126,7 @@ Status PgDocResult::ProcessSystemColumns() {
   if (syscol_processed_) {
     return Status::OK();
   }
+  SCHECK(!columnar_, IllegalState, "System columns are expected in the row format");
   syscol_processed_ = true;
 
   for (int i = 0; i < row_count_; i++) {
@@ -118,6 +149,7 @@ Status PgDocResult::ProcessSparseSystemColumns(std::string *reservoir) {
   // predetermined size. DocDB returns ybctids with sequential indexes first, starting from 0 and
   // until reservoir is full. Then it returns ybctids with random indexes, so they replace previous
   // ybctids.
+  SCHECK(!columnar_, IllegalState, "System columns are expected in the row format");
   for (int i = 0; i < row_count_; i++) {
     // Read index column
     PgWireDataHeader header = PgDocData::ReadDataHeader(&row_iterator_);
@@ -141,6 +173,54 @@ Status PgDocResult::ProcessSparseSystemColumns(std::string *reservoir) {
 
 //--------------------------------------------------------------------------------------------------
 
+size_t PrefetchController::EstimatedPageBytes() const {
+  return static_cast<size_t>(limit_ * bytes_per_row_);
+}
+
+void PrefetchController::PageReceived(
+    bool prefetched, MonoDelta latency, MonoDelta wait_time, MonoDelta consume_time,
+    int64_t rows, size_t bytes) {
+  // Weight of the last observation in the moving averages.
+  constexpr double kAlpha = 0.25;
+  // Waiting for less than this fraction of consume time is considered negligible.
+  constexpr double kNegligibleWaitRatio = 0.1;
+  // Pages are shrunk when consuming a page takes this many RPC round trips.
+  constexpr double kShrinkLatencyRatio = 4;
+
+  if (rows > 0) {
+    const double bytes_per_row = static_cast<double>(bytes) / rows;
+    bytes_per_row_ = bytes_per_row_ == 0
+        ? bytes_per_row : bytes_per_row_ + kAlpha * (bytes_per_row - bytes_per_row_);
+  }
+
+  // Latency is only observed when backend actually waited for the response, otherwise response
+  // could lie in the queue for arbitrary long time.
+  if (!prefetched || wait_time.ToSeconds() > 0) {
+    const double latency_sec = latency.ToSeconds();
+    latency_ = latency_ == 0 ? latency_sec : latency_ + kAlpha * (latency_sec - latency_);
+  }
+
+  if (!prefetched || !consume_time.Initialized()) {
+    return;
+  }
+
+  const double consume_sec = consume_time.ToSeconds();
+  const double wait_sec = wait_time.ToSeconds();
+  if (wait_sec > consume_sec * kNegligibleWaitRatio) {
+    // Backend consumes rows faster than they arrive, bigger pages amortize RPC latency better.
+    limit_ = std::min(limit_ * 2, max_limit_);
+  } else if (wait_sec == 0 && consume_sec > latency_ * kShrinkLatencyRatio) {
+    // Page arrives long before it is needed, it just holds memory.
+    limit_ = std::max(limit_ / 2, min_limit_);
+  }
+}
+
+void PrefetchController::Throttled() {
+  limit_ = std::max(limit_ / 2, min_limit_);
+}
+
+//--------------------------------------------------------------------------------------------------
+
 PgDocOp::PgDocOp(const PgSession::ScopedRefPtr& pg_session,
                  PgTable* table,
                  const PgObjectId& relation_id)
@@ -154,10 +234,13 @@ PgDocOp::~PgDocOp() {
     auto result = response_.Get();
     WARN_NOT_OK(result, "Operation completion failed");
   }
+  ReleasePrefetchMemory();
 }
 
 Status PgDocOp::ExecuteInit(const PgExecParameters *exec_params) {
   end_of_data_ = false;
+  prefetch_throttled_ = false;
+  last_result_time_ = MonoTime();
   if (exec_params) {
     exec_params_ = *exec_params;
   }
@@ -187,28 +270,94 @@ Status PgDocOp::GetResult(list<PgDocResult> *rowsets) {
 
   if (!end_of_data_) {
     // Send request now in case prefetching was suppressed.
-    if (suppress_next_result_prefetching_ && !response_.Valid()) {
+    bool prefetched = true;
+    if ((suppress_next_result_prefetching_ || prefetch_throttled_) && !response_.Valid()) {
+      prefetch_throttled_ = false;
+      prefetched = false;
       exec_status_ = SendRequest(true /* force_non_bufferable */);
       RETURN_NOT_OK(exec_status_);
     }
 
     DCHECK(response_.Valid());
+    const auto wait_start = MonoTime::Now();
     auto result = response_.Get();
+    const auto received = MonoTime::Now();
+    ReleasePrefetchMemory();
     auto rows = VERIFY_RESULT(ProcessResponse(result));
     // In case ProcessResponse doesn't fail with an error
     // it should return non empty rows and/or set end_of_data_.
     DCHECK(!rows.empty() || end_of_data_);
+    UpdatePrefetchController(rows, prefetched, wait_start, received);
     rowsets->splice(rowsets->end(), rows);
     // Prefetch next portion of data if needed.
     if (!(end_of_data_ || suppress_next_result_prefetching_)) {
-      exec_status_ = SendRequest(true /* force_non_bufferable */);
-      RETURN_NOT_OK(exec_status_);
+      const bool reserved = ReservePrefetchMemory();
+      if (prefetch_controller_) {
+        if (!reserved) {
+          prefetch_controller_->Throttled();
+        }
+        // Page size is applied after throttling, so the on demand request uses the reduced one.
+        SetPrefetchLimit(prefetch_controller_->limit());
+      }
+      if (reserved) {
+        exec_status_ = SendRequest(true /* force_non_bufferable */);
+        RETURN_NOT_OK(exec_status_);
+      } else {
+        // Next page will be requested when the backend asks for it.
+        prefetch_throttled_ = true;
+      }
     }
+    last_result_time_ = MonoTime::Now();
   }
 
   return Status::OK();
 }
 
+void PgDocOp::UpdatePrefetchController(
+    const std::list<PgDocResult>& rows, bool prefetched, MonoTime wait_start, MonoTime received) {
+  if (!prefetch_controller_) {
+    return;
+  }
+  int64_t row_count = 0;
+  size_t data_size = 0;
+  for (const auto& result : rows) {
+    row_count += result.row_count();
+    data_size += result.data_size();
+  }
+  // Time the backend spent processing previous page, i.e. since it got the previous result and
+  // until it asked for the next one.
+  MonoDelta consume_time;
+  if (last_result_time_.Initialized()) {
+    consume_time = wait_start - last_result_time_;
+  }
+  prefetch_controller_->PageReceived(
+      prefetched, received - request_sent_time_, received - wait_start, consume_time, row_count,
+      data_size);
+}
+
+bool PgDocOp::ReservePrefetchMemory() {
+  DCHECK_EQ(prefetch_memory_reserved_, 0U);
+  if (!prefetch_controller_) {
+    return true;
+  }
+  // Each active operation returns up to page size rows.
+  const auto bytes = prefetch_controller_->EstimatedPageBytes() *
+                     std::max<size_t>(std::min(parallelism_level_, active_op_count_), 1);
+  if (!pg_session_->TryReservePrefetchMemory(bytes)) {
+    VLOG(2) << "Prefetching skipped, estimated page size: " << bytes;
+    return false;
+  }
+  prefetch_memory_reserved_ = bytes;
+  return true;
+}
+
+void PgDocOp::ReleasePrefetchMemory() {
+  if (prefetch_memory_reserved_) {
+    pg_session_->ReleasePrefetchMemory(prefetch_memory_reserved_);
+    prefetch_memory_reserved_ = 0;
+  }
+}
+
 Result<int32_t> PgDocOp::GetRowsAffectedCount() const {
   RETURN_NOT_OK(exec_status_);
   DCHECK(end_of_data_);
@@ -265,6 +414,7 @@ void PgDocOp::MoveInactiveOpsOutside() {
 Status PgDocOp::SendRequest(bool force_non_bufferable) {
   DCHECK(exec_status_.ok());
   DCHECK(!response_.Valid());
+  request_sent_time_ = MonoTime::Now();
   exec_status_ = SendRequestImpl(force_non_bufferable);
   return exec_status_;
 }
@@ -344,8 +494,10 @@ Result<std::list<PgDocResult>> PgDocOp::ProcessResponseResult() {
     auto& rows_data = pgsql_ops_[op_index]->rows_data();
     if (rows_data) {
       if (no_sorting_order) {
-        result.emplace_back(std::move(rows_data));
+        result.emplace_back(std::move(rows_data), response.columnar_result());
       } else {
+        SCHECK(!response.columnar_result(), IllegalState,
+               "Rows data with sorting order is expected in the row format");
         const auto& batch_orders = pgsql_op->response().batch_orders();
         if (!batch_orders.empty()) {
           result.emplace_back(std::move(pgsql_op->rows_data()),
@@ -657,20 +809,22 @@ Result<bool> PgDocReadOp::PopulateParallelSelectOps() {
   // TODO(neil) The calculation for this control variable should be applied to ALL operators, but
   // the following calculation needs to be refined before it can be used for all statements.
   auto parallelism_level = FLAGS_ysql_select_parallelism;
+  const auto& partition_keys = table_->GetPartitions();
+  const auto split_parts = ScanSplitParts(partition_keys.size());
   if (parallelism_level < 0) {
     int tserver_count = VERIFY_RESULT(pg_session_->TabletServerCount(true /* primary_only */));
 
     // Establish lower and upper bounds on parallelism.
-    int kMinParSelParallelism = 1;
-    int kMaxParSelParallelism = 16;
-    parallelism_level_ =
-      std::min(std::max(tserver_count * 2, kMinParSelParallelism), kMaxParSelParallelism);
+    parallelism_level_ = std::min(
+        std::max<size_t>(tserver_count * 2, kMinParSelParallelism), kMaxParSelParallelism);
+    // Sub-ranges of a tablet are read in parallel by the same tablet server.
+    parallelism_level_ = std::max(
+        parallelism_level_, std::min(partition_keys.size() * split_parts, kMaxParSelParallelism));
   } else {
     parallelism_level_ = parallelism_level;
   }
 
   // Assign partitions to operators.
-  const auto& partition_keys = table_->GetPartitions();
   SCHECK_EQ(partition_keys.size(), pgsql_ops_.size(), IllegalState,
             "Number of partitions and number of partition keys are not the same");
 
@@ -692,12 +846,60 @@ Result<bool> PgDocReadOp::PopulateParallelSelectOps() {
                                           true /* lower_bound_is_inclusive */,
                                           upper_bound,
                                           false /* upper_bound_is_inclusive */));
+    if (split_parts > 1) {
+      GetReadReq(partition).set_scan_split_parts(narrow_cast<uint32_t>(split_parts));
+    }
   }
   active_op_count_ = partition_keys.size();
 
   return true;
 }
 
+size_t PgDocReadOp::ScanSplitParts(size_t partition_count) const {
+  // Hash partitioned tables have enough tablets to be scanned in parallel. Tablet servers are able
+  // to split forward scans only.
+  const auto& req = read_op_->read_request();
+  if (FLAGS_ysql_max_tablet_scan_split_parts <= 1 || table_->num_hash_key_columns() > 0 ||
+      !req.is_forward_scan() || partition_count >= kMaxParSelParallelism) {
+    return 1;
+  }
+  return std::min<size_t>(
+      FLAGS_ysql_max_tablet_scan_split_parts,
+      (kMaxParSelParallelism + partition_count - 1) / partition_count);
+}
+
+Status PgDocReadOp::SplitScan(PgsqlReadOp* read_op, std::vector<PgsqlOpPtr>* split_ops) {
+  auto& req = read_op->read_request();
+  const auto& split_keys = read_op->response().scan_split_keys();
+  VLOG(2) << "Split scan into " << split_keys.size() + 1 << " parts";
+
+  for (int i = 0; i != split_keys.size(); ++i) {
+    auto op = read_op->DeepCopy();
+    auto& split_req = down_cast<PgsqlReadOp&>(*op).read_request();
+    split_req.clear_paging_state();
+    split_req.clear_scan_split_parts();
+    auto* lower_bound = split_req.mutable_lower_bound();
+    lower_bound->set_key(split_keys.Get(i));
+    lower_bound->set_is_inclusive(true);
+    // The last sub-range inherits the upper bound of the whole scan.
+    if (i + 1 != split_keys.size()) {
+      auto* upper_bound = split_req.mutable_upper_bound();
+      upper_bound->set_key(split_keys.Get(i + 1));
+      upper_bound->set_is_inclusive(false);
+    }
+    // All sub-ranges are read at the same time.
+    op->set_read_time(read_op->read_time());
+    op->set_active(true);
+    split_ops->push_back(std::move(op));
+  }
+
+  // Tablet server has read the first sub-range only.
+  auto* upper_bound = req.mutable_upper_bound();
+  upper_bound->set_key(split_keys.Get(0));
+  upper_bound->set_is_inclusive(false);
+  return Status::OK();
+}
+
 Result<bool> PgDocReadOp::PopulateSamplingOps() {
   // Create one PgsqlOp per partition
   RETURN_NOT_OK(ClonePgsqlOps(table_->GetPartitionCount()));
@@ -784,6 +986,7 @@ Status PgDocReadOp::ProcessResponseReadStates() {
   // For each read_op, set up its request for the next batch of data or make it in-active.
   bool has_more_data = false;
   auto send_count = std::min(parallelism_level_, active_op_count_);
+  std::vector<PgsqlOpPtr> split_ops;
 
   for (size_t op_index = 0; op_index < send_count; op_index++) {
     auto& read_op = down_cast<PgsqlReadOp&>(*pgsql_ops_[op_index]);
@@ -865,6 +1068,14 @@ Status PgDocReadOp::ProcessResponseReadStates() {
       }
     }
 
+    // Only the first page of a scan is split.
+    if (req.has_scan_split_parts()) {
+      if (res.scan_split_keys_size() > 0) {
+        RETURN_NOT_OK(SplitScan(&read_op, &split_ops));
+      }
+      req.clear_scan_split_parts();
+    }
+
     if (has_more_arg) {
       has_more_data = true;
     } else {
@@ -872,6 +1083,12 @@ Status PgDocReadOp::ProcessResponseReadStates() {
     }
   }
 
+  if (!split_ops.empty()) {
+    // Newly created operators are active, MoveInactiveOpsOutside puts them in the active range.
+    has_more_data = true;
+    pgsql_ops_.insert(pgsql_ops_.end(), split_ops.begin(), split_ops.end());
+  }
+
   if (has_more_data || send_count < active_op_count_) {
     // Move inactive ops to the end of pgsql_ops_ to make room for new set of arguments.
     MoveInactiveOpsOutside();
@@ -937,6 +1154,36 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
           << " predicted_limit=" << predicted_limit
           << " limit=" << limit;
   req.set_limit(limit);
+
+  // Page size of long scans is adapted to the consumer rate, starting with the predicted limit.
+  // Pages never exceed the statement LIMIT, rows beyond it would be thrown away.
+  auto max_limit = FLAGS_ysql_adaptive_prefetch_max_limit;
+  if (!exec_params_.limit_use_default) {
+    max_limit = std::min<uint64_t>(
+        max_limit, exec_params_.limit_count + exec_params_.limit_offset);
+  }
+  if (!suppress_next_result_prefetching_ && FLAGS_ysql_enable_adaptive_prefetch &&
+      max_limit > limit) {
+    prefetch_controller_.emplace(limit, max_limit);
+  } else {
+    prefetch_controller_.reset();
+  }
+}
+
+void PgDocReadOp::SetPrefetchLimit(uint64_t limit) {
+  PgsqlReadRequestPB& req = read_op_->read_request();
+  // Sampling computes its state per page, it keeps the page size it started with.
+  if (req.has_sampling_state() || req.limit() == limit) {
+    return;
+  }
+  req.set_limit(limit);
+  for (size_t op_index = 0; op_index < active_op_count_; ++op_index) {
+    auto& read_req = down_cast<PgsqlReadOp&>(*pgsql_ops_[op_index]).read_request();
+    // Batches of ybctids are fetched in full.
+    if (read_req.batch_arguments_size() == 0 && !read_req.has_ybctid_column_value()) {
+      read_req.set_limit(limit);
+    }
+  }
 }
 
 void PgDocReadOp::SetRowMark() {
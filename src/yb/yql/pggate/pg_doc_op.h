@@ -20,11 +20,13 @@
 #include <boost/optional.hpp>
 
 #include "yb/util/locks.h"
+#include "yb/util/monotime.h"
 #include "yb/client/yb_op.h"
 
 #include "yb/yql/pggate/pg_gate_fwd.h"
 #include "yb/yql/pggate/pg_op.h"
 #include "yb/yql/pggate/pg_session.h"
+#include "yb/yql/pggate/util/pg_columnar_data.h"
 
 namespace yb {
 namespace pggate {
@@ -37,7 +39,8 @@ YB_STRONGLY_TYPED_BOOL(RequestSent);
 // PgDocResult represents a batch of rows in ONE reply from tablet servers.
 class PgDocResult {
  public:
-  explicit PgDocResult(rpc::SidecarPtr&& data);
+  // "columnar" tells whether data is in the columnar format, see PgColumnarWriter.
+  explicit PgDocResult(rpc::SidecarPtr&& data, bool columnar = false);
   PgDocResult(rpc::SidecarPtr&& data, std::list<int64_t>&& row_orders);
   ~PgDocResult();
 
@@ -49,7 +52,8 @@ class PgDocResult {
 
   // End of this batch.
   bool is_eof() const {
-    return row_count_ == 0 || row_iterator_.empty();
+    return row_count_ == 0 ||
+           (columnar_ ? next_row_ >= static_cast<size_t>(row_count_) : row_iterator_.empty());
   }
 
   // Get the postgres tuple from this batch.
@@ -76,6 +80,11 @@ class PgDocResult {
     return row_count_;
   }
 
+  // Size of rows data in this batch.
+  size_t data_size() const {
+    return data_size_;
+  }
+
  private:
   // Data selected from DocDB.
   rpc::SidecarPtr data_;
@@ -86,6 +95,15 @@ class PgDocResult {
   // The row number of only this batch.
   int64_t row_count_ = 0;
 
+  size_t data_size_ = 0;
+
+  // When data is in the columnar format, row_iterator_ is not advanced and values are read from
+  // the columns, which are parsed on the first access.
+  bool columnar_ = false;
+  bool columns_parsed_ = false;
+  std::vector<PgColumnarColumn> columns_;
+  size_t next_row_ = 0;
+
   // The indexing order of the row in this batch.
   // These order values help to identify the row order across all batches.
   std::list<int64_t> row_orders_;
@@ -97,6 +115,47 @@ class PgDocResult {
   bool syscol_processed_ = false;
 };
 
+//--------------------------------------------------------------------------------------------------
+// Adapts the number of rows requested per page by a long scan, so that prefetching of the next page
+// hides the RPC latency without fetching much more than the backend consumes:
+// - The page size grows while the backend has to wait for prefetched pages.
+// - The page size shrinks back while pages arrive much faster than the backend consumes them.
+// Paging state of the next page is known only from the response to the previous one, so at most
+// one page per tablet can be outstanding. Parallelism across tablets is controlled by PgDocOp.
+class PrefetchController {
+ public:
+  PrefetchController(uint64_t min_limit, uint64_t max_limit)
+      : min_limit_(min_limit), max_limit_(std::max(min_limit, max_limit)), limit_(min_limit) {}
+
+  // Number of rows to request in the next page.
+  uint64_t limit() const {
+    return limit_;
+  }
+
+  // Estimated size of the next page in bytes, 0 if no page was received yet.
+  size_t EstimatedPageBytes() const;
+
+  // Updates page size after a page is received.
+  // latency - time between sending the request and receiving the response.
+  // wait_time - time the backend was blocked waiting for the response.
+  // consume_time - time the backend spent processing previous page, not initialized for the first
+  // page.
+  void PageReceived(
+      bool prefetched, MonoDelta latency, MonoDelta wait_time, MonoDelta consume_time,
+      int64_t rows, size_t bytes);
+
+  // Called when the next page was not prefetched because of the session memory limit.
+  void Throttled();
+
+ private:
+  const uint64_t min_limit_;
+  const uint64_t max_limit_;
+  uint64_t limit_;
+  // Moving averages of row size and RPC latency, in bytes and seconds.
+  double bytes_per_row_ = 0;
+  double latency_ = 0;
+};
+
 //--------------------------------------------------------------------------------------------------
 // Doc operation API
 // Classes
@@ -164,6 +223,8 @@ class PgDocResult {
 //    - PopulateParallelSelectOps() Parallel processing of aggregate requests or requests with
 //      WHERE expressions filtering rows in DocDB.
 //      The same requests are constructed for each tablet server.
+//      Tablets of range partitioned tables are further split into sub-ranges by the keys returned
+//      with the first page, see SplitScan().
 //    - PopulateNextHashPermutationOps() Parallel processing SELECT by hash conditions.
 //      Hash permutations will be group into different request based on their hash_codes.
 //    - PopulateDmlByYbctidOps() Parallel processing SELECT by ybctid values.
@@ -298,7 +359,19 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
 
   void SetReadTime();
 
+  // Apply page size chosen by prefetch_controller_ to the requests.
+  virtual void SetPrefetchLimit(uint64_t limit) {}
+
  private:
+  // Reserve session memory for the next prefetched page. Returns false if prefetching of the next
+  // page should be skipped.
+  bool ReservePrefetchMemory();
+
+  void ReleasePrefetchMemory();
+
+  void UpdatePrefetchController(
+      const std::list<PgDocResult>& rows, bool prefetched, MonoTime wait_start, MonoTime received);
+
   CHECKED_STATUS SendRequest(bool force_non_bufferable);
 
   virtual CHECKED_STATUS SendRequestImpl(bool force_non_bufferable);
@@ -329,6 +402,9 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   // Next request will be sent in case upper level will ask for additional data.
   bool suppress_next_result_prefetching_ = false;
 
+  // Adapts page size of prefetched requests, set only for scans that prefetch.
+  boost::optional<PrefetchController> prefetch_controller_;
+
   // Populated protobuf request.
   std::vector<PgsqlOpPtr> pgsql_ops_;
 
@@ -406,6 +482,18 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   // Result set either from selected or returned targets is cached in a list of strings.
   // Querying state variables.
   Status exec_status_ = Status::OK();
+
+  // Next request was not prefetched because session prefetch memory limit was reached.
+  bool prefetch_throttled_ = false;
+
+  // Session memory reserved for the outstanding prefetched request.
+  size_t prefetch_memory_reserved_ = 0;
+
+  // Time the last request was sent.
+  MonoTime request_sent_time_;
+
+  // Time the last result was returned to the backend.
+  MonoTime last_result_time_;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -472,12 +560,21 @@ class PgDocReadOp : public PgDocOp {
   // Process response read state from DocDB.
   CHECKED_STATUS ProcessResponseReadStates();
 
+  // Number of parts a tablet scanned by PopulateParallelSelectOps should be split into.
+  size_t ScanSplitParts(size_t partition_count) const;
+
+  // Bound the scan of read_op by the first of split keys returned by the tablet server and create
+  // operators reading the remaining sub-ranges.
+  CHECKED_STATUS SplitScan(PgsqlReadOp* read_op, std::vector<PgsqlOpPtr>* split_ops);
+
   // Reset pgsql operators before reusing them with new arguments / inputs from Postgres.
   CHECKED_STATUS ResetInactivePgsqlOps();
 
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  void SetPrefetchLimit(uint64_t limit) override;
+
   // Set the backfill_spec field of our read request.
   void SetBackfillSpec();
 
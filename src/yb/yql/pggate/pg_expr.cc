@@ -330,6 +330,57 @@ void PgExpr::TranslateData(Slice *yb_cursor, const PgWireDataHeader& header, int
   translate_data_(yb_cursor, header, index, type_entity_, &type_attrs_, pg_tuple);
 }
 
+Status PgExpr::CheckColumnarColumn(const PgColumnarColumn& column) const {
+  // Column without values contains only NULLs.
+  if (column.type() == InternalType::VALUE_NOT_SET) {
+    return Status::OK();
+  }
+  SCHECK_EQ(column.width(), columnar_width_, Corruption,
+            Format("Unexpected width of columnar data of type $0", column.type()));
+  return Status::OK();
+}
+
+void PgExpr::TranslateColumnarData(const PgColumnarColumn& column, size_t row, int index,
+                                   PgTuple *pg_tuple) const {
+  DCHECK(translate_columnar_data_) << "Columnar data format translation is not provided";
+  translate_columnar_data_(column, row, index, type_entity_, &type_attrs_, pg_tuple);
+}
+
+void PgExpr::WriteColumnarNull(int index, PgTuple *pg_tuple) {
+  PgWireDataHeader header;
+  header.set_null();
+  pg_tuple->WriteNull(index, header);
+}
+
+void PgExpr::TranslateColumnarText(const PgColumnarColumn& column, size_t row, int index,
+                                   const YBCPgTypeEntity *type_entity,
+                                   const PgTypeAttrs *type_attrs, PgTuple *pg_tuple) {
+  if (column.IsNull(row)) {
+    return WriteColumnarNull(index, pg_tuple);
+  }
+
+  // Text is null-terminated the same way as in the row format, see PgExpr::TranslateText.
+  const Slice value = column.ReadBytes(row);
+  const char* text = value.cdata();
+  int64_t text_len = static_cast<int64_t>(value.size()) - 1;
+
+  DCHECK(text_len >= 0 && text[text_len] == '\0' && (text_len == 0 || text[text_len - 1] != '\0'))
+    << "Data received from DocDB does not have expected format";
+
+  pg_tuple->WriteDatum(index, type_entity->yb_to_datum(text, text_len, type_attrs));
+}
+
+void PgExpr::TranslateColumnarBinary(const PgColumnarColumn& column, size_t row, int index,
+                                     const YBCPgTypeEntity *type_entity,
+                                     const PgTypeAttrs *type_attrs, PgTuple *pg_tuple) {
+  if (column.IsNull(row)) {
+    return WriteColumnarNull(index, pg_tuple);
+  }
+
+  const Slice value = column.ReadBytes(row);
+  pg_tuple->WriteDatum(index, type_entity->yb_to_datum(value.data(), value.size(), type_attrs));
+}
+
 bool PgExpr::TranslateNumberHelper(
     const PgWireDataHeader& header, int index, const YBCPgTypeEntity *type_entity,
     PgTuple *pg_tuple) {
@@ -421,27 +472,27 @@ int PgExpr::get_pg_collid() const {
 void PgExpr::InitializeTranslateData() {
   switch (type_entity_->yb_type) {
     case YB_YQL_DATA_TYPE_INT8:
-      translate_data_ = TranslateNumber<int8_t>;
+      InitializeTranslateNumber<int8_t>();
       break;
 
     case YB_YQL_DATA_TYPE_INT16:
-      translate_data_ = TranslateNumber<int16_t>;
+      InitializeTranslateNumber<int16_t>();
       break;
 
     case YB_YQL_DATA_TYPE_INT32:
-      translate_data_ = TranslateNumber<int32_t>;
+      InitializeTranslateNumber<int32_t>();
       break;
 
     case YB_YQL_DATA_TYPE_INT64:
-      translate_data_ = TranslateNumber<int64_t>;
+      InitializeTranslateNumber<int64_t>();
       break;
 
     case YB_YQL_DATA_TYPE_UINT32:
-      translate_data_ = TranslateNumber<uint32_t>;
+      InitializeTranslateNumber<uint32_t>();
       break;
 
     case YB_YQL_DATA_TYPE_UINT64:
-      translate_data_ = TranslateNumber<uint64_t>;
+      InitializeTranslateNumber<uint64_t>();
       break;
 
     case YB_YQL_DATA_TYPE_STRING:
@@ -449,27 +500,29 @@ void PgExpr::InitializeTranslateData() {
         translate_data_ = TranslateCollateText;
       } else {
         translate_data_ = TranslateText;
+        translate_columnar_data_ = TranslateColumnarText;
       }
       break;
 
     case YB_YQL_DATA_TYPE_BOOL:
-      translate_data_ = TranslateNumber<bool>;
+      InitializeTranslateNumber<bool>();
       break;
 
     case YB_YQL_DATA_TYPE_FLOAT:
-      translate_data_ = TranslateNumber<float>;
+      InitializeTranslateNumber<float>();
       break;
 
     case YB_YQL_DATA_TYPE_DOUBLE:
-      translate_data_ = TranslateNumber<double>;
+      InitializeTranslateNumber<double>();
       break;
 
     case YB_YQL_DATA_TYPE_BINARY:
       translate_data_ = TranslateBinary;
+      translate_columnar_data_ = TranslateColumnarBinary;
       break;
 
     case YB_YQL_DATA_TYPE_TIMESTAMP:
-      translate_data_ = TranslateNumber<int64_t>;
+      InitializeTranslateNumber<int64_t>();
       break;
 
     case YB_YQL_DATA_TYPE_DECIMAL:
@@ -477,7 +530,7 @@ void PgExpr::InitializeTranslateData() {
       break;
 
     case YB_YQL_DATA_TYPE_GIN_NULL:
-      translate_data_ = TranslateNumber<uint8_t>;
+      InitializeTranslateNumber<uint8_t>();
       break;
 
     YB_PG_UNSUPPORTED_TYPES_IN_SWITCH:
@@ -18,6 +18,7 @@
 #include "yb/common/common_fwd.h"
 #include "yb/common/ql_datatype.h"
 
+#include "yb/yql/pggate/util/pg_columnar_data.h"
 #include "yb/yql/pggate/util/pg_doc_data.h"
 #include "yb/yql/pggate/util/pg_tuple.h"
 #include "yb/bfpg/tserver_opcodes.h"
@@ -104,6 +105,21 @@ class PgExpr {
   void TranslateData(Slice *yb_cursor, const PgWireDataHeader& header, int index,
                      PgTuple *pg_tuple) const;
 
+  // Function translate_columnar_data_() is the counterpart of translate_data_() for data received
+  // in the columnar format, it writes the value of the given row of the column to Postgres buffer.
+  // It is not set up for datatypes the columnar format is not used for, and the format is not
+  // requested from DocDB unless all targets support it.
+  void TranslateColumnarData(const PgColumnarColumn& column, size_t row, int index,
+                             PgTuple *pg_tuple) const;
+
+  bool supports_columnar_data() const {
+    return translate_columnar_data_ != nullptr;
+  }
+
+  // Checks that values of the column received in the columnar format could be translated by
+  // TranslateColumnarData(), i.e. their width matches the datatype of the expression.
+  CHECKED_STATUS CheckColumnarColumn(const PgColumnarColumn& column) const;
+
   static bool TranslateNumberHelper(
       const PgWireDataHeader& header, int index, const YBCPgTypeEntity *type_entity,
       PgTuple *pg_tuple);
@@ -124,6 +140,30 @@ class PgExpr {
     pg_tuple->WriteDatum(index, type_entity->yb_to_datum(&result, read_size, type_attrs));
   }
 
+  // Implementation for "translate_columnar_data()" for each supported datatype.
+  template<typename data_type>
+  static void TranslateColumnarNumber(const PgColumnarColumn& column, size_t row, int index,
+                                      const YBCPgTypeEntity *type_entity,
+                                      const PgTypeAttrs *type_attrs, PgTuple *pg_tuple) {
+    if (column.IsNull(row)) {
+      return WriteColumnarNull(index, pg_tuple);
+    }
+    // Width of the column is checked by CheckColumnarColumn.
+    data_type result;
+    column.ReadNumber(row, &result);
+    pg_tuple->WriteDatum(index, type_entity->yb_to_datum(&result, sizeof(result), type_attrs));
+  }
+
+  static void TranslateColumnarText(const PgColumnarColumn& column, size_t row, int index,
+                                    const YBCPgTypeEntity *type_entity,
+                                    const PgTypeAttrs *type_attrs, PgTuple *pg_tuple);
+
+  static void TranslateColumnarBinary(const PgColumnarColumn& column, size_t row, int index,
+                                      const YBCPgTypeEntity *type_entity,
+                                      const PgTypeAttrs *type_attrs, PgTuple *pg_tuple);
+
+  static void WriteColumnarNull(int index, PgTuple *pg_tuple);
+
   // Translates DocDB-char-based datatypes.
   static void TranslateText(Slice *yb_cursor, const PgWireDataHeader& header, int index,
                             const YBCPgTypeEntity *type_entity, const PgTypeAttrs *type_attrs,
@@ -208,6 +248,13 @@ class PgExpr {
 
   void InitializeTranslateData();
 
+  template<typename data_type>
+  void InitializeTranslateNumber() {
+    translate_data_ = TranslateNumber<data_type>;
+    translate_columnar_data_ = TranslateColumnarNumber<data_type>;
+    columnar_width_ = sizeof(data_type);
+  }
+
   // Data members.
   Opcode opcode_;
   const PgTypeEntity *type_entity_;
@@ -215,6 +262,10 @@ class PgExpr {
   const PgTypeAttrs type_attrs_;
   std::function<void(Slice *, const PgWireDataHeader&, int, const YBCPgTypeEntity *,
                      const PgTypeAttrs *, PgTuple *)> translate_data_;
+  std::function<void(const PgColumnarColumn&, size_t, int, const YBCPgTypeEntity *,
+                     const PgTypeAttrs *, PgTuple *)> translate_columnar_data_;
+  // Width of values in the columnar format, 0 for variable width types.
+  size_t columnar_width_ = 0;
 };
 
 class PgConstant : public PgExpr {
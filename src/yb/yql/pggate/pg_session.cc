@@ -965,6 +965,22 @@ bool PgSession::ShouldUseFollowerReads() const {
   return pg_txn_manager_->ShouldUseFollowerReads();
 }
 
+bool PgSession::TryReservePrefetchMemory(size_t bytes) {
+  // Always allow a single prefetched page, so scans with huge rows are not throttled forever.
+  if (FLAGS_ysql_session_prefetch_memory_limit &&
+      prefetch_memory_reserved_ &&
+      prefetch_memory_reserved_ + bytes > FLAGS_ysql_session_prefetch_memory_limit) {
+    return false;
+  }
+  prefetch_memory_reserved_ += bytes;
+  return true;
+}
+
+void PgSession::ReleasePrefetchMemory(size_t bytes) {
+  DCHECK_GE(prefetch_memory_reserved_, bytes);
+  prefetch_memory_reserved_ -= std::min(prefetch_memory_reserved_, bytes);
+}
+
 void PgSession::SetTimeout(const int timeout_ms) {
   session_->SetTimeout(MonoDelta::FromMilliseconds(timeout_ms));
   pg_client_.SetTimeout(timeout_ms * 1ms);
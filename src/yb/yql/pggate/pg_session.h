@@ -319,6 +319,11 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   bool ShouldUseFollowerReads() const;
 
+  // Accounts memory for a page that is going to be prefetched by a scan.
+  // Returns false if prefetching it would exceed ysql_session_prefetch_memory_limit.
+  bool TryReservePrefetchMemory(size_t bytes);
+  void ReleasePrefetchMemory(size_t bytes);
+
   CHECKED_STATUS SetActiveSubTransaction(SubTransactionId id);
   CHECKED_STATUS RollbackSubTransaction(SubTransactionId id);
 
@@ -410,6 +415,9 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   HybridTime in_txn_limit_;
   bool use_catalog_session_ = false;
 
+  // Estimated size of pages being prefetched by scans of this session.
+  size_t prefetch_memory_reserved_ = 0;
+
   const tserver::TServerSharedObject* const tserver_shared_object_;
   const YBCPgCallbacks& pg_callbacks_;
 };
@@ -18,8 +18,11 @@
 #include <gflags/gflags.h>
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(pgsql_rpc_keepalive_time_ms, 0,
              "If an RPC connection from a client is idle for this amount of time, the server "
              "will disconnect the client. Setting flag to 0 disables this clean up.");
@@ -53,6 +56,19 @@ DEFINE_uint64(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_bool(ysql_enable_adaptive_prefetch, true,
+            "Adapt number of rows prefetched by long scans to the rate at which rows are "
+            "consumed. Page size starts with ysql_prefetch_limit and grows up to "
+            "ysql_adaptive_prefetch_max_limit while the backend waits for prefetched pages.");
+
+DEFINE_uint64(ysql_adaptive_prefetch_max_limit, 16384,
+              "Maximum number of rows to prefetch when ysql_enable_adaptive_prefetch is set");
+
+DEFINE_uint64(ysql_session_prefetch_memory_limit, 64_MB,
+              "Maximum estimated size of prefetched pages outstanding in a single session. "
+              "Scans fall back to fetching pages on demand when this limit is reached. "
+              "0 means no limit.");
+
 DEFINE_uint64(ysql_session_max_batch_size, 512,
               "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
               "services");
@@ -112,6 +128,16 @@ DEFINE_int32(ysql_select_parallelism, -1,
             "Number of read requests to issue in parallel to tablets of a table "
             "for SELECT.");
 
+DEFINE_int32(ysql_max_tablet_scan_split_parts, 8,
+             "Maximum number of sub-ranges a tablet of a range partitioned table is split into by "
+             "aggregate and filtered scans, so the sub-ranges could be read in parallel. "
+             "1 disables splitting.");
+
+DEFINE_bool(ysql_enable_columnar_result, true,
+            "Request rows of scans from tablet servers in the columnar format, which is more "
+            "compact and faster to decode than the row format. Used only when all selected "
+            "columns are of supported types.");
+
 DEFINE_int32(ysql_max_write_restart_attempts, 20,
              "Max number of restart attempts made for writes on transaction conflicts.");
 
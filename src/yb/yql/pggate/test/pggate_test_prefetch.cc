@@ -0,0 +1,148 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//--------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "yb/util/monotime.h"
+#include "yb/util/test_util.h"
+
+#include "yb/yql/pggate/pg_doc_op.h"
+
+namespace yb {
+namespace pggate {
+
+namespace {
+
+constexpr uint64_t kMinLimit = 1024;
+constexpr uint64_t kMaxLimit = 16 * kMinLimit;
+constexpr size_t kBytesPerRow = 100;
+
+const MonoDelta kLatency = MonoDelta::FromMilliseconds(10);
+
+// Reports the first page, that is always fetched on demand.
+void ReceiveFirstPage(PrefetchController* controller) {
+  controller->PageReceived(
+      /* prefetched= */ false, kLatency, kLatency, MonoDelta(), controller->limit(),
+      controller->limit() * kBytesPerRow);
+}
+
+// Reports a prefetched page, the backend spent consume_time on the previous page and then waited
+// for this one for wait_time.
+void ReceivePrefetchedPage(
+    PrefetchController* controller, MonoDelta wait_time, MonoDelta consume_time) {
+  controller->PageReceived(
+      /* prefetched= */ true, kLatency, wait_time, consume_time, controller->limit(),
+      controller->limit() * kBytesPerRow);
+}
+
+} // namespace
+
+class PrefetchControllerTest : public YBTest {
+};
+
+TEST_F(PrefetchControllerTest, GrowWhileBackendWaits) {
+  PrefetchController controller(kMinLimit, kMaxLimit);
+  ASSERT_EQ(controller.limit(), kMinLimit);
+
+  // Pages fetched on demand don't change the page size.
+  ReceiveFirstPage(&controller);
+  ASSERT_EQ(controller.limit(), kMinLimit);
+
+  // Backend waits for prefetched pages, so page size doubles up to the max limit.
+  auto expected_limit = kMinLimit;
+  while (expected_limit < kMaxLimit) {
+    ReceivePrefetchedPage(&controller, kLatency / 2, kLatency);
+    expected_limit *= 2;
+    ASSERT_EQ(controller.limit(), expected_limit);
+  }
+  ReceivePrefetchedPage(&controller, kLatency / 2, kLatency);
+  ASSERT_EQ(controller.limit(), kMaxLimit);
+}
+
+TEST_F(PrefetchControllerTest, ShrinkWhilePagesWait) {
+  PrefetchController controller(kMinLimit, kMaxLimit);
+  ReceiveFirstPage(&controller);
+  for (int i = 0; i != 4; ++i) {
+    ReceivePrefetchedPage(&controller, kLatency / 2, kLatency);
+  }
+  ASSERT_EQ(controller.limit(), kMaxLimit);
+
+  // Negligible wait and consume time comparable to latency keep the page size.
+  ReceivePrefetchedPage(&controller, kLatency / 100, kLatency);
+  ASSERT_EQ(controller.limit(), kMaxLimit);
+  ReceivePrefetchedPage(&controller, MonoDelta::kZero, kLatency * 2);
+  ASSERT_EQ(controller.limit(), kMaxLimit);
+
+  // Pages arrive long before backend needs them, so page size halves down to the min limit.
+  auto expected_limit = kMaxLimit;
+  while (expected_limit > kMinLimit) {
+    ReceivePrefetchedPage(&controller, MonoDelta::kZero, kLatency * 10);
+    expected_limit /= 2;
+    ASSERT_EQ(controller.limit(), expected_limit);
+  }
+  ReceivePrefetchedPage(&controller, MonoDelta::kZero, kLatency * 10);
+  ASSERT_EQ(controller.limit(), kMinLimit);
+}
+
+TEST_F(PrefetchControllerTest, Throttled) {
+  PrefetchController controller(kMinLimit, kMaxLimit);
+  ReceiveFirstPage(&controller);
+  ReceivePrefetchedPage(&controller, kLatency / 2, kLatency);
+  ReceivePrefetchedPage(&controller, kLatency / 2, kLatency);
+  ASSERT_EQ(controller.limit(), 4 * kMinLimit);
+
+  controller.Throttled();
+  ASSERT_EQ(controller.limit(), 2 * kMinLimit);
+  controller.Throttled();
+  ASSERT_EQ(controller.limit(), kMinLimit);
+  controller.Throttled();
+  ASSERT_EQ(controller.limit(), kMinLimit);
+}
+
+TEST_F(PrefetchControllerTest, MaxLimitBelowMinLimit) {
+  PrefetchController controller(kMinLimit, kMinLimit / 2);
+  ReceiveFirstPage(&controller);
+  ReceivePrefetchedPage(&controller, kLatency / 2, kLatency);
+  ASSERT_EQ(controller.limit(), kMinLimit);
+}
+
+TEST_F(PrefetchControllerTest, EstimatedPageBytes) {
+  PrefetchController controller(kMinLimit, kMaxLimit);
+  // Row size is not known before the first page.
+  ASSERT_EQ(controller.EstimatedPageBytes(), 0U);
+
+  ReceiveFirstPage(&controller);
+  ASSERT_EQ(controller.EstimatedPageBytes(), kMinLimit * kBytesPerRow);
+
+  // Estimation follows the page size.
+  ReceivePrefetchedPage(&controller, kLatency / 2, kLatency);
+  ASSERT_EQ(controller.EstimatedPageBytes(), 2 * kMinLimit * kBytesPerRow);
+
+  // Row size is a moving average, so it changes gradually.
+  controller.PageReceived(
+      /* prefetched= */ true, kLatency, MonoDelta::kZero, kLatency, 100, 100 * 5 * kBytesPerRow);
+  const auto bytes_per_row = controller.EstimatedPageBytes() / controller.limit();
+  ASSERT_GT(bytes_per_row, kBytesPerRow);
+  ASSERT_LT(bytes_per_row, 5 * kBytesPerRow);
+
+  // Empty pages don't affect row size.
+  const auto estimated_bytes = controller.EstimatedPageBytes();
+  controller.PageReceived(
+      /* prefetched= */ true, kLatency, MonoDelta::kZero, kLatency, 0, 0);
+  ASSERT_EQ(controller.EstimatedPageBytes(), estimated_bytes);
+}
+
+} // namespace pggate
+} // namespace yb
@@ -19,6 +19,7 @@
 
 #include "yb/util/status_log.h"
 
+#include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/test/pggate_test.h"
 #include "yb/yql/pggate/ybc_pggate.h"
 
@@ -273,5 +274,150 @@ TEST_F(PggateTestSelect, TestSelectOneTablet) {
   pg_stmt = nullptr;
 }
 
+TEST_F(PggateTestSelect, TestSelectColumnarResult) {
+  CHECK_OK(Init("TestSelectColumnarResult"));
+
+  const char *tabname = "columnar_table";
+  const YBCPgOid tab_oid = 3;
+  YBCPgStatement pg_stmt;
+
+  // Create table in the connected database.
+  int col_count = 0;
+  CHECK_YBC_STATUS(YBCPgNewCreateTable(kDefaultDatabase, kDefaultSchema, tabname,
+                                       kDefaultDatabaseOid, tab_oid,
+                                       false /* is_shared_table */, true /* if_not_exist */,
+                                       false /* add_primary_key */, true /* colocated */,
+                                       kInvalidOid /* tablegroup_id */,
+                                       kInvalidOid /* tablespace_id */,
+                                       kInvalidOid /* matview_pg_table_id */,
+                                       &pg_stmt));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "hash_key", ++col_count,
+                                               DataType::INT64, true, true));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "id", ++col_count,
+                                               DataType::INT32, false, true));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "dependent_count", ++col_count,
+                                               DataType::INT16, false, false));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "salary", ++col_count,
+                                               DataType::FLOAT, false, false));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "job", ++col_count,
+                                               DataType::STRING, false, false));
+  CHECK_YBC_STATUS(YBCPgExecCreateTable(pg_stmt));
+
+  pg_stmt = nullptr;
+
+  // INSERT ----------------------------------------------------------------------------------------
+  // Every third row has NULL in its non key columns.
+  CHECK_YBC_STATUS(YBCPgNewInsert(kDefaultDatabaseOid, tab_oid,
+                                  false /* is_single_row_txn */, &pg_stmt));
+
+  YBCPgExpr expr_hash;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt8(pg_stmt, 0, false, &expr_hash));
+  YBCPgExpr expr_id;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt4(pg_stmt, 0, false, &expr_id));
+  YBCPgExpr expr_depcnt;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt2(pg_stmt, 0, false, &expr_depcnt));
+  YBCPgExpr expr_salary;
+  CHECK_YBC_STATUS(YBCTestNewConstantFloat4(pg_stmt, 0, false, &expr_salary));
+  YBCPgExpr expr_job;
+  CHECK_YBC_STATUS(YBCTestNewConstantText(pg_stmt, "", false, &expr_job));
+
+  int attr_num = 0;
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_hash));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_id));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_depcnt));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_salary));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_job));
+  CHECK_EQ(attr_num, col_count);
+
+  const int insert_row_count = 20;
+  for (int seed = 0; seed < insert_row_count; seed++) {
+    const bool is_null = seed % 3 == 0;
+    string job = strings::Substitute("Job_title_$0", seed);
+    CHECK_YBC_STATUS(YBCPgUpdateConstInt4(expr_id, seed, false));
+    CHECK_YBC_STATUS(YBCPgUpdateConstInt2(expr_depcnt, seed, is_null));
+    CHECK_YBC_STATUS(YBCPgUpdateConstFloat4(expr_salary, seed + 1.0*seed/10.0, is_null));
+    CHECK_YBC_STATUS(YBCPgUpdateConstText(expr_job, job.c_str(), is_null));
+
+    BeginTransaction();
+    CHECK_YBC_STATUS(YBCPgExecInsert(pg_stmt));
+    CommitTransaction();
+  }
+
+  pg_stmt = nullptr;
+
+  // SELECT ----------------------------------------------------------------------------------------
+  // Scan the table in the row and in the columnar result format, every fetched row is rendered
+  // to a string so both formats can be compared.
+  auto select_rows = [&](bool columnar_result) {
+    LOG(INFO) << "Test SELECTing with columnar result " << columnar_result;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_enable_columnar_result) = columnar_result;
+
+    YBCPgStatement select_stmt;
+    CHECK_YBC_STATUS(YBCPgNewSelect(kDefaultDatabaseOid, tab_oid,
+                                    NULL /* prepare_params */, &select_stmt));
+
+    YBCPgExpr colref;
+    CHECK_YBC_STATUS(YBCTestNewColumnRef(select_stmt, 1, DataType::INT64, &colref));
+    CHECK_YBC_STATUS(YBCPgDmlAppendTarget(select_stmt, colref));
+    CHECK_YBC_STATUS(YBCTestNewColumnRef(select_stmt, 2, DataType::INT32, &colref));
+    CHECK_YBC_STATUS(YBCPgDmlAppendTarget(select_stmt, colref));
+    CHECK_YBC_STATUS(YBCTestNewColumnRef(select_stmt, 3, DataType::INT16, &colref));
+    CHECK_YBC_STATUS(YBCPgDmlAppendTarget(select_stmt, colref));
+    CHECK_YBC_STATUS(YBCTestNewColumnRef(select_stmt, 4, DataType::FLOAT, &colref));
+    CHECK_YBC_STATUS(YBCPgDmlAppendTarget(select_stmt, colref));
+    CHECK_YBC_STATUS(YBCTestNewColumnRef(select_stmt, 5, DataType::STRING, &colref));
+    CHECK_YBC_STATUS(YBCPgDmlAppendTarget(select_stmt, colref));
+
+    // SELECT ... WHERE hash = 0.
+    YBCPgExpr expr_select_hash;
+    CHECK_YBC_STATUS(YBCTestNewConstantInt8(select_stmt, 0, false, &expr_select_hash));
+    CHECK_YBC_STATUS(YBCPgDmlBindColumn(select_stmt, 1, expr_select_hash));
+
+    BeginTransaction();
+    CHECK_YBC_STATUS(YBCPgExecSelect(select_stmt, nullptr /* exec_params */));
+
+    uint64_t *values = static_cast<uint64_t*>(YBCPAlloc(col_count * sizeof(uint64_t)));
+    bool *isnulls = static_cast<bool*>(YBCPAlloc(col_count * sizeof(bool)));
+    YBCPgSysColumns syscols;
+    std::vector<string> rows;
+    for (;;) {
+      bool has_data = false;
+      CHECK_YBC_STATUS(YBCPgDmlFetch(
+          select_stmt, col_count, values, isnulls, &syscols, &has_data));
+      if (!has_data) {
+        break;
+      }
+
+      CHECK(!isnulls[0] && !isnulls[1]);
+      CHECK_EQ(values[0], 0);  // hash_key : int64
+      int32_t id = narrow_cast<int32_t>(values[1]);  // id : int32
+      CHECK_EQ(isnulls[2], id % 3 == 0);
+      CHECK_EQ(isnulls[3], id % 3 == 0);
+      CHECK_EQ(isnulls[4], id % 3 == 0);
+
+      string row = strings::Substitute("id = $0", id);
+      if (!isnulls[2]) {
+        CHECK_EQ(values[2], id);  // dependent_count : int16
+        float salary = *reinterpret_cast<float*>(&values[3]);  // salary : float
+        CHECK_LE(salary, id + 1.0*id/10.0 + 0.01);
+        CHECK_GE(salary, id + 1.0*id/10.0 - 0.01);
+        string job = reinterpret_cast<char*>(values[4]);  // job : string
+        CHECK_EQ(job, strings::Substitute("Job_title_$0", id));
+        row += strings::Substitute(", dependent count = $0, salary = $1, job = $2",
+                                   values[2], salary, job);
+      }
+      LOG(INFO) << "ROW: " << row;
+      rows.push_back(std::move(row));
+    }
+    CommitTransaction();
+    return rows;
+  };
+
+  auto row_result = select_rows(false /* columnar_result */);
+  auto columnar_result = select_rows(true /* columnar_result */);
+  CHECK_EQ(row_result.size(), insert_row_count);
+  CHECK(row_result == columnar_result);
+}
+
 } // namespace pggate
 } // namespace yb
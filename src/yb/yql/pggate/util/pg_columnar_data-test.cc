@@ -0,0 +1,124 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+#include "yb/yql/pggate/util/pg_columnar_data.h"
+
+namespace yb {
+namespace pggate {
+
+class PgColumnarDataTest : public YBTest {
+};
+
+TEST_F(PgColumnarDataTest, RoundTrip) {
+  constexpr size_t kNumRows = 19;
+  constexpr size_t kNumColumns = 4;
+  PgColumnarWriter writer(kNumColumns);
+  for (size_t row = 0; row != kNumRows; ++row) {
+    QLValuePB int_value;
+    if (row % 3 != 0) {
+      int_value.set_int64_value(-static_cast<int64_t>(row) * 1000000007LL);
+    }
+    ASSERT_OK(writer.AppendValue(0, int_value));
+
+    // Leading NULLs before the type of the column is known.
+    QLValuePB text_value;
+    if (row >= 5 && row % 4 != 0) {
+      text_value.set_string_value(std::string(row, static_cast<char>('a' + row)));
+    }
+    ASSERT_OK(writer.AppendValue(1, text_value));
+
+    QLValuePB double_value;
+    double_value.set_double_value(row / 4.0);
+    ASSERT_OK(writer.AppendValue(2, double_value));
+
+    ASSERT_OK(writer.AppendValue(3, QLValuePB()));
+  }
+  ASSERT_EQ(kNumRows, writer.num_rows());
+
+  faststring buffer;
+  writer.Flush(&buffer);
+  ASSERT_EQ(0U, writer.num_rows());
+
+  std::vector<PgColumnarColumn> columns;
+  ASSERT_OK(PgColumnarReader::Parse(Slice(buffer), kNumRows, kNumColumns, &columns));
+  ASSERT_EQ(kNumColumns, columns.size());
+  ASSERT_EQ(InternalType::kInt64Value, columns[0].type());
+  ASSERT_EQ(8U, columns[0].width());
+  ASSERT_EQ(InternalType::kStringValue, columns[1].type());
+  ASSERT_EQ(0U, columns[1].width());
+  ASSERT_EQ(InternalType::kDoubleValue, columns[2].type());
+  ASSERT_EQ(InternalType::VALUE_NOT_SET, columns[3].type());
+
+  for (size_t row = 0; row != kNumRows; ++row) {
+    SCOPED_TRACE(Format("Row: $0", row));
+    if (row % 3 != 0) {
+      ASSERT_FALSE(columns[0].IsNull(row));
+      int64_t value;
+      columns[0].ReadNumber(row, &value);
+      ASSERT_EQ(-static_cast<int64_t>(row) * 1000000007LL, value);
+    } else {
+      ASSERT_TRUE(columns[0].IsNull(row));
+    }
+
+    if (row >= 5 && row % 4 != 0) {
+      ASSERT_FALSE(columns[1].IsNull(row));
+      // Text is null-terminated.
+      ASSERT_EQ(std::string(row, static_cast<char>('a' + row)) + '\0',
+                columns[1].ReadBytes(row).ToBuffer());
+    } else {
+      ASSERT_TRUE(columns[1].IsNull(row));
+      ASSERT_EQ(0U, columns[1].ReadBytes(row).size());
+    }
+
+    ASSERT_FALSE(columns[2].IsNull(row));
+    double value;
+    columns[2].ReadNumber(row, &value);
+    ASSERT_EQ(row / 4.0, value);
+
+    ASSERT_TRUE(columns[3].IsNull(row));
+  }
+}
+
+TEST_F(PgColumnarDataTest, Errors) {
+  PgColumnarWriter writer(1);
+  QLValuePB value;
+  value.set_int32_value(1);
+  ASSERT_OK(writer.AppendValue(0, value));
+  value.set_string_value("text");
+  ASSERT_NOK(writer.AppendValue(0, value));
+
+  PgColumnarWriter other_writer(1);
+  value.set_int32_value(1);
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_OK(other_writer.AppendValue(0, value));
+  }
+  faststring buffer;
+  other_writer.Flush(&buffer);
+
+  std::vector<PgColumnarColumn> columns;
+  ASSERT_OK(PgColumnarReader::Parse(Slice(buffer), 3, 1, &columns));
+  ASSERT_NOK(PgColumnarReader::Parse(Slice(buffer.data(), buffer.size() - 1), 3, 1, &columns));
+  ASSERT_NOK(PgColumnarReader::Parse(Slice(buffer), 4, 1, &columns));
+  ASSERT_NOK(PgColumnarReader::Parse(Slice(buffer), 2, 1, &columns));
+}
+
+} // namespace pggate
+} // namespace yb
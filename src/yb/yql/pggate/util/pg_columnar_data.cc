@@ -0,0 +1,281 @@
+//--------------------------------------------------------------------------------------------------
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "yb/yql/pggate/util/pg_columnar_data.h"
+
+#include <limits>
+
+#include "yb/common/ql_value.h"
+
+#include "yb/util/format.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace pggate {
+
+namespace {
+
+constexpr size_t kOffsetSize = sizeof(uint32_t);
+
+// Width of values of the type, 0 for variable width types.
+Result<size_t> ValueWidth(InternalType type) {
+  switch (type) {
+    case InternalType::kBoolValue:
+    case InternalType::kInt8Value:
+    case InternalType::kGinNullValue:
+      return 1;
+    case InternalType::kInt16Value:
+      return 2;
+    case InternalType::kInt32Value:
+    case InternalType::kUint32Value:
+    case InternalType::kFloatValue:
+      return 4;
+    case InternalType::kInt64Value:
+    case InternalType::kUint64Value:
+    case InternalType::kDoubleValue:
+      return 8;
+    case InternalType::kStringValue:
+    case InternalType::kBinaryValue:
+    case InternalType::kDecimalValue:
+      return 0;
+    default:
+      break;
+  }
+  return STATUS_FORMAT(NotSupported, "Unexpected type of columnar data: $0", type);
+}
+
+void AppendZeroes(size_t size, faststring *buffer) {
+  const size_t old_size = buffer->size();
+  buffer->resize(old_size + size);
+  memset(buffer->data() + old_size, 0, size);
+}
+
+void AppendFixed16(uint16_t value, faststring *buffer) {
+  uint8_t data[sizeof(value)];
+  LittleEndian::Store16(data, value);
+  buffer->append(data, sizeof(data));
+}
+
+void AppendFixed32(uint32_t value, faststring *buffer) {
+  uint8_t data[sizeof(value)];
+  LittleEndian::Store32(data, value);
+  buffer->append(data, sizeof(data));
+}
+
+void AppendFixed64(uint64_t value, faststring *buffer) {
+  uint8_t data[sizeof(value)];
+  LittleEndian::Store64(data, value);
+  buffer->append(data, sizeof(data));
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+
+PgColumnarWriter::PgColumnarWriter(size_t num_columns) : columns_(num_columns) {
+}
+
+Status PgColumnarWriter::SetType(InternalType type, Column *column) {
+  column->type = type;
+  column->width = VERIFY_RESULT(ValueWidth(type));
+  // Previous rows of the column are NULLs, fill their slots.
+  if (column->width != 0) {
+    AppendZeroes(column->num_rows * column->width, &column->values);
+  } else {
+    AppendZeroes(column->num_rows * kOffsetSize, &column->offsets);
+  }
+  return Status::OK();
+}
+
+Status PgColumnarWriter::AppendValue(size_t index, const QLValuePB& value) {
+  DCHECK_LT(index, columns_.size());
+  auto& column = columns_[index];
+  if (column.num_rows % 8 == 0) {
+    column.nulls.push_back(0);
+  }
+
+  if (QLValue::IsNull(value)) {
+    column.nulls[column.num_rows >> 3] |= 1 << (column.num_rows & 7);
+    column.has_nulls = true;
+    if (column.width != 0) {
+      AppendZeroes(column.width, &column.values);
+    } else if (column.type != InternalType::VALUE_NOT_SET) {
+      AppendFixed32(static_cast<uint32_t>(column.values.size()), &column.offsets);
+    }
+    ++column.num_rows;
+    return Status::OK();
+  }
+
+  if (value.value_case() != column.type) {
+    if (column.type != InternalType::VALUE_NOT_SET) {
+      return STATUS_FORMAT(
+          InternalError, "Column $0 has values of different types: $1 and $2",
+          index, column.type, value.value_case());
+    }
+    RETURN_NOT_OK(SetType(value.value_case(), &column));
+  }
+
+  switch (value.value_case()) {
+    case InternalType::kBoolValue:
+      column.values.push_back(value.bool_value() ? 1 : 0);
+      break;
+    case InternalType::kInt8Value:
+      column.values.push_back(static_cast<uint8_t>(value.int8_value()));
+      break;
+    case InternalType::kGinNullValue:
+      column.values.push_back(static_cast<uint8_t>(value.gin_null_value()));
+      break;
+    case InternalType::kInt16Value:
+      AppendFixed16(static_cast<uint16_t>(value.int16_value()), &column.values);
+      break;
+    case InternalType::kInt32Value:
+      AppendFixed32(static_cast<uint32_t>(value.int32_value()), &column.values);
+      break;
+    case InternalType::kUint32Value:
+      AppendFixed32(value.uint32_value(), &column.values);
+      break;
+    case InternalType::kFloatValue: {
+      const float float_value = value.float_value();
+      uint32_t int_value;
+      memcpy(&int_value, &float_value, sizeof(int_value));
+      AppendFixed32(int_value, &column.values);
+      break;
+    }
+    case InternalType::kInt64Value:
+      AppendFixed64(static_cast<uint64_t>(value.int64_value()), &column.values);
+      break;
+    case InternalType::kUint64Value:
+      AppendFixed64(value.uint64_value(), &column.values);
+      break;
+    case InternalType::kDoubleValue: {
+      const double double_value = value.double_value();
+      uint64_t int_value;
+      memcpy(&int_value, &double_value, sizeof(int_value));
+      AppendFixed64(int_value, &column.values);
+      break;
+    }
+    case InternalType::kStringValue:
+      // Postgres expects text to be null-terminated, see PgWire::WriteText.
+      column.values.append(value.string_value().c_str(), value.string_value().size() + 1);
+      break;
+    case InternalType::kBinaryValue:
+      column.values.append(value.binary_value());
+      break;
+    case InternalType::kDecimalValue:
+      // Serialized form of YB Decimal, decoding will be done in pg_expr.cc.
+      column.values.append(value.decimal_value().c_str(), value.decimal_value().size() + 1);
+      break;
+    default:
+      // Rejected by SetType.
+      return STATUS_FORMAT(
+          NotSupported, "Unexpected type of columnar data: $0", value.value_case());
+  }
+
+  if (column.width == 0) {
+    SCHECK_LE(column.values.size(), std::numeric_limits<uint32_t>::max(), InternalError,
+              Format("Too much data in column $0", index));
+    AppendFixed32(static_cast<uint32_t>(column.values.size()), &column.offsets);
+  }
+  ++column.num_rows;
+  return Status::OK();
+}
+
+void PgColumnarWriter::Flush(faststring *buffer) {
+  const auto rows = num_rows();
+  for (auto& column : columns_) {
+    DCHECK_EQ(column.num_rows, rows);
+    buffer->push_back(static_cast<uint8_t>(column.type));
+    buffer->push_back(column.has_nulls ? 1 : 0);
+    if (column.has_nulls) {
+      buffer->append(column.nulls.data(), column.nulls.size());
+    }
+    if (column.type != InternalType::VALUE_NOT_SET) {
+      if (column.width == 0) {
+        buffer->append(column.offsets.data(), column.offsets.size());
+      }
+      buffer->append(column.values.data(), column.values.size());
+    }
+
+    // Keep the allocated memory for the next page.
+    column.type = InternalType::VALUE_NOT_SET;
+    column.width = 0;
+    column.num_rows = 0;
+    column.has_nulls = false;
+    column.nulls.clear();
+    column.offsets.clear();
+    column.values.clear();
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+Status PgColumnarReader::Parse(Slice data, size_t num_rows, size_t num_columns,
+                               std::vector<PgColumnarColumn> *columns) {
+  columns->clear();
+  columns->reserve(num_columns);
+  const size_t bitmap_size = (num_rows + 7) / 8;
+  for (size_t i = 0; i != num_columns; ++i) {
+    SCHECK_GE(data.size(), 2U, Corruption, Format("Columnar data truncated at column $0", i));
+    columns->emplace_back();
+    auto& column = columns->back();
+    column.type_ = static_cast<InternalType>(data[0]);
+    const bool has_nulls = data[1] != 0;
+    data.remove_prefix(2);
+
+    if (has_nulls) {
+      SCHECK_GE(data.size(), bitmap_size, Corruption,
+                Format("Null bitmap of column $0 truncated", i));
+      column.nulls_ = data.data();
+      data.remove_prefix(bitmap_size);
+    }
+
+    if (column.type_ == InternalType::VALUE_NOT_SET) {
+      SCHECK(has_nulls || num_rows == 0, Corruption,
+             Format("Column $0 of unknown type has values", i));
+      continue;
+    }
+
+    column.width_ = VERIFY_RESULT(ValueWidth(column.type_));
+    if (column.width_ != 0) {
+      const size_t values_size = num_rows * column.width_;
+      SCHECK_GE(data.size(), values_size, Corruption, Format("Column $0 truncated", i));
+      column.values_ = data.data();
+      data.remove_prefix(values_size);
+      continue;
+    }
+
+    const size_t offsets_size = num_rows * kOffsetSize;
+    SCHECK_GE(data.size(), offsets_size, Corruption, Format("Offsets of column $0 truncated", i));
+    column.offsets_ = data.data();
+    data.remove_prefix(offsets_size);
+    uint32_t prev_offset = 0;
+    for (size_t row = 0; row != num_rows; ++row) {
+      const uint32_t offset = LittleEndian::Load32(column.offsets_ + row * kOffsetSize);
+      SCHECK_GE(offset, prev_offset, Corruption,
+                Format("Offsets of column $0 are not ordered at row $1", i, row));
+      prev_offset = offset;
+    }
+    SCHECK_GE(data.size(), prev_offset, Corruption, Format("Values of column $0 truncated", i));
+    column.values_ = data.data();
+    data.remove_prefix(prev_offset);
+  }
+
+  SCHECK(data.empty(), Corruption, Format("$0 bytes left after columnar data", data.size()));
+  return Status::OK();
+}
+
+}  // namespace pggate
+}  // namespace yb
@@ -0,0 +1,160 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_YQL_PGGATE_UTIL_PG_COLUMNAR_DATA_H_
+#define YB_YQL_PGGATE_UTIL_PG_COLUMNAR_DATA_H_
+
+#include <vector>
+
+#include "yb/common/ql_datatype.h"
+
+#include "yb/gutil/endian.h"
+
+#include "yb/util/faststring.h"
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace pggate {
+
+//--------------------------------------------------------------------------------------------------
+// Columnar format of rows data.
+//
+// Rows data starts with the row count, the same way as in the row format (see WriteColumn), and
+// is followed by the columns, one by one, in the order of the request targets:
+//   uint8          type of the column values (InternalType), VALUE_NOT_SET if all values are NULL.
+//   uint8          1 if the column has NULL values, 0 otherwise.
+//   bitmap         (row count + 7) / 8 bytes, bit N is set if value of row N is NULL. Present only
+//                  if the column has NULL values.
+// Followed by values of fixed width types (integers, floats, bool):
+//   array          row count values, little endian. NULL values are zeroes.
+// Or by values of variable width types (text, binary, decimal):
+//   uint32 array   row count end offsets of the values in the arena, little endian.
+//   arena          values, concatenated. NULL values are empty. Text values are null-terminated
+//                  like in the row format.
+//
+// Values of a column are laid out next to each other and addressed by row number, so the reader
+// does not have to parse preceding values to get the value of a row.
+//--------------------------------------------------------------------------------------------------
+
+// Accumulates rows and writes them in the columnar format.
+class PgColumnarWriter {
+ public:
+  explicit PgColumnarWriter(size_t num_columns);
+
+  // Append the value of the column to the current row. Values are expected to be appended for all
+  // columns of a row, values of the same column must have the same type.
+  CHECKED_STATUS AppendValue(size_t column, const QLValuePB& value);
+
+  // Write the accumulated columns to the buffer and start accumulating from scratch.
+  // Row count is not written, it is up to the caller.
+  void Flush(faststring *buffer);
+
+  size_t num_rows() const {
+    return columns_.empty() ? 0 : columns_.front().num_rows;
+  }
+
+ private:
+  struct Column {
+    InternalType type = InternalType::VALUE_NOT_SET;
+    size_t width = 0;
+    size_t num_rows = 0;
+    bool has_nulls = false;
+    faststring nulls;
+    faststring offsets;
+    faststring values;
+  };
+
+  static CHECKED_STATUS SetType(InternalType type, Column *column);
+
+  std::vector<Column> columns_;
+};
+
+// Column of rows data in the columnar format. Points to the data, so the data must outlive it.
+class PgColumnarColumn {
+ public:
+  InternalType type() const {
+    return type_;
+  }
+
+  // Width of values, 0 for variable width types.
+  size_t width() const {
+    return width_;
+  }
+
+  bool IsNull(size_t row) const {
+    return nulls_ && (nulls_[row >> 3] >> (row & 7)) & 1;
+  }
+
+  // Fixed width values.
+  void ReadNumber(size_t row, bool *value) const {
+    *value = values_[row] != 0;
+  }
+  void ReadNumber(size_t row, uint8_t *value) const {
+    *value = values_[row];
+  }
+  void ReadNumber(size_t row, int8_t *value) const {
+    *value = static_cast<int8_t>(values_[row]);
+  }
+  void ReadNumber(size_t row, int16_t *value) const {
+    *value = static_cast<int16_t>(LittleEndian::Load16(values_ + row * sizeof(*value)));
+  }
+  void ReadNumber(size_t row, uint32_t *value) const {
+    *value = LittleEndian::Load32(values_ + row * sizeof(*value));
+  }
+  void ReadNumber(size_t row, int32_t *value) const {
+    *value = static_cast<int32_t>(LittleEndian::Load32(values_ + row * sizeof(*value)));
+  }
+  void ReadNumber(size_t row, uint64_t *value) const {
+    *value = LittleEndian::Load64(values_ + row * sizeof(*value));
+  }
+  void ReadNumber(size_t row, int64_t *value) const {
+    *value = static_cast<int64_t>(LittleEndian::Load64(values_ + row * sizeof(*value)));
+  }
+  void ReadNumber(size_t row, float *value) const {
+    uint32_t int_value = LittleEndian::Load32(values_ + row * sizeof(*value));
+    memcpy(value, &int_value, sizeof(*value));
+  }
+  void ReadNumber(size_t row, double *value) const {
+    uint64_t int_value = LittleEndian::Load64(values_ + row * sizeof(*value));
+    memcpy(value, &int_value, sizeof(*value));
+  }
+
+  // Variable width values.
+  Slice ReadBytes(size_t row) const {
+    const uint32_t start = row == 0 ? 0 : LittleEndian::Load32(offsets_ + (row - 1) * 4);
+    return Slice(values_ + start, LittleEndian::Load32(offsets_ + row * 4) - start);
+  }
+
+ private:
+  friend class PgColumnarReader;
+
+  InternalType type_ = InternalType::VALUE_NOT_SET;
+  size_t width_ = 0;
+  const uint8_t *nulls_ = nullptr;
+  const uint8_t *offsets_ = nullptr;
+  const uint8_t *values_ = nullptr;
+};
+
+class PgColumnarReader {
+ public:
+  // Parse columns from rows data that follows the row count. Offsets are validated, so reading
+  // values of the returned columns never accesses memory outside of the data.
+  static CHECKED_STATUS Parse(Slice data, size_t num_rows, size_t num_columns,
+                              std::vector<PgColumnarColumn> *columns);
+};
+
+}  // namespace pggate
+}  // namespace yb
+
+#endif // YB_YQL_PGGATE_UTIL_PG_COLUMNAR_DATA_H_
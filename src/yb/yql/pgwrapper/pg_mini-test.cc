@@ -12,6 +12,7 @@
 //
 
 #include <atomic>
+#include <limits>
 #include <thread>
 
 #include <boost/preprocessor/seq/for_each.hpp>
@@ -21,6 +22,7 @@
 #include "yb/client/yb_table_name.h"
 
 #include "yb/common/pgsql_error.h"
+#include "yb/common/pgsql_protocol.pb.h"
 
 #include "yb/docdb/value_type.h"
 
@@ -82,6 +84,8 @@ DECLARE_int64(db_block_size_bytes);
 DECLARE_int64(db_filter_block_size_bytes);
 DECLARE_int64(db_index_block_size_bytes);
 DECLARE_int64(tablet_force_split_threshold_bytes);
+DECLARE_uint64(tablet_scan_split_min_part_size_bytes);
+DECLARE_uint64(read_rows_data_zero_copy_min_size);
 DECLARE_int64(TEST_inject_random_delay_on_txn_status_response_ms);
 
 namespace yb {
@@ -187,6 +191,24 @@ class PgMiniSingleTServerTest : public PgMiniTest {
   }
 };
 
+class PgMiniAdaptivePrefetchTest : public PgMiniSingleTServerTest {
+ public:
+  void SetUp() override {
+    FLAGS_ysql_prefetch_limit = 100;
+    FLAGS_ysql_adaptive_prefetch_max_limit = 100000;
+    PgMiniSingleTServerTest::SetUp();
+  }
+};
+
+class PgMiniScanSplitTest : public PgMiniSingleTServerTest {
+ public:
+  void SetUp() override {
+    FLAGS_db_block_size_bytes = 4_KB;
+    FLAGS_tablet_scan_split_min_part_size_bytes = 1;
+    PgMiniSingleTServerTest::SetUp();
+  }
+};
+
 class PgMiniMasterFailoverTest : public PgMiniTest {
  public:
   size_t NumMasters() override {
@@ -1716,6 +1738,35 @@ TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(SmallRead), PgMiniBigPrefetchTest)
   Run(kRows, kBlockSize, kReads);
 }
 
+// Compares scans that return ~10MB pages, with rows data attached to the response as is and
+// copied to the sidecar buffer.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigPageZeroCopy), PgMiniBigPrefetchTest) {
+  constexpr int kRows = RegularBuildVsSanitizers(10000, 1000);
+  constexpr int kValueSize = 1000;
+  constexpr int kReads = RegularBuildVsSanitizers(10, 2);
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value TEXT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, repeat('x', $0) FROM generate_series(1, $1) AS i",
+      kValueSize, kRows));
+
+  for (bool zero_copy : {false, true}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_read_rows_data_zero_copy_min_size) =
+        zero_copy ? 64_KB : std::numeric_limits<uint64_t>::max();
+    MonoDelta total_time = MonoDelta::kZero;
+    for (int i = 0; i != kReads; ++i) {
+      auto start = MonoTime::Now();
+      // length() is not pushed down, so whole values are returned by the tablet server.
+      auto total_size = ASSERT_RESULT(conn.FetchValue<int64_t>(
+          "SELECT SUM(LENGTH(value)) FROM t"));
+      total_time += MonoTime::Now() - start;
+      ASSERT_EQ(total_size, static_cast<int64_t>(kRows) * kValueSize);
+    }
+    LOG(INFO) << "Zero copy: " << zero_copy << ", average read time: " << total_time / kReads;
+  }
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(DDLWithRestart)) {
   SetAtomicFlag(1.0, &FLAGS_TEST_transaction_ignore_applying_probability);
   FLAGS_TEST_force_master_leader_resolution = true;
@@ -2472,6 +2523,82 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(TestSerializableStrongReadLockNotAbor
       << "Update status: " << update_status << ".\n";
 }
 
+// Scan of a single range partitioned tablet is split into sub-ranges read in parallel, results
+// should be the same as of the whole range scan.
+TEST_F(PgMiniScanSplitTest, YB_DISABLE_TEST_IN_TSAN(SplitRangeScan)) {
+  constexpr int kNumRows = 20000;
+  constexpr int kNumFlushes = 4;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT, v TEXT, PRIMARY KEY (k ASC))"));
+  for (int i = 0; i != kNumFlushes; ++i) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "INSERT INTO t SELECT s, repeat(md5(s::text), 8) FROM generate_series($0, $1) AS s",
+        i * kNumRows / kNumFlushes + 1, (i + 1) * kNumRows / kNumFlushes));
+    ASSERT_OK(cluster_->FlushTablets(tablet::FlushMode::kSync));
+  }
+
+  // Make sure that tablet splits scans of this table.
+  auto peers = ListTabletPeers(cluster_.get(), [](const auto& peer) {
+    return peer->tablet_metadata()->table_name() == "t";
+  });
+  ASSERT_EQ(peers.size(), 1U);
+  {
+    auto tablet = peers[0]->shared_tablet();
+    PgsqlReadRequestPB req;
+    req.set_scan_split_parts(4);
+    ASSERT_FALSE(tablet->GetPgsqlScanSplitKeys(req, *tablet->schema()).empty());
+  }
+
+  auto res = ASSERT_RESULT(conn.Fetch("SELECT COUNT(*), SUM(k), MIN(k), MAX(k) FROM t"));
+  auto count = ASSERT_RESULT(GetInt64(res.get(), 0, 0));
+  ASSERT_EQ(count, kNumRows);
+  const auto sum = ASSERT_RESULT(GetInt64(res.get(), 0, 1));
+  ASSERT_EQ(sum, static_cast<int64_t>(kNumRows) * (kNumRows + 1) / 2);
+  const auto min = ASSERT_RESULT(GetInt32(res.get(), 0, 2));
+  ASSERT_EQ(min, 1);
+  const auto max = ASSERT_RESULT(GetInt32(res.get(), 0, 3));
+  ASSERT_EQ(max, kNumRows);
+
+  count = ASSERT_RESULT(conn.FetchValue<int64_t>(
+      "SELECT COUNT(*) FROM t WHERE k % 3 = 0 AND v <> ''"));
+  ASSERT_EQ(count, kNumRows / 3);
+
+  count = ASSERT_RESULT(conn.FetchValue<int64_t>(
+      Format("SELECT COUNT(*) FROM t WHERE k > $0 AND k <= $1", kNumRows / 4, kNumRows / 2)));
+  ASSERT_EQ(count, kNumRows / 4);
+}
+
+// Statement LIMIT is above ysql_prefetch_limit, so the page size of the scan is adapted while the
+// rows are fetched.
+TEST_F(PgMiniAdaptivePrefetchTest, YB_DISABLE_TEST_IN_TSAN(LimitAbovePrefetchLimit)) {
+  constexpr int kNumRows = 20000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT, v TEXT, PRIMARY KEY (k ASC))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT s, md5(s::text) FROM generate_series(1, $0) AS s", kNumRows));
+
+  for (auto limit : {250, 1000, 5000}) {
+    for (auto offset : {0, 300}) {
+      auto res = ASSERT_RESULT(conn.FetchFormat(
+          "SELECT k, v FROM t ORDER BY k LIMIT $0 OFFSET $1", limit, offset));
+      ASSERT_EQ(PQntuples(res.get()), limit);
+      for (int i = 0; i != limit; ++i) {
+        ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), i, 0)), offset + i + 1);
+      }
+    }
+  }
+
+  // LIMIT applies to the filtered rows, so more rows than the LIMIT are read from the tablet.
+  auto res = ASSERT_RESULT(conn.Fetch(
+      "SELECT k FROM t WHERE md5(k::text) = v AND k % 7 = 0 ORDER BY k LIMIT 1000"));
+  ASSERT_EQ(PQntuples(res.get()), 1000);
+  for (int i = 0; i != 1000; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), i, 0)), (i + 1) * 7);
+  }
+}
+
 // Use special mode when non leader master times out all rpcs.
 // Then step down master leader and perform backup.
 TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_SANITIZERS_OR_MAC(NonRespondingMaster),
@@ -36,12 +36,15 @@
 #include "yb/master/master_heartbeat.pb.h"
 
 #include "yb/rpc/connection.h"
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_introspection.pb.h"
+#include "yb/rpc/scheduler.h"
 
 #include "yb/tserver/tablet_server_interface.h"
 #include "yb/tserver/tserver_service.proxy.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/memory/mc_types.h"
@@ -88,6 +91,16 @@ METRIC_DEFINE_gauge_uint64(
     server, redis_monitoring_clients, "Number of clients running monitor", yb::MetricUnit::kUnits,
     "Number of clients running monitor ");
 
+METRIC_DEFINE_histogram_with_percentiles(
+    server, redis_tablet_batch_operations, "Operations per Redis tablet flush",
+    yb::MetricUnit::kOperations,
+    "Number of operations sent to a tablet by a single flush of the Redis service.", 1000000LU, 2);
+METRIC_DEFINE_histogram_with_percentiles(
+    server, redis_tablet_batch_calls, "Redis calls per tablet flush",
+    yb::MetricUnit::kRequests,
+    "Number of Redis calls, whose operations were coalesced into a single tablet flush.",
+    100000LU, 2);
+
 #if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
 constexpr int32_t kDefaultRedisServiceTimeoutMs = 600000;
 #else
@@ -111,6 +124,19 @@ DEFINE_int32(redis_password_caching_duration_ms, 5000,
              "The duration for which we will cache the redis passwords. 0 to disable.");
 
 DEFINE_bool(redis_safe_batch, true, "Use safe batching with Redis service");
+
+DEFINE_int32(redis_tablet_batch_window_us, 500,
+             "Operations for a tablet, that has a flush in progress, are delayed for up to this "
+             "number of microseconds to be coalesced with operations of other Redis calls into a "
+             "single tablet RPC. 0 to flush operations of each call separately.");
+TAG_FLAG(redis_tablet_batch_window_us, runtime);
+TAG_FLAG(redis_tablet_batch_window_us, advanced);
+
+DEFINE_uint64(redis_tablet_batch_max_operations, 1024,
+              "Delayed operations for a tablet are flushed without waiting for the batch window "
+              "once there are this many of them.");
+TAG_FLAG(redis_tablet_batch_max_operations, runtime);
+TAG_FLAG(redis_tablet_batch_max_operations, advanced);
 DEFINE_bool(enable_redis_auth, true, "Enable AUTH for the Redis service");
 
 DECLARE_string(placement_cloud);
@@ -363,6 +389,70 @@ class SessionPool {
 class Block;
 typedef std::shared_ptr<Block> BlockPtr;
 
+// Coalesces blocks of operations for the same tablet, that were issued by different Redis calls,
+// into larger tablet RPCs.
+//
+// When there is no flush in progress for the tablet, the block is flushed right away, so an idle
+// proxy does not add any latency. Otherwise the block is delayed until the flush in progress
+// completes, but for no longer than redis_tablet_batch_window_us, and then it is flushed together
+// with all other blocks for this tablet that were delayed meanwhile.
+class TabletBatchers {
+ public:
+  void Init(SessionPool* session_pool, rpc::Scheduler* scheduler,
+            const scoped_refptr<MetricEntity>& metric_entity);
+
+  // Flushes the block, or delays it to be flushed with blocks of other calls.
+  void Add(const client::internal::RemoteTablet& tablet, BlockPtr block,
+           bool allow_local_calls_in_curr_thread);
+
+ private:
+  struct Entry {
+    // The context owns the arena the block is allocated on, so it is declared before the block
+    // to be destroyed after it.
+    BatchContextPtr context;
+    BlockPtr block;
+  };
+
+  struct TabletBatch {
+    explicit TabletBatch(const TabletId& tablet_id_) : tablet_id(tablet_id_) {}
+
+    const TabletId tablet_id;
+    std::mutex mutex;
+    std::vector<Entry> delayed;
+    size_t delayed_operations = 0;
+    size_t flushes_in_progress = 0;
+    bool flush_scheduled = false;
+    // Set when the batch is removed from batches_, so it should not be used for new blocks.
+    bool removed = false;
+
+    bool Idle() const {
+      return flushes_in_progress == 0 && delayed.empty() && !flush_scheduled;
+    }
+  };
+
+  typedef std::shared_ptr<TabletBatch> TabletBatchPtr;
+
+  TabletBatchPtr BatchFor(const TabletId& tablet_id);
+
+  void Flush(const TabletBatchPtr& batch, std::vector<Entry> entries,
+             bool allow_local_calls_in_curr_thread);
+
+  void FlushDone(const TabletBatchPtr& batch);
+
+  void FlushDelayed(const TabletBatchPtr& batch);
+
+  // Removes the batch from batches_ if there is nothing pending for its tablet.
+  void RemoveIfIdle(const TabletBatchPtr& batch);
+
+  SessionPool* session_pool_ = nullptr;
+  rpc::Scheduler* scheduler_ = nullptr;
+  scoped_refptr<Histogram> operations_per_flush_;
+  scoped_refptr<Histogram> calls_per_flush_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, TabletBatchPtr> batches_ GUARDED_BY(mutex_);
+};
+
 class Block : public std::enable_shared_from_this<Block> {
  public:
   typedef MCVector<Operation*> Ops;
@@ -383,10 +473,20 @@ class Block : public std::enable_shared_from_this<Block> {
     ops_.push_back(operation);
   }
 
-  void Launch(SessionPool* session_pool, bool allow_local_calls_in_curr_thread = true) {
+  void Launch(SessionPool* session_pool, TabletBatchers* tablet_batchers,
+              bool allow_local_calls_in_curr_thread = true) {
     session_pool_ = session_pool;
+    tablet_batchers_ = tablet_batchers;
+    if (tablet_batchers && FLAGS_redis_tablet_batch_window_us > 0) {
+      auto* tablet = BatchTablet();
+      if (tablet) {
+        tablet_batchers->Add(
+            *tablet, shared_from_this(), allow_local_calls_in_curr_thread && next_ == nullptr);
+        return;
+      }
+    }
+
     session_ = session_pool->Take();
-    bool has_ok = false;
     bool applied_operations = false;
     // Supposed to be called only once.
     client::FlushCallback callback = BlockCallback(shared_from_this());
@@ -394,9 +494,7 @@ class Block : public std::enable_shared_from_this<Block> {
       client::FlushStatus flush_status = {status, {}};
       callback(&flush_status);
     };
-    for (auto* op : ops_) {
-      has_ok = op->Apply(session_.get(), status_callback, &applied_operations) || has_ok;
-    }
+    bool has_ok = ApplyOperations(session_.get(), status_callback, &applied_operations);
     if (has_ok) {
       if (applied_operations) {
         // Allow local calls in this thread only if no one is waiting behind us.
@@ -420,37 +518,24 @@ class Block : public std::enable_shared_from_this<Block> {
                   ops_, static_cast<void*>(context_.get()), next_);
   }
 
- private:
-  class BlockCallback {
-   public:
-    explicit BlockCallback(BlockPtr block) : block_(std::move(block)) {
-      // We remember block_->context_ to avoid issues with having multiple instances referring the
-      // same block (that is allocated in arena and one of them calling block_->Done while another
-      // still have reference to block and trying to update ref counter for it in destructor.
-      context_ = block_ ? block_->context_ : nullptr;
-    }
+  const BatchContextPtr& context() const {
+    return context_;
+  }
 
-    ~BlockCallback() {
-      // We only reset context_ after block_, because resetting context_ could free Arena memory
-      // on which block_ is allocated together with its ref counter.
-      block_.reset();
-      context_.reset();
-    }
+  size_t num_operations() const {
+    return ops_.size();
+  }
 
-    void operator()(client::FlushStatus* status) {
-      // Block context owns the arena upon which this block is created.
-      // Done is going to free up block's reference to context. So, unless we ensure that
-      // the context lives beyond the block_.reset() we might get an error while updating the
-      // ref-count for the block_ (in the area of arena owned by the context).
-      auto context = block_->context_;
-      DCHECK(context != nullptr) << block_.get();
-      block_->Done(status);
-      block_.reset();
+  // Applies operations to the session. Returns true if there is an operation that was applied, or
+  // that will invoke the status callback.
+  bool ApplyOperations(
+      client::YBSession* session, const StatusFunctor& status_callback, bool* applied_operations) {
+    bool has_ok = false;
+    for (auto* op : ops_) {
+      has_ok = op->Apply(session, status_callback, applied_operations) || has_ok;
     }
-   private:
-    BlockPtr block_;
-    BatchContextPtr context_;
-  };
+    return has_ok;
+  }
 
   void Done(client::FlushStatus* flush_status) {
     MonoTime now = MonoTime::Now();
@@ -458,15 +543,24 @@ class Block : public std::enable_shared_from_this<Block> {
     VLOG(3) << "Received status from call " << flush_status->status.ToString(true);
 
     std::unordered_map<const client::YBOperation*, Status> op_errors;
-    bool tablet_not_found = false;
     if (!flush_status->status.ok()) {
+      // The flush status could be shared by several blocks, so errors are copied.
       for (const auto& error : flush_status->errors) {
-        if (error->status().IsNotFound()) {
-          tablet_not_found = true;
-        }
-        op_errors[&error->failed_op()] = std::move(error->status());
-        YB_LOG_EVERY_N_SECS(WARNING, 1) << "Explicit error while inserting: "
-                                        << error->status().ToString();
+        op_errors[&error->failed_op()] = error->status();
+      }
+    }
+
+    // Only errors of operations of this block are considered, other blocks flushed together with
+    // it handle their own errors.
+    bool tablet_not_found = false;
+    for (auto* op : ops_) {
+      if (!op->has_operation()) {
+        continue;
+      }
+      auto it = op_errors.find(&op->operation());
+      if (it != op_errors.end() && it->second.IsNotFound()) {
+        tablet_not_found = true;
+        break;
       }
     }
 
@@ -478,7 +572,8 @@ class Block : public std::enable_shared_from_this<Block> {
     for (auto* op : ops_) {
       if (op->has_operation() && op_errors.find(&op->operation()) != op_errors.end()) {
         // Could check here for NotFound either.
-        auto s = op_errors[&op->operation()];
+        const auto& s = op_errors[&op->operation()];
+        YB_LOG_EVERY_N_SECS(WARNING, 1) << "Explicit error while inserting: " << s.ToString();
         op->Respond(s);
       } else {
         op->Respond(Status::OK());
@@ -496,11 +591,58 @@ class Block : public std::enable_shared_from_this<Block> {
       session_.reset();
     }
     if (next_) {
-      next_->Launch(session_pool_, allow_local_calls_in_curr_thread);
+      next_->Launch(session_pool_, tablet_batchers_, allow_local_calls_in_curr_thread);
     }
     context_.reset();
   }
 
+ private:
+  // Returns the tablet of the block operations, if they could be coalesced with operations of
+  // other calls. Local operations, and operations whose tablet is not known, are flushed
+  // separately.
+  const client::internal::RemoteTablet* BatchTablet() const {
+    if (ops_.empty()) {
+      return nullptr;
+    }
+    for (auto* op : ops_) {
+      if (!op->has_operation()) {
+        return nullptr;
+      }
+    }
+    return ops_.front()->tablet().get();
+  }
+
+  class BlockCallback {
+   public:
+    explicit BlockCallback(BlockPtr block) : block_(std::move(block)) {
+      // We remember block_->context_ to avoid issues with having multiple instances referring the
+      // same block (that is allocated in arena and one of them calling block_->Done while another
+      // still have reference to block and trying to update ref counter for it in destructor.
+      context_ = block_ ? block_->context_ : nullptr;
+    }
+
+    ~BlockCallback() {
+      // We only reset context_ after block_, because resetting context_ could free Arena memory
+      // on which block_ is allocated together with its ref counter.
+      block_.reset();
+      context_.reset();
+    }
+
+    void operator()(client::FlushStatus* status) {
+      // Block context owns the arena upon which this block is created.
+      // Done is going to free up block's reference to context. So, unless we ensure that
+      // the context lives beyond the block_.reset() we might get an error while updating the
+      // ref-count for the block_ (in the area of arena owned by the context).
+      auto context = block_->context_;
+      DCHECK(context != nullptr) << block_.get();
+      block_->Done(status);
+      block_.reset();
+    }
+   private:
+    BlockPtr block_;
+    BatchContextPtr context_;
+  };
+
   bool Retrying() {
     auto old_table = context_->table();
     context_->CleanYBTableFromCache();
@@ -531,7 +673,7 @@ class Block : public std::enable_shared_from_this<Block> {
     for (auto* op : ops_) {
       op->ResetTable(context_->table());
     }
-    Launch(session_pool_, allow_local_calls_in_curr_thread);
+    Launch(session_pool_, tablet_batchers_, allow_local_calls_in_curr_thread);
     VLOG(3) << " Retrying with table : " << table->id() << " old table was " << old_table->id();
     return true;
   }
@@ -542,11 +684,172 @@ class Block : public std::enable_shared_from_this<Block> {
   rpc::RpcMethodMetrics metrics_internal_;
   MonoTime start_;
   SessionPool* session_pool_;
+  TabletBatchers* tablet_batchers_ = nullptr;
   std::shared_ptr<client::YBSession> session_;
   BlockPtr next_;
   int num_retries_ = 1;
 };
 
+void TabletBatchers::Init(SessionPool* session_pool, rpc::Scheduler* scheduler,
+                          const scoped_refptr<MetricEntity>& metric_entity) {
+  session_pool_ = session_pool;
+  scheduler_ = scheduler;
+  operations_per_flush_ = METRIC_redis_tablet_batch_operations.Instantiate(metric_entity);
+  calls_per_flush_ = METRIC_redis_tablet_batch_calls.Instantiate(metric_entity);
+}
+
+TabletBatchers::TabletBatchPtr TabletBatchers::BatchFor(const TabletId& tablet_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& result = batches_[tablet_id];
+  if (!result) {
+    result = std::make_shared<TabletBatch>(tablet_id);
+  }
+  return result;
+}
+
+void TabletBatchers::Add(const client::internal::RemoteTablet& tablet, BlockPtr block,
+                         bool allow_local_calls_in_curr_thread) {
+  Entry entry = { block->context(), std::move(block) };
+  std::vector<Entry> entries;
+  bool schedule_flush = false;
+  TabletBatchPtr batch;
+  for (;;) {
+    batch = BatchFor(tablet.tablet_id());
+    std::lock_guard<std::mutex> lock(batch->mutex);
+    if (batch->removed) {
+      // Removed after we got it from the map, the next lookup creates a new batch.
+      continue;
+    }
+    if (batch->flushes_in_progress == 0) {
+      ++batch->flushes_in_progress;
+      entries.push_back(std::move(entry));
+    } else {
+      batch->delayed_operations += entry.block->num_operations();
+      batch->delayed.push_back(std::move(entry));
+      if (batch->delayed_operations >= FLAGS_redis_tablet_batch_max_operations) {
+        entries.swap(batch->delayed);
+        batch->delayed_operations = 0;
+        ++batch->flushes_in_progress;
+      } else if (!batch->flush_scheduled) {
+        batch->flush_scheduled = true;
+        schedule_flush = true;
+      }
+    }
+    break;
+  }
+
+  if (schedule_flush) {
+    scheduler_->Schedule(
+        [this, batch](const Status& status) {
+          if (!status.ok()) {
+            // The scheduler is shutting down. Delayed blocks are flushed when the flush in
+            // progress completes.
+            return;
+          }
+          FlushDelayed(batch);
+        },
+        FLAGS_redis_tablet_batch_window_us * 1us);
+  }
+  if (!entries.empty()) {
+    Flush(batch, std::move(entries), allow_local_calls_in_curr_thread);
+  }
+}
+
+void TabletBatchers::Flush(const TabletBatchPtr& batch, std::vector<Entry> entries,
+                           bool allow_local_calls_in_curr_thread) {
+  auto session = session_pool_->Take();
+  size_t num_operations = 0;
+  std::vector<Entry> applied;
+  applied.reserve(entries.size());
+  for (auto& entry : entries) {
+    num_operations += entry.block->num_operations();
+    bool applied_operations = false;
+    // Batched blocks don't have local operations, so the status callback is never used.
+    if (entry.block->ApplyOperations(session.get(), StatusFunctor(), &applied_operations)) {
+      applied.push_back(std::move(entry));
+    } else {
+      entry.block->Processed();
+    }
+  }
+  entries.clear();
+  operations_per_flush_->Increment(num_operations);
+  calls_per_flush_->Increment(applied.size());
+
+  if (applied.empty()) {
+    session_pool_->Release(session);
+    FlushDone(batch);
+    return;
+  }
+
+  session->set_allow_local_calls_in_curr_thread(allow_local_calls_in_curr_thread);
+  session->FlushAsync([this, batch, session, applied = std::move(applied)](
+      client::FlushStatus* flush_status) mutable {
+    for (auto& entry : applied) {
+      entry.block->Done(flush_status);
+    }
+    applied.clear();
+    session_pool_->Release(session);
+    FlushDone(batch);
+  });
+}
+
+void TabletBatchers::FlushDone(const TabletBatchPtr& batch) {
+  std::vector<Entry> entries;
+  bool remove = false;
+  {
+    std::lock_guard<std::mutex> lock(batch->mutex);
+    --batch->flushes_in_progress;
+    if (batch->flushes_in_progress == 0 && batch->delayed.empty()) {
+      remove = !batch->flush_scheduled;
+    } else if (batch->flushes_in_progress == 0) {
+      entries.swap(batch->delayed);
+      batch->delayed_operations = 0;
+      ++batch->flushes_in_progress;
+    }
+  }
+  if (remove) {
+    RemoveIfIdle(batch);
+    return;
+  }
+  if (entries.empty()) {
+    return;
+  }
+  // Called from the flush callback, that should not execute local calls.
+  Flush(batch, std::move(entries), /* allow_local_calls_in_curr_thread= */ false);
+}
+
+void TabletBatchers::FlushDelayed(const TabletBatchPtr& batch) {
+  std::vector<Entry> entries;
+  {
+    std::lock_guard<std::mutex> lock(batch->mutex);
+    batch->flush_scheduled = false;
+    if (!batch->delayed.empty()) {
+      entries.swap(batch->delayed);
+      batch->delayed_operations = 0;
+      ++batch->flushes_in_progress;
+    }
+  }
+  if (entries.empty()) {
+    RemoveIfIdle(batch);
+    return;
+  }
+  // Invoked by the scheduler on a reactor thread, so local calls are not allowed.
+  Flush(batch, std::move(entries), /* allow_local_calls_in_curr_thread= */ false);
+}
+
+void TabletBatchers::RemoveIfIdle(const TabletBatchPtr& batch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::lock_guard<std::mutex> batch_lock(batch->mutex);
+  if (batch->removed || !batch->Idle()) {
+    return;
+  }
+  batch->removed = true;
+  auto it = batches_.find(batch->tablet_id);
+  if (it != batches_.end() && it->second == batch) {
+    batches_.erase(it);
+  }
+}
+
 typedef std::array<rpc::RpcMethodMetrics, kOperationTypeMapSize> InternalMetrics;
 
 struct BlockData {
@@ -581,15 +884,18 @@ class TabletOperations {
     FATAL_INVALID_ENUM_VALUE(OperationType, type);
   }
 
-  void Done(SessionPool* session_pool, bool allow_local_calls_in_curr_thread) {
+  void Done(SessionPool* session_pool, TabletBatchers* tablet_batchers,
+            bool allow_local_calls_in_curr_thread) {
     if (flush_head_) {
-      flush_head_->Launch(session_pool, allow_local_calls_in_curr_thread);
+      flush_head_->Launch(session_pool, tablet_batchers, allow_local_calls_in_curr_thread);
     } else {
       if (read_data_.block) {
-        read_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
+        read_data_.block->Launch(
+            session_pool, tablet_batchers, allow_local_calls_in_curr_thread);
       }
       if (write_data_.block) {
-        write_data_.block->Launch(session_pool, allow_local_calls_in_curr_thread);
+        write_data_.block->Launch(
+            session_pool, tablet_batchers, allow_local_calls_in_curr_thread);
       }
     }
   }
@@ -789,6 +1095,7 @@ struct RedisServiceImplData : public RedisServiceData {
   std::atomic<bool> initialized_;
   client::YBClient* client_ = nullptr;
   SessionPool session_pool_;
+  TabletBatchers tablet_batchers_;
   std::unordered_map<std::string, std::shared_ptr<client::YBTable>> db_to_opened_table_;
   std::shared_ptr<client::YBMetaDataCache> tables_cache_;
 
@@ -960,7 +1267,8 @@ class BatchContextImpl : public BatchContext {
 
     size_t idx = 0;
     for (auto& tablet : tablets_) {
-      tablet.second.Done(&impl_data_->session_pool_, ++idx == tablets_.size());
+      tablet.second.Done(
+          &impl_data_->session_pool_, &impl_data_->tablet_batchers_, ++idx == tablets_.size());
     }
     tablets_.clear();
   }
@@ -1358,6 +1666,8 @@ Status RedisServiceImplData::Initialize() {
     tables_cache_ = std::make_shared<YBMetaDataCache>(
         client_, false /* Update roles permissions cache */);
     session_pool_.Init(client_, server_->metric_entity());
+    tablet_batchers_.Init(
+        &session_pool_, &client_->messenger()->scheduler(), server_->metric_entity());
 
     initialized_.store(true, std::memory_order_release);
   }
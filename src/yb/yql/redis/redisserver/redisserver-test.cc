@@ -72,6 +72,7 @@ DECLARE_uint64(rpc_max_message_size);
 DECLARE_uint64(consensus_max_batch_size_bytes);
 DECLARE_int32(consensus_rpc_timeout_ms);
 DECLARE_int64(max_time_in_queue_ms);
+DECLARE_int32(redis_tablet_batch_window_us);
 
 DEFINE_uint64(test_redis_max_concurrent_commands, 20,
     "Value of redis_max_concurrent_commands for pipeline test");
@@ -81,6 +82,8 @@ DEFINE_uint64(test_redis_max_batch, 250,
 METRIC_DECLARE_gauge_uint64(redis_available_sessions);
 METRIC_DECLARE_gauge_uint64(redis_allocated_sessions);
 METRIC_DECLARE_gauge_uint64(redis_monitoring_clients);
+METRIC_DECLARE_histogram(redis_tablet_batch_operations);
+METRIC_DECLARE_histogram(redis_tablet_batch_calls);
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -1374,6 +1377,55 @@ TEST_F_EX(TestRedisService, SafeBatchPipeline, TestRedisServiceSafeBatch) {
   LOG(INFO) << yb::Format("Safe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+class TestRedisServiceTabletBatching : public TestRedisService {
+ public:
+  void SetUp() override {
+    FLAGS_redis_tablet_batch_window_us = 5000;
+    TestRedisService::SetUp();
+  }
+};
+
+// Commands of many concurrent clients are coalesced into tablet flushes shared by their calls.
+TEST_F_EX(TestRedisService, TabletBatching, TestRedisServiceTabletBatching) {
+  constexpr int kNumClients = 16;
+  constexpr int kNumKeys = RegularBuildVsSanitizers(100, 20);
+
+  std::vector<std::thread> threads;
+  for (int c = 0; c != kNumClients; ++c) {
+    threads.emplace_back([this, c] {
+      auto client = CreateClient();
+      for (int i = 0; i != kNumKeys; ++i) {
+        client->Send({"SET", Format("key_$0_$1", c, i), Format("value_$0_$1", c, i)},
+                     [](const RedisReply& reply) {
+          ASSERT_EQ("OK", reply.as_string()) << reply.ToString();
+        });
+        client->Commit();
+      }
+      for (int i = 0; i != kNumKeys; ++i) {
+        auto expected = Format("value_$0_$1", c, i);
+        client->Send({"GET", Format("key_$0_$1", c, i)}, [expected](const RedisReply& reply) {
+          ASSERT_EQ(expected, reply.as_string()) << reply.ToString();
+        });
+        client->Commit();
+      }
+      client->Disconnect();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto operations = METRIC_redis_tablet_batch_operations.Instantiate(server_->metric_entity());
+  auto calls = METRIC_redis_tablet_batch_calls.Instantiate(server_->metric_entity());
+  LOG(INFO) << "Tablet flushes: " << calls->TotalCount()
+            << ", max calls per flush: " << calls->MaxValueForTests()
+            << ", mean operations per flush: " << operations->MeanValueForTests();
+  // Each client waits for its command before sending the next one, so commands could share a
+  // flush only if calls of different clients were coalesced.
+  ASSERT_GT(calls->MaxValueForTests(), 1);
+  ASSERT_LT(calls->TotalCount(), kNumClients * kNumKeys * 2U);
+}
+
 TEST_F(TestRedisService, BatchedCommandMulti) {
   SendCommandAndExpectResponse(
       __LINE__,